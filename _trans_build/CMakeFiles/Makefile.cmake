@@ -0,0 +1,243 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/GossDetectDependencies.cmake"
+  "/root/repo/cmake/GossDetectPlatform.cmake"
+  "/root/repo/src/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/BoostDetectToolset-1.74.0.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/boost_filesystem-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/boost_filesystem-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/libboost_filesystem-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/libboost_filesystem-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_iostreams-1.74.0/boost_iostreams-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_iostreams-1.74.0/boost_iostreams-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_iostreams-1.74.0/libboost_iostreams-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_iostreams-1.74.0/libboost_iostreams-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_program_options-1.74.0/boost_program_options-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_program_options-1.74.0/boost_program_options-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_program_options-1.74.0/libboost_program_options-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_program_options-1.74.0/libboost_program_options-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-static.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCCompiler.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCCompilerABI.c"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompiler.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompilerABI.cpp"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCompilerIdDetection.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompileFeatures.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerABI.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerId.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitIncludeInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitLinkInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseLibraryArchitecture.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePushCheckState.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystem.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCompilerCommon.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeUnixFindMake.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckSymbolExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ADSP-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMCC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/AppleClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Borland-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Bruce-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompilerInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Comeau-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Compaq-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Compaq-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Cray-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Embarcadero-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Fujitsu-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/FujitsuClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GHS-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-FindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/HP-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/HP-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IAR-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMCPP-C-DetermineVersionInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMCPP-CXX-DetermineVersionInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMClang-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Intel-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IntelLLVM-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/LCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/LCC-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/MSVC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVHPC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVIDIA-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/OpenWatcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PGI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PathScale-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SCO-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SDCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SunPro-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SunPro-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/TI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Tasking-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/TinyCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/VisualAge-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/VisualAge-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Watcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XL-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XL-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XLClang-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XLClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/zOS-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/zOS-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBZip2.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBoost.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/FindZLIB.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/FeatureTesting.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-Determine-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/SelectLibraryConfigurations.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "src/CMakeFiles/gosslib.dir/DependInfo.cmake"
+  "src/CMakeFiles/gossapp.dir/DependInfo.cmake"
+  "src/CMakeFiles/goss.dir/DependInfo.cmake"
+  "src/CMakeFiles/xenomeapp.dir/DependInfo.cmake"
+  "src/CMakeFiles/xenome.dir/DependInfo.cmake"
+  "src/CMakeFiles/translucentapp.dir/DependInfo.cmake"
+  "src/CMakeFiles/translucent.dir/DependInfo.cmake"
+  "src/CMakeFiles/electusapp.dir/DependInfo.cmake"
+  "src/CMakeFiles/electus.dir/DependInfo.cmake"
+  "src/CMakeFiles/gossple.dir/DependInfo.cmake"
+  "src/CMakeFiles/testAnotTree.dir/DependInfo.cmake"
+  "src/CMakeFiles/testAsyncMerge.dir/DependInfo.cmake"
+  "src/CMakeFiles/testBackgroundLineSource.dir/DependInfo.cmake"
+  "src/CMakeFiles/testBackyardHash.dir/DependInfo.cmake"
+  "src/CMakeFiles/testBigInteger.dir/DependInfo.cmake"
+  "src/CMakeFiles/testBitVecSet.dir/DependInfo.cmake"
+  "src/CMakeFiles/testBlendedSort.dir/DependInfo.cmake"
+  "src/CMakeFiles/testBlockLineSource.dir/DependInfo.cmake"
+  "src/CMakeFiles/testBoundedQueue.dir/DependInfo.cmake"
+  "src/CMakeFiles/testCompactDynamicBitVector.dir/DependInfo.cmake"
+  "src/CMakeFiles/testDenseArray.dir/DependInfo.cmake"
+  "src/CMakeFiles/testEdgeAndCount.dir/DependInfo.cmake"
+  "src/CMakeFiles/testEdgeIndex.dir/DependInfo.cmake"
+  "src/CMakeFiles/testElectApp.dir/DependInfo.cmake"
+  "src/CMakeFiles/testEnumerativeCode.dir/DependInfo.cmake"
+  "src/CMakeFiles/testEstimateGraphStatistics.dir/DependInfo.cmake"
+  "src/CMakeFiles/testExternalVarPushSorter.dir/DependInfo.cmake"
+  "src/CMakeFiles/testExternalBufferSort.dir/DependInfo.cmake"
+  "src/CMakeFiles/testExternalMergeSort.dir/DependInfo.cmake"
+  "src/CMakeFiles/testFastqParser.dir/DependInfo.cmake"
+  "src/CMakeFiles/testFeistelHash.dir/DependInfo.cmake"
+  "src/CMakeFiles/testFibHeap.dir/DependInfo.cmake"
+  "src/CMakeFiles/testFixedWidthBitArray.dir/DependInfo.cmake"
+  "src/CMakeFiles/testGammaCodec.dir/DependInfo.cmake"
+  "src/CMakeFiles/testGossReadBaseString.dir/DependInfo.cmake"
+  "src/CMakeFiles/testGossReadDispatcher.dir/DependInfo.cmake"
+  "src/CMakeFiles/testGossReadSequenceBases.dir/DependInfo.cmake"
+  "src/CMakeFiles/testGraph.dir/DependInfo.cmake"
+  "src/CMakeFiles/testGraphComponents.dir/DependInfo.cmake"
+  "src/CMakeFiles/testJobManager.dir/DependInfo.cmake"
+  "src/CMakeFiles/testJsonWriter.dir/DependInfo.cmake"
+  "src/CMakeFiles/testKmerAligner.dir/DependInfo.cmake"
+  "src/CMakeFiles/testKmerIndex.dir/DependInfo.cmake"
+  "src/CMakeFiles/testKmerKernels.dir/DependInfo.cmake"
+  "src/CMakeFiles/testKmerNeighbourhood.dir/DependInfo.cmake"
+  "src/CMakeFiles/testLevenbergMarquardt.dir/DependInfo.cmake"
+  "src/CMakeFiles/testLineParser.dir/DependInfo.cmake"
+  "src/CMakeFiles/testMultithreadedBatchTask.dir/DependInfo.cmake"
+  "src/CMakeFiles/testParallelEdgeFilter.dir/DependInfo.cmake"
+  "src/CMakeFiles/testPerfReport.dir/DependInfo.cmake"
+  "src/CMakeFiles/testPlainLineSource.dir/DependInfo.cmake"
+  "src/CMakeFiles/testPhysicalFileFactory.dir/DependInfo.cmake"
+  "src/CMakeFiles/testRRRArray.dir/DependInfo.cmake"
+  "src/CMakeFiles/testReorderBuffer.dir/DependInfo.cmake"
+  "src/CMakeFiles/testResidentFileFactory.dir/DependInfo.cmake"
+  "src/CMakeFiles/testReverseComplementAdapter.dir/DependInfo.cmake"
+  "src/CMakeFiles/testRunLengthCodedBitVectorWord.dir/DependInfo.cmake"
+  "src/CMakeFiles/testRunLengthCodedSet.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSimpleHashMap.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSimpleHashSet.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSimpleRangeSet.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSmallBaseVector.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSortedArrayMap.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSortedKmerLookup.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSparseArray.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSparseArrayView.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSpinlock.dir/DependInfo.cmake"
+  "src/CMakeFiles/testSuperGraph.dir/DependInfo.cmake"
+  "src/CMakeFiles/testTourBus.dir/DependInfo.cmake"
+  "src/CMakeFiles/testUtils.dir/DependInfo.cmake"
+  "src/CMakeFiles/testVariableByteArray.dir/DependInfo.cmake"
+  "src/CMakeFiles/testVariableWidthBitArray.dir/DependInfo.cmake"
+  "src/CMakeFiles/testWordyBitVector.dir/DependInfo.cmake"
+  "src/CMakeFiles/testVByteCodec.dir/DependInfo.cmake"
+  "src/CMakeFiles/testGossCmdBuildGraph.dir/DependInfo.cmake"
+  "src/CMakeFiles/testGossCmdPrintContigs.dir/DependInfo.cmake"
+  "src/CMakeFiles/testGossCmdPruneTips.dir/DependInfo.cmake"
+  "src/CMakeFiles/testTransCmdAssemble.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/electus.dir/electus.cc.o"
+  "CMakeFiles/electus.dir/electus.cc.o.d"
+  "electus"
+  "electus.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/electus.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
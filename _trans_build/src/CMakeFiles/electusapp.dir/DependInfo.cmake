@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/ElectApp.cc" "src/CMakeFiles/electusapp.dir/ElectApp.cc.o" "gcc" "src/CMakeFiles/electusapp.dir/ElectApp.cc.o.d"
+  "/root/repo/src/GossCmdBuildKmerSet.cc" "src/CMakeFiles/electusapp.dir/GossCmdBuildKmerSet.cc.o" "gcc" "src/CMakeFiles/electusapp.dir/GossCmdBuildKmerSet.cc.o.d"
+  "/root/repo/src/GossCmdFilterReads.cc" "src/CMakeFiles/electusapp.dir/GossCmdFilterReads.cc.o" "gcc" "src/CMakeFiles/electusapp.dir/GossCmdFilterReads.cc.o.d"
+  "/root/repo/src/GossCmdHelp.cc" "src/CMakeFiles/electusapp.dir/GossCmdHelp.cc.o" "gcc" "src/CMakeFiles/electusapp.dir/GossCmdHelp.cc.o.d"
+  "/root/repo/src/GossCmdReg.cc" "src/CMakeFiles/electusapp.dir/GossCmdReg.cc.o" "gcc" "src/CMakeFiles/electusapp.dir/GossCmdReg.cc.o.d"
+  "/root/repo/src/GossOption.cc" "src/CMakeFiles/electusapp.dir/GossOption.cc.o" "gcc" "src/CMakeFiles/electusapp.dir/GossOption.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_trans_build/src/CMakeFiles/gosslib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/electusapp.dir/ElectApp.cc.o"
+  "CMakeFiles/electusapp.dir/ElectApp.cc.o.d"
+  "CMakeFiles/electusapp.dir/GossCmdBuildKmerSet.cc.o"
+  "CMakeFiles/electusapp.dir/GossCmdBuildKmerSet.cc.o.d"
+  "CMakeFiles/electusapp.dir/GossCmdFilterReads.cc.o"
+  "CMakeFiles/electusapp.dir/GossCmdFilterReads.cc.o.d"
+  "CMakeFiles/electusapp.dir/GossCmdHelp.cc.o"
+  "CMakeFiles/electusapp.dir/GossCmdHelp.cc.o.d"
+  "CMakeFiles/electusapp.dir/GossCmdReg.cc.o"
+  "CMakeFiles/electusapp.dir/GossCmdReg.cc.o.d"
+  "CMakeFiles/electusapp.dir/GossOption.cc.o"
+  "CMakeFiles/electusapp.dir/GossOption.cc.o.d"
+  "libelectusapp.a"
+  "libelectusapp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/electusapp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/goss.dir/goss.cc.o"
+  "CMakeFiles/goss.dir/goss.cc.o.d"
+  "goss"
+  "goss.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/goss.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
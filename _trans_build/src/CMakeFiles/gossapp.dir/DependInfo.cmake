@@ -0,0 +1,61 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/GossApp.cc" "src/CMakeFiles/gossapp.dir/GossApp.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossApp.cc.o.d"
+  "/root/repo/src/GossCmdAnnotateKmers.cc" "src/CMakeFiles/gossapp.dir/GossCmdAnnotateKmers.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdAnnotateKmers.cc.o.d"
+  "/root/repo/src/GossCmdBuildDb.cc" "src/CMakeFiles/gossapp.dir/GossCmdBuildDb.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdBuildDb.cc.o.d"
+  "/root/repo/src/GossCmdBuildEdgeIndex.cc" "src/CMakeFiles/gossapp.dir/GossCmdBuildEdgeIndex.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdBuildEdgeIndex.cc.o.d"
+  "/root/repo/src/GossCmdBuildEntryEdgeSet.cc" "src/CMakeFiles/gossapp.dir/GossCmdBuildEntryEdgeSet.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdBuildEntryEdgeSet.cc.o.d"
+  "/root/repo/src/GossCmdBuildGraph.cc" "src/CMakeFiles/gossapp.dir/GossCmdBuildGraph.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdBuildGraph.cc.o.d"
+  "/root/repo/src/GossCmdBuildKmerSet.cc" "src/CMakeFiles/gossapp.dir/GossCmdBuildKmerSet.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdBuildKmerSet.cc.o.d"
+  "/root/repo/src/GossCmdBuildScaffold.cc" "src/CMakeFiles/gossapp.dir/GossCmdBuildScaffold.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdBuildScaffold.cc.o.d"
+  "/root/repo/src/GossCmdBuildSubgraph.cc" "src/CMakeFiles/gossapp.dir/GossCmdBuildSubgraph.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdBuildSubgraph.cc.o.d"
+  "/root/repo/src/GossCmdBuildSupergraph.cc" "src/CMakeFiles/gossapp.dir/GossCmdBuildSupergraph.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdBuildSupergraph.cc.o.d"
+  "/root/repo/src/GossCmdClassifyReads.cc" "src/CMakeFiles/gossapp.dir/GossCmdClassifyReads.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdClassifyReads.cc.o.d"
+  "/root/repo/src/GossCmdClipLinks.cc" "src/CMakeFiles/gossapp.dir/GossCmdClipLinks.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdClipLinks.cc.o.d"
+  "/root/repo/src/GossCmdComputeNearKmers.cc" "src/CMakeFiles/gossapp.dir/GossCmdComputeNearKmers.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdComputeNearKmers.cc.o.d"
+  "/root/repo/src/GossCmdCountComponents.cc" "src/CMakeFiles/gossapp.dir/GossCmdCountComponents.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdCountComponents.cc.o.d"
+  "/root/repo/src/GossCmdDetectVariants.cc" "src/CMakeFiles/gossapp.dir/GossCmdDetectVariants.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdDetectVariants.cc.o.d"
+  "/root/repo/src/GossCmdDotGraph.cc" "src/CMakeFiles/gossapp.dir/GossCmdDotGraph.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdDotGraph.cc.o.d"
+  "/root/repo/src/GossCmdDotSupergraph.cc" "src/CMakeFiles/gossapp.dir/GossCmdDotSupergraph.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdDotSupergraph.cc.o.d"
+  "/root/repo/src/GossCmdDumpGraph.cc" "src/CMakeFiles/gossapp.dir/GossCmdDumpGraph.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdDumpGraph.cc.o.d"
+  "/root/repo/src/GossCmdDumpKmerSet.cc" "src/CMakeFiles/gossapp.dir/GossCmdDumpKmerSet.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdDumpKmerSet.cc.o.d"
+  "/root/repo/src/GossCmdEstimateErrorRate.cc" "src/CMakeFiles/gossapp.dir/GossCmdEstimateErrorRate.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdEstimateErrorRate.cc.o.d"
+  "/root/repo/src/GossCmdExtractCoreGenome.cc" "src/CMakeFiles/gossapp.dir/GossCmdExtractCoreGenome.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdExtractCoreGenome.cc.o.d"
+  "/root/repo/src/GossCmdExtractReads.cc" "src/CMakeFiles/gossapp.dir/GossCmdExtractReads.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdExtractReads.cc.o.d"
+  "/root/repo/src/GossCmdFilterReads.cc" "src/CMakeFiles/gossapp.dir/GossCmdFilterReads.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdFilterReads.cc.o.d"
+  "/root/repo/src/GossCmdFixReads.cc" "src/CMakeFiles/gossapp.dir/GossCmdFixReads.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdFixReads.cc.o.d"
+  "/root/repo/src/GossCmdGraphToKmerSet.cc" "src/CMakeFiles/gossapp.dir/GossCmdGraphToKmerSet.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdGraphToKmerSet.cc.o.d"
+  "/root/repo/src/GossCmdGroupReads.cc" "src/CMakeFiles/gossapp.dir/GossCmdGroupReads.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdGroupReads.cc.o.d"
+  "/root/repo/src/GossCmdHelp.cc" "src/CMakeFiles/gossapp.dir/GossCmdHelp.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdHelp.cc.o.d"
+  "/root/repo/src/GossCmdIntersectKmerSets.cc" "src/CMakeFiles/gossapp.dir/GossCmdIntersectKmerSets.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdIntersectKmerSets.cc.o.d"
+  "/root/repo/src/GossCmdLintGraph.cc" "src/CMakeFiles/gossapp.dir/GossCmdLintGraph.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdLintGraph.cc.o.d"
+  "/root/repo/src/GossCmdMergeAndAnnotateKmerSets.cc" "src/CMakeFiles/gossapp.dir/GossCmdMergeAndAnnotateKmerSets.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdMergeAndAnnotateKmerSets.cc.o.d"
+  "/root/repo/src/GossCmdPoolSamples.cc" "src/CMakeFiles/gossapp.dir/GossCmdPoolSamples.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdPoolSamples.cc.o.d"
+  "/root/repo/src/GossCmdPopBubbles.cc" "src/CMakeFiles/gossapp.dir/GossCmdPopBubbles.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdPopBubbles.cc.o.d"
+  "/root/repo/src/GossCmdPrintContigs.cc" "src/CMakeFiles/gossapp.dir/GossCmdPrintContigs.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdPrintContigs.cc.o.d"
+  "/root/repo/src/GossCmdPruneTips.cc" "src/CMakeFiles/gossapp.dir/GossCmdPruneTips.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdPruneTips.cc.o.d"
+  "/root/repo/src/GossCmdRestoreGraph.cc" "src/CMakeFiles/gossapp.dir/GossCmdRestoreGraph.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdRestoreGraph.cc.o.d"
+  "/root/repo/src/GossCmdScaffold.cc" "src/CMakeFiles/gossapp.dir/GossCmdScaffold.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdScaffold.cc.o.d"
+  "/root/repo/src/GossCmdSubtractKmerSet.cc" "src/CMakeFiles/gossapp.dir/GossCmdSubtractKmerSet.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdSubtractKmerSet.cc.o.d"
+  "/root/repo/src/GossCmdThreadPairs.cc" "src/CMakeFiles/gossapp.dir/GossCmdThreadPairs.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdThreadPairs.cc.o.d"
+  "/root/repo/src/GossCmdThreadReads.cc" "src/CMakeFiles/gossapp.dir/GossCmdThreadReads.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdThreadReads.cc.o.d"
+  "/root/repo/src/GossCmdTrimGraph.cc" "src/CMakeFiles/gossapp.dir/GossCmdTrimGraph.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdTrimGraph.cc.o.d"
+  "/root/repo/src/GossCmdTrimPaths.cc" "src/CMakeFiles/gossapp.dir/GossCmdTrimPaths.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossCmdTrimPaths.cc.o.d"
+  "/root/repo/src/GossOption.cc" "src/CMakeFiles/gossapp.dir/GossOption.cc.o" "gcc" "src/CMakeFiles/gossapp.dir/GossOption.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_trans_build/src/CMakeFiles/gosslib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
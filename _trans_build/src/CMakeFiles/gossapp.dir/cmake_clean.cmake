@@ -0,0 +1,93 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gossapp.dir/GossApp.cc.o"
+  "CMakeFiles/gossapp.dir/GossApp.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdAnnotateKmers.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdAnnotateKmers.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdBuildDb.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdBuildDb.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdBuildEdgeIndex.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdBuildEdgeIndex.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdBuildEntryEdgeSet.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdBuildEntryEdgeSet.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdBuildGraph.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdBuildGraph.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdBuildKmerSet.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdBuildKmerSet.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdBuildScaffold.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdBuildScaffold.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdBuildSubgraph.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdBuildSubgraph.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdBuildSupergraph.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdBuildSupergraph.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdClassifyReads.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdClassifyReads.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdClipLinks.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdClipLinks.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdComputeNearKmers.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdComputeNearKmers.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdCountComponents.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdCountComponents.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdDetectVariants.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdDetectVariants.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdDotGraph.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdDotGraph.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdDotSupergraph.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdDotSupergraph.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdDumpGraph.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdDumpGraph.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdDumpKmerSet.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdDumpKmerSet.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdEstimateErrorRate.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdEstimateErrorRate.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdExtractCoreGenome.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdExtractCoreGenome.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdExtractReads.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdExtractReads.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdFilterReads.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdFilterReads.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdFixReads.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdFixReads.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdGraphToKmerSet.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdGraphToKmerSet.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdGroupReads.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdGroupReads.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdHelp.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdHelp.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdIntersectKmerSets.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdIntersectKmerSets.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdLintGraph.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdLintGraph.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdMergeAndAnnotateKmerSets.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdMergeAndAnnotateKmerSets.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdPoolSamples.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdPoolSamples.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdPopBubbles.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdPopBubbles.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdPrintContigs.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdPrintContigs.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdPruneTips.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdPruneTips.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdRestoreGraph.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdRestoreGraph.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdScaffold.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdScaffold.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdSubtractKmerSet.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdSubtractKmerSet.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdThreadPairs.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdThreadPairs.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdThreadReads.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdThreadReads.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdTrimGraph.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdTrimGraph.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossCmdTrimPaths.cc.o"
+  "CMakeFiles/gossapp.dir/GossCmdTrimPaths.cc.o.d"
+  "CMakeFiles/gossapp.dir/GossOption.cc.o"
+  "CMakeFiles/gossapp.dir/GossOption.cc.o.d"
+  "libgossapp.a"
+  "libgossapp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gossapp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,63 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/AnnotTree.cc" "src/CMakeFiles/gosslib.dir/AnnotTree.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/AnnotTree.cc.o.d"
+  "/root/repo/src/App.cc" "src/CMakeFiles/gosslib.dir/App.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/App.cc.o.d"
+  "/root/repo/src/BackyardHash.cc" "src/CMakeFiles/gosslib.dir/BackyardHash.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/BackyardHash.cc.o.d"
+  "/root/repo/src/BigInteger.cc" "src/CMakeFiles/gosslib.dir/BigInteger.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/BigInteger.cc.o.d"
+  "/root/repo/src/CompactDynamicBitVector.cc" "src/CMakeFiles/gosslib.dir/CompactDynamicBitVector.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/CompactDynamicBitVector.cc.o.d"
+  "/root/repo/src/Debug.cc" "src/CMakeFiles/gosslib.dir/Debug.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/Debug.cc.o.d"
+  "/root/repo/src/DenseArray.cc" "src/CMakeFiles/gosslib.dir/DenseArray.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/DenseArray.cc.o.d"
+  "/root/repo/src/EdgeIndex.cc" "src/CMakeFiles/gosslib.dir/EdgeIndex.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/EdgeIndex.cc.o.d"
+  "/root/repo/src/EntryEdgeSet.cc" "src/CMakeFiles/gosslib.dir/EntryEdgeSet.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/EntryEdgeSet.cc.o.d"
+  "/root/repo/src/EstimateGraphStatistics.cc" "src/CMakeFiles/gosslib.dir/EstimateGraphStatistics.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/EstimateGraphStatistics.cc.o.d"
+  "/root/repo/src/ExternalSortUtils.cc" "src/CMakeFiles/gosslib.dir/ExternalSortUtils.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/ExternalSortUtils.cc.o.d"
+  "/root/repo/src/FileFactory.cc" "src/CMakeFiles/gosslib.dir/FileFactory.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/FileFactory.cc.o.d"
+  "/root/repo/src/GossCmdReg.cc" "src/CMakeFiles/gosslib.dir/GossCmdReg.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/GossCmdReg.cc.o.d"
+  "/root/repo/src/GossFastaReadBaseString.cc" "src/CMakeFiles/gosslib.dir/GossFastaReadBaseString.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/GossFastaReadBaseString.cc.o.d"
+  "/root/repo/src/GossFastqReadBaseString.cc" "src/CMakeFiles/gosslib.dir/GossFastqReadBaseString.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/GossFastqReadBaseString.cc.o.d"
+  "/root/repo/src/GossReadBaseString.cc" "src/CMakeFiles/gosslib.dir/GossReadBaseString.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/GossReadBaseString.cc.o.d"
+  "/root/repo/src/GossReadProcessor.cc" "src/CMakeFiles/gosslib.dir/GossReadProcessor.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/GossReadProcessor.cc.o.d"
+  "/root/repo/src/GossamerException.cc" "src/CMakeFiles/gosslib.dir/GossamerException.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/GossamerException.cc.o.d"
+  "/root/repo/src/Graph.cc" "src/CMakeFiles/gosslib.dir/Graph.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/Graph.cc.o.d"
+  "/root/repo/src/GraphComponents.cc" "src/CMakeFiles/gosslib.dir/GraphComponents.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/GraphComponents.cc.o.d"
+  "/root/repo/src/GraphTrimmer.cc" "src/CMakeFiles/gosslib.dir/GraphTrimmer.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/GraphTrimmer.cc.o.d"
+  "/root/repo/src/IntegerArray.cc" "src/CMakeFiles/gosslib.dir/IntegerArray.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/IntegerArray.cc.o.d"
+  "/root/repo/src/KmerKernels.cc" "src/CMakeFiles/gosslib.dir/KmerKernels.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/KmerKernels.cc.o.d"
+  "/root/repo/src/KmerSet.cc" "src/CMakeFiles/gosslib.dir/KmerSet.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/KmerSet.cc.o.d"
+  "/root/repo/src/LevenbergMarquardt.cc" "src/CMakeFiles/gosslib.dir/LevenbergMarquardt.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/LevenbergMarquardt.cc.o.d"
+  "/root/repo/src/LineSource.cc" "src/CMakeFiles/gosslib.dir/LineSource.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/LineSource.cc.o.d"
+  "/root/repo/src/MachDep.cc" "src/CMakeFiles/gosslib.dir/MachDep.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/MachDep.cc.o.d"
+  "/root/repo/src/MultithreadedBatchTask.cc" "src/CMakeFiles/gosslib.dir/MultithreadedBatchTask.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/MultithreadedBatchTask.cc.o.d"
+  "/root/repo/src/ParallelDecompressor.cc" "src/CMakeFiles/gosslib.dir/ParallelDecompressor.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/ParallelDecompressor.cc.o.d"
+  "/root/repo/src/PerfReport.cc" "src/CMakeFiles/gosslib.dir/PerfReport.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/PerfReport.cc.o.d"
+  "/root/repo/src/Phylogeny.cc" "src/CMakeFiles/gosslib.dir/Phylogeny.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/Phylogeny.cc.o.d"
+  "/root/repo/src/PhysicalFileFactory.cc" "src/CMakeFiles/gosslib.dir/PhysicalFileFactory.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/PhysicalFileFactory.cc.o.d"
+  "/root/repo/src/Profile.cc" "src/CMakeFiles/gosslib.dir/Profile.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/Profile.cc.o.d"
+  "/root/repo/src/RRRArray.cc" "src/CMakeFiles/gosslib.dir/RRRArray.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/RRRArray.cc.o.d"
+  "/root/repo/src/ResidentFileFactory.cc" "src/CMakeFiles/gosslib.dir/ResidentFileFactory.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/ResidentFileFactory.cc.o.d"
+  "/root/repo/src/ScaffoldGraph.cc" "src/CMakeFiles/gosslib.dir/ScaffoldGraph.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/ScaffoldGraph.cc.o.d"
+  "/root/repo/src/SmallBaseVector.cc" "src/CMakeFiles/gosslib.dir/SmallBaseVector.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/SmallBaseVector.cc.o.d"
+  "/root/repo/src/SparseArray.cc" "src/CMakeFiles/gosslib.dir/SparseArray.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/SparseArray.cc.o.d"
+  "/root/repo/src/StringFileFactory.cc" "src/CMakeFiles/gosslib.dir/StringFileFactory.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/StringFileFactory.cc.o.d"
+  "/root/repo/src/SuperGraph.cc" "src/CMakeFiles/gosslib.dir/SuperGraph.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/SuperGraph.cc.o.d"
+  "/root/repo/src/TourBus.cc" "src/CMakeFiles/gosslib.dir/TourBus.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/TourBus.cc.o.d"
+  "/root/repo/src/Utils.cc" "src/CMakeFiles/gosslib.dir/Utils.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/Utils.cc.o.d"
+  "/root/repo/src/VariableByteArray.cc" "src/CMakeFiles/gosslib.dir/VariableByteArray.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/VariableByteArray.cc.o.d"
+  "/root/repo/src/VariableWidthBitArray.cc" "src/CMakeFiles/gosslib.dir/VariableWidthBitArray.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/VariableWidthBitArray.cc.o.d"
+  "/root/repo/src/WordyBitVector.cc" "src/CMakeFiles/gosslib.dir/WordyBitVector.cc.o" "gcc" "src/CMakeFiles/gosslib.dir/WordyBitVector.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
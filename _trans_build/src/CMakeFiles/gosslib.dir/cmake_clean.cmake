@@ -0,0 +1,99 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gosslib.dir/AnnotTree.cc.o"
+  "CMakeFiles/gosslib.dir/AnnotTree.cc.o.d"
+  "CMakeFiles/gosslib.dir/App.cc.o"
+  "CMakeFiles/gosslib.dir/App.cc.o.d"
+  "CMakeFiles/gosslib.dir/BackyardHash.cc.o"
+  "CMakeFiles/gosslib.dir/BackyardHash.cc.o.d"
+  "CMakeFiles/gosslib.dir/BigInteger.cc.o"
+  "CMakeFiles/gosslib.dir/BigInteger.cc.o.d"
+  "CMakeFiles/gosslib.dir/CompactDynamicBitVector.cc.o"
+  "CMakeFiles/gosslib.dir/CompactDynamicBitVector.cc.o.d"
+  "CMakeFiles/gosslib.dir/Debug.cc.o"
+  "CMakeFiles/gosslib.dir/Debug.cc.o.d"
+  "CMakeFiles/gosslib.dir/DenseArray.cc.o"
+  "CMakeFiles/gosslib.dir/DenseArray.cc.o.d"
+  "CMakeFiles/gosslib.dir/EdgeIndex.cc.o"
+  "CMakeFiles/gosslib.dir/EdgeIndex.cc.o.d"
+  "CMakeFiles/gosslib.dir/EntryEdgeSet.cc.o"
+  "CMakeFiles/gosslib.dir/EntryEdgeSet.cc.o.d"
+  "CMakeFiles/gosslib.dir/EstimateGraphStatistics.cc.o"
+  "CMakeFiles/gosslib.dir/EstimateGraphStatistics.cc.o.d"
+  "CMakeFiles/gosslib.dir/ExternalSortUtils.cc.o"
+  "CMakeFiles/gosslib.dir/ExternalSortUtils.cc.o.d"
+  "CMakeFiles/gosslib.dir/FileFactory.cc.o"
+  "CMakeFiles/gosslib.dir/FileFactory.cc.o.d"
+  "CMakeFiles/gosslib.dir/GossCmdReg.cc.o"
+  "CMakeFiles/gosslib.dir/GossCmdReg.cc.o.d"
+  "CMakeFiles/gosslib.dir/GossFastaReadBaseString.cc.o"
+  "CMakeFiles/gosslib.dir/GossFastaReadBaseString.cc.o.d"
+  "CMakeFiles/gosslib.dir/GossFastqReadBaseString.cc.o"
+  "CMakeFiles/gosslib.dir/GossFastqReadBaseString.cc.o.d"
+  "CMakeFiles/gosslib.dir/GossReadBaseString.cc.o"
+  "CMakeFiles/gosslib.dir/GossReadBaseString.cc.o.d"
+  "CMakeFiles/gosslib.dir/GossReadProcessor.cc.o"
+  "CMakeFiles/gosslib.dir/GossReadProcessor.cc.o.d"
+  "CMakeFiles/gosslib.dir/GossamerException.cc.o"
+  "CMakeFiles/gosslib.dir/GossamerException.cc.o.d"
+  "CMakeFiles/gosslib.dir/Graph.cc.o"
+  "CMakeFiles/gosslib.dir/Graph.cc.o.d"
+  "CMakeFiles/gosslib.dir/GraphComponents.cc.o"
+  "CMakeFiles/gosslib.dir/GraphComponents.cc.o.d"
+  "CMakeFiles/gosslib.dir/GraphTrimmer.cc.o"
+  "CMakeFiles/gosslib.dir/GraphTrimmer.cc.o.d"
+  "CMakeFiles/gosslib.dir/IntegerArray.cc.o"
+  "CMakeFiles/gosslib.dir/IntegerArray.cc.o.d"
+  "CMakeFiles/gosslib.dir/KmerKernels.cc.o"
+  "CMakeFiles/gosslib.dir/KmerKernels.cc.o.d"
+  "CMakeFiles/gosslib.dir/KmerSet.cc.o"
+  "CMakeFiles/gosslib.dir/KmerSet.cc.o.d"
+  "CMakeFiles/gosslib.dir/LevenbergMarquardt.cc.o"
+  "CMakeFiles/gosslib.dir/LevenbergMarquardt.cc.o.d"
+  "CMakeFiles/gosslib.dir/LineSource.cc.o"
+  "CMakeFiles/gosslib.dir/LineSource.cc.o.d"
+  "CMakeFiles/gosslib.dir/MachDep.cc.o"
+  "CMakeFiles/gosslib.dir/MachDep.cc.o.d"
+  "CMakeFiles/gosslib.dir/MultithreadedBatchTask.cc.o"
+  "CMakeFiles/gosslib.dir/MultithreadedBatchTask.cc.o.d"
+  "CMakeFiles/gosslib.dir/ParallelDecompressor.cc.o"
+  "CMakeFiles/gosslib.dir/ParallelDecompressor.cc.o.d"
+  "CMakeFiles/gosslib.dir/PerfReport.cc.o"
+  "CMakeFiles/gosslib.dir/PerfReport.cc.o.d"
+  "CMakeFiles/gosslib.dir/Phylogeny.cc.o"
+  "CMakeFiles/gosslib.dir/Phylogeny.cc.o.d"
+  "CMakeFiles/gosslib.dir/PhysicalFileFactory.cc.o"
+  "CMakeFiles/gosslib.dir/PhysicalFileFactory.cc.o.d"
+  "CMakeFiles/gosslib.dir/Profile.cc.o"
+  "CMakeFiles/gosslib.dir/Profile.cc.o.d"
+  "CMakeFiles/gosslib.dir/RRRArray.cc.o"
+  "CMakeFiles/gosslib.dir/RRRArray.cc.o.d"
+  "CMakeFiles/gosslib.dir/ResidentFileFactory.cc.o"
+  "CMakeFiles/gosslib.dir/ResidentFileFactory.cc.o.d"
+  "CMakeFiles/gosslib.dir/ScaffoldGraph.cc.o"
+  "CMakeFiles/gosslib.dir/ScaffoldGraph.cc.o.d"
+  "CMakeFiles/gosslib.dir/SmallBaseVector.cc.o"
+  "CMakeFiles/gosslib.dir/SmallBaseVector.cc.o.d"
+  "CMakeFiles/gosslib.dir/SparseArray.cc.o"
+  "CMakeFiles/gosslib.dir/SparseArray.cc.o.d"
+  "CMakeFiles/gosslib.dir/StringFileFactory.cc.o"
+  "CMakeFiles/gosslib.dir/StringFileFactory.cc.o.d"
+  "CMakeFiles/gosslib.dir/SuperGraph.cc.o"
+  "CMakeFiles/gosslib.dir/SuperGraph.cc.o.d"
+  "CMakeFiles/gosslib.dir/TourBus.cc.o"
+  "CMakeFiles/gosslib.dir/TourBus.cc.o.d"
+  "CMakeFiles/gosslib.dir/Utils.cc.o"
+  "CMakeFiles/gosslib.dir/Utils.cc.o.d"
+  "CMakeFiles/gosslib.dir/VariableByteArray.cc.o"
+  "CMakeFiles/gosslib.dir/VariableByteArray.cc.o.d"
+  "CMakeFiles/gosslib.dir/VariableWidthBitArray.cc.o"
+  "CMakeFiles/gosslib.dir/VariableWidthBitArray.cc.o.d"
+  "CMakeFiles/gosslib.dir/WordyBitVector.cc.o"
+  "CMakeFiles/gosslib.dir/WordyBitVector.cc.o.d"
+  "libgosslib.a"
+  "libgosslib.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gosslib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
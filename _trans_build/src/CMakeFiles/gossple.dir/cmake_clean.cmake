@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gossple.dir/gossple.cc.o"
+  "CMakeFiles/gossple.dir/gossple.cc.o.d"
+  "gossple"
+  "gossple.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gossple.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
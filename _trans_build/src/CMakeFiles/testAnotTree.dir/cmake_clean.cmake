@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testAnotTree.dir/testAnnotTree.cc.o"
+  "CMakeFiles/testAnotTree.dir/testAnnotTree.cc.o.d"
+  "testAnotTree"
+  "testAnotTree.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testAnotTree.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
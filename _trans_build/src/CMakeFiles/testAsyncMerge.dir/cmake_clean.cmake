@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testAsyncMerge.dir/testAsyncMerge.cc.o"
+  "CMakeFiles/testAsyncMerge.dir/testAsyncMerge.cc.o.d"
+  "testAsyncMerge"
+  "testAsyncMerge.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testAsyncMerge.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
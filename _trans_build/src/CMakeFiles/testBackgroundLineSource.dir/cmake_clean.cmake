@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testBackgroundLineSource.dir/testBackgroundLineSource.cc.o"
+  "CMakeFiles/testBackgroundLineSource.dir/testBackgroundLineSource.cc.o.d"
+  "testBackgroundLineSource"
+  "testBackgroundLineSource.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testBackgroundLineSource.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
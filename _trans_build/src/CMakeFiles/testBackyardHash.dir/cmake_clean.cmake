@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testBackyardHash.dir/testBackyardHash.cc.o"
+  "CMakeFiles/testBackyardHash.dir/testBackyardHash.cc.o.d"
+  "testBackyardHash"
+  "testBackyardHash.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testBackyardHash.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testBigInteger.dir/testBigInteger.cc.o"
+  "CMakeFiles/testBigInteger.dir/testBigInteger.cc.o.d"
+  "testBigInteger"
+  "testBigInteger.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testBigInteger.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
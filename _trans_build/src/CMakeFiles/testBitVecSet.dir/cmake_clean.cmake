@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testBitVecSet.dir/testBitVecSet.cc.o"
+  "CMakeFiles/testBitVecSet.dir/testBitVecSet.cc.o.d"
+  "testBitVecSet"
+  "testBitVecSet.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testBitVecSet.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testBlendedSort.dir/testBlendedSort.cc.o"
+  "CMakeFiles/testBlendedSort.dir/testBlendedSort.cc.o.d"
+  "testBlendedSort"
+  "testBlendedSort.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testBlendedSort.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
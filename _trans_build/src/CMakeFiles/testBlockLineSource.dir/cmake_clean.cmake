@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testBlockLineSource.dir/testBlockLineSource.cc.o"
+  "CMakeFiles/testBlockLineSource.dir/testBlockLineSource.cc.o.d"
+  "testBlockLineSource"
+  "testBlockLineSource.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testBlockLineSource.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
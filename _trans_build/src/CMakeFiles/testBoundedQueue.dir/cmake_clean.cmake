@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testBoundedQueue.dir/testBoundedQueue.cc.o"
+  "CMakeFiles/testBoundedQueue.dir/testBoundedQueue.cc.o.d"
+  "testBoundedQueue"
+  "testBoundedQueue.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testBoundedQueue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
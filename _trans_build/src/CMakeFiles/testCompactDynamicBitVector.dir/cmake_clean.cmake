@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testCompactDynamicBitVector.dir/testCompactDynamicBitVector.cc.o"
+  "CMakeFiles/testCompactDynamicBitVector.dir/testCompactDynamicBitVector.cc.o.d"
+  "testCompactDynamicBitVector"
+  "testCompactDynamicBitVector.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testCompactDynamicBitVector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testDenseArray.dir/testDenseArray.cc.o"
+  "CMakeFiles/testDenseArray.dir/testDenseArray.cc.o.d"
+  "testDenseArray"
+  "testDenseArray.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testDenseArray.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testEdgeAndCount.dir/testEdgeAndCount.cc.o"
+  "CMakeFiles/testEdgeAndCount.dir/testEdgeAndCount.cc.o.d"
+  "testEdgeAndCount"
+  "testEdgeAndCount.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testEdgeAndCount.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
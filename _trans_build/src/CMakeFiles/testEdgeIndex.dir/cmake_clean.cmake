@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testEdgeIndex.dir/testEdgeIndex.cc.o"
+  "CMakeFiles/testEdgeIndex.dir/testEdgeIndex.cc.o.d"
+  "testEdgeIndex"
+  "testEdgeIndex.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testEdgeIndex.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
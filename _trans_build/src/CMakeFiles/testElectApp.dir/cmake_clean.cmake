@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testElectApp.dir/testElectApp.cc.o"
+  "CMakeFiles/testElectApp.dir/testElectApp.cc.o.d"
+  "testElectApp"
+  "testElectApp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testElectApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
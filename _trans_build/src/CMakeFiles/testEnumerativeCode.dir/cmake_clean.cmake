@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testEnumerativeCode.dir/testEnumerativeCode.cc.o"
+  "CMakeFiles/testEnumerativeCode.dir/testEnumerativeCode.cc.o.d"
+  "testEnumerativeCode"
+  "testEnumerativeCode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testEnumerativeCode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
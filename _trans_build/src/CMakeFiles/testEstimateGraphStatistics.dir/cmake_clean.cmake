@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testEstimateGraphStatistics.dir/testEstimateGraphStatistics.cc.o"
+  "CMakeFiles/testEstimateGraphStatistics.dir/testEstimateGraphStatistics.cc.o.d"
+  "testEstimateGraphStatistics"
+  "testEstimateGraphStatistics.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testEstimateGraphStatistics.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
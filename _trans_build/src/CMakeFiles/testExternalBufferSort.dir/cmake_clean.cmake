@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testExternalBufferSort.dir/testExternalBufferSort.cc.o"
+  "CMakeFiles/testExternalBufferSort.dir/testExternalBufferSort.cc.o.d"
+  "testExternalBufferSort"
+  "testExternalBufferSort.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testExternalBufferSort.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testExternalMergeSort.dir/testExternalMergeSort.cc.o"
+  "CMakeFiles/testExternalMergeSort.dir/testExternalMergeSort.cc.o.d"
+  "testExternalMergeSort"
+  "testExternalMergeSort.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testExternalMergeSort.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testExternalVarPushSorter.dir/testExternalVarPushSorter.cc.o"
+  "CMakeFiles/testExternalVarPushSorter.dir/testExternalVarPushSorter.cc.o.d"
+  "testExternalVarPushSorter"
+  "testExternalVarPushSorter.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testExternalVarPushSorter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testFastqParser.dir/testFastqParser.cc.o"
+  "CMakeFiles/testFastqParser.dir/testFastqParser.cc.o.d"
+  "testFastqParser"
+  "testFastqParser.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testFastqParser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
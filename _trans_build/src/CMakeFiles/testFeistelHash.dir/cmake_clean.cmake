@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testFeistelHash.dir/testFeistelHash.cc.o"
+  "CMakeFiles/testFeistelHash.dir/testFeistelHash.cc.o.d"
+  "testFeistelHash"
+  "testFeistelHash.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testFeistelHash.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
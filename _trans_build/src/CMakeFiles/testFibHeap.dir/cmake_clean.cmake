@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testFibHeap.dir/testFibHeap.cc.o"
+  "CMakeFiles/testFibHeap.dir/testFibHeap.cc.o.d"
+  "testFibHeap"
+  "testFibHeap.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testFibHeap.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testFixedWidthBitArray.dir/testFixedWidthBitArray.cc.o"
+  "CMakeFiles/testFixedWidthBitArray.dir/testFixedWidthBitArray.cc.o.d"
+  "testFixedWidthBitArray"
+  "testFixedWidthBitArray.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testFixedWidthBitArray.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
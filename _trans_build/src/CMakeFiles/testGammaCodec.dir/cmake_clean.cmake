@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testGammaCodec.dir/testGammaCodec.cc.o"
+  "CMakeFiles/testGammaCodec.dir/testGammaCodec.cc.o.d"
+  "testGammaCodec"
+  "testGammaCodec.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testGammaCodec.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testGossCmdBuildGraph.dir/testGossCmdBuildGraph.cc.o"
+  "CMakeFiles/testGossCmdBuildGraph.dir/testGossCmdBuildGraph.cc.o.d"
+  "testGossCmdBuildGraph"
+  "testGossCmdBuildGraph.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testGossCmdBuildGraph.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testGossCmdPrintContigs.dir/testGossCmdPrintContigs.cc.o"
+  "CMakeFiles/testGossCmdPrintContigs.dir/testGossCmdPrintContigs.cc.o.d"
+  "testGossCmdPrintContigs"
+  "testGossCmdPrintContigs.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testGossCmdPrintContigs.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testGossCmdPruneTips.dir/testGossCmdPruneTips.cc.o"
+  "CMakeFiles/testGossCmdPruneTips.dir/testGossCmdPruneTips.cc.o.d"
+  "testGossCmdPruneTips"
+  "testGossCmdPruneTips.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testGossCmdPruneTips.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
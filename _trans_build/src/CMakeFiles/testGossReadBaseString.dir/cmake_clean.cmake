@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testGossReadBaseString.dir/testGossReadBaseString.cc.o"
+  "CMakeFiles/testGossReadBaseString.dir/testGossReadBaseString.cc.o.d"
+  "testGossReadBaseString"
+  "testGossReadBaseString.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testGossReadBaseString.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testGossReadDispatcher.dir/testGossReadDispatcher.cc.o"
+  "CMakeFiles/testGossReadDispatcher.dir/testGossReadDispatcher.cc.o.d"
+  "testGossReadDispatcher"
+  "testGossReadDispatcher.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testGossReadDispatcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testGossReadSequenceBases.dir/testGossReadSequenceBases.cc.o"
+  "CMakeFiles/testGossReadSequenceBases.dir/testGossReadSequenceBases.cc.o.d"
+  "testGossReadSequenceBases"
+  "testGossReadSequenceBases.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testGossReadSequenceBases.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
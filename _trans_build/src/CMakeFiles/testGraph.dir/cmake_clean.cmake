@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testGraph.dir/testGraph.cc.o"
+  "CMakeFiles/testGraph.dir/testGraph.cc.o.d"
+  "testGraph"
+  "testGraph.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testGraph.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
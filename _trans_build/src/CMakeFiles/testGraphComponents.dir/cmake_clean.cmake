@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testGraphComponents.dir/testGraphComponents.cc.o"
+  "CMakeFiles/testGraphComponents.dir/testGraphComponents.cc.o.d"
+  "testGraphComponents"
+  "testGraphComponents.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testGraphComponents.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testJobManager.dir/testJobManager.cc.o"
+  "CMakeFiles/testJobManager.dir/testJobManager.cc.o.d"
+  "testJobManager"
+  "testJobManager.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testJobManager.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
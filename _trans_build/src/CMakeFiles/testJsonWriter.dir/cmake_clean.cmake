@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testJsonWriter.dir/testJsonWriter.cc.o"
+  "CMakeFiles/testJsonWriter.dir/testJsonWriter.cc.o.d"
+  "testJsonWriter"
+  "testJsonWriter.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testJsonWriter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testKmerAligner.dir/testKmerAligner.cc.o"
+  "CMakeFiles/testKmerAligner.dir/testKmerAligner.cc.o.d"
+  "testKmerAligner"
+  "testKmerAligner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testKmerAligner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
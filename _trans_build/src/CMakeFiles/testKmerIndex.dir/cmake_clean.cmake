@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testKmerIndex.dir/testKmerIndex.cc.o"
+  "CMakeFiles/testKmerIndex.dir/testKmerIndex.cc.o.d"
+  "testKmerIndex"
+  "testKmerIndex.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testKmerIndex.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testKmerKernels.dir/testKmerKernels.cc.o"
+  "CMakeFiles/testKmerKernels.dir/testKmerKernels.cc.o.d"
+  "testKmerKernels"
+  "testKmerKernels.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testKmerKernels.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
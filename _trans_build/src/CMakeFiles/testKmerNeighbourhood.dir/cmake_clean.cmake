@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testKmerNeighbourhood.dir/testKmerNeighbourhood.cc.o"
+  "CMakeFiles/testKmerNeighbourhood.dir/testKmerNeighbourhood.cc.o.d"
+  "testKmerNeighbourhood"
+  "testKmerNeighbourhood.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testKmerNeighbourhood.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
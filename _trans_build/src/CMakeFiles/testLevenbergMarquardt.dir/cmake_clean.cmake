@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testLevenbergMarquardt.dir/testLevenbergMarquardt.cc.o"
+  "CMakeFiles/testLevenbergMarquardt.dir/testLevenbergMarquardt.cc.o.d"
+  "testLevenbergMarquardt"
+  "testLevenbergMarquardt.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testLevenbergMarquardt.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testLineParser.dir/testLineParser.cc.o"
+  "CMakeFiles/testLineParser.dir/testLineParser.cc.o.d"
+  "testLineParser"
+  "testLineParser.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testLineParser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
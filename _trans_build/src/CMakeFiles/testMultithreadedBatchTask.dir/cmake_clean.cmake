@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testMultithreadedBatchTask.dir/testMultithreadedBatchTask.cc.o"
+  "CMakeFiles/testMultithreadedBatchTask.dir/testMultithreadedBatchTask.cc.o.d"
+  "testMultithreadedBatchTask"
+  "testMultithreadedBatchTask.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testMultithreadedBatchTask.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
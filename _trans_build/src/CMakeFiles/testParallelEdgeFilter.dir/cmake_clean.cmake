@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testParallelEdgeFilter.dir/testParallelEdgeFilter.cc.o"
+  "CMakeFiles/testParallelEdgeFilter.dir/testParallelEdgeFilter.cc.o.d"
+  "testParallelEdgeFilter"
+  "testParallelEdgeFilter.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testParallelEdgeFilter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
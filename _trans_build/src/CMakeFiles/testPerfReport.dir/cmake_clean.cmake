@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testPerfReport.dir/testPerfReport.cc.o"
+  "CMakeFiles/testPerfReport.dir/testPerfReport.cc.o.d"
+  "testPerfReport"
+  "testPerfReport.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testPerfReport.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testPhysicalFileFactory.dir/testPhysicalFileFactory.cc.o"
+  "CMakeFiles/testPhysicalFileFactory.dir/testPhysicalFileFactory.cc.o.d"
+  "testPhysicalFileFactory"
+  "testPhysicalFileFactory.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testPhysicalFileFactory.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
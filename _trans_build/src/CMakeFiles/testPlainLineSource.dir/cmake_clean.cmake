@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testPlainLineSource.dir/testPlainLineSource.cc.o"
+  "CMakeFiles/testPlainLineSource.dir/testPlainLineSource.cc.o.d"
+  "testPlainLineSource"
+  "testPlainLineSource.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testPlainLineSource.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
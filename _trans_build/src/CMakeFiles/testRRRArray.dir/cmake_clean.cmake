@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testRRRArray.dir/testRRRArray.cc.o"
+  "CMakeFiles/testRRRArray.dir/testRRRArray.cc.o.d"
+  "testRRRArray"
+  "testRRRArray.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testRRRArray.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testReorderBuffer.dir/testReorderBuffer.cc.o"
+  "CMakeFiles/testReorderBuffer.dir/testReorderBuffer.cc.o.d"
+  "testReorderBuffer"
+  "testReorderBuffer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testReorderBuffer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testResidentFileFactory.dir/testResidentFileFactory.cc.o"
+  "CMakeFiles/testResidentFileFactory.dir/testResidentFileFactory.cc.o.d"
+  "testResidentFileFactory"
+  "testResidentFileFactory.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testResidentFileFactory.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
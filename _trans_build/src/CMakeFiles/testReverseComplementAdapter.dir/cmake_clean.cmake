@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testReverseComplementAdapter.dir/testReverseComplementAdapter.cc.o"
+  "CMakeFiles/testReverseComplementAdapter.dir/testReverseComplementAdapter.cc.o.d"
+  "testReverseComplementAdapter"
+  "testReverseComplementAdapter.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testReverseComplementAdapter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
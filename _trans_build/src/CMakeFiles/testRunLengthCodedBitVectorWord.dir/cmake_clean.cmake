@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testRunLengthCodedBitVectorWord.dir/testRunLengthCodedBitVectorWord.cc.o"
+  "CMakeFiles/testRunLengthCodedBitVectorWord.dir/testRunLengthCodedBitVectorWord.cc.o.d"
+  "testRunLengthCodedBitVectorWord"
+  "testRunLengthCodedBitVectorWord.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testRunLengthCodedBitVectorWord.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
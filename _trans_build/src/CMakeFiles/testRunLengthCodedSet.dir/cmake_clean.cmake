@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testRunLengthCodedSet.dir/testRunLengthCodedSet.cc.o"
+  "CMakeFiles/testRunLengthCodedSet.dir/testRunLengthCodedSet.cc.o.d"
+  "testRunLengthCodedSet"
+  "testRunLengthCodedSet.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testRunLengthCodedSet.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSimpleHashMap.dir/testSimpleHashMap.cc.o"
+  "CMakeFiles/testSimpleHashMap.dir/testSimpleHashMap.cc.o.d"
+  "testSimpleHashMap"
+  "testSimpleHashMap.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSimpleHashMap.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
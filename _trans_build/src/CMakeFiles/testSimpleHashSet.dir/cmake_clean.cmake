@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSimpleHashSet.dir/testSimpleHashSet.cc.o"
+  "CMakeFiles/testSimpleHashSet.dir/testSimpleHashSet.cc.o.d"
+  "testSimpleHashSet"
+  "testSimpleHashSet.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSimpleHashSet.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSimpleRangeSet.dir/testSimpleRangeSet.cc.o"
+  "CMakeFiles/testSimpleRangeSet.dir/testSimpleRangeSet.cc.o.d"
+  "testSimpleRangeSet"
+  "testSimpleRangeSet.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSimpleRangeSet.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSmallBaseVector.dir/testSmallBaseVector.cc.o"
+  "CMakeFiles/testSmallBaseVector.dir/testSmallBaseVector.cc.o.d"
+  "testSmallBaseVector"
+  "testSmallBaseVector.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSmallBaseVector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
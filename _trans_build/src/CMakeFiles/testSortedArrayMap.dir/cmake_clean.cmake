@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSortedArrayMap.dir/testSortedArrayMap.cc.o"
+  "CMakeFiles/testSortedArrayMap.dir/testSortedArrayMap.cc.o.d"
+  "testSortedArrayMap"
+  "testSortedArrayMap.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSortedArrayMap.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
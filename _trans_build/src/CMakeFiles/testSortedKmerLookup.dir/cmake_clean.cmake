@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSortedKmerLookup.dir/testSortedKmerLookup.cc.o"
+  "CMakeFiles/testSortedKmerLookup.dir/testSortedKmerLookup.cc.o.d"
+  "testSortedKmerLookup"
+  "testSortedKmerLookup.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSortedKmerLookup.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSparseArray.dir/testSparseArray.cc.o"
+  "CMakeFiles/testSparseArray.dir/testSparseArray.cc.o.d"
+  "testSparseArray"
+  "testSparseArray.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSparseArray.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSparseArrayView.dir/testSparseArrayView.cc.o"
+  "CMakeFiles/testSparseArrayView.dir/testSparseArrayView.cc.o.d"
+  "testSparseArrayView"
+  "testSparseArrayView.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSparseArrayView.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
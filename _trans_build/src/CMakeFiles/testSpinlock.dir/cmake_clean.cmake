@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSpinlock.dir/testSpinlock.cc.o"
+  "CMakeFiles/testSpinlock.dir/testSpinlock.cc.o.d"
+  "testSpinlock"
+  "testSpinlock.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSpinlock.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
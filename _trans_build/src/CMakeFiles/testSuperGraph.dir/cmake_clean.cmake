@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testSuperGraph.dir/testSuperGraph.cc.o"
+  "CMakeFiles/testSuperGraph.dir/testSuperGraph.cc.o.d"
+  "testSuperGraph"
+  "testSuperGraph.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testSuperGraph.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
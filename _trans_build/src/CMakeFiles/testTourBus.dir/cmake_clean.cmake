@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testTourBus.dir/testTourBus.cc.o"
+  "CMakeFiles/testTourBus.dir/testTourBus.cc.o.d"
+  "testTourBus"
+  "testTourBus.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testTourBus.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testTransCmdAssemble.dir/testTransCmdAssemble.cc.o"
+  "CMakeFiles/testTransCmdAssemble.dir/testTransCmdAssemble.cc.o.d"
+  "testTransCmdAssemble"
+  "testTransCmdAssemble.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testTransCmdAssemble.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
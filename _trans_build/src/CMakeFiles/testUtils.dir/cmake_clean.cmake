@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testUtils.dir/testUtils.cc.o"
+  "CMakeFiles/testUtils.dir/testUtils.cc.o.d"
+  "testUtils"
+  "testUtils.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testUtils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testVByteCodec.dir/testVByteCodec.cc.o"
+  "CMakeFiles/testVByteCodec.dir/testVByteCodec.cc.o.d"
+  "testVByteCodec"
+  "testVByteCodec.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testVByteCodec.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testVariableByteArray.dir/testVariableByteArray.cc.o"
+  "CMakeFiles/testVariableByteArray.dir/testVariableByteArray.cc.o.d"
+  "testVariableByteArray"
+  "testVariableByteArray.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testVariableByteArray.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
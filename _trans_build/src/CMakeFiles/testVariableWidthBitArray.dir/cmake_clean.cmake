@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testVariableWidthBitArray.dir/testVariableWidthBitArray.cc.o"
+  "CMakeFiles/testVariableWidthBitArray.dir/testVariableWidthBitArray.cc.o.d"
+  "testVariableWidthBitArray"
+  "testVariableWidthBitArray.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testVariableWidthBitArray.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testWordyBitVector.dir/testWordyBitVector.cc.o"
+  "CMakeFiles/testWordyBitVector.dir/testWordyBitVector.cc.o.d"
+  "testWordyBitVector"
+  "testWordyBitVector.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testWordyBitVector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/translucent.dir/translucent.cc.o"
+  "CMakeFiles/translucent.dir/translucent.cc.o.d"
+  "translucent"
+  "translucent.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/translucent.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,32 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/GossCmdBuildGraph.cc" "src/CMakeFiles/translucentapp.dir/GossCmdBuildGraph.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/GossCmdBuildGraph.cc.o.d"
+  "/root/repo/src/GossCmdHelp.cc" "src/CMakeFiles/translucentapp.dir/GossCmdHelp.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/GossCmdHelp.cc.o.d"
+  "/root/repo/src/GossCmdLintGraph.cc" "src/CMakeFiles/translucentapp.dir/GossCmdLintGraph.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/GossCmdLintGraph.cc.o.d"
+  "/root/repo/src/GossCmdPopBubbles.cc" "src/CMakeFiles/translucentapp.dir/GossCmdPopBubbles.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/GossCmdPopBubbles.cc.o.d"
+  "/root/repo/src/GossCmdPruneTips.cc" "src/CMakeFiles/translucentapp.dir/GossCmdPruneTips.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/GossCmdPruneTips.cc.o.d"
+  "/root/repo/src/GossCmdReg.cc" "src/CMakeFiles/translucentapp.dir/GossCmdReg.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/GossCmdReg.cc.o.d"
+  "/root/repo/src/GossCmdTrimGraph.cc" "src/CMakeFiles/translucentapp.dir/GossCmdTrimGraph.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/GossCmdTrimGraph.cc.o.d"
+  "/root/repo/src/GossOption.cc" "src/CMakeFiles/translucentapp.dir/GossOption.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/GossOption.cc.o.d"
+  "/root/repo/src/ResolveTranscripts.cc" "src/CMakeFiles/translucentapp.dir/ResolveTranscripts.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/ResolveTranscripts.cc.o.d"
+  "/root/repo/src/TransCmdAssemble.cc" "src/CMakeFiles/translucentapp.dir/TransCmdAssemble.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/TransCmdAssemble.cc.o.d"
+  "/root/repo/src/TransCmdMergeGraphWithReference.cc" "src/CMakeFiles/translucentapp.dir/TransCmdMergeGraphWithReference.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/TransCmdMergeGraphWithReference.cc.o.d"
+  "/root/repo/src/TransCmdTrimRelative.cc" "src/CMakeFiles/translucentapp.dir/TransCmdTrimRelative.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/TransCmdTrimRelative.cc.o.d"
+  "/root/repo/src/TranslucentApp.cc" "src/CMakeFiles/translucentapp.dir/TranslucentApp.cc.o" "gcc" "src/CMakeFiles/translucentapp.dir/TranslucentApp.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_trans_build/src/CMakeFiles/gosslib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,35 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/translucentapp.dir/GossCmdBuildGraph.cc.o"
+  "CMakeFiles/translucentapp.dir/GossCmdBuildGraph.cc.o.d"
+  "CMakeFiles/translucentapp.dir/GossCmdHelp.cc.o"
+  "CMakeFiles/translucentapp.dir/GossCmdHelp.cc.o.d"
+  "CMakeFiles/translucentapp.dir/GossCmdLintGraph.cc.o"
+  "CMakeFiles/translucentapp.dir/GossCmdLintGraph.cc.o.d"
+  "CMakeFiles/translucentapp.dir/GossCmdPopBubbles.cc.o"
+  "CMakeFiles/translucentapp.dir/GossCmdPopBubbles.cc.o.d"
+  "CMakeFiles/translucentapp.dir/GossCmdPruneTips.cc.o"
+  "CMakeFiles/translucentapp.dir/GossCmdPruneTips.cc.o.d"
+  "CMakeFiles/translucentapp.dir/GossCmdReg.cc.o"
+  "CMakeFiles/translucentapp.dir/GossCmdReg.cc.o.d"
+  "CMakeFiles/translucentapp.dir/GossCmdTrimGraph.cc.o"
+  "CMakeFiles/translucentapp.dir/GossCmdTrimGraph.cc.o.d"
+  "CMakeFiles/translucentapp.dir/GossOption.cc.o"
+  "CMakeFiles/translucentapp.dir/GossOption.cc.o.d"
+  "CMakeFiles/translucentapp.dir/ResolveTranscripts.cc.o"
+  "CMakeFiles/translucentapp.dir/ResolveTranscripts.cc.o.d"
+  "CMakeFiles/translucentapp.dir/TransCmdAssemble.cc.o"
+  "CMakeFiles/translucentapp.dir/TransCmdAssemble.cc.o.d"
+  "CMakeFiles/translucentapp.dir/TransCmdMergeGraphWithReference.cc.o"
+  "CMakeFiles/translucentapp.dir/TransCmdMergeGraphWithReference.cc.o.d"
+  "CMakeFiles/translucentapp.dir/TransCmdTrimRelative.cc.o"
+  "CMakeFiles/translucentapp.dir/TransCmdTrimRelative.cc.o.d"
+  "CMakeFiles/translucentapp.dir/TranslucentApp.cc.o"
+  "CMakeFiles/translucentapp.dir/TranslucentApp.cc.o.d"
+  "libtranslucentapp.a"
+  "libtranslucentapp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/translucentapp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
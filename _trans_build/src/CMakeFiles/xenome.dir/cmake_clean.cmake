@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/xenome.dir/xenome.cc.o"
+  "CMakeFiles/xenome.dir/xenome.cc.o.d"
+  "xenome"
+  "xenome.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/xenome.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/GossCmdBuildKmerSet.cc" "src/CMakeFiles/xenomeapp.dir/GossCmdBuildKmerSet.cc.o" "gcc" "src/CMakeFiles/xenomeapp.dir/GossCmdBuildKmerSet.cc.o.d"
+  "/root/repo/src/GossCmdComputeNearKmers.cc" "src/CMakeFiles/xenomeapp.dir/GossCmdComputeNearKmers.cc.o" "gcc" "src/CMakeFiles/xenomeapp.dir/GossCmdComputeNearKmers.cc.o.d"
+  "/root/repo/src/GossCmdGroupReads.cc" "src/CMakeFiles/xenomeapp.dir/GossCmdGroupReads.cc.o" "gcc" "src/CMakeFiles/xenomeapp.dir/GossCmdGroupReads.cc.o.d"
+  "/root/repo/src/GossCmdHelp.cc" "src/CMakeFiles/xenomeapp.dir/GossCmdHelp.cc.o" "gcc" "src/CMakeFiles/xenomeapp.dir/GossCmdHelp.cc.o.d"
+  "/root/repo/src/GossCmdMergeAndAnnotateKmerSets.cc" "src/CMakeFiles/xenomeapp.dir/GossCmdMergeAndAnnotateKmerSets.cc.o" "gcc" "src/CMakeFiles/xenomeapp.dir/GossCmdMergeAndAnnotateKmerSets.cc.o.d"
+  "/root/repo/src/GossCmdReg.cc" "src/CMakeFiles/xenomeapp.dir/GossCmdReg.cc.o" "gcc" "src/CMakeFiles/xenomeapp.dir/GossCmdReg.cc.o.d"
+  "/root/repo/src/GossOption.cc" "src/CMakeFiles/xenomeapp.dir/GossOption.cc.o" "gcc" "src/CMakeFiles/xenomeapp.dir/GossOption.cc.o.d"
+  "/root/repo/src/XenoApp.cc" "src/CMakeFiles/xenomeapp.dir/XenoApp.cc.o" "gcc" "src/CMakeFiles/xenomeapp.dir/XenoApp.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_trans_build/src/CMakeFiles/gosslib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
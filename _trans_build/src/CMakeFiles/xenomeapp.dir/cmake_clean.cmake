@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/xenomeapp.dir/GossCmdBuildKmerSet.cc.o"
+  "CMakeFiles/xenomeapp.dir/GossCmdBuildKmerSet.cc.o.d"
+  "CMakeFiles/xenomeapp.dir/GossCmdComputeNearKmers.cc.o"
+  "CMakeFiles/xenomeapp.dir/GossCmdComputeNearKmers.cc.o.d"
+  "CMakeFiles/xenomeapp.dir/GossCmdGroupReads.cc.o"
+  "CMakeFiles/xenomeapp.dir/GossCmdGroupReads.cc.o.d"
+  "CMakeFiles/xenomeapp.dir/GossCmdHelp.cc.o"
+  "CMakeFiles/xenomeapp.dir/GossCmdHelp.cc.o.d"
+  "CMakeFiles/xenomeapp.dir/GossCmdMergeAndAnnotateKmerSets.cc.o"
+  "CMakeFiles/xenomeapp.dir/GossCmdMergeAndAnnotateKmerSets.cc.o.d"
+  "CMakeFiles/xenomeapp.dir/GossCmdReg.cc.o"
+  "CMakeFiles/xenomeapp.dir/GossCmdReg.cc.o.d"
+  "CMakeFiles/xenomeapp.dir/GossOption.cc.o"
+  "CMakeFiles/xenomeapp.dir/GossOption.cc.o.d"
+  "CMakeFiles/xenomeapp.dir/XenoApp.cc.o"
+  "CMakeFiles/xenomeapp.dir/XenoApp.cc.o.d"
+  "libxenomeapp.a"
+  "libxenomeapp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/xenomeapp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,142 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src
+# Build directory: /root/repo/_trans_build/src
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(testAnotTree "/root/repo/_trans_build/src/testAnotTree")
+set_tests_properties(testAnotTree PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;261;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testAsyncMerge "/root/repo/_trans_build/src/testAsyncMerge")
+set_tests_properties(testAsyncMerge PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;262;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testBackgroundLineSource "/root/repo/_trans_build/src/testBackgroundLineSource")
+set_tests_properties(testBackgroundLineSource PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;263;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testBackyardHash "/root/repo/_trans_build/src/testBackyardHash")
+set_tests_properties(testBackyardHash PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;264;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testBigInteger "/root/repo/_trans_build/src/testBigInteger")
+set_tests_properties(testBigInteger PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;265;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testBitVecSet "/root/repo/_trans_build/src/testBitVecSet")
+set_tests_properties(testBitVecSet PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;266;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testBlendedSort "/root/repo/_trans_build/src/testBlendedSort")
+set_tests_properties(testBlendedSort PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;267;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testBlockLineSource "/root/repo/_trans_build/src/testBlockLineSource")
+set_tests_properties(testBlockLineSource PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;268;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testBoundedQueue "/root/repo/_trans_build/src/testBoundedQueue")
+set_tests_properties(testBoundedQueue PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;269;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testCompactDynamicBitVector "/root/repo/_trans_build/src/testCompactDynamicBitVector")
+set_tests_properties(testCompactDynamicBitVector PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;270;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testDenseArray "/root/repo/_trans_build/src/testDenseArray")
+set_tests_properties(testDenseArray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;271;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testEdgeAndCount "/root/repo/_trans_build/src/testEdgeAndCount")
+set_tests_properties(testEdgeAndCount PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;272;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testEdgeIndex "/root/repo/_trans_build/src/testEdgeIndex")
+set_tests_properties(testEdgeIndex PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;273;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testElectApp "/root/repo/_trans_build/src/testElectApp")
+set_tests_properties(testElectApp PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;274;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testEnumerativeCode "/root/repo/_trans_build/src/testEnumerativeCode")
+set_tests_properties(testEnumerativeCode PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;275;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testEstimateGraphStatistics "/root/repo/_trans_build/src/testEstimateGraphStatistics")
+set_tests_properties(testEstimateGraphStatistics PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;276;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testExternalVarPushSorter "/root/repo/_trans_build/src/testExternalVarPushSorter")
+set_tests_properties(testExternalVarPushSorter PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;277;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testExternalBufferSort "/root/repo/_trans_build/src/testExternalBufferSort")
+set_tests_properties(testExternalBufferSort PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;278;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testExternalMergeSort "/root/repo/_trans_build/src/testExternalMergeSort")
+set_tests_properties(testExternalMergeSort PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;279;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testFastqParser "/root/repo/_trans_build/src/testFastqParser")
+set_tests_properties(testFastqParser PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;280;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testFeistelHash "/root/repo/_trans_build/src/testFeistelHash")
+set_tests_properties(testFeistelHash PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;281;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testFibHeap "/root/repo/_trans_build/src/testFibHeap")
+set_tests_properties(testFibHeap PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;282;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testFixedWidthBitArray "/root/repo/_trans_build/src/testFixedWidthBitArray")
+set_tests_properties(testFixedWidthBitArray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;283;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testGammaCodec "/root/repo/_trans_build/src/testGammaCodec")
+set_tests_properties(testGammaCodec PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;284;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testGossReadBaseString "/root/repo/_trans_build/src/testGossReadBaseString")
+set_tests_properties(testGossReadBaseString PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;285;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testGossReadDispatcher "/root/repo/_trans_build/src/testGossReadDispatcher")
+set_tests_properties(testGossReadDispatcher PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;286;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testGossReadSequenceBases "/root/repo/_trans_build/src/testGossReadSequenceBases")
+set_tests_properties(testGossReadSequenceBases PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;287;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testGraph "/root/repo/_trans_build/src/testGraph")
+set_tests_properties(testGraph PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;288;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testGraphComponents "/root/repo/_trans_build/src/testGraphComponents")
+set_tests_properties(testGraphComponents PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;289;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testJobManager "/root/repo/_trans_build/src/testJobManager")
+set_tests_properties(testJobManager PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;290;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testJsonWriter "/root/repo/_trans_build/src/testJsonWriter")
+set_tests_properties(testJsonWriter PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;291;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testKmerAligner "/root/repo/_trans_build/src/testKmerAligner")
+set_tests_properties(testKmerAligner PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;292;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testKmerIndex "/root/repo/_trans_build/src/testKmerIndex")
+set_tests_properties(testKmerIndex PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;293;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testKmerKernels "/root/repo/_trans_build/src/testKmerKernels")
+set_tests_properties(testKmerKernels PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;294;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testKmerNeighbourhood "/root/repo/_trans_build/src/testKmerNeighbourhood")
+set_tests_properties(testKmerNeighbourhood PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;295;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testLevenbergMarquardt "/root/repo/_trans_build/src/testLevenbergMarquardt")
+set_tests_properties(testLevenbergMarquardt PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;296;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testLineParser "/root/repo/_trans_build/src/testLineParser")
+set_tests_properties(testLineParser PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;297;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testMultithreadedBatchTask "/root/repo/_trans_build/src/testMultithreadedBatchTask")
+set_tests_properties(testMultithreadedBatchTask PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;298;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testParallelEdgeFilter "/root/repo/_trans_build/src/testParallelEdgeFilter")
+set_tests_properties(testParallelEdgeFilter PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;299;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testPerfReport "/root/repo/_trans_build/src/testPerfReport")
+set_tests_properties(testPerfReport PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;300;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testPlainLineSource "/root/repo/_trans_build/src/testPlainLineSource")
+set_tests_properties(testPlainLineSource PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;301;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testPhysicalFileFactory "/root/repo/_trans_build/src/testPhysicalFileFactory")
+set_tests_properties(testPhysicalFileFactory PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;302;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testRRRArray "/root/repo/_trans_build/src/testRRRArray")
+set_tests_properties(testRRRArray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;303;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testReorderBuffer "/root/repo/_trans_build/src/testReorderBuffer")
+set_tests_properties(testReorderBuffer PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;304;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testResidentFileFactory "/root/repo/_trans_build/src/testResidentFileFactory")
+set_tests_properties(testResidentFileFactory PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;305;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testReverseComplementAdapter "/root/repo/_trans_build/src/testReverseComplementAdapter")
+set_tests_properties(testReverseComplementAdapter PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;306;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testRunLengthCodedBitVectorWord "/root/repo/_trans_build/src/testRunLengthCodedBitVectorWord")
+set_tests_properties(testRunLengthCodedBitVectorWord PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;307;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testRunLengthCodedSet "/root/repo/_trans_build/src/testRunLengthCodedSet")
+set_tests_properties(testRunLengthCodedSet PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;308;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSimpleHashMap "/root/repo/_trans_build/src/testSimpleHashMap")
+set_tests_properties(testSimpleHashMap PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;309;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSimpleHashSet "/root/repo/_trans_build/src/testSimpleHashSet")
+set_tests_properties(testSimpleHashSet PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;310;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSimpleRangeSet "/root/repo/_trans_build/src/testSimpleRangeSet")
+set_tests_properties(testSimpleRangeSet PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;311;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSmallBaseVector "/root/repo/_trans_build/src/testSmallBaseVector")
+set_tests_properties(testSmallBaseVector PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;312;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSortedArrayMap "/root/repo/_trans_build/src/testSortedArrayMap")
+set_tests_properties(testSortedArrayMap PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;313;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSortedKmerLookup "/root/repo/_trans_build/src/testSortedKmerLookup")
+set_tests_properties(testSortedKmerLookup PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;314;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSparseArray "/root/repo/_trans_build/src/testSparseArray")
+set_tests_properties(testSparseArray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;315;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSparseArrayView "/root/repo/_trans_build/src/testSparseArrayView")
+set_tests_properties(testSparseArrayView PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;316;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSpinlock "/root/repo/_trans_build/src/testSpinlock")
+set_tests_properties(testSpinlock PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;317;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testSuperGraph "/root/repo/_trans_build/src/testSuperGraph")
+set_tests_properties(testSuperGraph PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;318;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testTourBus "/root/repo/_trans_build/src/testTourBus")
+set_tests_properties(testTourBus PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;319;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testUtils "/root/repo/_trans_build/src/testUtils")
+set_tests_properties(testUtils PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;320;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testVariableByteArray "/root/repo/_trans_build/src/testVariableByteArray")
+set_tests_properties(testVariableByteArray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;321;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testVariableWidthBitArray "/root/repo/_trans_build/src/testVariableWidthBitArray")
+set_tests_properties(testVariableWidthBitArray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;322;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testWordyBitVector "/root/repo/_trans_build/src/testWordyBitVector")
+set_tests_properties(testWordyBitVector PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;323;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testVByteCodec "/root/repo/_trans_build/src/testVByteCodec")
+set_tests_properties(testVByteCodec PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;324;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testGossCmdBuildGraph "/root/repo/_trans_build/src/testGossCmdBuildGraph")
+set_tests_properties(testGossCmdBuildGraph PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;325;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testGossCmdPrintContigs "/root/repo/_trans_build/src/testGossCmdPrintContigs")
+set_tests_properties(testGossCmdPrintContigs PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;326;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testGossCmdPruneTips "/root/repo/_trans_build/src/testGossCmdPruneTips")
+set_tests_properties(testGossCmdPruneTips PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;327;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(testTransCmdAssemble "/root/repo/_trans_build/src/testTransCmdAssemble")
+set_tests_properties(testTransCmdAssemble PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;247;ADD_TEST;/root/repo/src/CMakeLists.txt;330;gossamer_unit_test;/root/repo/src/CMakeLists.txt;0;")
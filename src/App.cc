@@ -14,6 +14,7 @@
 #include "GossCmdReg.hh"
 #include "GossOption.hh"
 #include "Logger.hh"
+#include "PerfReport.hh"
 #include "PhysicalFileFactory.hh"
 
 #include <iostream>
@@ -34,9 +35,9 @@ namespace { // anonymous
     Debug verboseExceptions("verbose-exceptions",
                             "print detailed information about errors");
 
-    options_description opts;
+    std::shared_ptr<options_description> opts(new options_description);
 
-    positional_options_description posOpts;
+    std::shared_ptr<positional_options_description> posOpts(new positional_options_description);
 
     string cmdName;
 
@@ -128,6 +129,24 @@ namespace { // anonymous
         return !bad_opt;
     }
 
+    bool
+    writePerfReport(const string& pFileName, const string& pProgram, const string& pVersion,
+                    int argc, char* argv[], int pStatus)
+    {
+        try
+        {
+            strings args(argv + 1, argv + argc);
+            FileFactory::OutHolderPtr outp(theFileFactory->out(pFileName));
+            PerfReport::write(**outp, pProgram, pVersion, cmdName, args, pStatus);
+            return true;
+        }
+        catch (...)
+        {
+            cerr << "unable to write the performance report to '" << pFileName << "'" << endl;
+            return false;
+        }
+    }
+
 } // namespace anonymous
 
 
@@ -164,7 +183,7 @@ App::help(bool pExit)
     {
         cerr << cmdName << endl;
     }
-    cerr << opts << endl;
+    cerr << *opts << endl;
 
     if (pExit)
     {
@@ -176,6 +195,14 @@ int
 App::main(int argc, char* argv[])
 {
     setupPlatform();
+    return run(argc, argv, FileFactoryPtr());
+}
+
+int
+App::run(int argc, char* argv[], const FileFactoryPtr& pFactory)
+{
+    int status = 0;
+    string perfReport;
     try
     {
         BOOST_ASSERT(GossCmdReg::cmds);
@@ -221,6 +248,9 @@ App::main(int argc, char* argv[])
             bad_cmd = true;
         }
 
+        opts = std::make_shared<options_description>();
+        posOpts = std::make_shared<positional_options_description>();
+
         variables_map optsMap;
         bool bad_opt = false;
         if (!bad_cmd)
@@ -228,7 +258,7 @@ App::main(int argc, char* argv[])
             stringstream bad_opt_msg;
             for (GossOptions::OptsMap::const_iterator j = mGlobalOpts.opts.begin(); j != mGlobalOpts.opts.end(); ++j)
             {
-                j->second->add(opts, posOpts);
+                j->second->add(*opts, *posOpts);
             }
 
             const set<string>& common(i->second->commonOptions());
@@ -241,17 +271,17 @@ App::main(int argc, char* argv[])
                         Gossamer::error()
                             << Gossamer::general_error_info("unrecognised common option " + *j));
                 }
-                k->second->add(opts, posOpts);
+                k->second->add(*opts, *posOpts);
             }
 
             const GossOptions& specific(i->second->specificOptions());
             for (GossOptions::OptsMap::const_iterator j = specific.opts.begin(); j != specific.opts.end(); ++j)
             {
-                j->second->add(opts, posOpts);
+                j->second->add(*opts, *posOpts);
             }
 
             parsed_options parsed_opts = command_line_parser(argc - argsToSkip, argv + argsToSkip).
-                                                            options(opts).allow_unregistered().run();
+                                                            options(*opts).allow_unregistered().run();
             for (vector<basic_option<char> >::const_iterator
                  j  = parsed_opts.options.begin();
                  j != parsed_opts.options.end();
@@ -276,17 +306,29 @@ App::main(int argc, char* argv[])
         }
 
         // set up the file factory
-        strings tmp;
-        if (optsMap.count("tmp-dir") == 0)
+        if (pFactory)
         {
-            //tmp.push_back("/tmp"); //???
-            tmp.push_back( Gossamer::defaultTmpDir() );
+            theFileFactory = pFactory;
         }
         else
         {
-            tmp = optsMap["tmp-dir"].as<strings>();
+            strings tmp;
+            if (optsMap.count("tmp-dir") == 0)
+            {
+                //tmp.push_back("/tmp"); //???
+                tmp.push_back( Gossamer::defaultTmpDir() );
+            }
+            else
+            {
+                tmp = optsMap["tmp-dir"].as<strings>();
+            }
+            std::shared_ptr<PhysicalFileFactory> fac(new PhysicalFileFactory(tmp[0]));
+            if (optsMap.count("num-threads"))
+            {
+                fac->setDecompressionThreads(optsMap["num-threads"].as<uint64_t>());
+            }
+            theFileFactory = fac;
         }
-        theFileFactory = FileFactoryPtr(new PhysicalFileFactory(tmp[0]));
 
         // set up logging
         Severity sev(optsMap.count("verbose") ? info : warning);
@@ -312,11 +354,22 @@ App::main(int argc, char* argv[])
             }
         }
 
+        if (optsMap.count("perf-report"))
+        {
+            perfReport = optsMap["perf-report"].as<string>();
+        }
+        PerfReport::enable(!perfReport.empty());
+        if (PerfReport::enabled())
+        {
+            PerfReport::reset();
+        }
+
         cmd = i->second->create(*this, optsMap);
 
         GossCmdContext cxt(fileFactory(), logger(), cmdName, optsMap);
         try
         {
+            PerfReport::Phase phase(cmdName);
             (*cmd)(cxt);
         }
         catch (Gossamer::error& e)
@@ -403,17 +456,22 @@ App::main(int argc, char* argv[])
             cerr << diagnostic_information(e);
             cerr << "------ end of diagnostic information ------" << endl;
         }
-        return 1;
+        status = 1;
     }
     catch (std::exception& e)
     {
         cerr << "caught unexpected exception: " << e.what() << endl;
-        return 1;
+        status = 1;
     }
     catch (...)
     {
         cerr << "caught unknown exception" << endl;
-        return 1;
+        status = 1;
+    }
+
+    if (!perfReport.empty() && !writePerfReport(perfReport, name(), version(), argc, argv, status))
+    {
+        status = 1;
     }
-    return 0;
+    return status;
 }
@@ -41,6 +41,11 @@ public:
 
     virtual int main(int argc, char* argv[]);
 
+    // Run a single command as main() would, but using pFactory for its
+    // files, if it is given, rather than a factory set up from the
+    // command line. This may be called several times in one process.
+    int run(int argc, char* argv[], const FileFactoryPtr& pFactory);
+
     App(const GossOptions& pGlobalOpts, const GossOptions& pCommonOpts)
         : mGlobalOpts(pGlobalOpts), mCommonOpts(pCommonOpts)
     {
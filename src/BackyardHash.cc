@@ -110,10 +110,50 @@ namespace // anonymous
         std::sort(pPerm.begin(), pPerm.end(), cmp);
     }
 
+    // A SpinlockHolder which can be compiled away when the
+    // hash table is owned by a single thread.
+    template <bool Locked>
+    class OptionalSpinlockHolder
+    {
+    public:
+        OptionalSpinlockHolder(Spinlock& pLock)
+            : mLock(pLock)
+        {
+            if (Locked)
+            {
+                mLock.lock();
+            }
+        }
+
+        ~OptionalSpinlockHolder()
+        {
+            if (Locked)
+            {
+                mLock.unlock();
+            }
+        }
+
+    private:
+        Spinlock& mLock;
+    };
+
 } // namespace anonymous
 
 void
 BackyardHash::insert(const value_type& pItem)
+{
+    doInsert<true>(pItem);
+}
+
+void
+BackyardHash::insertExclusive(const value_type& pItem)
+{
+    doInsert<false>(pItem);
+}
+
+template <bool Locked>
+void
+BackyardHash::doInsert(const value_type& pItem)
 {
     // Figure out if the item is already in the hash table
     // and if so, update the count. Unfortunately, this
@@ -149,7 +189,7 @@ BackyardHash::insert(const value_type& pItem)
         uint64_t s = s0;
         while (s < mItems.size())
         {
-            SpinlockHolder lk(mMutexes[lockNum(s0)]);
+            OptionalSpinlockHolder<Locked> lk(mMutexes[lockNum(s0)]);
             Content x = unpack(mItems[s]);
             if (x.hash() == j && x.count() > 0 && unhash(s0, j, x.value()) == pItem)
             {
@@ -163,7 +203,7 @@ BackyardHash::insert(const value_type& pItem)
                 else
                 {
                     mItems[s] = value_type(0);
-                    SpinlockHolder lk(mOtherMutex);
+                    OptionalSpinlockHolder<Locked> lk(mOtherMutex);
                     if (mOther.find(pItem) == mOther.end())
                     {
                         ++mSpills;
@@ -183,7 +223,7 @@ BackyardHash::insert(const value_type& pItem)
     // instruction!) and the locking.
     if (0)
     {
-        SpinlockHolder lk(mOtherMutex);
+        OptionalSpinlockHolder<Locked> lk(mOtherMutex);
         std::unordered_map<value_type,uint64_t>::iterator i = mOther.find(pItem);
         if (i != mOther.end())
         {
@@ -209,7 +249,7 @@ BackyardHash::insert(const value_type& pItem)
             value_type vOld;
             value_type vNew = pack(j, c, h.value());
             {
-                SpinlockHolder lk(mMutexes[lockNum(s0)]);
+                OptionalSpinlockHolder<Locked> lk(mMutexes[lockNum(s0)]);
                 vOld = mItems[s];
                 mItems[s] = vNew;
             }
@@ -232,7 +272,7 @@ BackyardHash::insert(const value_type& pItem)
     //cerr << "cuckoo insert failed" << endl;
 
     // Too hard. Let's just drop the item into the spill table.
-    SpinlockHolder lk(mOtherMutex);
+    OptionalSpinlockHolder<Locked> lk(mOtherMutex);
     if (mOther.find(k) == mOther.end())
     {
         ++mPanics;
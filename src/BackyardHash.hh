@@ -298,6 +298,12 @@ public:
 
     void insert(const value_type& pItem);
 
+    /**
+     * Insert an item without taking any locks. This may only be used
+     * when no other thread is accessing the hash table.
+     */
+    void insertExclusive(const value_type& pItem);
+
     void sort(std::vector<uint32_t>& pPerm, uint64_t pNumThreads) const;
 
     template <typename Vis>
@@ -424,6 +430,9 @@ public:
     }
 
 private:
+    template <bool Locked>
+    void doInsert(const value_type& pItem);
+
     PartialHash partialHash(const value_type& pKey) const
     {
         uint64_t s0 = slotBits(pKey);
@@ -203,6 +203,15 @@ public:
     /// Reverse complement.
     void reverseComplement(uint64_t pK)
     {
+        if (pK - 1 < sBitsPerWord / 2)
+        {
+            // A k-mer with k <= 32 lives entirely in the low word,
+            // and so does its reverse complement.
+            word_type w = Gossamer::rev(~mWords[0]) >> (sBitsPerWord - 2*pK);
+            clear();
+            mWords[0] = w;
+            return;
+        }
         for (int64_t i = 0; i < Words/2; ++i)
         {
             word_type tmp = Gossamer::rev(~mWords[i]);
@@ -322,6 +331,13 @@ public:
 
     BigInteger& operator<<=(uint64_t pShift)
     {
+        if (Words == 2 && pShift - 1 < sBitsPerWord - 1)
+        {
+            mWords[Words - 1] = (mWords[Words - 1] << pShift)
+                              | (mWords[0] >> (sBitsPerWord - pShift));
+            mWords[0] <<= pShift;
+            return *this;
+        }
         if (pShift >= sBits)
         {
             clear();
@@ -358,6 +374,13 @@ public:
 
     BigInteger& operator>>=(uint64_t pShift)
     {
+        if (Words == 2 && pShift - 1 < sBitsPerWord - 1)
+        {
+            mWords[0] = (mWords[0] >> pShift)
+                      | (mWords[Words - 1] << (sBitsPerWord - pShift));
+            mWords[Words - 1] >>= pShift;
+            return *this;
+        }
         if (pShift >= sBits)
         {
             clear();
@@ -530,7 +553,7 @@ public:
         uint64_t seed = 14695981039346656037ULL;
         for (int64_t i = 0; i < Words; ++i)
         {
-            seed = wordHash(mWords[i], seed);
+            seed = mWords[i] ? wordHash(mWords[i], seed) : zeroWordHash(seed);
         }
         return seed;
     }
@@ -569,6 +592,13 @@ private:
         std::memset(mWords, 0, sizeof(mWords));
     }
 
+    // wordHash(0, pSeed): each of the 8 rounds only multiplies by
+    // the FNV prime, so the 8 rounds together multiply by its 8th power.
+    static uint64_t zeroWordHash(uint64_t pSeed)
+    {
+        return pSeed * 0x1efac7090aef4a21ULL;
+    }
+
     static uint64_t wordHash(uint64_t pWord, uint64_t pSeed)
     {
         uint64_t r = pSeed;
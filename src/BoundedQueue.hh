@@ -51,6 +51,10 @@
 #include "Profile.hh"
 #endif
 
+#ifndef PERFREPORT_HH
+#include "PerfReport.hh"
+#endif
+
 template <typename T, bool W = false>
 class BoundedQueue
 {
@@ -71,6 +75,9 @@ public:
                 mFullCond.wait(lock);
             }
             mItems.push_back(pItem);
+            mPuts++;
+            mSumItems += mItems.size();
+            mMaxSeen = std::max<uint64_t>(mMaxSeen, mItems.size());
             if (mWaiters > 0)
             {
                 mEmptyCond.notify_one();
@@ -146,14 +153,25 @@ public:
         PropertyTree t;
         t.putProp("empty-waits", mEmptyWaits);
         t.putProp("full-waits", mFullWaits);
+        t.putProp("puts", mPuts);
+        t.putProp("max-occupancy", mMaxSeen);
         return t;
     }
 
     BoundedQueue(uint64_t pMaxItems)
-        : mMaxItems(pMaxItems), mFinished(false), mFullWaits(0), mEmptyWaits(0), mWaiters(0)
+        : mMaxItems(pMaxItems), mFinished(false), mFullWaits(0), mEmptyWaits(0), mWaiters(0),
+          mPuts(0), mSumItems(0), mMaxSeen(0)
     {
     }
 
+    ~BoundedQueue()
+    {
+        if (mPuts && PerfReport::enabled())
+        {
+            PerfReport::addQueue(mMaxItems, mPuts, mSumItems, mMaxSeen, mFullWaits, mEmptyWaits);
+        }
+    }
+
 private:
     const uint64_t mMaxItems;
     Deque<T> mItems;
@@ -165,6 +183,9 @@ private:
     uint64_t mFullWaits;
     uint64_t mEmptyWaits;
     uint64_t mWaiters;
+    uint64_t mPuts;
+    uint64_t mSumItems;
+    uint64_t mMaxSeen;
 };
 
 #endif // BOUNDEDQUEUE_HH
@@ -0,0 +1,127 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef CONCURRENTUNIONFIND_HH
+#define CONCURRENTUNIONFIND_HH
+
+#ifndef STDINT_H
+#include <stdint.h>
+#define STDINT_H
+#endif
+
+#ifndef STD_ATOMIC
+#include <atomic>
+#define STD_ATOMIC
+#endif
+
+#ifndef STD_MEMORY
+#include <memory>
+#define STD_MEMORY
+#endif
+
+#ifndef STD_UTILITY
+#include <utility>
+#define STD_UTILITY
+#endif
+
+#ifndef BOOST_NONCOPYABLE_HPP
+#include <boost/noncopyable.hpp>
+#define BOOST_NONCOPYABLE_HPP
+#endif
+
+// Disjoint sets over the integers [0, n), which may be united and
+// found from several threads at once without locking.
+//
+// Roots are always linked beneath smaller roots, so the root of a set
+// is its least member, whatever order the unions happen in. Finds halve
+// the path they follow.
+//
+class ConcurrentUnionFind : private boost::noncopyable
+{
+public:
+    uint64_t size() const
+    {
+        return mSize;
+    }
+
+    // The least member of the set containing pX.
+    uint64_t find(uint64_t pX)
+    {
+        while (true)
+        {
+            uint64_t p = mParent[pX].load(std::memory_order_relaxed);
+            if (p == pX)
+            {
+                return pX;
+            }
+            uint64_t gp = mParent[p].load(std::memory_order_relaxed);
+            if (gp != p)
+            {
+                // Losing this race does no harm: someone else has
+                // shortened the path already.
+                mParent[pX].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            }
+            pX = gp;
+        }
+    }
+
+    // Merge the sets containing pX and pY.
+    void unite(uint64_t pX, uint64_t pY)
+    {
+        while (true)
+        {
+            pX = find(pX);
+            pY = find(pY);
+            if (pX == pY)
+            {
+                return;
+            }
+            if (pX < pY)
+            {
+                std::swap(pX, pY);
+            }
+            // pX may have stopped being a root since we found it.
+            uint64_t x = pX;
+            if (mParent[pX].compare_exchange_weak(x, pY, std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+    }
+
+    // Point the members [pBegin, pEnd) directly at their roots. Ranges
+    // may be flattened concurrently with each other, but not with unite().
+    void flatten(uint64_t pBegin, uint64_t pEnd)
+    {
+        for (uint64_t i = pBegin; i < pEnd; ++i)
+        {
+            mParent[i].store(find(i), std::memory_order_relaxed);
+        }
+    }
+
+    // The parent of pX: after flatten(), its root.
+    uint64_t parent(uint64_t pX) const
+    {
+        return mParent[pX].load(std::memory_order_relaxed);
+    }
+
+    explicit ConcurrentUnionFind(uint64_t pSize)
+        : mSize(pSize), mParent(new std::atomic<uint64_t>[pSize])
+    {
+        for (uint64_t i = 0; i < pSize; ++i)
+        {
+            mParent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    const uint64_t mSize;
+    std::unique_ptr<std::atomic<uint64_t>[]> mParent;
+};
+
+#endif // CONCURRENTUNIONFIND_HH
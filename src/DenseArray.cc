@@ -248,6 +248,70 @@ DenseSelect::select(uint64_t i) const
 }
 
 
+void
+DenseSelect::prefetchBlock(uint64_t i) const
+{
+    uint64_t blockNum = i >> mHeader.logBlockSize;
+    uint64_t il = mIndex[blockNum];
+    const uint8_t* block = mData + (il & ~sBlockTypeMask);
+
+    uint64_t subBlockOffset
+        = (i & (mHeader.blockSize - 1)) >> mHeader.logSampleRate;
+
+    switch (static_cast<block_type_t>(il & sBlockTypeMask))
+    {
+        case tSmall:
+        {
+            Gossamer::prefetch(reinterpret_cast<const uint16_t*>(block) + subBlockOffset);
+            break;
+        }
+
+        case tFullSpill64:
+        {
+            Gossamer::prefetch(reinterpret_cast<const uint64_t*>(block) + (i & (mHeader.blockSize - 1)));
+            break;
+        }
+
+        case tFullSpill32:
+        {
+            Gossamer::prefetch(reinterpret_cast<const uint32_t*>(block) + (i & (mHeader.blockSize - 1)));
+            break;
+        }
+
+        case tFullSpill16:
+        {
+            Gossamer::prefetch(reinterpret_cast<const uint16_t*>(block) + (i & (mHeader.blockSize - 1)));
+            break;
+        }
+
+        case tFullSpill8:
+        {
+            Gossamer::prefetch(block + (i & (mHeader.blockSize - 1)));
+            break;
+        }
+
+        case tIntermediate:
+        {
+            const uint32_t* b = reinterpret_cast<const uint32_t*>(block);
+            const internal_pointer_t* sbs
+                = reinterpret_cast<const internal_pointer_t*>(
+                    block + (sizeof(*b) <<
+                        (mHeader.logBlockSize - mHeader.logSampleRate))
+                );
+            Gossamer::prefetch(b + subBlockOffset);
+            Gossamer::prefetch(sbs + subBlockOffset);
+            break;
+        }
+
+        default:
+        {
+            // Corrupt indexes are reported by select().
+            break;
+        }
+    }
+}
+
+
 pair<uint64_t,uint64_t>
 DenseSelect::select(uint64_t i, uint64_t j) const
 {
@@ -180,6 +180,18 @@ public:
 
     std::pair<uint64_t,uint64_t> select(uint64_t i, uint64_t j) const;
 
+    // Hint that select(i) will be called soon. Prefetching happens in
+    // two stages: prefetchIndex() fetches the master index entries for
+    // i, and prefetchBlock(), which reads them, fetches the block entry.
+    void prefetchIndex(uint64_t i) const
+    {
+        uint64_t blockNum = i >> mHeader.logBlockSize;
+        Gossamer::prefetch(mRank + blockNum);
+        Gossamer::prefetch(mIndex + blockNum);
+    }
+
+    void prefetchBlock(uint64_t i) const;
+
     DenseSelect(const WordyBitVector& pBitVector,
                 const std::string& pBaseName, FileFactory& pFactory,
                 bool pInvertSense);
@@ -8,7 +8,6 @@
 //
 #include "BackgroundMultiConsumer.hh"
 #include "EdgeIndex.hh"
-#include "FixedWidthBitArray.hh"
 
 using namespace boost;
 using namespace std;
@@ -83,6 +82,12 @@ EdgeIndex::write(const std::string& pBaseName, FileFactory& pFactory) const
 {
     string name = pBaseName + "-edge-index";
 
+    // The index may be mapped from the files being written, so take
+    // a copy first.
+    const vector<SegmentAndOffset> segs(mSegs, mSegs + mNumSegs);
+    const vector<PathIdAndOffset> paths(mPaths, mPaths + mNumPaths);
+    const vector<uint64_t> multi(mMultiWords, mMultiWords + (mNumPaths + 63) / 64);
+
     // mHeader
     {
         FileFactory::OutHolderPtr op(pFactory.out(name + ".header"));
@@ -90,33 +95,37 @@ EdgeIndex::write(const std::string& pBaseName, FileFactory& pFactory) const
         Header h;
         h.version = version;
         h.div = mDiv;
+        h.fingerprint = mFingerprint;
         o.write(reinterpret_cast<const char*>(&h), sizeof(h));
     }
 
     // mSegmentIndex
     {
-        MappedArray<uint64_t>::Builder segArr(name + ".segs", pFactory);
-        for (SegmentIndex::const_iterator
-             i = mSegmentIndex.begin(); i != mSegmentIndex.end(); ++i)
+        MappedArray<SegmentAndOffset>::Builder segArr(name + ".segs", pFactory);
+        for (uint64_t i = 0; i < segs.size(); ++i)
         {
-            segArr.push_back(i->first);
-            segArr.push_back(i->second);
+            segArr.push_back(segs[i]);
         }
         segArr.end();
     }
 
     // mPathIndex
     {
-        MappedArray<uint32_t>::Builder pathArr(name + ".paths", pFactory);
-        FixedWidthBitArray<1>::Builder multiArr(name + ".multi", pFactory);
-        for (uint64_t i = 0; i < mPathIndex.size(); ++i)
+        MappedArray<PathIdAndOffset>::Builder pathArr(name + ".paths", pFactory);
+        for (uint64_t i = 0; i < paths.size(); ++i)
         {
-            const PathIdAndOffset& x(mPathIndex[i]);
-            pathArr.push_back(x.first);
-            pathArr.push_back(x.second);
-            multiArr.push_back(mMulti[i]);
+            pathArr.push_back(paths[i]);
         }
         pathArr.end();
+    }
+
+    // mMulti, in the layout of a FixedWidthBitArray<1>.
+    {
+        MappedArray<uint64_t>::Builder multiArr(name + ".multi", pFactory);
+        for (uint64_t i = 0; i < multi.size(); ++i)
+        {
+            multiArr.push_back(multi[i]);
+        }
         multiArr.end();
     }
 }
@@ -139,7 +148,7 @@ EdgeIndex::read(const std::string& pBaseName, FileFactory& pFactory, const Graph
             BOOST_THROW_EXCEPTION(
                 Gossamer::error()
                     << Gossamer::general_error_info("No edge index header file found.")
-                    << Gossamer::version_mismatch_info(make_pair(SuperGraph::version, 0)));
+                    << Gossamer::version_mismatch_info(make_pair(EdgeIndex::version, 0)));
         }
         (**ip).read(reinterpret_cast<char*>(&h), sizeof(h));
         if (h.version != EdgeIndex::version)
@@ -151,42 +160,24 @@ EdgeIndex::read(const std::string& pBaseName, FileFactory& pFactory, const Graph
         }
     }
     
-    unique_ptr<EdgeIndex> ix(new EdgeIndex(pGraph, h.div));
+    unique_ptr<EdgeIndex> ix(new EdgeIndex(pGraph, h.div, h.fingerprint));
+    ix->mMapped = unique_ptr<Mapped>(new Mapped(name, pFactory));
+    const Mapped& m(*ix->mMapped);
 
-    // mSegmentIndex
+    if (m.segs.size() != 1 + (pGraph.count() >> h.div)
+        || m.multi.size() != (m.paths.size() + 63) / 64)
     {
-        
-        MappedArray<uint64_t>::LazyIterator segItr(name + ".segs", pFactory);
-        while (segItr.valid())
-        {
-            SegmentAndOffset so;
-            so.first = *segItr;
-            ++segItr;
-            so.second = *segItr;
-            ++segItr;
-            ix->mSegmentIndex.push_back(so);
-        }
+        BOOST_THROW_EXCEPTION(
+            Gossamer::error()
+                << boost::errinfo_file_name(name + ".segs")
+                << Gossamer::general_error_info("Edge index does not match the graph."));
     }
 
-    // mPathIndex
-    {
-        MappedArray<uint32_t>::LazyIterator pathItr(name + ".paths", pFactory);
-        FixedWidthBitArray<1>::LazyIterator multiItr(FixedWidthBitArray<1>::lazyIterator(name + ".multi", pFactory));
-        const uint64_t sz(pathItr.size());
-        uint64_t i = 0;
-        ix->mPathIndex.resize(sz, PathIdAndOffset(0, 0));
-        ix->mMulti.resize(sz);
-        while (pathItr.valid())
-        {
-            PathId id(*pathItr);
-            ++pathItr;
-            SegmentOffset ofs(*pathItr);
-            ++pathItr;
-            ix->mPathIndex[i] = PathIdAndOffset(id, ofs);
-            ix->mMulti[i] = *multiItr;
-            ++multiItr;
-        }
-    }
+    ix->mSegs = m.segs.begin();
+    ix->mNumSegs = m.segs.size();
+    ix->mPaths = m.paths.begin();
+    ix->mMultiWords = m.multi.begin();
+    ix->mNumPaths = m.paths.size();
 
     return ix;
 }
@@ -198,7 +189,7 @@ EdgeIndex::create(const Graph& pGraph, const EntryEdgeSet& pEntryEdges,
 {
     BOOST_ASSERT(pEntryEdges.count() < numeric_limits<SegmentRank>::max());
 
-    unique_ptr<EdgeIndex> ix(new EdgeIndex(pGraph, pDiv));
+    unique_ptr<EdgeIndex> ix(new EdgeIndex(pGraph, pDiv, pSuper.fingerprint()));
     uint64_t numEdges = 1 + (pGraph.count() >> pDiv);
     ix->mSegmentIndex.resize(numEdges);
 
@@ -229,7 +220,7 @@ EdgeIndex::create(const Graph& pGraph, const EntryEdgeSet& pEntryEdges,
     for (SuperGraph::PathIterator i(pSuper); i.valid(); ++i)
     {
         const SuperPath p = pSuper[*i];
-        const vector<SuperPath::Segment>& seg(p.segments());
+        const SuperPath::SegmentsRef seg(p.segments());
         for (uint64_t j = 0; j < seg.size(); ++j)
         {
             if (seg[j].isLinearPath())
@@ -242,11 +233,11 @@ EdgeIndex::create(const Graph& pGraph, const EntryEdgeSet& pEntryEdges,
     // Using the segment use counts, we can index those that are unique
     LOG(pLog, info) << "constructing path index";
     ix->mPathIndex.resize(numEntryEdges);
-    ix->mMulti.resize(numEntryEdges);
+    ix->mMulti.resize((numEntryEdges + 63) / 64, 0);
     for (SuperGraph::PathIterator i(pSuper); i.valid(); ++i)
     {
         const SuperPath p = pSuper[*i];
-        const vector<SuperPath::Segment>& seg(p.segments());
+        const SuperPath::SegmentsRef seg(p.segments());
         int64_t l = 0;
         for (uint64_t j = 0; j < seg.size(); ++j)
         {
@@ -255,7 +246,7 @@ EdgeIndex::create(const Graph& pGraph, const EntryEdgeSet& pEntryEdges,
             {
                 if (segCounts[s] != 1)
                 {
-                    ix->mMulti[s] = true;
+                    ix->mMulti[s >> 6] |= 1ULL << (s & 63);
                 }
                 else
                 {
@@ -277,12 +268,52 @@ EdgeIndex::create(const Graph& pGraph, const EntryEdgeSet& pEntryEdges,
         }
     }
 
+    ix->mSegs = ix->mSegmentIndex.data();
+    ix->mNumSegs = ix->mSegmentIndex.size();
+    ix->mPaths = ix->mPathIndex.data();
+    ix->mMultiWords = ix->mMulti.data();
+    ix->mNumPaths = ix->mPathIndex.size();
+
     LOG(pLog, info) << "completed edge index construction";
 
     return ix;
 }
 
-EdgeIndex::EdgeIndex(const Graph& pGraph, uint64_t pDiv)
-    : mDiv(pDiv), mGraph(pGraph), mSegmentIndex(), mPathIndex(), mMulti()
+unique_ptr<EdgeIndex>
+EdgeIndex::open(const std::string& pBaseName, FileFactory& pFactory,
+                const Graph& pGraph, const EntryEdgeSet& pEntryEdges,
+                const SuperGraph& pSuper, uint64_t pDiv,
+                uint64_t pNumThreads, Logger& pLog)
+{
+    if (pSuper.fingerprint() && pFactory.exists(pBaseName + "-edge-index.header"))
+    {
+        try
+        {
+            unique_ptr<EdgeIndex> ix(read(pBaseName, pFactory, pGraph));
+            if (ix->mFingerprint == pSuper.fingerprint() && ix->mDiv == pDiv)
+            {
+                LOG(pLog, info) << "using saved edge index";
+                return ix;
+            }
+        }
+        catch (...)
+        {
+        }
+        LOG(pLog, info) << "saved edge index is out of date";
+    }
+    return create(pGraph, pEntryEdges, pSuper, pDiv, pNumThreads, pLog);
+}
+
+EdgeIndex::Mapped::Mapped(const std::string& pName, FileFactory& pFactory)
+    : segs(pName + ".segs", pFactory),
+      paths(pName + ".paths", pFactory),
+      multi(pName + ".multi", pFactory)
+{
+}
+
+EdgeIndex::EdgeIndex(const Graph& pGraph, uint64_t pDiv, uint64_t pFingerprint)
+    : mDiv(pDiv), mFingerprint(pFingerprint), mGraph(pGraph),
+      mSegmentIndex(), mPathIndex(), mMulti(),
+      mSegs(0), mNumSegs(0), mPaths(0), mMultiWords(0), mNumPaths(0)
 {
 }
@@ -17,6 +17,10 @@
 #include "SuperGraph.hh"
 #endif
 
+#ifndef MAPPEDARRAY_HH
+#include "MappedArray.hh"
+#endif
+
 #ifndef BOOST_UNORDERED_MAP_HPP
 #include <boost/unordered_map.hpp>
 #define BOOST_UNORDERED_MAP_HPP
@@ -25,15 +29,18 @@
 class EdgeIndex
 {
 public:
-    static constexpr uint64_t version = 2011092301ULL;
+    static constexpr uint64_t version = 2026101701ULL;
     // Version history
     // 2011082901   - first readable/writable version
     // 2011092301   - changed PathIndex to a dense array
+    // 2026101701   - 32 bit segment index entries, used in place, and
+    //                the fingerprint of the supergraph indexed
 
     struct Header
     {
         uint64_t version;
         uint64_t div;
+        uint64_t fingerprint;
     };
 
     typedef uint32_t PathId;
@@ -67,8 +74,8 @@ public:
         }
 
         r = r >> mDiv;
-        pSegRank = mSegmentIndex[r].first;
-        pOffset = mSegmentIndex[r].second;
+        pSegRank = mSegs[r].first;
+        pOffset = mSegs[r].second;
         return true;
     }
 
@@ -81,8 +88,8 @@ public:
         }
 
         uint64_t r = pRank >> mDiv;
-        pSegRank = mSegmentIndex[r].first;
-        pOffset = mSegmentIndex[r].second;
+        pSegRank = mSegs[r].first;
+        pOffset = mSegs[r].second;
         return true;
     }
 
@@ -95,13 +102,13 @@ public:
      */
     bool superpath(const uint64_t& pSegRank, SuperPathIdAndOffset& pInfo) const
     {
-        BOOST_ASSERT(pSegRank < mMulti.size());
-        if (mMulti[pSegRank])
+        BOOST_ASSERT(pSegRank < mNumPaths);
+        if ((mMultiWords[pSegRank >> 6] >> (pSegRank & 63)) & 1)
         {
             return false;
         }
 
-        const PathIdAndOffset& x(mPathIndex[pSegRank]);
+        const PathIdAndOffset& x(mPaths[pSegRank]);
         pInfo = std::make_pair(SuperPathId(x.first), x.second);
         return true;
     }
@@ -111,6 +118,9 @@ public:
      */
     void write(const std::string& pBaseName, FileFactory& pFactory) const;
 
+    /**
+     * Opens a saved EdgeIndex. The index is used in place from the mapped files.
+     */
     static std::unique_ptr<EdgeIndex> read(const std::string& pBaseName, FileFactory& pFactory,
                                          const Graph& pGraph);
 
@@ -118,15 +128,49 @@ public:
                                            const SuperGraph& pSuper, uint64_t pDiv, 
                                            uint64_t pNumThreads, Logger& pLog);
 
+    /**
+     * Reads the saved EdgeIndex, if it was built from the given supergraph
+     * with the same cache rate, or else creates a new one.
+     */
+    static std::unique_ptr<EdgeIndex> open(const std::string& pBaseName, FileFactory& pFactory,
+                                         const Graph& pGraph, const EntryEdgeSet& pEntryEdges,
+                                         const SuperGraph& pSuper, uint64_t pDiv,
+                                         uint64_t pNumThreads, Logger& pLog);
+
 private:
 
-    EdgeIndex(const Graph& pGraph, uint64_t pDiv);
+    EdgeIndex(const Graph& pGraph, uint64_t pDiv, uint64_t pFingerprint);
+
+    /**
+     * The saved index, mapped.
+     */
+    struct Mapped
+    {
+        MappedArray<SegmentAndOffset> segs;
+        MappedArray<PathIdAndOffset> paths;
+        MappedArray<uint64_t> multi;
+
+        Mapped(const std::string& pName, FileFactory& pFactory);
+    };
 
     const uint64_t mDiv;
+    const uint64_t mFingerprint;
     const Graph& mGraph;
+
+    // The index, as built by create().
     SegmentIndex mSegmentIndex;
     PathIndex mPathIndex;
-    boost::dynamic_bitset<> mMulti;
+    std::vector<uint64_t> mMulti;
+
+    // The index, as read.
+    std::unique_ptr<Mapped> mMapped;
+
+    // Wherever the index is held.
+    const SegmentAndOffset* mSegs;
+    uint64_t mNumSegs;
+    const PathIdAndOffset* mPaths;
+    const uint64_t* mMultiWords;
+    uint64_t mNumPaths;
 };
 
 #endif // EDGEINDEX_HH
@@ -21,7 +21,6 @@
 #include "ElectApp.hh"
 
 #include "LineSource.hh"
-#include "BackgroundMultiConsumer.hh"
 #include "BackyardHash.hh"
 #include "Debug.hh"
 #include "ElectVersion.hh"
@@ -33,9 +32,11 @@
 #include "GossOption.hh"
 #include "GossOptionChecker.hh"
 #include "GossRead.hh"
+#include "GossReadDispatcher.hh"
 #include "GossReadHandler.hh"
 #include "GossReadProcessor.hh"
 #include "GossReadSequenceBases.hh"
+#include "IntegerArray.hh"
 #include "KmerSet.hh"
 #include "KmerizingAdapter.hh"
 #include "Logger.hh"
@@ -43,6 +44,7 @@
 #include "Timer.hh"
 #include "ReadSequenceFileSequence.hh"
 #include "SimpleHashMap.hh"
+#include "SortedKmerLookup.hh"
 #include "StringFileFactory.hh"
 #include "UnboundedProgressMonitor.hh"
 #include "Utils.hh"
@@ -65,8 +67,6 @@ using namespace Gossamer;
 
 typedef vector<string> strings;
 
-typedef std::pair<GossReadPtr, GossReadPtr> ReadPair;
-
 namespace // anonymous
 {
     GossOptions globalOpts;
@@ -88,23 +88,127 @@ namespace // anonymous
             const uint64_t S = BackyardHash::maxSlotBits(M);
             const uint64_t N = M / (1.5 * sizeof(uint32_t) + sizeof(BackyardHash::value_type));
 
-            log(info, "building reference kmer set");
-            GossCmdBuildKmerSet(mK, S, N, mT, mOut, mRefFastas, strings(), strings())(pCxt);
+            if (mUnion)
+            {
+                buildUnion(pCxt, S, N);
+            }
+            else
+            {
+                log(info, "building reference kmer set");
+                GossCmdBuildKmerSet(mK, S, N, mT, mOut, mRefFastas, strings(), strings())(pCxt);
+            }
 
             log(info, "total elapsed time: " + lexical_cast<string>(t.check()));
         }
 
-        ElectCmdIndex(const strings& pRefFasta, const string& pOut, uint64_t pK, double pM, uint64_t pT)
-            : mRefFastas(pRefFasta), mOut(pOut), mK(pK), mM(pM), mT(pT)
+        ElectCmdIndex(const strings& pRefFasta, const string& pOut, uint64_t pK, double pM, uint64_t pT,
+                      bool pUnion)
+            : mRefFastas(pRefFasta), mOut(pOut), mK(pK), mM(pM), mT(pT), mUnion(pUnion)
         {
         }
 
     private:
+        typedef std::shared_ptr<KmerSet> KmerSetPtr;
+
+        // Build a kmer set for each reference, then merge them into a
+        // single kmer set over their union, with an integer array holding,
+        // for each kmer, a bitmap of the references it occurs in.
+        void buildUnion(const GossCmdContext& pCxt, uint64_t pS, uint64_t pN)
+        {
+            Logger& log(pCxt.log);
+            FileFactory& fac(pCxt.fac);
+
+            const uint64_t R = mRefFastas.size();
+            if (R > 64)
+            {
+                BOOST_THROW_EXCEPTION(
+                    Gossamer::error()
+                        << Gossamer::general_error_info("a union index can hold at most 64 references"));
+            }
+
+            strings names;
+            for (uint64_t i = 0; i < R; ++i)
+            {
+                log(info, "building kmer set for " + mRefFastas[i]);
+                names.push_back(fac.tmpName());
+                GossCmdBuildKmerSet(mK, pS, pN, mT, names.back(), strings(1, mRefFastas[i]),
+                                    strings(), strings())(pCxt);
+            }
+
+            uint64_t n = 0;
+            {
+                vector<KmerSetPtr> sets;
+                for (uint64_t i = 0; i < R; ++i)
+                {
+                    sets.push_back(std::make_shared<KmerSet>(names[i], fac));
+                }
+                mergeSets(sets, [&] (const KmerSet::Edge& pKmer, uint64_t pRefs) { ++n; });
+                log(info, "writing out " + lexical_cast<string>(n) + " kmers.");
+
+                KmerSet::Builder bld(mK, mOut, fac, n);
+                IntegerArray::BuilderPtr refsBld
+                    = IntegerArray::builder(IntegerArray::roundUpBits(R), mOut + ".refs", fac);
+                mergeSets(sets, [&] (const KmerSet::Edge& pKmer, uint64_t pRefs) {
+                    bld.push_back(pKmer.value());
+                    refsBld->push_back(IntegerArray::value_type(pRefs));
+                });
+                bld.end();
+                refsBld->end();
+            }
+
+            FileFactory::OutHolderPtr op(fac.out(mOut + ".ref-names"));
+            for (uint64_t i = 0; i < R; ++i)
+            {
+                **op << mRefFastas[i] << endl;
+                KmerSet::remove(names[i], fac);
+            }
+        }
+
+        // Visit the kmers of the union of some kmer sets, in order, along
+        // with a bitmap of the sets containing each one.
+        template <typename Vis>
+        static void mergeSets(const vector<KmerSetPtr>& pSets, Vis pVis)
+        {
+            vector<std::shared_ptr<KmerSet::Iterator> > itrs;
+            for (uint64_t i = 0; i < pSets.size(); ++i)
+            {
+                itrs.push_back(std::make_shared<KmerSet::Iterator>(*pSets[i]));
+            }
+            while (true)
+            {
+                bool any = false;
+                KmerSet::Edge x(Gossamer::position_type(0));
+                for (uint64_t i = 0; i < itrs.size(); ++i)
+                {
+                    if (itrs[i]->valid() && (!any || (**itrs[i]).first < x))
+                    {
+                        x = (**itrs[i]).first;
+                        any = true;
+                    }
+                }
+                if (!any)
+                {
+                    return;
+                }
+                uint64_t refs = 0;
+                for (uint64_t i = 0; i < itrs.size(); ++i)
+                {
+                    if (itrs[i]->valid() && (**itrs[i]).first == x)
+                    {
+                        refs |= 1ULL << i;
+                        ++*itrs[i];
+                    }
+                }
+                pVis(x, refs);
+            }
+        }
+
         const strings mRefFastas;
         const string mOut;
         const uint64_t mK;
         const double mM;
         const uint64_t mT;
+        const bool mUnion;
     };
 
     class ElectCmdFactoryIndex : public GossCmdFactory
@@ -131,9 +235,12 @@ namespace // anonymous
             uint64_t T = 4;
             chk.getOptional("num-threads", T);
 
+            bool unionIdx = false;
+            chk.getOptional("union-index", unionIdx);
+
             chk.throwIfNecessary(pApp);
 
-            return GossCmdPtr(new ElectCmdIndex(refs, out, K, M, T));
+            return GossCmdPtr(new ElectCmdIndex(refs, out, K, M, T, unionIdx));
         }
 
         ElectCmdFactoryIndex()
@@ -143,6 +250,8 @@ namespace // anonymous
             mCommonOptions.insert("max-memory");
             mCommonOptions.insert("kmer-size");
             mSpecificOptions.addOpt<string>("prefix", "P", "reference output prefix");
+            mSpecificOptions.addOpt<bool>("union-index", "",
+                    "build a single index which keeps the references distinct");
         }
     };
 
@@ -160,10 +269,19 @@ namespace // anonymous
             {
                 Gossamer::edge_type kmer(pKmer.normalized(mK));
                 uint64_t c = 0;
+                for (uint64_t i = 0; i < mUnions.size(); ++i)
+                {
+                    const UnionIndex& u(mUnions[i]);
+                    Gossamer::rank_type r;
+                    if (u.mKmers->accessAndRank(KmerSet::Edge(kmer), r))
+                    {
+                        c |= (*u.mRefs)[r].asUInt64() << u.mFirstId;
+                    }
+                }
                 uint64_t m = 1;
                 for (uint8_t i = 0; i < mKmerSets.size(); ++i)
                 {
-                    if (mKmerSets[i]->access(KmerSet::Edge(kmer)))
+                    if (mKmerSets[i] && mKmerSets[i]->access(KmerSet::Edge(kmer)))
                     {
                         c |= m;
                     }
@@ -172,6 +290,39 @@ namespace // anonymous
                 return c;
             }
 
+            // Look up a sorted batch of (normalized) kmers, or-ing the
+            // references each one appears in into pRefs[pOwners[query]].
+            void lookup(const SortedKmerLookup& pBatch, const vector<uint64_t>& pOwners,
+                        vector<uint64_t>& pRefs) const
+            {
+                for (uint64_t i = 0; i < mUnions.size(); ++i)
+                {
+                    const UnionIndex& u(mUnions[i]);
+                    auto vis = [&] (uint64_t pQuery, Gossamer::rank_type pRank) {
+                        pRefs[pOwners[pQuery]] |= (*u.mRefs)[pRank].asUInt64() << u.mFirstId;
+                    };
+                    pBatch.lookup(*u.mKmers, vis);
+                }
+                for (uint64_t i = 0; i < mKmerSets.size(); ++i)
+                {
+                    if (!mKmerSets[i])
+                    {
+                        continue;
+                    }
+                    const uint64_t m = 1ULL << i;
+                    auto vis = [&] (uint64_t pQuery, Gossamer::rank_type) {
+                        pRefs[pOwners[pQuery]] |= m;
+                    };
+                    pBatch.lookup(*mKmerSets[i], vis);
+                }
+            }
+
+            // The number of references added.
+            uint64_t references() const
+            {
+                return mNumRefs;
+            }
+
             // Add a single read as a reference.
             void addReference(GossCmdContext& pCxt, uint8_t pId, const GossRead& pRead, const uint64_t pNumThreads)
             {
@@ -190,6 +341,7 @@ namespace // anonymous
                     mKmerSets.resize(pId + 1);
                 }
                 mKmerSets[pId] = kmerSetPtr;
+                ++mNumRefs;
             }
 
             // Add a FASTA file as a reference.
@@ -207,7 +359,7 @@ namespace // anonymous
                 GossReadParserFactory fastaParserFac(FastaParser::create);
 
                 items.push_back(GossReadSequence::Item(pFastaFile, fastaParserFac, seqFac));
-                LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+                LineSourceFactory lineSrcFac(BlockLineSource::create);
                 ReadSequenceFileSequence reads(items, pSrcFac, lineSrcFac);
                 KmerizingAdapter src(reads, mK);
 
@@ -221,6 +373,7 @@ namespace // anonymous
                     mKmerSets.resize(pId + 1);
                 }
                 mKmerSets[pId] = kmerSetPtr;
+                ++mNumRefs;
             }
 
             // Add a pre-built KmerSet index as a reference.
@@ -233,26 +386,69 @@ namespace // anonymous
                     mKmerSets.resize(pId + 1);
                 }
                 mKmerSets[pId] = kmerSetPtr;
+                ++mNumRefs;
+            }
+
+            // Add the references in a pre-built union index, numbering them
+            // from pId. Returns the number of references added.
+            uint64_t addUnionReferences(FileFactory& pFac, const string& pBaseName, uint8_t pId)
+            {
+                strings names;
+                {
+                    FileFactory::InHolderPtr ip(pFac.in(pBaseName + ".ref-names"));
+                    string l;
+                    while (getline(**ip, l))
+                    {
+                        names.push_back(l);
+                    }
+                }
+                if (pId + names.size() > 64)
+                {
+                    BOOST_THROW_EXCEPTION(
+                        Gossamer::error()
+                            << Gossamer::general_error_info("too many references (the maximum is 64)"));
+                }
+                UnionIndex u;
+                u.mKmers = std::make_shared<KmerSet>(pBaseName, pFac);
+                u.mRefs = IntegerArray::create(IntegerArray::roundUpBits(names.size()), pBaseName + ".refs", pFac);
+                u.mFirstId = pId;
+                mUnions.push_back(u);
+                mNumRefs += names.size();
+                return names.size();
             }
 
             KmerMap(const uint64_t pK)
-                : mK(pK), mKmerSets()
+                : mK(pK), mKmerSets(), mNumRefs(0)
             {
                 mKmerSets.reserve(64);
             }
 
         private:
+            struct UnionIndex
+            {
+                KmerSetPtr mKmers;
+                IntegerArrayPtr mRefs;
+                uint64_t mFirstId;
+            };
 
             // TODO: This ought to be a multimap from k to the sets at that k!
             const uint64_t mK;
             vector<KmerSetPtr> mKmerSets;
+            vector<UnionIndex> mUnions;
+            uint64_t mNumRefs;
         };
 
         struct RefCompiler : public GossReadHandler
         {
-            // Add a KmerSet index reference.
+            // Add a KmerSet index reference, or the references
+            // in a union index.
             void operator()(const string& pPrefix, FileFactory& pFac)
             {
+                if (pFac.exists(pPrefix + ".ref-names"))
+                {
+                    mId += mKmerMap.addUnionReferences(pFac, pPrefix, mId);
+                    return;
+                }
                 mKmerMap.addReference(pFac, pPrefix, mId);
                 ++mId;
             }
@@ -305,6 +501,12 @@ namespace // anonymous
                 uint64_t& num(pMatched ? mMatchBuffered : mNonmatchBuffered);
                 mutex& mut(pMatched ? mMatchMut : mNonmatchMut);
 
+                // Inserting an empty streambuf sets failbit on the shared
+                // stream, which would lose every later write to it.
+                if (num == 0)
+                {
+                    return;
+                }
                 num = 0;
                 {
                     unique_lock<mutex> lk(mut);
@@ -403,11 +605,37 @@ namespace // anonymous
             stringstream mNonmatchBuffer2;
         };
 
-        struct KmerFilter
+        struct KmerFilter : public GossReadHandler
         {
-            void push_back(GossReadPtr pRead)
+            void operator()(const GossRead& pRead)
+            {
+                filter(pRead);
+            }
+
+            void operator()(const GossRead& pLhs, const GossRead& pRhs)
             {
-                const GossRead& read(*pRead);
+                filter(pLhs, pRhs);
+            }
+
+            void operator()(const GossReadBatch& pBatch)
+            {
+                if (pBatch.paired())
+                {
+                    for (uint64_t i = 0; i < pBatch.size(); ++i)
+                    {
+                        filter(pBatch.lhs(i), pBatch.rhs(i));
+                    }
+                    return;
+                }
+                for (uint64_t i = 0; i < pBatch.size(); ++i)
+                {
+                    filter(pBatch[i]);
+                }
+            }
+
+            void filter(const GossRead& pRead)
+            {
+                const GossRead& read(pRead);
                 uint64_t c = 0;
                 for (GossRead::Iterator i(read, mK); i.valid(); ++i)
                 {
@@ -422,10 +650,10 @@ namespace // anonymous
                 mWriter(false, read);
             }
 
-            void push_back(ReadPair pPair)
+            void filter(const GossRead& pLhs, const GossRead& pRhs)
             {
-                const GossRead& lhs(*pPair.first);
-                const GossRead& rhs(*pPair.second);
+                const GossRead& lhs(pLhs);
+                const GossRead& rhs(pRhs);
                 uint64_t c = 0;
                 for (GossRead::Iterator i(lhs, mK); i.valid(); ++i)
                 {
@@ -440,7 +668,7 @@ namespace // anonymous
                 for (GossRead::Iterator i(rhs, mK); i.valid(); ++i)
                 {
                     c |= mKmerMap[i.kmer().normalized(mK)];
-                    if (c >= mRefThreshold)
+                    if (popcnt(c) >= mRefThreshold)
                     {
                         mWriter(true, lhs, rhs);
                         return;
@@ -450,6 +678,17 @@ namespace // anonymous
                 mWriter(false, lhs, rhs);
             }
 
+            // Write out a read that has already been classified.
+            void write(bool pMatched, const GossRead& pRead)
+            {
+                mWriter(pMatched, pRead);
+            }
+
+            void write(bool pMatched, const GossRead& pLhs, const GossRead& pRhs)
+            {
+                mWriter(pMatched, pLhs, pRhs);
+            }
+
             KmerFilter(const uint64_t pK, const uint64_t pRefThreshold,
                        const KmerMap& pKmerMap, ostream* pMatchOutLhs, ostream* pMatchOutRhs, 
                        ostream* pNonmatchOutLhs, ostream* pNonmatchOutRhs,
@@ -474,41 +713,94 @@ namespace // anonymous
         {
             void operator()(const GossRead& pRead)
             {
-                mReadGrp.push_back(pRead.clone());
+                if (mBatch)
+                {
+                    mBatch->push_back(pRead);
+                    if (mBatch->full())
+                    {
+                        flush();
+                    }
+                    return;
+                }
+                (*mDispatcher)(pRead);
             }
 
             void operator()(const GossRead& pLhs, const GossRead& pRhs)
             {
-                mPairGrp.push_back(ReadPair(pLhs.clone(), pRhs.clone()));
+                if (mBatch)
+                {
+                    mBatch->push_back(pLhs, pRhs);
+                    if (mBatch->full())
+                    {
+                        flush();
+                    }
+                    return;
+                }
+                (*mDispatcher)(pLhs, pRhs);
+            }
+
+            void end()
+            {
+                if (mBatch)
+                {
+                    flush();
+                    return;
+                }
+                mDispatcher->end();
             }
 
             ReadFilter(const uint64_t pK, const uint64_t pRefThreshold, 
                        const KmerMap& pKmerMap, ostream* pMatchOut, ostream* pNonmatchOut,
-                       uint64_t pNumThreads)
+                       uint64_t pNumThreads, uint64_t pBatchSize = 0)
                 : mK(pK), mRefThreshold(pRefThreshold), 
                   mKmerMap(pKmerMap), mMatchOut1(pMatchOut), mMatchOut2(0), 
                   mNonmatchOut1(pNonmatchOut), mNonmatchOut2(0),
-                  mReadGrp(128), mPairGrp(0), mNumThreads(pNumThreads)
+                  mNumThreads(pNumThreads), mLookup(pK)
             {
-                for (uint64_t i = 0; i < mNumThreads; ++i)
+                if (pBatchSize)
                 {
-                    mKmerFilts.push_back(
-                            std::make_shared<KmerFilter>(
-                                mK, mRefThreshold, mKmerMap,
-                                mMatchOut1, mMatchOut2, mNonmatchOut1, mNonmatchOut2,
-                                mMatchMut, mNonmatchMut));
-                    mReadGrp.add(*mKmerFilts.back());
+                    addBatchWriter(pBatchSize, false);
+                    return;
                 }
+                mDispatcher = std::make_shared<GossReadDispatcher>(makeFilters());
             }
 
             ReadFilter(const uint64_t pK, const uint64_t pRefThreshold,
                        const KmerMap& pKmerMap, ostream* pMatchOutLhs, ostream* pMatchOutRhs, 
-                       ostream* pNonmatchOutLhs, ostream* pNonmatchOutRhs, uint64_t pNumThreads)
+                       ostream* pNonmatchOutLhs, ostream* pNonmatchOutRhs, uint64_t pNumThreads,
+                       uint64_t pBatchSize = 0)
                 : mK(pK), mRefThreshold(pRefThreshold),
                   mKmerMap(pKmerMap), mMatchOut1(pMatchOutLhs), mMatchOut2(pMatchOutRhs), 
                   mNonmatchOut1(pNonmatchOutLhs), mNonmatchOut2(pNonmatchOutRhs),
-                  mReadGrp(0), mPairGrp(128), mNumThreads(pNumThreads)
+                  mNumThreads(pNumThreads), mLookup(pK)
+            {
+                if (pBatchSize)
+                {
+                    addBatchWriter(pBatchSize, true);
+                    return;
+                }
+                mDispatcher = std::make_shared<GossPairDispatcher>(makeFilters());
+            }
+
+        private:
+            // In batch mode, the kmers of a whole batch of reads are sorted
+            // and looked up in one pass over each reference, and a single
+            // (unthreaded) KmerFilter is used to write out the results.
+            void addBatchWriter(uint64_t pBatchSize, bool pPaired)
+            {
+                mBatch = std::make_shared<GossReadBatch>(pBatchSize, pPaired);
+                mKmerFilts.push_back(
+                        std::make_shared<KmerFilter>(
+                            mK, mRefThreshold, mKmerMap,
+                            mMatchOut1, mMatchOut2, mNonmatchOut1, mNonmatchOut2,
+                            mMatchMut, mNonmatchMut));
+            }
+
+            // Otherwise, there is a KmerFilter for each thread, and reads
+            // are dispatched to them in batches.
+            vector<GossReadHandlerPtr> makeFilters()
             {
+                vector<GossReadHandlerPtr> filts;
                 for (uint64_t i = 0; i < mNumThreads; ++i)
                 {
                     mKmerFilts.push_back(
@@ -516,11 +808,61 @@ namespace // anonymous
                                 mK, mRefThreshold, mKmerMap,
                                 mMatchOut1, mMatchOut2, mNonmatchOut1, mNonmatchOut2,
                                 mMatchMut, mNonmatchMut));
-                    mPairGrp.add(*mKmerFilts.back());
+                    filts.push_back(mKmerFilts.back());
                 }
+                return filts;
+            }
+
+            void addKmers(const GossRead& pRead, uint64_t pOwner)
+            {
+                for (GossRead::Iterator i(pRead, mK); i.valid(); ++i)
+                {
+                    mLookup.push_back(i.kmer().normalized(mK));
+                    mOwners.push_back(pOwner);
+                }
+            }
+
+            void flush()
+            {
+                const GossReadBatch& b(*mBatch);
+                if (b.empty())
+                {
+                    return;
+                }
+                mLookup.clear();
+                mOwners.clear();
+                for (uint64_t i = 0; i < b.size(); ++i)
+                {
+                    if (b.paired())
+                    {
+                        addKmers(b.lhs(i), i);
+                        addKmers(b.rhs(i), i);
+                    }
+                    else
+                    {
+                        addKmers(b[i], i);
+                    }
+                }
+                mLookup.sort(mNumThreads);
+
+                vector<uint64_t> refs(b.size(), 0);
+                mKmerMap.lookup(mLookup, mOwners, refs);
+
+                KmerFilter& w(*mKmerFilts.front());
+                for (uint64_t i = 0; i < b.size(); ++i)
+                {
+                    if (b.paired())
+                    {
+                        w.write(popcnt(refs[i]) >= mRefThreshold, b.lhs(i), b.rhs(i));
+                    }
+                    else
+                    {
+                        w.write(popcnt(refs[i]) >= mRefThreshold, b[i]);
+                    }
+                }
+                mBatch->clear();
             }
 
-        private:
             const uint64_t mK;
             const uint64_t mRefThreshold;
             const KmerMap& mKmerMap;
@@ -531,9 +873,11 @@ namespace // anonymous
             ostream* mNonmatchOut1;
             ostream* mNonmatchOut2;
             vector<KmerFilterPtr> mKmerFilts;
-            BackgroundMultiConsumer<GossReadPtr> mReadGrp;
-            BackgroundMultiConsumer<ReadPair> mPairGrp;
+            GossReadHandlerPtr mDispatcher;
             const uint64_t mNumThreads;
+            GossReadBatchPtr mBatch;
+            SortedKmerLookup mLookup;
+            vector<uint64_t> mOwners;
         };
 
         void filterSingle(const GossCmdContext& pCxt, const KmerMap& pKmerMap, const string& pSuffix, 
@@ -559,7 +903,7 @@ namespace // anonymous
             }
             ReadFilter filt(mK, mRefThreshold, pKmerMap, 
                             matchPtr ? &**matchPtr : 0, nonmatchPtr ? &**nonmatchPtr : 0,
-                            pNumThreads);
+                            pNumThreads, mSortedLookupBatch);
             GossReadProcessor::processSingle(pCxt, pFastas, pFastqs, pLines, filt, &umon);
         }
 
@@ -591,7 +935,7 @@ namespace // anonymous
             ReadFilter filt(mK, mRefThreshold, pKmerMap, 
                             matchLhsPtr ? &**matchLhsPtr : 0, matchRhsPtr ? &**matchRhsPtr : 0, 
                             nonmatchLhsPtr ? &**nonmatchLhsPtr : 0, nonmatchRhsPtr ? &**nonmatchRhsPtr : 0,
-                            pNumThreads);
+                            pNumThreads, mSortedLookupBatch);
             GossReadProcessor::processPairs(pCxt, pFastas, pFastqs, pLines, filt, &umon);
         }
 
@@ -649,7 +993,7 @@ namespace // anonymous
                     refCompiler(mRefIndexes[i], fac);
                 }
             }
-            
+
             log(info, "processing reads");
             // Process reads.
             if (mPairs)
@@ -673,13 +1017,15 @@ namespace // anonymous
                       const strings& pFastas, const strings& pFastqs, const strings& pLines,
                       bool pPairs, double pMaxMemory, uint64_t pNumThreads,
                       const string& pMatchPrefix, const string& pNonmatchPrefix,
-                      bool pPreserveReadOrder, bool pSingleSeqRefs)
+                      bool pPreserveReadOrder, bool pSingleSeqRefs,
+                      uint64_t pSortedLookupBatch = 0)
             : mK(pK), mRefThreshold(pRefThreshold == -1ULL ? pRefFastas.size() + pRefIndexes.size() : pRefThreshold),
               mRefFastas(pRefFastas), mRefIndexes(pRefIndexes),
               mFastas(pFastas), mFastqs(pFastqs), mLines(pLines), 
               mPairs(pPairs), mMaxMemory(pMaxMemory), mNumThreads(pNumThreads),
               mMatchPrefix(pMatchPrefix), mNonmatchPrefix(pNonmatchPrefix),
-              mPreserveReadOrder(pPreserveReadOrder), mSingleSeqRefs(pSingleSeqRefs)
+              mPreserveReadOrder(pPreserveReadOrder), mSingleSeqRefs(pSingleSeqRefs),
+              mSortedLookupBatch(pSortedLookupBatch)
         {
         }
 
@@ -698,8 +1044,27 @@ namespace // anonymous
         const string mNonmatchPrefix;
         const bool mPreserveReadOrder;
         const bool mSingleSeqRefs;
+        const uint64_t mSortedLookupBatch;
     };
 
+    // The number of references in an index: one for a kmer set, and
+    // one for each name listed with a union index.
+    uint64_t indexReferences(FileFactory& pFac, const string& pPrefix)
+    {
+        if (!pFac.exists(pPrefix + ".ref-names"))
+        {
+            return 1;
+        }
+        uint64_t n = 0;
+        FileFactory::InHolderPtr ip(pFac.in(pPrefix + ".ref-names"));
+        string l;
+        while (getline(**ip, l))
+        {
+            ++n;
+        }
+        return n;
+    }
+
     class ElectCmdFactoryGroup : public GossCmdFactory
     {
     public:
@@ -738,6 +1103,15 @@ namespace // anonymous
 
             uint64_t refThresh = -1ULL;
             chk.getOptional("ref-threshold", refThresh);
+            if (refThresh == -1ULL)
+            {
+                // A union index counts once for each reference it holds.
+                refThresh = fastaRefs.size();
+                for (uint64_t i = 0; i < indexRefs.size(); ++i)
+                {
+                    refThresh += indexReferences(fac, indexRefs[i]);
+                }
+            }
 
             string match = "";
             chk.getOptional("match-prefix", match);
@@ -751,10 +1125,13 @@ namespace // anonymous
             bool singleSeqRefs = false;
             chk.getOptional("single-sequence-refs", singleSeqRefs);
 
+            uint64_t sortedLookupBatch = 0;
+            chk.getOptional("sorted-lookup-batch", sortedLookupBatch);
+
             chk.throwIfNecessary(pApp);
 
             return GossCmdPtr(new ElectCmdGroup(K, refThresh, fastaRefs, indexRefs, fastas, fastqs, lines, pairs, maxMem, T, 
-                                                match, nonmatch, ord, singleSeqRefs));
+                                                match, nonmatch, ord, singleSeqRefs, sortedLookupBatch));
         }
 
         ElectCmdFactoryGroup()
@@ -779,6 +1156,9 @@ namespace // anonymous
             mSpecificOptions.addOpt<string>("non-match-prefix", "", "filename prefix for non-matching reads");
             mSpecificOptions.addOpt<string>("single-seq-refs", "", "treat each sequence as a separate reference");
             mSpecificOptions.addOpt<strings>("ref-index", "", "prefix of reference index");
+            mSpecificOptions.addOpt<uint64_t>("sorted-lookup-batch", "",
+                    "classify reads in batches of this many, looking up the kmers of each batch "
+                    "in one sequential pass over each reference (default: off)");
         }
     };
 
@@ -807,6 +1187,7 @@ ElectApp::ElectApp()
                                 "enable particular debugging output");
     globalOpts.addOpt<bool>("help", "h", "show a help message");
     globalOpts.addOpt<string>("log-file", "l", "place to write messages");
+    globalOpts.addOpt<string>("perf-report", "", "write a JSON report of the time, memory and I/O used to this file");
     globalOpts.addOpt<strings>("tmp-dir", "", "a directory to use for temporary files (default /tmp)");
     globalOpts.addOpt<uint64_t>("num-threads", "T", "maximum number of worker threads to use, where possible");
     globalOpts.addOpt<bool>("verbose", "v", "show progress messages");
@@ -1015,6 +1015,7 @@ EspressoApp::EspressoApp()
                                 "enable particular debugging output");
     globalOpts.addOpt<bool>("help", "h", "show a help message");
     globalOpts.addOpt<string>("log-file", "l", "place to write messages");
+    globalOpts.addOpt<string>("perf-report", "", "write a JSON report of the time, memory and I/O used to this file");
     globalOpts.addOpt<strings>("tmp-dir", "", "a directory to use for temporary files (default /tmp)");
     globalOpts.addOpt<uint64_t>("num-threads", "T", "maximum number of worker threads to use, where possible");
     globalOpts.addOpt<bool>("verbose", "v", "show progress messages");
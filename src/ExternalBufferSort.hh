@@ -9,12 +9,12 @@
 #ifndef EXTERNALBUFFERSORT_HH
 #define EXTERNALBUFFERSORT_HH
 
-#ifndef FILEFACTORY_HH
-#include "FileFactory.hh"
+#ifndef EXTERNALMERGESORT_HH
+#include "ExternalMergeSort.hh"
 #endif
 
-#ifndef MAPPEDARRAY_HH
-#include "MappedArray.hh"
+#ifndef FILEFACTORY_HH
+#include "FileFactory.hh"
 #endif
 
 #ifndef TRIVIALVECTOR_HH
@@ -25,39 +25,22 @@
 #include "VByteCodec.hh"
 #endif
 
+#ifndef STD_ALGORITHM
+#include <algorithm>
+#define STD_ALGORITHM
+#endif
+
 #ifndef STD_VECTOR
 #include <vector>
 #define STD_VECTOR
 #endif
 
+// Sort byte strings (packets) lexicographically, in external memory.
+//
 class ExternalBufferSort
 {
 public:
-    static const uint64_t Radix = 256;
-    
-    class Cmp
-    {
-    public:
-        bool operator()(uint8_t const* pLhs, uint8_t const* pRhs)
-        {
-            uint8_t const* lp = pLhs;
-            uint64_t l = VByteCodec::decode(lp);
-            uint8_t const* rp = pRhs;
-            uint64_t r = VByteCodec::decode(rp);
-            uint64_t i = 0;
-            uint64_t j = 0;
-            while (i < l && j < r)
-            {
-                if (*lp != *rp)
-                {
-                    return *lp < *rp;
-                }
-                ++i; ++j;
-                ++lp; ++rp;
-            }
-            return l < r;
-        }
-    };
+    typedef std::vector<uint8_t> Item;
 
     class InAdapter
     {
@@ -83,174 +66,85 @@ public:
         std::istream& mFile;
     };
 
-    class BufferedFile
+    // Items are stored in runs as a VByte length followed by the bytes.
+    class Codec
     {
     public:
-        template <typename Vec>
-        void push_back(const Vec& pItem)
+        static void write(std::ostream& pOut, const Item& pItem)
         {
             TrivialVector<uint8_t,16> tmp;
             VByteCodec::encode(pItem.size(), tmp);
-            uint64_t z = tmp.size() + pItem.size();
-            if (mBuffer.size() + z > mBufferSize)
+            pOut.write(reinterpret_cast<const char*>(tmp.begin()), tmp.size());
+            if (!pItem.empty())
             {
-                flush();
+                pOut.write(reinterpret_cast<const char*>(&pItem[0]), pItem.size());
             }
-            mBuffer.insert(mBuffer.end(), tmp.begin(), tmp.end());
-            mBuffer.insert(mBuffer.end(), pItem.begin(), pItem.end());
         }
 
-        void flush()
+        static bool read(std::istream& pIn, Item& pItem)
         {
-            if (mBuffer.empty())
+            InAdapter itr(pIn);
+            uint64_t z = VByteCodec::decode(itr);
+            if (!pIn.good())
             {
-                return;
+                return false;
             }
-            //std::cerr << "flushing " << mFileName << std::endl;
-
-            FileFactory::OutHolderPtr outp(mFactory.out(mFileName, FileFactory::AppendMode));
-            std::ostream& out(**outp);
-            out.write(reinterpret_cast<const char*>(&mBuffer[0]), mBuffer.size());
-            mBuffer.clear();
+            pItem.resize(z);
+            if (z != 0)
+            {
+                pIn.read(reinterpret_cast<char*>(&pItem[0]), z);
+            }
+            return !pIn.fail();
         }
 
-        BufferedFile(uint64_t pBufferSize, const std::string& pFileName, FileFactory& pFactory)
-            : mBufferSize(pBufferSize), mFileName(pFileName), mFactory(pFactory)
+        // The memory a buffered item takes: the vector, and the heap
+        // block holding its bytes, which the allocator pads with a
+        // header and rounds up. (A buffered item is a copy, so its
+        // capacity is its size.) For short packets the overhead is
+        // most of it.
+        static uint64_t size(const Item& pItem)
         {
+            return sizeof(Item) + heapBytes(pItem.size());
         }
 
-    private:
-        const uint64_t mBufferSize;
-        const std::string mFileName;
-        FileFactory& mFactory;
-        std::vector<uint8_t> mBuffer;
+        static uint64_t heapBytes(uint64_t pBytes)
+        {
+            static const uint64_t header = sizeof(void*);
+            static const uint64_t align = 2 * sizeof(void*);
+            static const uint64_t least = 4 * sizeof(void*);
+            if (pBytes == 0)
+            {
+                return 0;
+            }
+            return std::max(least, (pBytes + header + align - 1) / align * align);
+        }
     };
-    typedef boost::shared_ptr<BufferedFile> BufferedFilePtr;
 
     template <typename Vec>
     void push_back(const Vec& pItem)
     {
-        mRoot->push_back(pItem);
+        mItem.assign(pItem.begin(), pItem.end());
+        mSorter.push_back(mItem);
     }
 
     template <typename Dest>
     void sort(Dest& pDest)
     {
-        mRoot->flush();
-        mRoot = BufferedFilePtr();
-        sort(mFileName, 0, pDest);
+        mSorter.sort(pDest);
         pDest.end();
     }
 
-    ExternalBufferSort(uint64_t pBufferSize, FileFactory& pFactory)
-        : mFactory(pFactory), mBufferSize(pBufferSize), mFileName(pFactory.tmpName()),
-          mRoot(new BufferedFile(mBufferSize, mFileName, mFactory))
+    // pBufferSize is the memory budget, in bytes.
+    ExternalBufferSort(uint64_t pBufferSize, FileFactory& pFactory, uint64_t pNumThreads = 1)
+        : mSorter(pFactory, Sorter::Params(pBufferSize, pNumThreads))
     {
     }
 
 private:
+    typedef ExternalMergeSort<Item,Codec> Sorter;
 
-    template <typename Dest>
-    void sort(const std::string& pFileName, uint64_t pDepth, Dest& pDest)
-    {
-        if (!mFactory.exists(pFileName))
-        {
-            return;
-        }
-
-        if (mFactory.size(pFileName) <= mBufferSize)
-        {
-            {
-                MappedArray<uint8_t> a(pFileName, mFactory);
-                std::vector<uint8_t const*> perm;
-                for (uint8_t const* p = a.begin(); p != a.end();)
-                {
-                    perm.push_back(p);
-                    uint64_t z = VByteCodec::decode(p, a.end());
-                    p += z;
-                }
-
-                std::sort(perm.begin(), perm.end(), Cmp());
-                std::vector<uint8_t> itm;
-                for (uint64_t i = 0; i < perm.size(); ++i)
-                {
-                    uint8_t const * p = perm[i];
-                    uint64_t z = VByteCodec::decode(p);
-                    itm.resize(z);
-                    for (uint64_t j = 0; j < z; ++j)
-                    {
-                        itm[j] = *p++;
-                    }
-                    pDest.push_back(itm);
-                }
-            }
-            mFactory.remove(pFileName);
-            return;
-        }
-
-        //std::cerr << "recursing on " << pFileName << std::endl;
-
-        std::vector<BufferedFilePtr> kids;
-        std::vector<uint8_t> used(Radix, false);
-        for (uint64_t i = 0; i < Radix; ++i)
-        {
-            std::string fn = pFileName + "-" + boost::lexical_cast<std::string>(i);
-            kids.push_back(BufferedFilePtr(new BufferedFile(mBufferSize / Radix, fn, mFactory)));
-        }
-
-        {
-            FileFactory::InHolderPtr inp(mFactory.in(pFileName));
-            std::istream& in(**inp);
-            InAdapter itr(in);
-            std::vector<uint8_t> item;
-            while (in.good())
-            {
-                uint64_t z = VByteCodec::decode(itr);
-                if (!in.good())
-                {
-                    break;
-                }
-                item.resize(z);
-                if( z != 0 ) {
-                    // if z is zero, &item[0] throws an out of range exception
-                    // in debug mode.
-                    in.read(reinterpret_cast<char*>(&item[0]), z);
-                }
-                if (item.size() == pDepth)
-                {
-                    pDest.push_back(item);
-                }
-                else
-                {
-                    kids[item[pDepth]]->push_back(item);
-                    used[item[pDepth]] = true;
-                }
-            }
-        }
-
-        for (uint64_t i = 0; i < Radix; ++i)
-        {
-            kids[i]->flush();
-        }
-        kids.clear();
-
-        mFactory.remove(pFileName);
-
-        for (uint64_t i = 0; i < Radix; ++i)
-        {
-            if (!used[i])
-            {
-                continue;
-            }
-            std::string fn = pFileName + "-" + boost::lexical_cast<std::string>(i);
-            sort(fn, pDepth + 1, pDest);
-        }
-    }
-
-    FileFactory& mFactory;
-    const uint64_t mBufferSize;
-    const std::string mFileName;
-    BufferedFilePtr mRoot;
+    Sorter mSorter;
+    Item mItem;
 };
 
 #endif // EXTERNALBUFFERSORT_HH
@@ -0,0 +1,219 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef EXTERNALMERGESORT_HH
+#define EXTERNALMERGESORT_HH
+
+#ifndef EXTERNALSORTUTILS_HH
+#include "ExternalSortUtils.hh"
+#endif
+
+#ifndef FILEFACTORY_HH
+#include "FileFactory.hh"
+#endif
+
+#ifndef GOSSAMEREXCEPTION_HH
+#include "GossamerException.hh"
+#endif
+
+#ifndef LOSERTREE_HH
+#include "LoserTree.hh"
+#endif
+
+#ifndef THREADGROUP_HH
+#include "ThreadGroup.hh"
+#endif
+
+#ifndef STD_ALGORITHM
+#include <algorithm>
+#define STD_ALGORITHM
+#endif
+
+#ifndef STD_EXCEPTION
+#include <exception>
+#define STD_EXCEPTION
+#endif
+
+#ifndef STD_FUNCTIONAL
+#include <functional>
+#define STD_FUNCTIONAL
+#endif
+
+#ifndef STD_MEMORY
+#include <memory>
+#define STD_MEMORY
+#endif
+
+#ifndef STD_STRING
+#include <string>
+#define STD_STRING
+#endif
+
+#ifndef STD_THREAD
+#include <thread>
+#define STD_THREAD
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+// The external sort engine behind ExternalSort, ExternalVarPushSorter
+// and ExternalBufferSort (and so PacketSorter).
+//
+// Items are pushed into an in-memory buffer. When the buffer reaches
+// its share of the memory budget, it is handed to a background thread
+// which sorts it (on several threads) and writes it out as a run,
+// while pushing carries on into a second buffer. If everything fits
+// in memory, no runs are written at all.
+//
+// The runs are merged with a loser tree, at most Params::fanIn at a
+// time; the last merge streams straight into the destination.
+//
+// The codec V provides write() and read(), as ExternalSortCodec does,
+// and size(), which estimates the memory an item occupies.
+//
+template <typename T, typename V = ExternalSortCodec<T>, typename Cmp = std::less<T> >
+class ExternalMergeSort : public ExternalSortBase
+{
+public:
+    // The fewest items worth giving a thread of their own in sortRun.
+    static const uint64_t sMinChunk = 1ULL << 14;
+
+    struct Params
+    {
+        // Bytes of items to hold in memory. Half goes to the buffer
+        // being filled, and half to the run being sorted and written.
+        // Sorting a run on several threads briefly needs a second copy
+        // of its items.
+        uint64_t memory;
+
+        // Threads to use for sorting runs.
+        uint64_t numThreads;
+
+        // The most runs to merge at once.
+        uint64_t fanIn;
+
+        // The most bytes of runs to keep on disk at once. Exceeding it
+        // is an error. Zero means no limit.
+        uint64_t tmpSpace;
+
+        // The directory for runs. If empty, the FileFactory's
+        // temporary directory is used.
+        std::string tmpDir;
+
+        Params(uint64_t pMemory, uint64_t pNumThreads = 1)
+            : memory(pMemory), numThreads(pNumThreads), fanIn(64), tmpSpace(0)
+        {
+        }
+    };
+
+    void push_back(const T& pItem)
+    {
+        mBuf.push_back(pItem);
+        mBufBytes += V::size(pItem);
+        ++mCount;
+        if (mBufBytes >= mParams.memory / 2)
+        {
+            spill();
+        }
+    }
+
+    // The number of items pushed.
+    uint64_t count() const
+    {
+        return mCount;
+    }
+
+    // Push the sorted items into pDest.
+    template <typename Dest>
+    void sort(Dest& pDest);
+
+    // Sort pItems in memory, using pNumThreads threads. The items are
+    // split into chunks which are sorted concurrently, then merged.
+    static void sortRun(std::vector<T>& pItems, uint64_t pNumThreads, const Cmp& pCmp = Cmp());
+
+    ExternalMergeSort(FileFactory& pFactory, const Params& pParams, const Cmp& pCmp = Cmp());
+
+    ~ExternalMergeSort();
+
+private:
+    typedef FileInWrapper<T,V> RunReader;
+    typedef FileFactory::TmpFileHolderPtr RunPtr;
+
+    // A range of a vector, as a source for the loser tree, for merging
+    // chunks sorted in memory.
+    class RangeSrc
+    {
+    public:
+        bool valid() const
+        {
+            return mCurr != mEnd;
+        }
+
+        T& operator*() const
+        {
+            return *mCurr;
+        }
+
+        void operator++()
+        {
+            ++mCurr;
+        }
+
+        RangeSrc(typename std::vector<T>::iterator pBegin, typename std::vector<T>::iterator pEnd)
+            : mCurr(pBegin), mEnd(pEnd)
+        {
+        }
+
+    private:
+        typename std::vector<T>::iterator mCurr;
+        typename std::vector<T>::iterator mEnd;
+    };
+
+    // Hand the buffer to the background writer.
+    void spill();
+
+    // Wait for the background writer, rethrowing anything it threw.
+    void join();
+
+    // Sort pItems and write them as a new run.
+    void writeRun(std::vector<T>& pItems);
+
+    // Merge the runs [pBegin, pEnd) into pDest.
+    template <typename Dest>
+    void merge(uint64_t pBegin, uint64_t pEnd, Dest& pDest);
+
+    std::string newRunName();
+
+    // Record a newly written run, and check the temporary space budget.
+    void addRun(const RunPtr& pRun);
+
+    // Remove the runs [pBegin, pEnd).
+    void removeRuns(uint64_t pBegin, uint64_t pEnd);
+
+    FileFactory& mFactory;
+    const Params mParams;
+    const Cmp mCmp;
+    const std::string mBase;
+    uint64_t mRunNum;
+    uint64_t mCount;
+    std::vector<T> mBuf;
+    uint64_t mBufBytes;
+    std::vector<T> mSpare;
+    std::thread mWriter;
+    std::exception_ptr mWriterError;
+    std::vector<RunPtr> mRuns;
+    std::vector<uint64_t> mRunBytes;
+    uint64_t mTmpBytes;
+};
+
+#include "ExternalMergeSort.tcc"
+
+#endif // EXTERNALMERGESORT_HH
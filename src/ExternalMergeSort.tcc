@@ -0,0 +1,258 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+
+#ifndef BOOST_LEXICAL_CAST_HPP
+#include <boost/lexical_cast.hpp>
+#define BOOST_LEXICAL_CAST_HPP
+#endif
+
+template <typename T, typename V, typename Cmp>
+template <typename Dest>
+void
+ExternalMergeSort<T,V,Cmp>::sort(Dest& pDest)
+{
+    join();
+
+    if (mRuns.empty())
+    {
+        // It all fit in memory.
+        sortRun(mBuf, mParams.numThreads, mCmp);
+        for (uint64_t i = 0; i < mBuf.size(); ++i)
+        {
+            pDest.push_back(mBuf[i]);
+        }
+        std::vector<T>().swap(mBuf);
+        mBufBytes = 0;
+        return;
+    }
+
+    if (!mBuf.empty())
+    {
+        writeRun(mBuf);
+    }
+    std::vector<T>().swap(mBuf);
+    std::vector<T>().swap(mSpare);
+    mBufBytes = 0;
+
+    const uint64_t f = std::max<uint64_t>(2, mParams.fanIn);
+    uint64_t b = 0;
+    while (mRuns.size() - b > f)
+    {
+        uint64_t e = b + f;
+        std::string fn = newRunName();
+        RunPtr h(new FileFactory::TmpFileHolder(mFactory, fn));
+        {
+            FileOutWrapper<T,V> out(fn, mFactory);
+            merge(b, e, out);
+        }
+        addRun(h);
+        removeRuns(b, e);
+        b = e;
+    }
+
+    merge(b, mRuns.size(), pDest);
+    removeRuns(b, mRuns.size());
+    mRuns.clear();
+    mRunBytes.clear();
+}
+
+
+template <typename T, typename V, typename Cmp>
+void
+ExternalMergeSort<T,V,Cmp>::sortRun(std::vector<T>& pItems, uint64_t pNumThreads, const Cmp& pCmp)
+{
+    const uint64_t n = pItems.size();
+    const uint64_t p = std::min(pNumThreads, n / sMinChunk);
+    if (p <= 1)
+    {
+        std::sort(pItems.begin(), pItems.end(), pCmp);
+        return;
+    }
+
+    std::vector<RangeSrc> srcs;
+    {
+        ThreadGroup grp;
+        for (uint64_t i = 0; i < p; ++i)
+        {
+            typename std::vector<T>::iterator b = pItems.begin() + n * i / p;
+            typename std::vector<T>::iterator e = pItems.begin() + n * (i + 1) / p;
+            srcs.push_back(RangeSrc(b, e));
+            if (i > 0)
+            {
+                grp.create([b, e, &pCmp] () {
+                    std::sort(b, e, pCmp);
+                });
+            }
+        }
+        std::sort(pItems.begin(), pItems.begin() + n / p, pCmp);
+        grp.join();
+    }
+
+    std::vector<RangeSrc*> ptrs;
+    for (uint64_t i = 0; i < p; ++i)
+    {
+        ptrs.push_back(&srcs[i]);
+    }
+    LoserTree<RangeSrc,T,Cmp> tree(ptrs, pCmp);
+    std::vector<T> out;
+    out.reserve(n);
+    while (tree.valid())
+    {
+        out.push_back(std::move(*srcs[tree.winner()]));
+        ++tree;
+    }
+    pItems.swap(out);
+}
+
+
+template <typename T, typename V, typename Cmp>
+ExternalMergeSort<T,V,Cmp>::ExternalMergeSort(FileFactory& pFactory, const Params& pParams, const Cmp& pCmp)
+    : mFactory(pFactory), mParams(pParams), mCmp(pCmp), mBase(pFactory.tmpName()),
+      mRunNum(0), mCount(0), mBufBytes(0), mTmpBytes(0)
+{
+}
+
+
+template <typename T, typename V, typename Cmp>
+ExternalMergeSort<T,V,Cmp>::~ExternalMergeSort()
+{
+    if (mWriter.joinable())
+    {
+        mWriter.join();
+    }
+}
+
+
+template <typename T, typename V, typename Cmp>
+void
+ExternalMergeSort<T,V,Cmp>::spill()
+{
+    join();
+    mSpare.swap(mBuf);
+    mBufBytes = 0;
+    mWriter = std::thread([this] () {
+        try
+        {
+            writeRun(mSpare);
+        }
+        catch (...)
+        {
+            mWriterError = std::current_exception();
+        }
+    });
+}
+
+
+template <typename T, typename V, typename Cmp>
+void
+ExternalMergeSort<T,V,Cmp>::join()
+{
+    if (mWriter.joinable())
+    {
+        mWriter.join();
+    }
+    if (mWriterError)
+    {
+        std::exception_ptr e = mWriterError;
+        mWriterError = std::exception_ptr();
+        std::rethrow_exception(e);
+    }
+}
+
+
+template <typename T, typename V, typename Cmp>
+void
+ExternalMergeSort<T,V,Cmp>::writeRun(std::vector<T>& pItems)
+{
+    sortRun(pItems, mParams.numThreads, mCmp);
+    std::string fn = newRunName();
+    RunPtr h(new FileFactory::TmpFileHolder(mFactory, fn));
+    {
+        FileOutWrapper<T,V> out(fn, mFactory);
+        for (uint64_t i = 0; i < pItems.size(); ++i)
+        {
+            out.push_back(pItems[i]);
+        }
+    }
+    pItems.clear();
+    addRun(h);
+}
+
+
+template <typename T, typename V, typename Cmp>
+template <typename Dest>
+void
+ExternalMergeSort<T,V,Cmp>::merge(uint64_t pBegin, uint64_t pEnd, Dest& pDest)
+{
+    std::vector<std::unique_ptr<RunReader> > readers;
+    std::vector<RunReader*> ptrs;
+    for (uint64_t i = pBegin; i < pEnd; ++i)
+    {
+        readers.push_back(std::unique_ptr<RunReader>(new RunReader(mRuns[i]->name(), mFactory)));
+        ptrs.push_back(readers.back().get());
+    }
+
+    LoserTree<RunReader,T,Cmp> tree(ptrs, mCmp);
+    T itm;
+    while (tree.valid())
+    {
+        itm = *tree;
+        pDest.push_back(itm);
+        ++tree;
+    }
+}
+
+
+template <typename T, typename V, typename Cmp>
+std::string
+ExternalMergeSort<T,V,Cmp>::newRunName()
+{
+    std::string fn;
+    if (mParams.tmpDir.empty())
+    {
+        genFileName(mBase, ++mRunNum, fn);
+    }
+    else
+    {
+        genFileName(mParams.tmpDir, mBase.substr(mBase.find_last_of('/') + 1), ++mRunNum, fn);
+    }
+    return fn;
+}
+
+
+template <typename T, typename V, typename Cmp>
+void
+ExternalMergeSort<T,V,Cmp>::addRun(const RunPtr& pRun)
+{
+    uint64_t z = mFactory.size(pRun->name());
+    mRuns.push_back(pRun);
+    mRunBytes.push_back(z);
+    mTmpBytes += z;
+    if (mParams.tmpSpace && mTmpBytes > mParams.tmpSpace)
+    {
+        BOOST_THROW_EXCEPTION(
+            Gossamer::error()
+                << Gossamer::general_error_info("external sort needs more than "
+                                                + boost::lexical_cast<std::string>(mParams.tmpSpace)
+                                                + " bytes of temporary space"));
+    }
+}
+
+
+template <typename T, typename V, typename Cmp>
+void
+ExternalMergeSort<T,V,Cmp>::removeRuns(uint64_t pBegin, uint64_t pEnd)
+{
+    for (uint64_t i = pBegin; i < pEnd; ++i)
+    {
+        mRuns[i] = RunPtr();
+        mTmpBytes -= mRunBytes[i];
+        mRunBytes[i] = 0;
+    }
+}
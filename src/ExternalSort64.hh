@@ -9,8 +9,8 @@
 #ifndef EXTERNALSORT64_HH
 #define EXTERNALSORT64_HH
 
-#ifndef EXTERNALSORTUTILS_HH
-#include "ExternalSortUtils.hh"
+#ifndef EXTERNALMERGESORT_HH
+#include "ExternalMergeSort.hh"
 #endif
 
 #ifndef FILEFACTORY_HH
@@ -28,7 +28,7 @@ public:
     template <typename SrcItr, typename DestItr>
     static void sort(SrcItr& pSrc, DestItr& pDest,
                      FileFactory& pFactory, uint64_t pBufSpace,
-                     Logger* pLogger);
+                     Logger* pLogger, uint64_t pNumThreads = 1);
 };
 
 
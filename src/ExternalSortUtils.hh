@@ -78,6 +78,11 @@ struct ExternalSortCodec
         pIn.read(reinterpret_cast<char*>(&pItem), sizeof(pItem));
         return pIn.good();
     }
+
+    static uint64_t size(const T& pItem)
+    {
+        return sizeof(pItem);
+    }
 };
 
 
@@ -9,20 +9,8 @@
 #ifndef EXTERNALVARPUSHSORTER_HH
 #define EXTERNALVARPUSHSORTER_HH
 
-#ifndef EXTERNALSORTUTILS_HH
-#include "ExternalSortUtils.hh"
-#endif
-
-#if defined(__GNUC__)
-#ifndef UNISTD_H
-#include <unistd.h>
-#define UNISTD_H
-#endif
-#endif
-
-#ifndef STD_ALGORITHM
-#include <algorithm>
-#define STD_ALGORITHM
+#ifndef EXTERNALMERGESORT_HH
+#include "ExternalMergeSort.hh"
 #endif
 
 #ifndef FILEFACTORY_HH
@@ -36,31 +24,25 @@ class ExternalVarPushSorter : public ExternalSortBase
 public:
     void push_back(const T& pItem)
     {
-        mBuf.push_back(pItem);
-        mPerm.push_back(mBuf.size() - 1);
-        if (mBuf.size() == mMaxBufItems)
-        {
-            flush();
-        }
+        mSorter.push_back(pItem);
     }
 
     template <typename Dest>
-    void sort(Dest& pDest);
+    void sort(Dest& pDest)
+    {
+        mSorter.sort(pDest);
+    }
 
-    ExternalVarPushSorter(FileFactory& pFactory, uint64_t pMaxBufItems);
+    // Runs hold up to pMaxBufItems items (as measured by V::size()).
+    ExternalVarPushSorter(FileFactory& pFactory, uint64_t pMaxBufItems, uint64_t pNumThreads = 1)
+        : mSorter(pFactory, typename Sorter::Params(2 * pMaxBufItems * sizeof(T), pNumThreads))
+    {
+    }
 
 private:
-    void flush();
+    typedef ExternalMergeSort<T,V> Sorter;
 
-    FileFactory& mFactory;
-    const std::string mBase;
-    const uint64_t mMaxBufItems;
-    std::vector<FileFactory::TmpFileHolderPtr> mFiles;
-    uint64_t mFileNum;
-    std::vector<T> mBuf;
-    std::vector<uint64_t> mPerm;
+    Sorter mSorter;
 };
 
-#include "ExternalVarPushSorter.tcc"
-
 #endif // EXTERNALVARPUSHSORTER_HH
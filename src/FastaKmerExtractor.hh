@@ -37,6 +37,10 @@
 #include "FileFactory.hh"
 #endif
 
+#ifndef KMERKERNELS_HH
+#include "KmerKernels.hh"
+#endif
+
 class FastaKmerExtractor
 {
 public:
@@ -77,27 +81,19 @@ private:
             return;
         }
 
+        auto both = [this] (uint64_t pOffset, uint64_t pKmer, uint64_t pRc) {
+            mEdges.push_back(pKmer);
+            mEdges.push_back(pRc);
+        };
         while (mCurr == mEnd && mSrc.valid())
         {
             const std::string& r(mSrc.read());
-            //std::cerr << r << std::endl;
-
             mEdges.clear();
-            for (uint64_t i = 0; i <= r.size() - mK; ++i)
+            mCodes.resize(r.size());
+            if (r.size())
             {
-                uint64_t x;
-                if (!getEdge(r, i, mK, x))
-                {
-                    continue;
-                }
-                mEdges.push_back(x);
-                uint64_t y = 0;
-                for (uint64_t j = 0; j < mK; ++j)
-                {
-                    y = (y << 2) | (3 - (x & 3));
-                    x >>= 2;
-                }
-                mEdges.push_back(y);
+                KmerKernels::encode(r.data(), r.size(), &mCodes[0]);
+                KmerKernels::roll<uint64_t>(&mCodes[0], mCodes.size(), mK, both);
             }
             mCurr = mEdges.begin();
             mEnd = mEdges.end();
@@ -105,51 +101,10 @@ private:
         }
     }
 
-    static bool getEdge(const std::string& pStr, uint64_t pOff, uint64_t pLen,
-                        uint64_t& pRes)
-    {
-        uint64_t x = 0;
-        for (uint64_t i = pOff; i < pOff + pLen; ++i)
-        {
-            switch (pStr[i])
-            {
-                case 'A':
-                case 'a':
-                {
-                    x = (x << 2) | 0UL;
-                    break;
-                }
-                case 'C':
-                case 'c':
-                {
-                    x = (x << 2) | 1UL;
-                    break;
-                }
-                case 'G':
-                case 'g':
-                {
-                    x = (x << 2) | 2UL;
-                    break;
-                }
-                case 'T':
-                case 't':
-                {
-                    x = (x << 2) | 3UL;
-                    break;
-                }
-                default:
-                {
-                    return false;
-                }
-            }
-        }
-        pRes = x;
-        return true;
-    }
-
     const uint64_t mK;
     FileFactory::InHolderPtr mIn;
     FastaParser mSrc;
+    std::vector<uint8_t> mCodes;
     std::vector<uint64_t> mEdges;
     std::vector<uint64_t>::const_iterator mCurr;
     std::vector<uint64_t>::const_iterator mEnd;
@@ -56,7 +56,7 @@ public:
             return;
         }
         
-        const std::string& line(*mSrc);
+        LineSource::Range line(mSrc.range());
         if (!(line.size() > 0 && line[0] == '>'))
         {
             mValid = false;
@@ -67,7 +67,7 @@ public:
                                                   boost::lexical_cast<std::string>(mLineNum)));
         }
         
-        mLabel = std::string(line.begin() + 1, line.end());
+        mLabel.assign(line.begin() + 1, line.end());
         mSequence.clear();
         while (true)
         {
@@ -77,12 +77,12 @@ public:
             {
                 break;
             }
-            const std::string& line(*mSrc);
+            LineSource::Range line(mSrc.range());
             if (line.size() > 0 && line[0] == '>')
             {
                 break;
             }
-            mSequence += line;
+            mSequence.append(line.begin(), line.end());
         }
     }
 
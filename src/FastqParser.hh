@@ -59,19 +59,15 @@ public:
         return mRead;
     }
 
-    static void getLine( const LineSource& pSrc, std::string& pDst )
+    static LineSource::Range getLine( const LineSource& pSrc )
     {
-        const std::string& line = *pSrc;
+        LineSource::Range line(pSrc.range());
         // for windows where new line is \r\n
-        const unsigned int l = line.length();
-        if( l > 0 && line.at( l - 1 ) == '\r' )
+        if (line.size() > 0 && line[line.size() - 1] == '\r')
         {
-            pDst = line.substr( 0, l - 1 );
-        }
-        else
-        {
-            pDst = line;
+            return LineSource::Range(line.begin(), line.end() - 1);
         }
+        return line;
     }
 
 
@@ -83,8 +79,7 @@ public:
             return;
         }
 
-        std::string line;
-        getLine( mSrc, line );
+        LineSource::Range line(getLine(mSrc));
 
         if (!(line.size() > 0 && line[0] == '@'))
         {
@@ -96,7 +91,7 @@ public:
                                                   boost::lexical_cast<std::string>(mLineNum)));
         }
         
-        mLabel = std::string(line.begin() + 1, line.end());
+        mLabel.assign(line.begin() + 1, line.end());
         mSequence.clear();
         while (true)
         {
@@ -111,12 +106,12 @@ public:
                                                   boost::lexical_cast<std::string>(mLineNum)));
 
             }
-            getLine( mSrc, line );
+            line = getLine(mSrc);
             if (line.size() > 0 && (line[0] == '@' || line[0] == '+'))
             {
                 break;
             }
-            mSequence += line;
+            mSequence.append(line.begin(), line.end());
         }
 
         if (!(line.size() > 0 && line[0] == '+'))
@@ -129,7 +124,7 @@ public:
                                                   boost::lexical_cast<std::string>(mLineNum)));
         }
 
-        mQLabel = std::string(line.begin() + 1, line.end());
+        mQLabel.assign(line.begin() + 1, line.end());
         if (mQLabel.size() > 0 && mQLabel != mLabel)
         { 
             mValid = false;
@@ -149,7 +144,7 @@ public:
             {
                 break;
             }
-            getLine( mSrc, line );
+            line = getLine(mSrc);
             if (line.size() > 0 && (line[0] == '@' || line[0] == '+'))
             {
                 // The '@' symbol may be present in Sanger-format
@@ -162,7 +157,7 @@ public:
                     break;
                 }
             }
-            mQual += line;
+            mQual.append(line.begin(), line.end());
         }
 
         if (mSequence.size() != mQual.size())
@@ -367,7 +367,7 @@ GossCmdAnnotateKmers::operator()(const GossCmdContext& pCxt)
     }
 
     GossReadParserFactory fastaParserFac(FastaParser::create);
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     GossReadSequenceBasesFactory seqFac;
 
     for (map<string,uint32_t>::const_iterator i = ins.begin(); i != ins.end(); ++i)
@@ -594,10 +594,10 @@ GossCmdBuildDb::storeReadLinks(const GossCmdContext& pCxt, const Graph& pG, cons
 
     const EntryEdgeSet& entries(pSg.entries());
     map<int64_t,uint64_t> dist;
-    ExternalBufferSort sorter(1024ULL * 1024ULL * 1024ULL, fac);
-    log(info, "constructing edge index");
+    ExternalBufferSort sorter(1024ULL * 1024ULL * 1024ULL, fac, mNumThreads);
+    log(info, "opening edge index");
 
-    auto idxPtr = EdgeIndex::create(pG, entries, pSg, mCacheRate, mNumThreads, log);
+    auto idxPtr = EdgeIndex::open(mIn, fac, pG, entries, pSg, mCacheRate, mNumThreads, log);
     EdgeIndex& idx(*idxPtr);
     const PairAligner alnr(pG, entries, idx);
 
@@ -627,7 +627,7 @@ GossCmdBuildDb::storeReadLinks(const GossCmdContext& pCxt, const Graph& pG, cons
     }
 
     UnboundedProgressMonitor umon(log, 100000, " read pairs");
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     ReadPairSequenceFileSequence reads(items, fac, lineSrcFac, &umon, &log);
 
     log(info, "mapping pairs.");
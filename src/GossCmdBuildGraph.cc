@@ -10,6 +10,7 @@
 
 #include "AsyncMerge.hh"
 #include "LineSource.hh"
+#include "BackgroundConsumer.hh"
 #include "BackgroundMultiConsumer.hh"
 #include "BackyardHash.hh"
 #include "Debug.hh"
@@ -26,13 +27,17 @@
 #include "Graph.hh"
 #include "LineParser.hh"
 #include "Logger.hh"
+#include "PerfReport.hh"
 #include "Profile.hh"
 #include "ReadSequenceFileSequence.hh"
 #include "ReverseComplementAdapter.hh"
 #include "Timer.hh"
 #include "VByteCodec.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <queue>
 #include <stdexcept>
 #include <boost/lexical_cast.hpp>
 
@@ -265,6 +270,720 @@ namespace // anonymous
         }
     }
 
+    // Sort several hash tables, returning the total number of items.
+    uint64_t sortTables(const vector<const BackyardHash*>& pTables,
+                        vector<vector<uint32_t> >& pPerms, uint64_t pNumThreads)
+    {
+        uint64_t n = 0;
+        pPerms.resize(pTables.size());
+        for (uint64_t i = 0; i < pTables.size(); ++i)
+        {
+            pTables[i]->sort(pPerms[i], pNumThreads);
+            n += pPerms[i].size();
+        }
+        return n;
+    }
+
+    // Merge the contents of several sorted hash tables into a single
+    // sorted sequence of edges and counts, returning the number of
+    // distinct edges.
+    template <typename Builder>
+    uint64_t mergeTables(const vector<const BackyardHash*>& pTables,
+                         const vector<vector<uint32_t> >& pPerms, Builder& pBld)
+    {
+        vector<uint64_t> pos(pTables.size(), 0);
+        auto head = [&] (uint64_t pTbl) {
+            return (*pTables[pTbl])[pPerms[pTbl][pos[pTbl]]];
+        };
+        auto greater = [&] (uint64_t pLhs, uint64_t pRhs) {
+            return head(pRhs).first < head(pLhs).first;
+        };
+        priority_queue<uint64_t,vector<uint64_t>,decltype(greater)> heap(greater);
+        for (uint64_t i = 0; i < pTables.size(); ++i)
+        {
+            if (pPerms[i].size() > 0)
+            {
+                heap.push(i);
+            }
+        }
+        if (heap.empty())
+        {
+            return 0;
+        }
+
+        // As in flushNaked, allow for duplicates.
+        uint64_t n = 0;
+        pair<Gossamer::edge_type,uint64_t> prev = head(heap.top());
+        prev.second = 0;
+        while (!heap.empty())
+        {
+            uint64_t t = heap.top();
+            heap.pop();
+            pair<Gossamer::edge_type,uint64_t> itm = head(t);
+            if (++pos[t] < pPerms[t].size())
+            {
+                heap.push(t);
+            }
+            if (itm.first == prev.first)
+            {
+                prev.second += itm.second;
+                continue;
+            }
+            pBld.push_back(prev.first, prev.second);
+            ++n;
+            prev = itm;
+        }
+        pBld.push_back(prev.first, prev.second);
+        ++n;
+        return n;
+    }
+
+    // Sorts and dumps full hash tables as temporary naked graphs in the
+    // background, returning each table to its owner's free queue when
+    // done with it.
+    class PartitionFlusher
+    {
+    public:
+        void flush(BackyardHash* pHash, BoundedQueue<BackyardHash*>& pFree)
+        {
+            mJobs.put(Job(pHash, &pFree));
+        }
+
+        void end()
+        {
+            mJobs.finish();
+            mThreads.join();
+            mJoined = true;
+            if (mError)
+            {
+                std::rethrow_exception(mError);
+            }
+        }
+
+        std::string nextName()
+        {
+            unique_lock<mutex> lk(mMutex);
+            return mTmp + "-" + lexical_cast<string>(mNextPart++);
+        }
+
+        const vector<string>& parts() const
+        {
+            return mParts;
+        }
+
+        const vector<uint64_t>& sizes() const
+        {
+            return mSizes;
+        }
+
+        PartitionFlusher(const string& pTmp, uint64_t pNumThreads, FileFactory& pFactory)
+            : mTmp(pTmp), mFactory(pFactory), mJobs(pNumThreads), mJoined(false), mNextPart(0)
+        {
+            for (uint64_t i = 0; i < pNumThreads; ++i)
+            {
+                mThreads.create([this] () { run(); });
+            }
+        }
+
+        ~PartitionFlusher()
+        {
+            if (!mJoined)
+            {
+                mJobs.finish();
+                mThreads.join();
+            }
+        }
+
+    private:
+        typedef std::pair<BackyardHash*,BoundedQueue<BackyardHash*>*> Job;
+
+        void run()
+        {
+            Job j;
+            while (mJobs.get(j))
+            {
+                try
+                {
+                    string nm = nextName();
+                    vector<const BackyardHash*> tbls(1, j.first);
+                    vector<vector<uint32_t> > perms;
+                    sortTables(tbls, perms, 1);
+                    NakedGraph::Builder bld(nm, mFactory);
+                    uint64_t z = mergeTables(tbls, perms, bld);
+                    bld.end();
+
+                    unique_lock<mutex> lk(mMutex);
+                    mParts.push_back(nm);
+                    mSizes.push_back(z);
+                }
+                catch (...)
+                {
+                    unique_lock<mutex> lk(mMutex);
+                    if (!mError)
+                    {
+                        mError = std::current_exception();
+                    }
+                }
+                j.first->clear();
+                j.second->put(j.first);
+            }
+        }
+
+        const string mTmp;
+        FileFactory& mFactory;
+        BoundedQueue<Job> mJobs;
+        ThreadGroup mThreads;
+        bool mJoined;
+        mutex mMutex;
+        uint64_t mNextPart;
+        vector<string> mParts;
+        vector<uint64_t> mSizes;
+        std::exception_ptr mError;
+    };
+
+    // Inserts the rho-mers of one partition into a pair of hash tables
+    // which no other thread touches. When the table being filled
+    // spills, it is handed to the flusher, and filling carries on in
+    // the other table.
+    class PartitionConsumer
+    {
+    public:
+        typedef KmerBlockPtr value_type;
+
+        void push_back(const KmerBlockPtr& pBlk)
+        {
+            Profile::Context pc("PartitionConsumer::push_back");
+            const KmerBlock& blk(*pBlk);
+            for (uint64_t i = 0; i < blk.size(); ++i)
+            {
+                mCurr->insertExclusive(blk[i]);
+            }
+            if (mCurr->spills() > 0)
+            {
+                mFlusher.flush(mCurr, mFree);
+                mFree.get(mCurr);
+            }
+        }
+
+        const BackyardHash& current() const
+        {
+            return *mCurr;
+        }
+
+        PartitionConsumer(BackyardHash& pFirst, BackyardHash& pSecond, PartitionFlusher& pFlusher)
+            : mCurr(&pFirst), mFree(2), mFlusher(pFlusher)
+        {
+            mFree.put(&pSecond);
+        }
+
+    private:
+        BackyardHash* mCurr;
+        BoundedQueue<BackyardHash*> mFree;
+        PartitionFlusher& mFlusher;
+    };
+
+    // Mix every word of the rho-mer, so that for k > 32 the bases in
+    // the high words spread the rho-mers between partitions too.
+    uint64_t partition(const Gossamer::edge_type& pRhomer, uint64_t pNumParts)
+    {
+        uint64_t h = 0;
+        std::pair<const uint64_t*,const uint64_t*> ws = pRhomer.words();
+        for (const uint64_t* w = ws.first; w != ws.second; ++w)
+        {
+            h = (h ^ *w) * 0x9e3779b97f4a7c13ULL;
+        }
+        return (h >> 32) % pNumParts;
+    }
+
+    // Accumulate the rho-mers in a single hash table shared by all the
+    // consumer threads, stopping to dump it when it spills.
+    template <typename Src>
+    void buildShared(Src& pRhomers, uint64_t pK, uint64_t pS, uint64_t pN, uint64_t pT,
+                     const string& pGraphName, Logger& pLog, FileFactory& pFactory)
+    {
+        BackyardHash h(pS, 2 * (pK + 1), pN);
+        BackyardConsumer bc(h);
+
+        BackgroundMultiConsumer<KmerBlockPtr> bg(4096);
+        for (uint64_t i = 0; i < pT; ++i)
+        {
+            bg.add(bc);
+        }
+
+        KmerBlockPtr blk(new KmerBlock);
+        blk->reserve(blkSz);
+        uint64_t n = 0;
+        uint64_t nSinceClear = 0;
+        uint64_t j = 0;
+        uint64_t prevLoad = 0;
+        const uint64_t m = (1 << (pS / 2)) - 1;
+        uint64_t z = 0;
+        vector<string> parts;
+        vector<uint64_t> sizes;
+        string tmp = pFactory.tmpName();
+        while (pRhomers.valid())
+        {
+            blk->push_back(*pRhomers);
+            if (blk->size() == blkSz)
+            {
+                Profile::Context pc("GossCmdBuildGraph::push-block");
+                bg.push_back(blk);
+                blk = KmerBlockPtr(new KmerBlock);
+                blk->reserve(blkSz);
+                ++nSinceClear;
+                if ((++n & m) == 0)
+                {
+                    uint64_t cap = h.capacity();
+                    uint64_t spl = h.spills();
+                    uint64_t sz = h.size();
+                    double ld = static_cast<double>(sz) / static_cast<double>(cap);
+                    uint64_t l = 200 * ld;
+                    if (l != prevLoad)
+                    {
+                        pLog(info, "processed " + lexical_cast<string>(n * blkSz) + " individual rho-mers.");
+                        pLog(info, "hash table load is " + lexical_cast<string>(ld));
+                        pLog(info, "number of spills is " + lexical_cast<string>(spl));
+                        pLog(info, "the average rho-mer frequency is " + lexical_cast<string>(1.0 * (nSinceClear * blkSz) / sz));
+                        prevLoad = l;
+                    }
+                    if (spl > 0)
+                    {
+                        PerfReport::Phase phase("dump temporary graph");
+                        bg.sync(pT);
+                        uint64_t cap = h.capacity();
+                        uint64_t sz = h.size();
+                        double ld = static_cast<double>(sz) / static_cast<double>(cap);
+                        pLog(info, "hash table load at dumping is " + lexical_cast<string>(ld));
+                        string nm = tmp + "-" + lexical_cast<string>(j++);
+                        pLog(info, "dumping temporary graph " + nm);
+                        uint64_t z0 = flushNaked(h, nm, pT, pLog, pFactory);
+                        z += z0;
+                        parts.push_back(nm);
+                        sizes.push_back(z0);
+                        h.clear();
+                        nSinceClear = 0;
+                        pLog(info, "done.");
+                    }
+                }
+            }
+            ++pRhomers;
+        }
+        if (blk->size() > 0)
+        {
+            bg.push_back(blk);
+            blk = KmerBlockPtr();
+        }
+        bg.wait();
+
+        if (parts.size() == 0)
+        {
+            PerfReport::Phase phase("write graph");
+            pLog(info, "writing out graph (no merging necessary).");
+            flush(h, pK, pGraphName, pT, pLog, pFactory);
+        }
+        else
+        {
+            if (h.size() > 0)
+            {
+                PerfReport::Phase phase("dump temporary graph");
+                string nm = tmp + "-" + lexical_cast<string>(j++);
+                pLog(info, "dumping temporary graph " + nm);
+                uint64_t z0 = flushNaked(h, nm, pT, pLog, pFactory);
+                z += z0;
+                parts.push_back(nm);
+                sizes.push_back(z0);
+                h.clear();
+                pLog(info, "done.");
+            }
+        
+            PerfReport::Phase phase("merge temporary graphs");
+            pLog(info, "merging temporary graphs");
+            pLog(info, "estimated number of edges " + lexical_cast<string>(z));
+
+            AsyncMerge::merge<Graph>(parts, sizes, pGraphName, pK, z, pT, 65536, pFactory);
+
+            for (uint64_t i = 0; i < parts.size(); ++i)
+            {
+                pFactory.remove(parts[i]);
+            }
+        }
+    }
+
+    // Accumulate the rho-mers in hash tables partitioned between the
+    // consumer threads. Each partition has two tables, so that a full
+    // table can be dumped while the other one is filled.
+    template <typename Src>
+    void buildPartitioned(Src& pRhomers, uint64_t pK, uint64_t pS, uint64_t pN, uint64_t pT,
+                          const string& pGraphName, Logger& pLog, FileFactory& pFactory)
+    {
+        const uint64_t P = std::max<uint64_t>(1, pT);
+        const uint64_t N = std::max<uint64_t>(pN / (2 * P), 1024);
+        const uint64_t S = std::min<uint64_t>(pS, log2((double)N));
+        pLog(info, "using " + lexical_cast<string>(P) + " partitions of "
+                    + lexical_cast<string>(S) + " slot bits.");
+
+        std::vector<std::shared_ptr<BackyardHash> > tables;
+        for (uint64_t i = 0; i < 2 * P; ++i)
+        {
+            tables.push_back(std::make_shared<BackyardHash>(S, 2 * (pK + 1), N));
+        }
+
+        PartitionFlusher flusher(pFactory.tmpName(), P, pFactory);
+        std::vector<std::shared_ptr<PartitionConsumer> > conss;
+        std::vector<std::shared_ptr<BackgroundConsumer<PartitionConsumer> > > bgs;
+        std::vector<KmerBlockPtr> blks;
+        for (uint64_t i = 0; i < P; ++i)
+        {
+            conss.push_back(std::make_shared<PartitionConsumer>(*tables[2 * i], *tables[2 * i + 1], flusher));
+            bgs.push_back(std::make_shared<BackgroundConsumer<PartitionConsumer> >(*conss[i], 64));
+            blks.push_back(std::make_shared<KmerBlock>());
+            blks.back()->reserve(blkSz);
+        }
+
+        while (pRhomers.valid())
+        {
+            const Gossamer::edge_type& e(*pRhomers);
+            uint64_t p = partition(e, P);
+            blks[p]->push_back(e);
+            if (blks[p]->size() == blkSz)
+            {
+                Profile::Context pc("GossCmdBuildGraph::push-block");
+                bgs[p]->push_back(blks[p]);
+                blks[p] = std::make_shared<KmerBlock>();
+                blks[p]->reserve(blkSz);
+            }
+            ++pRhomers;
+        }
+        for (uint64_t i = 0; i < P; ++i)
+        {
+            if (blks[i]->size() > 0)
+            {
+                bgs[i]->push_back(blks[i]);
+            }
+            bgs[i]->wait();
+        }
+        flusher.end();
+
+        vector<const BackyardHash*> rest;
+        for (uint64_t i = 0; i < P; ++i)
+        {
+            if (conss[i]->current().size() > 0)
+            {
+                rest.push_back(&conss[i]->current());
+            }
+        }
+        vector<vector<uint32_t> > perms;
+        uint64_t n = sortTables(rest, perms, pT);
+
+        vector<string> parts(flusher.parts());
+        vector<uint64_t> sizes(flusher.sizes());
+        if (parts.size() == 0)
+        {
+            pLog(info, "writing out graph (no merging necessary).");
+            pLog(info, "estimated number of edges is " + lexical_cast<string>(n));
+            try
+            {
+                Graph::Builder bld(pK, pGraphName, pFactory, n);
+                mergeTables(rest, perms, bld);
+                bld.end();
+            }
+            catch (ios_base::failure& e)
+            {
+                BOOST_THROW_EXCEPTION(Gossamer::error()
+                    << Gossamer::write_error_info(pGraphName));
+            }
+            return;
+        }
+
+        if (n > 0)
+        {
+            string nm = flusher.nextName();
+            pLog(info, "dumping temporary graph " + nm);
+            NakedGraph::Builder bld(nm, pFactory);
+            sizes.push_back(mergeTables(rest, perms, bld));
+            bld.end();
+            parts.push_back(nm);
+        }
+        uint64_t z = 0;
+        for (uint64_t i = 0; i < sizes.size(); ++i)
+        {
+            z += sizes[i];
+        }
+
+        pLog(info, "merging " + lexical_cast<string>(parts.size()) + " temporary graphs");
+        pLog(info, "estimated number of edges " + lexical_cast<string>(z));
+
+        AsyncMerge::merge<Graph>(parts, sizes, pGraphName, pK, z, pT, 65536, pFactory);
+
+        for (uint64_t i = 0; i < parts.size(); ++i)
+        {
+            pFactory.remove(parts[i]);
+        }
+    }
+
+    // The most buckets --disk-buckets may ask for. Every bucket is
+    // open for writing at once, so this also bounds the open files.
+    const uint64_t maxDiskBuckets = 1ULL << 12;
+
+    // Appends rho-mers to a bucket file, as the raw words
+    // needed to hold them.
+    class BucketWriter
+    {
+    public:
+        void push_back(const Gossamer::edge_type& pRhomer)
+        {
+            Gossamer::edge_type::value_type v = pRhomer.value();
+            std::pair<const uint64_t*,const uint64_t*> ws = v.words();
+            mBuf.insert(mBuf.end(), ws.first, ws.first + mWords);
+            if (mBuf.size() >= mBufWords)
+            {
+                flush();
+            }
+            ++mCount;
+        }
+
+        void end()
+        {
+            flush();
+            mOutHolder = FileFactory::OutHolderPtr();
+        }
+
+        uint64_t count() const
+        {
+            return mCount;
+        }
+
+        BucketWriter(const std::string& pFileName, uint64_t pWords, uint64_t pBufWords,
+                     FileFactory& pFactory)
+            : mFileName(pFileName), mOutHolder(pFactory.out(pFileName)), mWords(pWords),
+              mBufWords(pBufWords), mCount(0)
+        {
+            mBuf.reserve(mBufWords + mWords);
+        }
+
+    private:
+        void flush()
+        {
+            try
+            {
+                (**mOutHolder).write(reinterpret_cast<const char*>(mBuf.data()),
+                                     mBuf.size() * sizeof(uint64_t));
+            }
+            catch (ios_base::failure& e)
+            {
+                BOOST_THROW_EXCEPTION(Gossamer::error()
+                    << Gossamer::write_error_info(mFileName));
+            }
+            mBuf.clear();
+        }
+
+        const std::string mFileName;
+        FileFactory::OutHolderPtr mOutHolder;
+        const uint64_t mWords;
+        const uint64_t mBufWords;
+        uint64_t mCount;
+        std::vector<uint64_t> mBuf;
+    };
+
+    // Read, sort and count the rho-mers in a bucket, writing them out
+    // as a naked graph. Returns the number of distinct rho-mers.
+    uint64_t countBucket(const string& pBucketName, uint64_t pNumItems, uint64_t pWords,
+                         const string& pGraphName, FileFactory& pFactory)
+    {
+        vector<Gossamer::edge_type> items;
+        items.reserve(pNumItems);
+        {
+            FileFactory::InHolderPtr inp(pFactory.in(pBucketName));
+            istream& in(**inp);
+            vector<uint64_t> buf(pWords * 4096);
+            while (items.size() < pNumItems)
+            {
+                uint64_t n = std::min<uint64_t>(4096, pNumItems - items.size());
+                in.read(reinterpret_cast<char*>(buf.data()), n * pWords * sizeof(uint64_t));
+                if (static_cast<uint64_t>(in.gcount()) != n * pWords * sizeof(uint64_t))
+                {
+                    BOOST_THROW_EXCEPTION(Gossamer::error()
+                        << Gossamer::general_error_info("unexpected end of file")
+                        << boost::errinfo_file_name(pBucketName));
+                }
+                for (uint64_t i = 0; i < n; ++i)
+                {
+                    Gossamer::edge_type::value_type v(0);
+                    std::copy(&buf[i * pWords], &buf[(i + 1) * pWords], v.words().first);
+                    items.push_back(Gossamer::edge_type(v));
+                }
+            }
+        }
+        pFactory.remove(pBucketName);
+
+        std::sort(items.begin(), items.end());
+
+        uint64_t n = 0;
+        try
+        {
+            NakedGraph::Builder bld(pGraphName, pFactory);
+            for (uint64_t i = 0; i < items.size();)
+            {
+                uint64_t j = i + 1;
+                while (j < items.size() && items[j] == items[i])
+                {
+                    ++j;
+                }
+                bld.push_back(items[i], j - i);
+                ++n;
+                i = j;
+            }
+            bld.end();
+        }
+        catch (ios_base::failure& e)
+        {
+            BOOST_THROW_EXCEPTION(Gossamer::error()
+                << Gossamer::write_error_info(pGraphName));
+        }
+        return n;
+    }
+
+    // Partition the rho-mers on disk by their high order bits, so that
+    // each bucket holds a contiguous range of them. Then sort and count
+    // the buckets in parallel, with as many in memory at once as the
+    // buffer allows, and concatenate them into the graph in order.
+    //
+    // While partitioning, the write buffers of all the buckets together
+    // take at most an eighth of the buffer.
+    template <typename Src>
+    void buildBucketed(Src& pRhomers, uint64_t pK, uint64_t pNumBuckets, uint64_t pBufferSize,
+                       uint64_t pT, const string& pGraphName, Logger& pLog, FileFactory& pFactory)
+    {
+        const uint64_t rhoBits = 2 * (pK + 1);
+        const uint64_t words = (rhoBits + 63) / 64;
+        uint64_t bits = 0;
+        while ((1ULL << bits) < std::min(pNumBuckets, maxDiskBuckets) && bits < rhoBits)
+        {
+            ++bits;
+        }
+        const uint64_t B = 1ULL << bits;
+        const uint64_t shift = rhoBits - bits;
+
+        const uint64_t files = Gossamer::openFileLimit(B + 64);
+        if (files < B + 64)
+        {
+            BOOST_THROW_EXCEPTION(Gossamer::error()
+                << Gossamer::general_error_info(
+                    "partitioning into " + lexical_cast<string>(B) + " buckets needs "
+                    + lexical_cast<string>(B + 64) + " open files, but only "
+                    + lexical_cast<string>(files) + " are allowed. Use fewer buckets."));
+        }
+
+        const uint64_t bufWords
+            = std::max(words, std::min<uint64_t>(1ULL << 16, pBufferSize / 8 / B / sizeof(uint64_t)));
+        pLog(info, "partitioning rho-mers into " + lexical_cast<string>(B) + " buckets, with "
+                    + lexical_cast<string>(bufWords * sizeof(uint64_t)) + " byte write buffers.");
+
+        const string tmp = pFactory.tmpName();
+        vector<string> buckets;
+        vector<string> counted;
+        vector<uint64_t> sizes(B, 0);
+        {
+            vector<std::shared_ptr<BucketWriter> > writers;
+            for (uint64_t i = 0; i < B; ++i)
+            {
+                buckets.push_back(tmp + "-bucket-" + lexical_cast<string>(i));
+                counted.push_back(tmp + "-counted-" + lexical_cast<string>(i));
+                writers.push_back(std::make_shared<BucketWriter>(buckets.back(), words, bufWords, pFactory));
+            }
+            while (pRhomers.valid())
+            {
+                const Gossamer::edge_type& e(*pRhomers);
+                Gossamer::edge_type::value_type v = e.value();
+                v >>= shift;
+                writers[v.asUInt64()]->push_back(e);
+                ++pRhomers;
+            }
+            for (uint64_t i = 0; i < B; ++i)
+            {
+                writers[i]->end();
+                sizes[i] = writers[i]->count();
+            }
+        }
+
+        // Loading a bucket takes the rho-mers themselves, plus the read buffer.
+        const uint64_t largest = *std::max_element(sizes.begin(), sizes.end());
+        const uint64_t bytes = largest * sizeof(Gossamer::edge_type) + 4096 * words * sizeof(uint64_t);
+        uint64_t T = std::max<uint64_t>(1, std::min<uint64_t>(pT, pBufferSize / bytes));
+        if (bytes > pBufferSize)
+        {
+            pLog(warning, "the largest bucket needs " + lexical_cast<string>(bytes)
+                            + " bytes, which exceeds the buffer size. Consider using more buckets.");
+        }
+        pLog(info, "counting buckets using " + lexical_cast<string>(T) + " threads.");
+
+        vector<uint64_t> distinct(B, 0);
+        std::atomic<uint64_t> next(0);
+        std::exception_ptr err;
+        mutex errMutex;
+        {
+            ThreadGroup threads;
+            for (uint64_t t = 0; t < T; ++t)
+            {
+                threads.create([&] () {
+                    for (uint64_t i = next++; i < B; i = next++)
+                    {
+                        try
+                        {
+                            distinct[i] = countBucket(buckets[i], sizes[i], words, counted[i], pFactory);
+                        }
+                        catch (...)
+                        {
+                            unique_lock<mutex> lk(errMutex);
+                            if (!err)
+                            {
+                                err = std::current_exception();
+                            }
+                            next = B;
+                        }
+                    }
+                });
+            }
+            threads.join();
+        }
+        if (err)
+        {
+            std::rethrow_exception(err);
+        }
+
+        uint64_t z = 0;
+        for (uint64_t i = 0; i < B; ++i)
+        {
+            z += distinct[i];
+        }
+        pLog(info, "writing out graph with " + lexical_cast<string>(z) + " edges.");
+
+        try
+        {
+            Graph::Builder bld(pK, pGraphName, pFactory, z);
+            for (uint64_t i = 0; i < B; ++i)
+            {
+                {
+                    FileFactory::InHolderPtr inp(pFactory.in(counted[i]));
+                    istream& in(**inp);
+                    Gossamer::EdgeAndCount itm(Gossamer::position_type(0), 0);
+                    for (uint64_t j = 0; j < distinct[i]; ++j)
+                    {
+                        EdgeAndCountCodec::decode(in, itm);
+                        bld.push_back(itm.first, itm.second);
+                    }
+                }
+                pFactory.remove(counted[i]);
+            }
+            bld.end();
+        }
+        catch (ios_base::failure& e)
+        {
+            BOOST_THROW_EXCEPTION(Gossamer::error()
+                << Gossamer::write_error_info(pGraphName));
+        }
+    }
+
 } // namespace anonymous
 
 void
@@ -301,7 +1020,7 @@ GossCmdBuildGraph::operator()(const GossCmdContext& pCxt)
     }
 
     UnboundedProgressMonitor umon(log, 100000, " reads");
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     ReadSequenceFileSequence reads(items, fac, lineSrcFac, &umon, &log);
 
     ReverseComplementAdapter x(reads, rho);
@@ -312,107 +1031,18 @@ GossCmdBuildGraph::operator()(const GossCmdContext& pCxt)
     log(info, "using " + lexical_cast<string>(mS) + " slot bits.");
     log(info, "using " + lexical_cast<string>(log2((double)mN)) + " table bits.");
 
-    BackyardHash h(mS, 2 * rho, mN);
-    BackyardConsumer bc(h);
-
-    BackgroundMultiConsumer<KmerBlockPtr> bg(4096);
-    for (uint64_t i = 0; i < mT; ++i)
+    if (mDiskBuckets)
     {
-        bg.add(bc);
+        const uint64_t bufferSize = mN * (1.5 * sizeof(uint32_t) + sizeof(BackyardHash::value_type));
+        buildBucketed(x, mK, mDiskBuckets, bufferSize, mT, mGraphName, log, fac);
     }
-
-    KmerBlockPtr blk(new KmerBlock);
-    blk->reserve(blkSz);
-    uint64_t n = 0;
-    uint64_t nSinceClear = 0;
-    uint64_t j = 0;
-    uint64_t prevLoad = 0;
-    const uint64_t m = (1 << (mS / 2)) - 1;
-    uint64_t z = 0;
-    vector<string> parts;
-    vector<uint64_t> sizes;
-    string tmp = fac.tmpName();
-    while (x.valid())
+    else if (mPartitioned)
     {
-        blk->push_back(*x);
-        if (blk->size() == blkSz)
-        {
-            Profile::Context pc("GossCmdBuildGraph::push-block");
-            bg.push_back(blk);
-            blk = KmerBlockPtr(new KmerBlock);
-            blk->reserve(blkSz);
-            ++nSinceClear;
-            if ((++n & m) == 0)
-            {
-                uint64_t cap = h.capacity();
-                uint64_t spl = h.spills();
-                uint64_t sz = h.size();
-                double ld = static_cast<double>(sz) / static_cast<double>(cap);
-                uint64_t l = 200 * ld;
-                if (l != prevLoad)
-                {
-                    log(info, "processed " + lexical_cast<string>(n * blkSz) + " individual rho-mers.");
-                    log(info, "hash table load is " + lexical_cast<string>(ld));
-                    log(info, "number of spills is " + lexical_cast<string>(spl));
-                    log(info, "the average rho-mer frequency is " + lexical_cast<string>(1.0 * (nSinceClear * blkSz) / sz));
-                    prevLoad = l;
-                }
-                if (spl > 0)
-                {
-                    bg.sync(mT);
-                    uint64_t cap = h.capacity();
-                    uint64_t sz = h.size();
-                    double ld = static_cast<double>(sz) / static_cast<double>(cap);
-                    log(info, "hash table load at dumping is " + lexical_cast<string>(ld));
-                    string nm = tmp + "-" + lexical_cast<string>(j++);
-                    log(info, "dumping temporary graph " + nm);
-                    uint64_t z0 = flushNaked(h, nm, mT, log, fac);
-                    z += z0;
-                    parts.push_back(nm);
-                    sizes.push_back(z0);
-                    h.clear();
-                    nSinceClear = 0;
-                    log(info, "done.");
-                }
-            }
-        }
-        ++x;
-    }
-    if (blk->size() > 0)
-    {
-        bg.push_back(blk);
-        blk = KmerBlockPtr();
-    }
-    bg.wait();
-
-    if (parts.size() == 0)
-    {
-        log(info, "writing out graph (no merging necessary).");
-        flush(h, mK, mGraphName, mT, log, fac);
+        buildPartitioned(x, mK, mS, mN, mT, mGraphName, log, fac);
     }
     else
     {
-        if (h.size() > 0)
-        {
-            string nm = tmp + "-" + lexical_cast<string>(j++);
-            log(info, "dumping temporary graph " + nm);
-            uint64_t z0 = flushNaked(h, nm, mT, log, fac);
-            z += z0;
-            parts.push_back(nm);
-            sizes.push_back(z0);
-            h.clear();
-            log(info, "done.");
-        }
-        
-        log(info, "merging temporary graphs");
-        log(info, "estimated number of edges " + lexical_cast<string>(z));
-
-        AsyncMerge::merge<Graph>(parts, sizes, mGraphName, mK, z, mT, 65536, fac);
-
-        for (uint64_t i = 0; i < parts.size(); ++i)
-        {
-            fac.remove(parts[i]);
-        }
+        buildShared(x, mK, mS, mN, mT, mGraphName, log, fac);
     }
 
     log(info, "finish graph build");
@@ -449,6 +1079,13 @@ GossCmdFactoryBuildGraph::create(App& pApp, const variables_map& pOpts)
     uint64_t T = 4;
     chk.getOptional("num-threads", T);
 
+    bool partitioned = false;
+    chk.getOptional("partitioned-hash", partitioned);
+
+    uint64_t D = 0;
+    chk.getOptional("disk-buckets", D, GossOptionChecker::RangeCheck(maxDiskBuckets));
+    chk.exclusive("partitioned-hash", "disk-buckets");
+
     FileFactory& fac(pApp.fileFactory());
     GossOptionChecker::FileCreateCheck createChk(fac, true);
     GossOptionChecker::FileReadCheck readChk(fac);
@@ -473,7 +1110,8 @@ GossCmdFactoryBuildGraph::create(App& pApp, const variables_map& pOpts)
 
     chk.throwIfNecessary(pApp);
 
-    return GossCmdPtr(new GossCmdBuildGraph(K, S, N, T, graphName, fastaNames, fastqNames, lineNames));
+    return GossCmdPtr(new GossCmdBuildGraph(K, S, N, T, graphName, fastaNames, fastqNames, lineNames,
+                                            partitioned, D));
 }
 
 GossCmdFactoryBuildGraph::GossCmdFactoryBuildGraph()
@@ -487,4 +1125,10 @@ GossCmdFactoryBuildGraph::GossCmdFactoryBuildGraph()
     mCommonOptions.insert("line-in");
     mCommonOptions.insert("fastas-in");
     mCommonOptions.insert("fastqs-in");
+
+    mSpecificOptions.addOpt<bool>("partitioned-hash", "",
+            "give each thread its own partition of the hash table, and dump full tables in the background");
+    mSpecificOptions.addOpt<uint64_t>("disk-buckets", "",
+            "partition the rho-mers into this many buckets on disk (at most 4096), "
+            "and count each one separately");
 }
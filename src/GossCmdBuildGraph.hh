@@ -22,9 +22,11 @@ public:
 
     GossCmdBuildGraph(const uint64_t& pK, const uint64_t& pS, const uint64_t& pN,
                       const uint64_t& pT, const std::string& pGraphName,
-                      const strings& pFastaNames, const strings& pFastqNames, const strings& pLineNames)
+                      const strings& pFastaNames, const strings& pFastqNames, const strings& pLineNames,
+                      bool pPartitioned = false, uint64_t pDiskBuckets = 0)
         : mK(pK), mS(pS), mN(pN), mT(pT), mGraphName(pGraphName),
-          mFastaNames(pFastaNames), mFastqNames(pFastqNames), mLineNames(pLineNames)
+          mFastaNames(pFastaNames), mFastqNames(pFastqNames), mLineNames(pLineNames),
+          mPartitioned(pPartitioned), mDiskBuckets(pDiskBuckets)
     {
     }
 
@@ -37,6 +39,8 @@ private:
     const strings mFastaNames;
     const strings mFastqNames;
     const strings mLineNames;
+    const bool mPartitioned;
+    const uint64_t mDiskBuckets;
 };
 
 class GossCmdFactoryBuildGraph : public GossCmdFactory
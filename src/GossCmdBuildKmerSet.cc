@@ -141,7 +141,7 @@ GossCmdBuildKmerSet::operator()(const GossCmdContext& pCxt)
     }
 
     UnboundedProgressMonitor umon(log, 100000, " reads");
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     ReadSequenceFileSequence reads(items, fac, lineSrcFac, &umon, &log);
 
     KmerizingAdapter x(reads, mK);
@@ -333,9 +333,9 @@ GossCmdBuildScaffold::operator()(const GossCmdContext& pCxt)
     const EntryEdgeSet& entries(sg.entries());
 
     map<int64_t,uint64_t> dist;
-    ExternalBufferSort sorter(1024ULL * 1024ULL * 1024ULL, fac);
+    ExternalBufferSort sorter(1024ULL * 1024ULL * 1024ULL, fac, mNumThreads);
 
-    log(info, "constructing edge index");
+    log(info, "opening edge index");
     GraphPtr gPtr = Graph::open(mIn, fac);
     Graph& g(*gPtr);
     if (g.asymmetric())
@@ -345,7 +345,7 @@ GossCmdBuildScaffold::operator()(const GossCmdContext& pCxt)
             << Gossamer::open_graph_name_info(mIn));
     }
 
-    auto idxPtr = EdgeIndex::create(g, entries, sg, mCacheRate, mNumThreads, log);
+    auto idxPtr = EdgeIndex::open(mIn, fac, g, entries, sg, mCacheRate, mNumThreads, log);
     EdgeIndex& idx(*idxPtr);
     const PairAligner alnr(g, entries, idx);
 
@@ -375,7 +375,7 @@ GossCmdBuildScaffold::operator()(const GossCmdContext& pCxt)
     }
 
     UnboundedProgressMonitor umon(log, 100000, " read pairs");
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     ReadPairSequenceFileSequence reads(items, fac, lineSrcFac, &umon, &log);
 
     log(info, "mapping pairs.");
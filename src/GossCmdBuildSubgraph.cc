@@ -172,7 +172,7 @@ GossCmdBuildSubgraph::operator()(const GossCmdContext& pCxt)
     }
 
     UnboundedProgressMonitor umon(log, 100000, " reads");
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     ReadSequenceFileSequence reads(items, fac, lineSrcFac, &umon);
 
     ReverseComplementAdapter revs(reads, k + 1);
@@ -478,7 +478,7 @@ GossCmdClassifyReads::operator()(const GossCmdContext& pCxt)
         }
     }
 
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     UnboundedProgressMonitor umon(log, 100000, " reads");
 
     uint64_t k = ref.K();
@@ -15,6 +15,7 @@
 #include "GossOptionChecker.hh"
 #include "GossReadSequenceBases.hh"
 #include "Graph.hh"
+#include "GraphComponents.hh"
 #include "LineParser.hh"
 #include "Logger.hh"
 #include "ReadSequenceFileSequence.hh"
@@ -23,6 +24,7 @@
 #include "Timer.hh"
 
 #include <list>
+#include <memory>
 #include <string>
 #include <boost/lexical_cast.hpp>
 
@@ -32,142 +34,6 @@ using namespace std;
 
 typedef vector<string> strings;
 
-namespace {
-    
-Gossamer::rank_type rcRank(Graph& pG, Gossamer::rank_type pR)
-{
-    Graph::Edge e(pG.select(pR)); 
-    e = pG.reverseComplement(e);
-    return pG.rank(e);
-}
-
-struct CompInfo
-{
-    double mean() const
-    {
-        return mNumEdges ? mCountSum / double(mNumEdges) : 0;
-    }
-
-    double stdDev() const
-    {
-        return   mNumEdges 
-               ? sqrt(double(mNumEdges) * mCountSum2 - (double(mCountSum) * mCountSum)) / mNumEdges
-               : 0;
-    }
-
-    void add(uint64_t pCount)
-    {
-        mNumEdges += 1;
-        mCountMin = min(mCountMin, pCount);
-        mCountMax = max(mCountMax, pCount);
-        mCountSum += pCount;
-        mCountSum2 += pCount * pCount;
-    }
-
-    CompInfo(uint64_t pStart) :
-        mStart(pStart),
-        mNumEdges(0), mCountMin(numeric_limits<uint64_t>::max()), mCountMax(0), mCountSum(0), mCountSum2(0)
-    {
-    }
-
-    uint64_t mStart;
-    uint64_t mNumEdges;
-    uint64_t mCountMin;
-    uint64_t mCountMax;
-    uint64_t mCountSum;
-    uint64_t mCountSum2;
-};
-
-struct CompInfoGte
-{
-    bool operator()(const CompInfo& pC1 ,const CompInfo& pC2) const
-    {
-        return pC2.mNumEdges < pC1.mNumEdges;
-    }
-};
-
-void follow(Graph& pG, Graph::Edge& pE, dynamic_bitset<>& pMarked, CompInfo& pInfo)
-{
-    vector<Graph::Node> ns;
-    ns.push_back(pG.from(pE));
-
-    while (!ns.empty())
-    {
-        Graph::Node n(ns.back());
-        ns.pop_back();
-        pair<Gossamer::rank_type, Gossamer::rank_type> p = pG.beginEndRank(n);
-
-        // Trace forwards.
-        for (Gossamer::rank_type r = p.first; r != p.second; ++r)
-        {
-            if (pMarked[r])
-            {
-                pMarked[r] = false;
-                pInfo.add(pG.multiplicity(r));
-                Graph::Edge e(pG.select(r));
-                ns.push_back(pG.to(e));
-            }
-        }
-    
-        // Trace backwards.
-        Graph::Node nRC(pG.reverseComplement(n));
-        p = pG.beginEndRank(nRC);
-        for (Gossamer::rank_type rRC = p.first; rRC != p.second; ++rRC)
-        {
-            uint64_t r = rcRank(pG, rRC);
-            if (pMarked[r])
-            {
-                pMarked[r] = false;
-                pInfo.add(pG.multiplicity(r));
-                Graph::Edge e(pG.select(r));
-                ns.push_back(pG.from(e));
-            }
-        }
-    }
-}
-
-#if 0
-
-void dive(Graph& pG, Graph::Node& pN, dynamic_bitset<>& pMarked, CompInfo& pInfo, bool pRC)
-{
-    vector<Graph::Node> ns;
-    ns.push_back(pN);
-
-    while (!ns.empty())
-    {
-        Graph::Node n(ns.back());
-        ns.pop_back();
-        pair<Gossamer::rank_type, Gossamer::rank_type> p = pG.beginEndRank(n);
-        for (Gossamer::rank_type r = p.first; r != p.second; ++r)
-        {
-            Gossamer::rank_type r_fwd = pRC ? rcRank(pG, r) : r;
-            if (pMarked[r_fwd])
-            {
-                pMarked[r_fwd] = false;
-                pInfo.add(pG.multiplicity(r_fwd));
-                Graph::Edge e(pG.select(r));
-                ns.push_back(pG.to(e));
-            }
-        }
-    }
-}
-
-void follow(Graph& pG, Graph::Edge& pE, dynamic_bitset<>& pMarked, CompInfo& pInfo)
-{
-    // Traverse forward from pE's target node.
-    Graph::Node n_t(pG.to(pE));
-    dive(pG, n_t, pMarked, pInfo, false);
-
-    // Traverse backward from pE's source node.
-    Graph::Node n_f(pG.from(pE));
-    n_f = pG.reverseComplement(n_f);
-    dive(pG, n_f, pMarked, pInfo, true);
-}
-
-#endif
-
-};
-
 void
 GossCmdCountComponents::operator()(const GossCmdContext& pCxt)
 {
@@ -211,7 +77,7 @@ GossCmdCountComponents::operator()(const GossCmdContext& pCxt)
         }
     }
 
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     ReadSequenceFileSequence reads(items, fac, lineSrcFac, 0);
 
     dynamic_bitset<> marked(z);
@@ -242,72 +108,61 @@ GossCmdCountComponents::operator()(const GossCmdContext& pCxt)
     }
 
     log(info, "finding components");
-    ProgressMonitorNew mon(log, z);
-    vector<CompInfo> comps;
-    for (uint64_t i = 0; i < z; ++i)
+    std::unique_ptr<GraphComponents> gc;
     {
-        mon.tick(i);
-        if (marked[i])
-        {
-            CompInfo info(i);
-            info.add(g.multiplicity(i));
-            Graph::Edge e(g.select(i));
-            follow(g, e, marked, info);
-            comps.push_back(info);
-        }
+        ProgressMonitorNew mon(log, z);
+        gc = std::unique_ptr<GraphComponents>(new GraphComponents(g, marked, mThreads, &mon));
     }
+    const vector<GraphComponents::Component>& comps(gc->components());
 
     cout << "Comp\tSize\tMin\tMax\tMean\tStd Dev\n";
     for (uint64_t i = 0; i < comps.size(); ++i)
     {
-        const CompInfo& c(comps[i]);
+        const GraphComponents::Component& c(comps[i]);
         cout << i << '\t' << c.mNumEdges << '\t'
-             << c.mCountMin << '\t' << c.mCountMax << '\t' 
+             << c.mCountMin << '\t' << c.mCountMax << '\t'
              << c.mean() << '\t' << c.stdDev() << '\n';
     }
 
-
-    if (!mOut.empty() && comps.size())
+    if (mOut.empty() || comps.empty())
     {
-        LOG(log, info) << "Writing largest component";
-        for (uint64_t i = 0; i < 1; ++i)
-        {
-            const CompInfo& c(comps[i]);
-            marked.set();
-            CompInfo dummy(c.mNumEdges);
-            Graph::Edge e(g.select(c.mStart));
-            follow(g, e, marked, dummy);
-    
-            // Get rcs
-            for (uint64_t i = 0; i < z; ++i)
-            {
-                if (!marked[i])
-                {
-                    Graph::Edge f(g.select(i));
-                    uint64_t j = g.rank(g.reverseComplement(f));
-                    marked[j] = false;
-                }
-            }
-    
+        return;
+    }
 
-            uint64_t numEdges = 0;
-            for (uint64_t j = 0; j < z; ++j)
-            {
-                numEdges += !marked[j] ? 1 : 0;
-            }
+    LOG(log, info) << "Writing largest component";
 
-            Graph::Builder b(g.K(), mOut /* + lexical_cast<string>(i) */, fac, numEdges);
-            for (uint64_t i = 0; i < z; ++i)
-            {
-                if (!marked[i])
-                {
-                    b.push_back(g.select(i).value(), g.multiplicity(i));
-                }
-            }
+    // The component is written out with all the edges of the graph
+    // which are connected to it, not just those used by the reads.
+    uint64_t start = comps[gc->largest()].mStart;
+    if (!items.empty())
+    {
+        gc.reset();
+        gc = std::unique_ptr<GraphComponents>(new GraphComponents(g, mThreads));
+    }
+    marked.reset();
+    gc->edges(gc->component(start), marked);
+    gc.reset();
 
-            b.end();
+    // Get rcs
+    for (uint64_t i = 0; i < z; ++i)
+    {
+        if (marked[i])
+        {
+            Graph::Edge f(g.select(i));
+            uint64_t j = g.rank(g.reverseComplement(f));
+            marked[j] = true;
+        }
+    }
+
+    Graph::Builder b(g.K(), mOut, fac, marked.count());
+    for (uint64_t i = 0; i < z; ++i)
+    {
+        if (marked[i])
+        {
+            b.push_back(g.select(i).value(), g.multiplicity(i));
         }
     }
+    b.end();
 }
 
 
@@ -334,9 +189,12 @@ GossCmdFactoryCountComponents::create(App& pApp, const variables_map& pOpts)
     strings lineNames;
     chk.getRepeating0("line-in", lineNames, readChk);
 
+    uint64_t t = 4;
+    chk.getOptional("num-threads", t);
+
     chk.throwIfNecessary(pApp);
 
-    return GossCmdPtr(new GossCmdCountComponents(in, out, fastaNames, fastqNames, lineNames));
+    return GossCmdPtr(new GossCmdCountComponents(in, out, fastaNames, fastqNames, lineNames, t));
 }
 
 GossCmdFactoryCountComponents::GossCmdFactoryCountComponents()
@@ -21,9 +21,11 @@ public:
     void operator()(const GossCmdContext& pCxt);
 
     GossCmdCountComponents(const std::string& pIn, const std::string& pOut,
-                           const strings& pFastaNames, const strings& pFastqNames, const strings& pLineNames)
+                           const strings& pFastaNames, const strings& pFastqNames, const strings& pLineNames,
+                           uint64_t pThreads = 1)
         : mIn(pIn), mOut(pOut),
-          mFastaNames(pFastaNames), mFastqNames(pFastqNames), mLineNames(pLineNames)
+          mFastaNames(pFastaNames), mFastqNames(pFastqNames), mLineNames(pLineNames),
+          mThreads(pThreads)
     {
     }
 
@@ -33,6 +35,7 @@ private:
     const strings mFastaNames;
     const strings mFastqNames;
     const strings mLineNames;
+    const uint64_t mThreads;
 };
 
 
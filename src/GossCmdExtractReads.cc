@@ -90,7 +90,7 @@ GossCmdExtractReads::operator()(const GossCmdContext& pCxt)
     UnboundedProgressMonitor umon(log, 100000, " reads");
     uint64_t n = 0;
     uint64_t m = 0;
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     for (ReadSequenceFileSequence reads(items, fac, lineSrcFac, &umon);
         reads.valid(); ++reads, ++n)
     {
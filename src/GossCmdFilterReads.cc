@@ -216,7 +216,7 @@ GossCmdFilterReads::operator()(const GossCmdContext& pCxt)
     if (mPairs)
     {
         UnboundedProgressMonitor umon(log, 100000, " read pairs");
-        LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+        LineSourceFactory lineSrcFac(BlockLineSource::create);
         ReadPairSequenceFileSequence reads(items, fac, lineSrcFac, &umon, &log);
 
         FileFactory::OutHolderPtr match1P;
@@ -269,7 +269,7 @@ GossCmdFilterReads::operator()(const GossCmdContext& pCxt)
     else
     {
         UnboundedProgressMonitor umon(log, 100000, " reads");
-        LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+        LineSourceFactory lineSrcFac(BlockLineSource::create);
         ReadSequenceFileSequence reads(items, fac, lineSrcFac, &umon);
 
         FileFactory::OutHolderPtr matchP;
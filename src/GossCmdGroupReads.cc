@@ -23,10 +23,13 @@
 #include "ProgressMonitor.hh"
 #include "ReadPairSequenceFileSequence.hh"
 #include "ReadSequenceFileSequence.hh"
+#include "ReorderBuffer.hh"
 #include "Spinlock.hh"
 #include "SimpleHashSet.hh"
+#include "SortedKmerLookup.hh"
 #include "Timer.hh"
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 
@@ -382,23 +385,53 @@ namespace // anonymous
     {
     public:
 
-        bool operator()(Gossamer::edge_type pKmer, uint8_t& pClass) const
+        // Normalize pKmer, and return true if this pass classifies it.
+        bool wanted(Gossamer::edge_type& pKmer) const
         {
-            uint64_t r;
-            uint8_t c = 0;
             pKmer.normalize(K());
-            if (   !mBounded
-                || (pKmer >= mFrom && pKmer <= mTo))
+            return !mBounded || (pKmer >= mFrom && pKmer <= mTo);
+        }
+
+        // Look up a batch of normalized kmers, and return a bitmap
+        // of the classes of those which are present.
+        uint8_t classes(const vector<KmerSet::Edge>& pKmers,
+                        vector<Gossamer::rank_type>& pRanks, vector<bool>& pFound) const
+        {
+            pRanks.resize(pKmers.size());
+            pFound.resize(pKmers.size());
+            mKmers.accessAndRank(pKmers.begin(), pKmers.end(), pRanks.begin(), pFound.begin());
+
+            uint8_t blrg = 0;
+            for (uint64_t i = 0; i < pKmers.size(); ++i)
             {
-                if (mKmers.accessAndRank(KmerSet::Edge(pKmer), r))
+                if (pFound[i])
                 {
-                    c += uint8_t(mLhs.get(r)) << 1;
-                    c += mRhs.get(r);
-                    pClass = c;
-                    return true;
+                    blrg |= 1 << classOf(pRanks[i]);
                 }
             }
-            return false;
+            return blrg;
+        }
+
+        // Look up a sorted batch of normalized kmers, or-ing the class of
+        // each one present into the bitmap of the read it came from.
+        void classes(const SortedKmerLookup& pKmers, const vector<uint64_t>& pOwners,
+                     vector<uint8_t>& pBlrgs) const
+        {
+            auto vis = [&] (uint64_t pQuery, Gossamer::rank_type pRank) {
+                pBlrgs[pOwners[pQuery]] |= 1 << classOf(pRank);
+            };
+            pKmers.lookup(mKmers, vis);
+        }
+
+        // As above, but with a probe per kmer, which only touches the
+        // part of the kmer set that the batch spans.
+        void probeClasses(const SortedKmerLookup& pKmers, const vector<uint64_t>& pOwners,
+                          vector<uint8_t>& pBlrgs) const
+        {
+            auto vis = [&] (uint64_t pQuery, Gossamer::rank_type pRank) {
+                pBlrgs[pOwners[pQuery]] |= 1 << classOf(pRank);
+            };
+            pKmers.probe(mKmers, vis);
         }
 
         uint64_t K() const
@@ -429,6 +462,11 @@ namespace // anonymous
         }
 
     private:
+        uint8_t classOf(Gossamer::rank_type pRank) const
+        {
+            return (uint8_t(mLhs.get(pRank)) << 1) + mRhs.get(pRank);
+        }
+
         const KmerSet mKmers;
         const WordyBitVector mLhs;
         const WordyBitVector mRhs;
@@ -447,23 +485,35 @@ namespace // anonymous
 
         void operator()(KmerSrc& pSrc)
         {
-            uint8_t blrg = 0;
+            classified(pSrc, classify(pSrc));
+        }
+
+        // Return the classification of a read, without recording it.
+        uint8_t classify(KmerSrc& pSrc)
+        {
+            mKmers.clear();
             for (; pSrc.valid(); ++pSrc)
             {
-                uint8_t c;
-                if (mKmerClass(*pSrc, c))
+                Gossamer::edge_type kmer(*pSrc);
+                if (mKmerClass.wanted(kmer))
                 {
-                    blrg |= 1 << c;
+                    mKmers.push_back(KmerSet::Edge(kmer));
                 }
             }
+            return mKmerClass.classes(mKmers, mRanks, mFound);
+        }
+
+        // Record the classification of a read.
+        void classified(KmerSrc& pSrc, uint8_t pBlrg)
+        {
             if (mSinglePass)
             {
-                pSrc.print(blrg);
-                mCounts[blrg] += 1;
+                pSrc.print(pBlrg);
+                mCounts[pBlrg] += 1;
             }
             else
             {
-                pSrc.writeClass(blrg);
+                pSrc.writeClass(pBlrg);
             }
         }
 
@@ -482,10 +532,319 @@ namespace // anonymous
         bool mSinglePass;
         const KmerClassifier& mKmerClass;
         vector<uint64_t> mCounts;
+        vector<KmerSet::Edge> mKmers;
+        vector<Gossamer::rank_type> mRanks;
+        vector<bool> mFound;
     };
 
     typedef std::shared_ptr<Classifier> ClassifierPtr;
 
+    // Classifies reads in large batches, looking up all of the kmers
+    // in a batch with a single sorted pass over the kmer set.
+    class BatchClassifier
+    {
+    public:
+        void push_back(KmerSrcPtr pSrc)
+        {
+            mBatch.push_back(pSrc);
+            if (mBatch.size() >= mBatchSize)
+            {
+                flush();
+            }
+        }
+
+        void flush()
+        {
+            mLookup.clear();
+            mOwners.clear();
+            for (uint64_t i = 0; i < mBatch.size(); ++i)
+            {
+                for (KmerSrc& src(*mBatch[i]); src.valid(); ++src)
+                {
+                    Gossamer::edge_type kmer(*src);
+                    if (mKmerClass.wanted(kmer))
+                    {
+                        mLookup.push_back(kmer);
+                        mOwners.push_back(i);
+                    }
+                }
+            }
+            mLookup.sort(mNumThreads);
+
+            vector<uint8_t> blrgs(mBatch.size(), 0);
+            mKmerClass.classes(mLookup, mOwners, blrgs);
+            for (uint64_t i = 0; i < mBatch.size(); ++i)
+            {
+                mClassifier.classified(*mBatch[i], blrgs[i]);
+            }
+            mBatch.clear();
+        }
+
+        BatchClassifier(const KmerClassifier& pKmerClass, Classifier& pClassifier,
+                        uint64_t pBatchSize, uint64_t pNumThreads)
+            : mKmerClass(pKmerClass), mClassifier(pClassifier),
+              mBatchSize(pBatchSize), mNumThreads(pNumThreads), mLookup(pKmerClass.K())
+        {
+        }
+
+    private:
+        const KmerClassifier& mKmerClass;
+        Classifier& mClassifier;
+        const uint64_t mBatchSize;
+        const uint64_t mNumThreads;
+        vector<KmerSrcPtr> mBatch;
+        SortedKmerLookup mLookup;
+        vector<uint64_t> mOwners;
+    };
+
+    // Classifies reads in batches on several threads, and prints them
+    // in their original order from a single writer thread. Only used
+    // for single pass classification, since with several passes the
+    // reads are printed in order once all the passes are done.
+    class OrderedClassifier
+    {
+    public:
+        static const uint64_t batchSize = 4096;
+
+        const vector<uint64_t>& getCounts() const
+        {
+            return mCounts;
+        }
+
+        void push_back(KmerSrcPtr pSrc)
+        {
+            if (!mCurr)
+            {
+                mBuffer.reserve(mNextSeq);
+                mCurr = std::make_shared<SrcBatch>();
+                mCurr->seq = mNextSeq++;
+                mCurr->srcs.reserve(batchSize);
+            }
+            mCurr->srcs.push_back(pSrc);
+            if (mCurr->srcs.size() == batchSize)
+            {
+                flush();
+            }
+        }
+
+        void end()
+        {
+            if (mEnded)
+            {
+                return;
+            }
+            mEnded = true;
+            flush();
+            mGrp.wait();
+            mBuffer.finish();
+            mWriter.join();
+        }
+
+        OrderedClassifier(const KmerClassifier& pKmerClass, uint64_t pNumThreads)
+            : mBuffer(4 * pNumThreads), mNextSeq(0), mCounts(16, 0),
+              mGrp(2 * pNumThreads), mEnded(false)
+        {
+            for (uint64_t i = 0; i < pNumThreads; ++i)
+            {
+                mWorkers.push_back(std::make_shared<Worker>(pKmerClass, mBuffer));
+                mGrp.addApply(*mWorkers.back());
+            }
+            mWriter.create([this] () { write(); });
+        }
+
+        ~OrderedClassifier()
+        {
+            end();
+        }
+
+    private:
+        struct SrcBatch
+        {
+            uint64_t seq;
+            vector<KmerSrcPtr> srcs;
+            vector<uint8_t> blrgs;
+        };
+        typedef std::shared_ptr<SrcBatch> SrcBatchPtr;
+
+        class Worker
+        {
+        public:
+            void operator()(const SrcBatchPtr& pBatch)
+            {
+                pBatch->blrgs.resize(pBatch->srcs.size());
+                for (uint64_t i = 0; i < pBatch->srcs.size(); ++i)
+                {
+                    pBatch->blrgs[i] = mClassifier.classify(*pBatch->srcs[i]);
+                }
+                mBuffer.put(pBatch->seq, pBatch);
+            }
+
+            Worker(const KmerClassifier& pKmerClass, ReorderBuffer<SrcBatchPtr>& pBuffer)
+                : mClassifier(pKmerClass, true), mBuffer(pBuffer)
+            {
+            }
+
+        private:
+            Classifier mClassifier;
+            ReorderBuffer<SrcBatchPtr>& mBuffer;
+        };
+
+        void flush()
+        {
+            if (mCurr)
+            {
+                mGrp.push_back(mCurr);
+                mCurr = SrcBatchPtr();
+            }
+        }
+
+        void write()
+        {
+            SrcBatchPtr b;
+            while (mBuffer.get(b))
+            {
+                for (uint64_t i = 0; i < b->srcs.size(); ++i)
+                {
+                    b->srcs[i]->print(b->blrgs[i]);
+                    mCounts[b->blrgs[i]] += 1;
+                }
+            }
+        }
+
+        ReorderBuffer<SrcBatchPtr> mBuffer;
+        uint64_t mNextSeq;
+        SrcBatchPtr mCurr;
+        vector<uint64_t> mCounts;
+        vector<std::shared_ptr<Worker> > mWorkers;
+        BackgroundMultiConsumer<SrcBatchPtr> mGrp;
+        ThreadGroup mWriter;
+        bool mEnded;
+    };
+
+    // Classifies reads against a kmer set too big to be held in memory
+    // at once, reading the reads only once.
+    //
+    // The kmers of the reads are spilled, tagged with their read number,
+    // to a temporary file for each of the slices of the kmer set that the
+    // passes cover. Each file is then read back in chunks, which are
+    // sorted and looked up in that slice alone. The classes found are
+    // recorded with the ReadClassWriter, which combines those of each
+    // read from the different passes.
+    class KmerSpill
+    {
+    public:
+        // The kmers of a pair are given with the same read number.
+        void push_back(uint64_t pReadNum, const GossRead& pRead)
+        {
+            Rec r;
+            r.read = pReadNum;
+            for (GossRead::Iterator i(pRead, mK); i.valid(); ++i)
+            {
+                r.kmer = i.kmer();
+                r.kmer.normalize(mK);
+                const uint64_t p = std::upper_bound(mBounds.begin(), mBounds.end(), r.kmer) - mBounds.begin();
+                (**mFiles[p]).write(reinterpret_cast<const char*>(&r), sizeof(Rec));
+            }
+        }
+
+        // Look up the spilled kmers, one pass at a time.
+        void join(Logger& pLog, const string& pIn, ReadClassWriter& pClassWriter, uint64_t pNumThreads)
+        {
+            mFiles.clear();
+            for (uint64_t p = 0; p < mNames.size(); ++p)
+            {
+                pLog(info, "pass " + lexical_cast<string>(p));
+                KmerClassifier kmerClassr(pIn, mFac, mNames.size(), p);
+                joinPass(mNames[p], kmerClassr, pClassWriter, pNumThreads);
+                mFac.remove(mNames[p]);
+            }
+            mNames.clear();
+        }
+
+        KmerSpill(FileFactory& pFac, const string& pIn, uint64_t pK, uint64_t pNumPasses)
+            : mFac(pFac), mK(pK)
+        {
+            // The slices start at the same ranks as in KmerClassifier.
+            const KmerSet kmers(pIn, mFac);
+            const uint64_t z = kmers.count();
+            for (uint64_t p = 1; p < pNumPasses; ++p)
+            {
+                mBounds.push_back(kmers.select(p * z / pNumPasses).value());
+            }
+            for (uint64_t p = 0; p < pNumPasses; ++p)
+            {
+                mNames.push_back(mFac.tmpName());
+                mFiles.push_back(mFac.out(mNames.back()));
+            }
+        }
+
+        ~KmerSpill()
+        {
+            mFiles.clear();
+            for (uint64_t p = 0; p < mNames.size(); ++p)
+            {
+                mFac.remove(mNames[p]);
+            }
+        }
+
+    private:
+        static const uint64_t chunkSize = 1ULL << 22;
+
+        struct Rec
+        {
+            Gossamer::edge_type kmer;
+            uint64_t read;
+        };
+
+        void joinPass(const string& pName, const KmerClassifier& pKmerClass,
+                      ReadClassWriter& pClassWriter, uint64_t pNumThreads)
+        {
+            FileFactory::InHolderPtr inp(mFac.in(pName));
+            istream& in(**inp);
+            vector<Rec> recs(chunkSize);
+            SortedKmerLookup lookup(mK);
+            vector<uint64_t> owners;
+            vector<uint8_t> blrgs;
+            while (in.good())
+            {
+                in.read(reinterpret_cast<char*>(&recs[0]), chunkSize * sizeof(Rec));
+                const uint64_t n = in.gcount() / sizeof(Rec);
+                if (n == 0)
+                {
+                    break;
+                }
+
+                // The kmers were spilled in read order, so a chunk covers
+                // a range of reads.
+                const uint64_t first = recs[0].read;
+                lookup.clear();
+                owners.clear();
+                for (uint64_t i = 0; i < n; ++i)
+                {
+                    lookup.push_back(recs[i].kmer);
+                    owners.push_back(recs[i].read - first);
+                }
+                lookup.sort(pNumThreads);
+
+                blrgs.assign(recs[n - 1].read - first + 1, 0);
+                pKmerClass.probeClasses(lookup, owners, blrgs);
+                for (uint64_t i = 0; i < blrgs.size(); ++i)
+                {
+                    if (blrgs[i])
+                    {
+                        pClassWriter(first + i, blrgs[i]);
+                    }
+                }
+            }
+        }
+
+        FileFactory& mFac;
+        const uint64_t mK;
+        vector<Gossamer::edge_type> mBounds;
+        vector<string> mNames;
+        vector<FileFactory::OutHolderPtr> mFiles;
+    };
+
     string classStr(const string& pLhsName, const string& pRhsName, uint64_t i)
     {
         switch (i)
@@ -577,7 +936,8 @@ namespace // anonymous
     }
 
     void classReads(Logger& pLog, FileFactory& pFac, const string& pIn, uint64_t pNumPasses,
-                    uint64_t pNumThreads, const ReadItems& pReadItems, bool pNoWrite,
+                    uint64_t pNumThreads, uint64_t pBatchSize, bool pOrdered, bool pSpill,
+                    const ReadItems& pReadItems, bool pNoWrite,
                     ReadClassWriter& pClassWriter, uint64_t pK, vector<uint64_t>& pCounts,
                     const string& pPrefix, const string& pLhsName, const string& pRhsName, const string& pSuffix)
     {
@@ -620,25 +980,83 @@ namespace // anonymous
             outs.push_back(Out(&ambiguousM, &**ambiguousP));
         }
 
-        for (uint64_t p = 0; p < pNumPasses; ++p)
+        const bool spill = pSpill && pNumPasses > 1;
+        if (spill)
+        {
+            KmerSpill kmerSpill(pFac, pIn, pK, pNumPasses);
+            {
+                pLog(info, "spilling kmers");
+                UnboundedProgressMonitor umon(pLog, 100000, " reads");
+                LineSourceFactory lineSrcFac(BlockLineSource::create);
+                ReadSequenceFileSequence reads(pReadItems, pFac, lineSrcFac, &umon, &pLog);
+                for (uint64_t r = 0; reads.valid(); ++reads, ++r)
+                {
+                    // Make sure every read gets a class, even with no kmers found.
+                    pClassWriter(r, 0);
+                    kmerSpill.push_back(r, *reads);
+                }
+            }
+            kmerSpill.join(pLog, pIn, pClassWriter, pNumThreads);
+        }
+
+        for (uint64_t p = 0; p < pNumPasses && !spill; ++p)
         {
             pLog(info, "pass " + lexical_cast<string>(p));
             KmerClassifier kmerClassr(pIn, pFac, pNumPasses, p);
             vector<ClassifierPtr> classrs;
             BackgroundMultiConsumer<KmerSrcPtr> grp(128);
-            for (uint64_t i = 0; i < pNumThreads; ++i)
+            std::unique_ptr<BatchClassifier> batch;
+            std::unique_ptr<OrderedClassifier> ordered;
+            if (pBatchSize)
             {
                 classrs.push_back(ClassifierPtr(new Classifier(kmerClassr, pNumPasses == 1)));
-                grp.add(*classrs.back());
+                batch = std::unique_ptr<BatchClassifier>(
+                            new BatchClassifier(kmerClassr, *classrs.back(), pBatchSize, pNumThreads));
+            }
+            else if (pOrdered && pNumPasses == 1)
+            {
+                ordered = std::unique_ptr<OrderedClassifier>(
+                            new OrderedClassifier(kmerClassr, pNumThreads));
+            }
+            else
+            {
+                for (uint64_t i = 0; i < pNumThreads; ++i)
+                {
+                    classrs.push_back(ClassifierPtr(new Classifier(kmerClassr, pNumPasses == 1)));
+                    grp.add(*classrs.back());
+                }
             }
 
             UnboundedProgressMonitor umon(pLog, 100000, " reads");
-            LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+            LineSourceFactory lineSrcFac(BlockLineSource::create);
             ReadSequenceFileSequence reads(pReadItems, pFac, lineSrcFac, &umon, &pLog);
             for (uint64_t r = 0; reads.valid(); ++reads, ++r)
             {
                 KmerSrcPtr srcPtr(new Read(pK, r, (*reads).clone(), outs, pClassWriter));
-                grp.push_back(srcPtr);
+                if (batch)
+                {
+                    batch->push_back(srcPtr);
+                }
+                else if (ordered)
+                {
+                    ordered->push_back(srcPtr);
+                }
+                else
+                {
+                    grp.push_back(srcPtr);
+                }
+            }
+            if (batch)
+            {
+                batch->flush();
+            }
+            if (ordered)
+            {
+                ordered->end();
+                for (uint64_t j = 0; j < pCounts.size(); ++j)
+                {
+                    pCounts[j] += ordered->getCounts()[j];
+                }
             }
             grp.wait();
 
@@ -670,7 +1088,7 @@ namespace // anonymous
             {
                 pLog(info, "grouping output reads");
                 UnboundedProgressMonitor umon(pLog, 100000, " reads");
-                LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+                LineSourceFactory lineSrcFac(BlockLineSource::create);
                 ReadSequenceFileSequence reads(pReadItems, pFac, lineSrcFac,
                                                &umon, &pLog);
                 for (uint64_t r = 0; reads.valid(); ++reads, ++r, ++rcItr)
@@ -686,7 +1104,8 @@ namespace // anonymous
     }
 
     void classPairs(Logger& pLog, FileFactory& pFac, const string& pIn, uint64_t pNumPasses,
-                    uint64_t pNumThreads, const ReadItems& pReadItems, bool pNoWrite,
+                    uint64_t pNumThreads, uint64_t pBatchSize, bool pOrdered, bool pSpill,
+                    const ReadItems& pReadItems, bool pNoWrite,
                     ReadClassWriter& pClassWriter, uint64_t pK, vector<uint64_t>& pCounts,
                     const string& pPrefix, const string& pLhsName, const string& pRhsName, const string& pSuffix)
     {
@@ -740,26 +1159,85 @@ namespace // anonymous
             outs.push_back(Outs(&ambiguousM, &**ambiguousP_1, &**ambiguousP_2));
         }
 
-        for (uint64_t p = 0; p < pNumPasses; ++p)
+        const bool spill = pSpill && pNumPasses > 1;
+        if (spill)
+        {
+            KmerSpill kmerSpill(pFac, pIn, pK, pNumPasses);
+            {
+                pLog(info, "spilling kmers");
+                UnboundedProgressMonitor umon(pLog, 100000, " read pairs");
+                LineSourceFactory lineSrcFac(BlockLineSource::create);
+                ReadPairSequenceFileSequence reads(pReadItems, pFac, lineSrcFac,
+                        &umon, &pLog);
+                for (uint64_t r = 0; reads.valid(); ++reads, ++r)
+                {
+                    pClassWriter(r, 0);
+                    kmerSpill.push_back(r, reads.lhs());
+                    kmerSpill.push_back(r, reads.rhs());
+                }
+            }
+            kmerSpill.join(pLog, pIn, pClassWriter, pNumThreads);
+        }
+
+        for (uint64_t p = 0; p < pNumPasses && !spill; ++p)
         {
             pLog(info, "pass " + lexical_cast<string>(p));
             KmerClassifier kmerClassr(pIn, pFac, pNumPasses, p);
             vector<ClassifierPtr> classrs;
             BackgroundMultiConsumer<KmerSrcPtr> grp(128);
-            for (uint64_t i = 0; i < pNumThreads; ++i)
+            std::unique_ptr<BatchClassifier> batch;
+            std::unique_ptr<OrderedClassifier> ordered;
+            if (pBatchSize)
             {
                 classrs.push_back(ClassifierPtr(new Classifier(kmerClassr, pNumPasses == 1)));
-                grp.add(*classrs.back());
+                batch = std::unique_ptr<BatchClassifier>(
+                            new BatchClassifier(kmerClassr, *classrs.back(), pBatchSize, pNumThreads));
+            }
+            else if (pOrdered && pNumPasses == 1)
+            {
+                ordered = std::unique_ptr<OrderedClassifier>(
+                            new OrderedClassifier(kmerClassr, pNumThreads));
+            }
+            else
+            {
+                for (uint64_t i = 0; i < pNumThreads; ++i)
+                {
+                    classrs.push_back(ClassifierPtr(new Classifier(kmerClassr, pNumPasses == 1)));
+                    grp.add(*classrs.back());
+                }
             }
 
             UnboundedProgressMonitor umon(pLog, 100000, " reads");
-            LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+            LineSourceFactory lineSrcFac(BlockLineSource::create);
             ReadPairSequenceFileSequence reads(pReadItems, pFac, lineSrcFac,
                     &umon, &pLog);
             for (uint64_t r = 0; reads.valid(); ++reads, ++r)
             {
                 KmerSrcPtr srcPtr(new Pair(pK, r, reads.lhs().clone(), reads.rhs().clone(), outs, pClassWriter));
-                grp.push_back(srcPtr);
+                if (batch)
+                {
+                    batch->push_back(srcPtr);
+                }
+                else if (ordered)
+                {
+                    ordered->push_back(srcPtr);
+                }
+                else
+                {
+                    grp.push_back(srcPtr);
+                }
+            }
+            if (batch)
+            {
+                batch->flush();
+            }
+            if (ordered)
+            {
+                ordered->end();
+                for (uint64_t j = 0; j < pCounts.size(); ++j)
+                {
+                    pCounts[j] += ordered->getCounts()[j];
+                }
             }
             grp.wait();
 
@@ -791,7 +1269,7 @@ namespace // anonymous
             {
                 pLog(info, "grouping output reads");
                 UnboundedProgressMonitor umon(pLog, 100000, " reads");
-                LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+                LineSourceFactory lineSrcFac(BlockLineSource::create);
                 ReadPairSequenceFileSequence reads(pReadItems, pFac,
                         lineSrcFac, &umon, &pLog);
                 for (uint64_t r = 0; reads.valid(); ++reads, ++r, ++rcItr)
@@ -885,14 +1363,9 @@ GossCmdGroupReads::operator()(const GossCmdContext& pCxt)
 
     fac.populate(numPasses == 1);
 
-    uint64_t T = mNumThreads;
-    if (mPreserveReadOrder)
-    {
-        log(warning, "--preserve-read-order implies --num-threads 1");
-        T = 1;
-    }
+    const uint64_t T = mNumThreads;
 
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
     GossReadSequenceFactoryPtr seqFac
         = std::make_shared<GossReadSequenceBasesFactory>();
 
@@ -913,7 +1386,7 @@ GossCmdGroupReads::operator()(const GossCmdContext& pCxt)
             UnboundedProgressMonitor umon(log, 100000, " read pairs");
             ReadPairSequenceFileSequence reads(items, fac, lineSrcFac,
                 &umon, &log);
-            classPairs(log, fac, mIn, numPasses, T, items, mDontWriteReads,
+            classPairs(log, fac, mIn, numPasses, T, mSortedLookupBatch, mPreserveReadOrder, mSpillKmers, items, mDontWriteReads,
                 classWriter, K, counts, mPrefix, mLhsName, mRhsName, "txt");
             printStats(counts, mDontWriteReads, mLhsName, mRhsName);
             log(info, "total elapsed time: " + lexical_cast<string>(t.check()));
@@ -934,7 +1407,7 @@ GossCmdGroupReads::operator()(const GossCmdContext& pCxt)
             UnboundedProgressMonitor umon(log, 100000, " read pairs");
             ReadPairSequenceFileSequence reads(items, fac, lineSrcFac,
                 &umon, &log);
-            classPairs(log, fac, mIn, numPasses, T, items, mDontWriteReads,
+            classPairs(log, fac, mIn, numPasses, T, mSortedLookupBatch, mPreserveReadOrder, mSpillKmers, items, mDontWriteReads,
                 classWriter, K, counts, mPrefix, mLhsName, mRhsName, "fasta");
             printStats(counts, mDontWriteReads, mLhsName, mRhsName);
             log(info, "total elapsed time: " + lexical_cast<string>(t.check()));
@@ -955,7 +1428,7 @@ GossCmdGroupReads::operator()(const GossCmdContext& pCxt)
             UnboundedProgressMonitor umon(log, 100000, " read pairs");
             ReadPairSequenceFileSequence reads(items, fac, lineSrcFac,
                 &umon, &log);
-            classPairs(log, fac, mIn, numPasses, T, items, mDontWriteReads,
+            classPairs(log, fac, mIn, numPasses, T, mSortedLookupBatch, mPreserveReadOrder, mSpillKmers, items, mDontWriteReads,
                 classWriter, K, counts, mPrefix, mLhsName, mRhsName, "fastq");
             printStats(counts, mDontWriteReads, mLhsName, mRhsName);
             log(info, "total elapsed time: " + lexical_cast<string>(t.check()));
@@ -978,7 +1451,7 @@ GossCmdGroupReads::operator()(const GossCmdContext& pCxt)
             UnboundedProgressMonitor umon(log, 100000, " read pairs");
             ReadSequenceFileSequence reads(items, fac, lineSrcFac,
                 &umon, &log);
-            classReads(log, fac, mIn, numPasses, T, items, mDontWriteReads,
+            classReads(log, fac, mIn, numPasses, T, mSortedLookupBatch, mPreserveReadOrder, mSpillKmers, items, mDontWriteReads,
                 classWriter, K, counts, mPrefix, mLhsName, mRhsName, "txt");
             printStats(counts, mDontWriteReads, mLhsName, mRhsName);
             log(info, "total elapsed time: " + lexical_cast<string>(t.check()));
@@ -999,7 +1472,7 @@ GossCmdGroupReads::operator()(const GossCmdContext& pCxt)
             UnboundedProgressMonitor umon(log, 100000, " read pairs");
             ReadSequenceFileSequence reads(items, fac, lineSrcFac,
                 &umon, &log);
-            classReads(log, fac, mIn, numPasses, T, items, mDontWriteReads,
+            classReads(log, fac, mIn, numPasses, T, mSortedLookupBatch, mPreserveReadOrder, mSpillKmers, items, mDontWriteReads,
                 classWriter, K, counts, mPrefix, mLhsName, mRhsName, "fasta");
             printStats(counts, mDontWriteReads, mLhsName, mRhsName);
             log(info, "total elapsed time: " + lexical_cast<string>(t.check()));
@@ -1020,7 +1493,7 @@ GossCmdGroupReads::operator()(const GossCmdContext& pCxt)
             UnboundedProgressMonitor umon(log, 100000, " read pairs");
             ReadSequenceFileSequence reads(items, fac, lineSrcFac,
                 &umon, &log);
-            classReads(log, fac, mIn, numPasses, T, items, mDontWriteReads,
+            classReads(log, fac, mIn, numPasses, T, mSortedLookupBatch, mPreserveReadOrder, mSpillKmers, items, mDontWriteReads,
                 classWriter, K, counts, mPrefix, mLhsName, mRhsName, "fastq");
             printStats(counts, mDontWriteReads, mLhsName, mRhsName);
             log(info, "total elapsed time: " + lexical_cast<string>(t.check()));
@@ -1075,10 +1548,16 @@ GossCmdFactoryGroupReads::create(App& pApp, const boost::program_options::variab
     bool ord = false;
     chk.getOptional("preserve-read-order", ord);
 
+    uint64_t batch = 0;
+    chk.getOptional("sorted-lookup-batch", batch);
+
+    bool spill = false;
+    chk.getOptional("spill-kmers", spill);
+
     chk.throwIfNecessary(pApp);
 
     return GossCmdPtr(new GossCmdGroupReads(in, fastas, fastqs, lines, pairs, M, T,
-                                            lhsName, rhsName, prefix, noOut, ord));
+                                            lhsName, rhsName, prefix, noOut, ord, batch, spill));
 }
 
 GossCmdFactoryGroupReads::GossCmdFactoryGroupReads()
@@ -1103,4 +1582,10 @@ GossCmdFactoryGroupReads::GossCmdFactoryGroupReads()
             "do not produce any output read files");
     mSpecificOptions.addOpt<bool>("preserve-read-order", "",
             "maintain the same relative ordering of reads in output files");
+    mSpecificOptions.addOpt<uint64_t>("sorted-lookup-batch", "",
+            "classify reads in batches of this many, looking up the kmers of each batch "
+            "in one sequential pass over the index (default: off)");
+    mSpecificOptions.addOpt<bool>("spill-kmers", "",
+            "when the index needs more than one pass, read the input once, "
+            "spilling its kmers to temporary files (default: off)");
 }
@@ -24,11 +24,13 @@ public:
                        const strings& pFastas, const strings& pFastqs, const strings& pLines,
                        bool pPairs, double pMaxMemory, uint64_t pNumThreads,
                        const std::string& pLhsName, const std::string& pRhsName, const std::string& pPrefix,
-                       bool pDontWriteReads, bool pPreserveReadOrder)
+                       bool pDontWriteReads, bool pPreserveReadOrder, uint64_t pSortedLookupBatch = 0,
+                       bool pSpillKmers = false)
         : mIn(pIn), mFastas(pFastas), mFastqs(pFastqs), mLines(pLines), 
           mPairs(pPairs), mMaxMemory(pMaxMemory), mNumThreads(pNumThreads),
           mLhsName(pLhsName), mRhsName(pRhsName), mPrefix(pPrefix),
-          mDontWriteReads(pDontWriteReads), mPreserveReadOrder(pPreserveReadOrder)
+          mDontWriteReads(pDontWriteReads), mPreserveReadOrder(pPreserveReadOrder),
+          mSortedLookupBatch(pSortedLookupBatch), mSpillKmers(pSpillKmers)
     {
     }
 
@@ -45,6 +47,8 @@ private:
     const std::string mPrefix;
     const bool mDontWriteReads;
     const bool mPreserveReadOrder;
+    const uint64_t mSortedLookupBatch;
+    const bool mSpillKmers;
 };
 
 class GossCmdFactoryGroupReads : public GossCmdFactory
@@ -13,8 +13,12 @@
 #include "Graph.hh"
 #include "ProgressMonitor.hh"
 #include "SuperGraph.hh"
+#include "ThreadGroup.hh"
 #include "Timer.hh"
 
+#include <atomic>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <boost/lexical_cast.hpp>
 
@@ -46,86 +50,124 @@ namespace // anonymous
         vector<EdgeAndRank>& mEdges;
     };
 
-    void printLinearSegments(FileFactory& pFac, Logger& pLog,
-                             const string& pIn, const string& pOut, 
-                             bool pOmitSequence, bool pVerboseHeaders, bool mNoLineBreaks,
-                             bool pPrintRcs, uint64_t pL, uint64_t pC)
+    // The contigs found in one chunk of the rank space. Each contig is
+    // formatted without its number, which is assigned when the chunks
+    // are written out, in rank order.
+    struct Chunk
     {
-        GraphPtr gPtr = Graph::open(pIn, pFac);
-        Graph& g(*gPtr);
-        if (g.asymmetric())
+        string mText;
+        vector<uint64_t> mEnds;
+
+        void clear()
         {
-            BOOST_THROW_EXCEPTION(Gossamer::error()
-                << Gossamer::general_error_info("Asymmetric graphs not yet handled")
-                << Gossamer::open_graph_name_info(pIn));
+            mText.clear();
+            mEnds.clear();
         }
+    };
 
-        FileFactory::OutHolderPtr outPtr(pFac.out(pOut));
-        ostream& out(**outPtr);
+    class SegmentPrinter
+    {
+    public:
+        static const uint64_t sChunkSize = 1ULL << 16;
 
-        dynamic_bitset<> seen(g.count());
+        // Find the linear segments which start in the ranks [pBegin, pEnd).
+        void findSegments(uint64_t pBegin, uint64_t pEnd, Chunk& pChunk) const
+        {
+            vector<EdgeAndRank> edges;
+            SmallBaseVector vec;
+            ostringstream out;
+            for (uint64_t i = pBegin; i < pEnd; ++i)
+            {
+                if (claimed(i))
+                {
+                    continue;
+                }
 
-        vector<EdgeAndRank> edges;
+                Graph::Edge e = mGraph.select(i);
+                Graph::Node e_f = mGraph.from(e);
+                if (mGraph.inDegree(e_f) == 1 && mGraph.outDegree(e_f) == 1)
+                {
+                    continue;
+                }
 
-        SmallBaseVector vec;
+                edges.clear();
+                Vis vis(edges);
+                Graph::Edge end = mGraph.linearPath(e, vis);
+
+                // The reverse complement of this segment starts at
+                // end_rc. The segment is printed from whichever of the
+                // two starts has the lower rank; claiming the other
+                // saves walking the segment a second time.
+                Graph::Edge end_rc = mGraph.reverseComplement(end);
+                uint64_t end_rc_rnk = mGraph.rank(end_rc);
+                if (end_rc_rnk < i)
+                {
+                    continue;
+                }
+                claim(end_rc_rnk);
 
-        if (pOmitSequence)
-        {
-            out << "Number\tLength\tMinCov\tMaxCov\tMeanCov\tStdDevCov" << endl;
+                if (print(edges, vec, out))
+                {
+                    pChunk.mText += out.str();
+                    pChunk.mEnds.push_back(pChunk.mText.size());
+                    out.str(string());
+                }
+            }
         }
 
-        const uint64_t cols = mNoLineBreaks ? -1 : 60;
-        uint64_t conitNo = 1;
-        ProgressMonitorNew mon(pLog, g.count());
-        for (uint64_t i = 0; i < g.count(); ++i)
+        // Write out a chunk, numbering its contigs.
+        void write(const Chunk& pChunk, ostream& pOut)
         {
-            mon.tick(i);
-
-            Graph::Edge e = g.select(i);
-            Graph::Node e_f = g.from(e);
-            if (g.inDegree(e_f) == 1 && g.outDegree(e_f) == 1)
+            for (uint64_t j = 0, b = 0; j < pChunk.mEnds.size(); ++j)
             {
-                continue;
+                if (!mOmitSequence)
+                {
+                    pOut << '>';
+                }
+                pOut << mContigNo++;
+                pOut.write(pChunk.mText.data() + b, pChunk.mEnds[j] - b);
+                b = pChunk.mEnds[j];
             }
+        }
 
-            if (seen[i])
+        SegmentPrinter(const Graph& pGraph, bool pOmitSequence, bool pVerboseHeaders,
+                       bool pNoLineBreaks, uint64_t pL, uint64_t pC)
+            : mGraph(pGraph), mOmitSequence(pOmitSequence), mVerboseHeaders(pVerboseHeaders),
+              mCols(pNoLineBreaks ? -1 : 60), mL(pL), mC(pC), mContigNo(1),
+              mClaimed((pGraph.count() + 63) / 64)
+        {
+            for (uint64_t i = 0; i < mClaimed.size(); ++i)
             {
-                continue;
+                mClaimed[i] = 0;
             }
+        }
 
-            Graph::Edge beg = e;
+    private:
+        bool claimed(uint64_t pRank) const
+        {
+            return (mClaimed[pRank / 64].load(std::memory_order_relaxed) >> (pRank % 64)) & 1;
+        }
 
-            edges.clear();
-            Vis vis(edges);
-            Graph::Edge end = g.linearPath(beg, vis);
+        void claim(uint64_t pRank) const
+        {
+            mClaimed[pRank / 64].fetch_or(1ULL << (pRank % 64), std::memory_order_relaxed);
+        }
 
-            Graph::Edge end_rc = g.reverseComplement(end);
-            uint64_t end_rc_rnk = g.rank(end_rc);
-            BOOST_ASSERT(!seen[i]);
-            BOOST_ASSERT(!seen[end_rc_rnk]);
-            seen[i] = true;
-            seen[end_rc_rnk] = true;
+        // Format the segment, less its number, if it passes the length
+        // and coverage cutoffs.
+        bool print(const vector<EdgeAndRank>& pEdges, SmallBaseVector& pVec, ostream& pOut) const
+        {
+            const Graph& g(mGraph);
+            const vector<EdgeAndRank>& edges(pEdges);
 
             uint64_t min_cov = numeric_limits<uint64_t>::max();
-
             for (uint64_t j = 0; j < edges.size(); ++j)
             {
-                Graph::Edge x = edges[j].first;
-                uint64_t x_rnk = edges[j].second;
-                uint64_t x_cov = g.multiplicity(x_rnk);
-                seen[x_rnk] = true;
+                uint64_t x_cov = g.multiplicity(edges[j].second);
                 if (x_cov < min_cov)
                 {
                     min_cov = x_cov;
                 }
-
-                if (!pPrintRcs) 
-                {
-                    Graph::Edge y = g.reverseComplement(x);
-                    uint64_t y_rnk = g.rank(y);
-                    BOOST_ASSERT(x_cov == g.multiplicity(y_rnk));
-                    seen[y_rnk] = true;
-                }
             }
 
             Graph::Node fst = g.from(edges.front().first);
@@ -143,52 +185,146 @@ namespace // anonymous
             {
                 len -= g.K();
             }
-            if (len >= pL && min_cov >= pC)
+            if (len < mL || min_cov < mC)
+            {
+                return false;
+            }
+
+            uint64_t s = 0;
+            uint64_t s2 = 0;
+            uint64_t n = edges.size();
+            uint64_t minimum = numeric_limits<uint64_t>::max();
+            uint64_t maximum = 0;
+            for (uint64_t j = 0; j < n; ++j)
             {
-                uint64_t s = 0;
-                uint64_t s2 = 0;
-                uint64_t n = edges.size();
-                uint64_t minimum = numeric_limits<uint64_t>::max();
-                uint64_t maximum = 0;
-                for (uint64_t j = 0; j < n; ++j)
+                uint64_t w = g.multiplicity(edges[j].second);
+                s += w;
+                s2 += w * w;
+                if (w > maximum)
                 {
-                    uint64_t w = g.multiplicity(edges[j].second);
-                    s += w;
-                    s2 += w * w;
-                    if (w > maximum)
-                    {
-                        maximum = w;
-                    }
-                    if (w < minimum)
-                    {
-                        minimum = w;
-                    }
+                    maximum = w;
                 }
-                double a = static_cast<double>(s) / n;
-                double d = sqrt(static_cast<double>(s2) / n - a * a);
-                if (pOmitSequence)
+                if (w < minimum)
                 {
-                    out << conitNo++ << '\t' << (n + g.K()) << '\t' << minimum << '\t' << maximum << '\t' << a << '\t' << d << endl;
+                    minimum = w;
                 }
-                else
+            }
+            double a = static_cast<double>(s) / n;
+            double d = sqrt(static_cast<double>(s2) / n - a * a);
+            if (mOmitSequence)
+            {
+                pOut << '\t' << (n + g.K()) << '\t' << minimum << '\t' << maximum << '\t' << a << '\t' << d << endl;
+            }
+            else
+            {
+                if (mVerboseHeaders)
                 {
-                    out << '>' << conitNo++;
-                    if (pVerboseHeaders)
-                    {
-                        out << ' ' << (n + g.K()) << ':' << minimum << ':' << maximum << ':' << a << ':' << d;
-                    }
-                    out << endl;
+                    pOut << ' ' << (n + g.K()) << ':' << minimum << ':' << maximum << ':' << a << ':' << d;
+                }
+                pOut << endl;
 
-                    vec.clear();
-                    g.seq(edges[0].first, vec);
-                    for (uint64_t j = 1; j < edges.size(); ++j)
+                pVec.clear();
+                g.seq(edges[0].first, pVec);
+                for (uint64_t j = 1; j < edges.size(); ++j)
+                {
+                    pVec.push_back(edges[j].first.value() & 3);
+                }
+                SmallBaseVector v(pVec, (!includeFst) * g.K(), len);
+                v.print(pOut, mCols);
+            }
+            return true;
+        }
+
+        const Graph& mGraph;
+        const bool mOmitSequence;
+        const bool mVerboseHeaders;
+        const uint64_t mCols;
+        const uint64_t mL;
+        const uint64_t mC;
+        uint64_t mContigNo;
+        mutable vector<std::atomic<uint64_t> > mClaimed;
+    };
+
+    void printLinearSegments(FileFactory& pFac, Logger& pLog,
+                             const string& pIn, const string& pOut, 
+                             bool pOmitSequence, bool pVerboseHeaders, bool mNoLineBreaks,
+                             bool pPrintRcs, uint64_t pL, uint64_t pC, uint64_t pNumThreads)
+    {
+        GraphPtr gPtr = Graph::open(pIn, pFac);
+        Graph& g(*gPtr);
+        if (g.asymmetric())
+        {
+            BOOST_THROW_EXCEPTION(Gossamer::error()
+                << Gossamer::general_error_info("Asymmetric graphs not yet handled")
+                << Gossamer::open_graph_name_info(pIn));
+        }
+
+        FileFactory::OutHolderPtr outPtr(pFac.out(pOut));
+        ostream& out(**outPtr);
+
+        if (pOmitSequence)
+        {
+            out << "Number\tLength\tMinCov\tMaxCov\tMeanCov\tStdDevCov" << endl;
+        }
+
+        // The rank space is carved into chunks, which are handed out to
+        // the threads a round at a time. Each round is written out, in
+        // order, while the next is being found.
+        SegmentPrinter printer(g, pOmitSequence, pVerboseHeaders, mNoLineBreaks, pL, pC);
+        const uint64_t z = g.count();
+        const uint64_t S = SegmentPrinter::sChunkSize;
+        const uint64_t T = std::max<uint64_t>(1, pNumThreads);
+        const uint64_t R = 4 * T;
+
+        auto launch = [&] (uint64_t pBegin, vector<Chunk>& pChunks) {
+            std::unique_ptr<ThreadGroup> grp(new ThreadGroup);
+            std::shared_ptr<std::atomic<uint64_t> > next(new std::atomic<uint64_t>(0));
+            for (uint64_t t = 0; t < T; ++t)
+            {
+                grp->create([&printer, &pChunks, next, pBegin, z, S] () {
+                    while (true)
                     {
-                        vec.push_back(edges[j].first.value() & 3);
+                        uint64_t j = (*next)++;
+                        if (j >= pChunks.size())
+                        {
+                            return;
+                        }
+                        uint64_t b = std::min(z, pBegin + j * S);
+                        uint64_t e = std::min(z, b + S);
+                        pChunks[j].clear();
+                        printer.findSegments(b, e, pChunks[j]);
                     }
-                    SmallBaseVector v(vec, (!includeFst) * g.K(), len);
-                    v.print(out, cols);
-                }
+                });
+            }
+            return grp;
+        };
+
+        vector<Chunk> curr(R);
+        vector<Chunk> next(R);
+        ProgressMonitorNew mon(pLog, z);
+        uint64_t begin = 0;
+        launch(begin, curr)->join();
+        while (begin < z)
+        {
+            uint64_t nextBegin = std::min(z, begin + R * S);
+            std::unique_ptr<ThreadGroup> grp;
+            if (nextBegin < z)
+            {
+                grp = launch(nextBegin, next);
+            }
+
+            for (uint64_t j = 0; j < R; ++j)
+            {
+                printer.write(curr[j], out);
+                mon.tick(std::min(z, begin + (j + 1) * S));
+            }
+
+            if (grp)
+            {
+                grp->join();
             }
+            curr.swap(next);
+            begin = nextBegin;
         }
     }
 
@@ -203,7 +339,7 @@ GossCmdPrintContigs::operator()(const GossCmdContext& pCxt)
 
     if (mPrintLinearSegments)
     {
-        printLinearSegments(fac, log, mIn, mOut, mOmitSequence, mVerboseHeaders, mNoLineBreaks, mPrintRcs, mL, mC);
+        printLinearSegments(fac, log, mIn, mOut, mOmitSequence, mVerboseHeaders, mNoLineBreaks, mPrintRcs, mL, mC, mNumThreads);
     }
     else
     {
@@ -216,7 +352,7 @@ GossCmdPrintContigs::operator()(const GossCmdContext& pCxt)
         }
         catch (...)
         {
-            printLinearSegments(fac, log, mIn, mOut, mOmitSequence, mVerboseHeaders, mNoLineBreaks, mPrintRcs, mL, mC);
+            printLinearSegments(fac, log, mIn, mOut, mOmitSequence, mVerboseHeaders, mNoLineBreaks, mPrintRcs, mL, mC, mNumThreads);
         }
     }
     log(info, "total elapsed time: " + lexical_cast<string>(t.check()));
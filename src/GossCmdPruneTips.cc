@@ -14,8 +14,11 @@
 #include "Graph.hh"
 #include "Timer.hh"
 #include "MultithreadedBatchTask.hh"
+#include "PerfReport.hh"
 #include "ProgressMonitor.hh"
+#include "ThreadGroup.hh"
 
+#include <algorithm>
 #include <string>
 #include <boost/atomic.hpp>
 #include <boost/lexical_cast.hpp>
@@ -47,212 +50,253 @@ namespace // anonymous
         vector<EdgeAndRank>& mEdges;
     };
 
-    void linearPath(const Graph& pGraph, const Graph::Edge& pBegin, Vis& pVis)
+    // Counts the edges of a linear path, giving up after a limit.
+    class BoundedVis
     {
-        Graph::Edge e = pBegin;
-        Graph::Node n = pGraph.to(e);
-        while (pGraph.inDegree(n) == 1 && pGraph.outDegree(n) == 1)
+    public:
+        bool operator()(const Graph::Edge& pEdge, const Gossamer::rank_type& pRank)
         {
-            Graph::Edge ee = pGraph.onlyOutEdge(n);
-            if (ee == pBegin)
-            {
-                break;
-            }
+            return ++mCount <= mLimit;
+        }
 
-            pVis(e, pGraph.rank(e));
-            e = ee;
-            n = pGraph.to(e);
+        bool truncated() const
+        {
+            return mCount > mLimit;
         }
-        pVis(e, pGraph.rank(e));
-    }
 
-    class Block : public MultithreadedBatchTask::WorkThread
+        BoundedVis(uint64_t pLimit)
+            : mCount(0), mLimit(pLimit)
+        {
+        }
+
+    private:
+        uint64_t mCount;
+        const uint64_t mLimit;
+    };
+
+    class TipFinder
     {
     public:
-        void operator()()
+        // If the linear path starting with pBeg is a tip which should be
+        // removed, append the ranks of its edges, and of their reverse
+        // complements, to pZap and return true.
+        bool check(const Graph::Edge& pBeg, vector<EdgeAndRank>& pEdges, vector<uint64_t>& pZap) const
         {
-            vector<EdgeAndRank> edges;
-            vector<EdgeAndRank> otherEdges;
-            vector<uint64_t> zapRanks;
-            int workQuantum = 10000ll;
+            const Graph::Edge& beg(pBeg);
+            Graph::Node n = mGraph.from(beg);
+            if (mGraph.inDegree(n) != 0)
+            {
+                return false;
+            }
 
-            bool cutoffCheck = mCutoff.get() > 0;
-            bool relCutoffCheck = mRelCutoff.get() > 0;
+            vector<EdgeAndRank>& edges(pEdges);
+            edges.clear();
+            Vis vis(edges);
+            Graph::Edge end = mGraph.linearPath(beg, vis);
 
-            for (uint64_t i = mBegin; i < mEnd; ++i)
+            uint64_t l = edges.size();
+            if (l > 2 * mGraph.K())
             {
-                if (--workQuantum <= 0)
-                {
-                    if (!reportWorkDone(i - mBegin))
-                    {
-                        return;
-                    }
-                    workQuantum = 10000ll;
-                }
+                return false;
+            }
 
-                Graph::Edge beg = mGraph.select(i);
-                Graph::Node n = mGraph.from(beg);
-                if (mGraph.inDegree(n) != 0)
-                {
-                    continue;
-                }
+            uint8_t begIn = mGraph.inDegree(mGraph.from(beg));
+            uint8_t begOut = mGraph.outDegree(mGraph.from(beg));
+            uint8_t endIn = mGraph.inDegree(mGraph.to(end));
+            uint8_t endOut = mGraph.outDegree(mGraph.to(end));
 
-                edges.clear();
-                Vis vis(edges);
-                Graph::Edge end = mGraph.linearPath(beg, vis);
+            bool begCon = begOut > 1 || begIn > 0;
+            bool endCon = endIn > 1 || endOut > 0;
 
-                if (0)
+            // If both ends are connected, it can't be a tip.
+            if (begCon && endCon)
+            {
+                return false;
+            }
+
+            // Okay, we've got a tip.
+
+            uint32_t c = 0;
+            if (!begCon && endCon)
+            {
+                // Joined at the end
+                c  = mGraph.multiplicity(end);
+                n = mGraph.reverseComplement(mGraph.to(end));
+            }
+            else if (!endCon && begCon)
+            {
+                // Joined at the beginning
+                c  = mGraph.multiplicity(beg);
+                n = mGraph.from(beg);
+            }
+            else
+            {
+                // Not joined at all!
+                BOOST_ASSERT(!begCon && !endCon);
+                return false;
+            }
+
+            // Perform cutoff check
+            if (mCutoff && c < mCutoff.get())
+            {
+                return false;
+            }
+
+            {
+                // Check that there are no edges from the
+                // attaching node with lower coverage than
+                // this node, and that the edge passes the
+                // relative cutoff threshold (if applicable).
+                pair<uint64_t,uint64_t> r = mGraph.beginEndRank(n);
+                bool okay = true;
+                uint32_t totalCoverage = 0;
+                for (uint64_t j = r.first; j < r.second; ++j)
                 {
-                    otherEdges.clear();
-                    Vis otherVis(otherEdges);
-                    linearPath(mGraph, beg, otherVis);
+                    uint32_t cov = mGraph.multiplicity(j);
+                    totalCoverage += cov;
 
-                    if (edges != otherEdges)
+                    if (cov < c)
                     {
-                        for (uint64_t j = 0; j < otherEdges.size(); ++j)
-                        {
-                            cerr << otherEdges[j].second << '\t';
-                        }
-                        cerr << endl;
-                        for (uint64_t j = 0; j < edges.size(); ++j)
-                        {
-                            cerr << edges[j].second << '\t';
-                        }
-                        cerr << endl;
-                        throw "splat";
+                        okay = false;
+                        break;
                     }
                 }
 
-                uint64_t l = edges.size();
-                if (l > 2 * mGraph.K())
+                if (!okay ||
+                  (mRelCutoff && c < totalCoverage * mRelCutoff.get()))
                 {
-                    continue;
+                    return false;
                 }
+            }
 
-                uint8_t begIn = mGraph.inDegree(mGraph.from(beg));
-                uint8_t begOut = mGraph.outDegree(mGraph.from(beg));
-                uint8_t endIn = mGraph.inDegree(mGraph.to(end));
-                uint8_t endOut = mGraph.outDegree(mGraph.to(end));
-
-                bool begCon = begOut > 1 || begIn > 0;
-                bool endCon = endIn > 1 || endOut > 0;
+            for (uint64_t j = 0; j < edges.size(); ++j)
+            {
+                Graph::Edge x = edges[j].first;
+                Graph::Edge y = mGraph.reverseComplement(x);
+                pZap.push_back(edges[j].second);
+                pZap.push_back(mGraph.rank(y));
+            }
+            return true;
+        }
 
-                // If both ends are connected, it can't be a tip.
-                if (begCon && endCon)
+        // Append to pStarts the edges out of pNode which could start a
+        // tip, and the starts of the (short) linear paths which end at
+        // pNode. These are the only tips whose status can change when
+        // the edges at pNode change.
+        void frontier(const Graph::Node& pNode, vector<Graph::Edge>& pStarts) const
+        {
+            pair<uint64_t,uint64_t> r = mGraph.beginEndRank(pNode);
+            bool source = mGraph.inDegree(pNode) == 0;
+            for (uint64_t j = r.first; j < r.second; ++j)
+            {
+                Graph::Edge e = mGraph.select(j);
+                if (source)
                 {
-                    continue;
+                    pStarts.push_back(e);
                 }
 
-                // Okay, we've got a tip.
-
-                uint32_t c = 0;
-                bool check = false;
-                if (!begCon && endCon)
-                {
-                    // Joined at the end
-                    c  = mGraph.multiplicity(end);
-                    n = mGraph.reverseComplement(mGraph.to(end));
-                    check = true;
-                }
-                else if (!endCon && begCon)
-                {
-                    // Joined at the beginning
-                    c  = mGraph.multiplicity(beg);
-                    n = mGraph.from(beg);
-                    check = true;
-                }
-                else
+                // Walking forwards from an edge out of the node is
+                // walking backwards along the reverse complement.
+                BoundedVis vis(2 * mGraph.K() + 1);
+                Graph::Edge f = mGraph.linearPath(e, vis);
+                if (!vis.truncated() && mGraph.outDegree(mGraph.to(f)) == 0)
                 {
-                    // Not joined at all!
-                    BOOST_ASSERT(!begCon && !endCon);
-                    continue;
+                    pStarts.push_back(mGraph.reverseComplement(f));
                 }
+            }
+        }
 
-                // Perform cutoff check
-                if (cutoffCheck && c < mRelCutoff.get())
-                {
-                    continue;
-                }
+        TipFinder(const Graph& pGraph, const optional<uint64_t>& pCutoff,
+                  const optional<double>& pRelCutoff)
+            : mGraph(pGraph), mCutoff(pCutoff), mRelCutoff(pRelCutoff)
+        {
+        }
 
-                BOOST_ASSERT(check);
+    private:
+        const Graph& mGraph;
+        const optional<uint64_t> mCutoff;
+        const optional<double> mRelCutoff;
+    };
 
-                {
-                    // Check that there are no edges from the
-                    // attaching node with lower coverage than
-                    // this node, and that the edge passes the
-                    // relative cutoff threshold (if applicable).
-                    pair<uint64_t,uint64_t> r = mGraph.beginEndRank(n);
-                    bool okay = true;
-                    uint32_t totalCoverage = 0;
-                    for (uint64_t j = r.first; j < r.second; ++j)
-                    {
-                        uint32_t cov = mGraph.multiplicity(j);
-                        totalCoverage += cov;
-
-                        if (cov < c)
-                        {
-                            okay = false;
-                            break;
-                        }
-                    }
+    // The first pass looks at every edge.
+    class Block : public MultithreadedBatchTask::WorkThread
+    {
+    public:
+        void operator()()
+        {
+            vector<EdgeAndRank> edges;
+            vector<uint64_t> zapRanks;
+            uint64_t tips = 0;
+            int workQuantum = 10000ll;
 
-                    if (!okay ||
-                      (relCutoffCheck && c < totalCoverage * mRelCutoff.get()))
+            for (uint64_t i = mBegin; i < mEnd; ++i)
+            {
+                if (--workQuantum <= 0)
+                {
+                    if (!reportWorkDone(i - mBegin))
                     {
-                        continue;
+                        return;
                     }
+                    workQuantum = 10000ll;
                 }
 
-                //log(info, "Zap!");
-                zapRanks.clear();
-                for (uint64_t j = 0; j < edges.size(); ++j)
+                if (mFinder.check(mGraph.select(i), edges, zapRanks))
                 {
-                    Graph::Edge x = edges[j].first;
-                    Graph::Edge y = mGraph.reverseComplement(x);
-                    uint64_t x_rnk = edges[j].second;
-                    uint64_t y_rnk = mGraph.rank(y);
-                    zapRanks.push_back(x_rnk);
-                    zapRanks.push_back(y_rnk);
+                    ++tips;
                 }
+            }
 
+            {
                 std::unique_lock<std::mutex> lk(mMutex);
                 for (uint64_t j = 0; j < zapRanks.size(); ++j)
                 {
                     mZapped[zapRanks[j]] = true;
                 }
-                ++mTipCount;
-                mZapCount += zapRanks.size();
             }
+            mTipCount += tips;
+            mZapCount += zapRanks.size();
 
             reportWorkDone(mEnd - mBegin);
         }
 
-        Block(MultithreadedBatchTask& pTask, const Graph& pGraph,
+        Block(MultithreadedBatchTask& pTask, const Graph& pGraph, const TipFinder& pFinder,
               dynamic_bitset<>& pZapped, std::mutex& pMutex,
               boost::atomic<uint64_t>& pTipCount, boost::atomic<uint64_t>& pZapCount,
-              uint64_t pBegin, uint64_t pEnd,
-              const optional<uint64_t> pCutoff,
-              const optional<double> pRelCutoff)
+              uint64_t pBegin, uint64_t pEnd)
             : MultithreadedBatchTask::WorkThread(pTask),
-              mGraph(pGraph), mZapped(pZapped), mMutex(pMutex),
+              mGraph(pGraph), mFinder(pFinder), mZapped(pZapped), mMutex(pMutex),
               mTipCount(pTipCount), mZapCount(pZapCount),
-              mBegin(pBegin), mEnd(pEnd), mCutoff(pCutoff), mRelCutoff(pRelCutoff)
+              mBegin(pBegin), mEnd(pEnd)
         {
         }
 
     private:
         const Graph& mGraph;
+        const TipFinder& mFinder;
         dynamic_bitset<>& mZapped;
         std::mutex& mMutex;
         boost::atomic<uint64_t>& mTipCount;
         boost::atomic<uint64_t>& mZapCount;
         const uint64_t mBegin;
         const uint64_t mEnd;
-        const optional<uint64_t> mCutoff;
-        const optional<double> mRelCutoff;
     };
     typedef std::shared_ptr<Block> BlockPtr;
 
+    // Split [0, pN) into pThreads pieces, and call pFunc(begin, end, t)
+    // for each on its own thread.
+    template <typename Func>
+    void parallelFor(uint64_t pN, uint64_t pThreads, Func pFunc)
+    {
+        const uint64_t T = std::max<uint64_t>(1, std::min(pThreads, pN));
+        ThreadGroup grp;
+        for (uint64_t t = 1; t < T; ++t)
+        {
+            grp.create([=] () { pFunc(pN * t / T, pN * (t + 1) / T, t); });
+        }
+        pFunc(0, pN / T, 0);
+        grp.join();
+    }
+
     Debug dumpGraphBuildStats("dump-graph-build-stats", "Dump the graph builder stats.");
 
 } // namespace anonymous
@@ -276,46 +320,118 @@ GossCmdPruneTips::operator()(const GossCmdContext& pCxt)
     Timer t;
     uint64_t zc = 0;
     uint64_t tc = 0;
-    for (uint64_t iteration = 0; iteration < mIterations; ++iteration)
+    TipFinder finder(g, mCutoff, mRelCutoff);
+
+    // The starts of the tips to check in the next pass. After the first
+    // pass, only tips near the edges removed by the previous pass can
+    // have changed, so the passes get cheaper as they go.
+    vector<Graph::Edge> starts;
+    for (uint64_t iteration = 0; mUntilStable || iteration < mIterations; ++iteration)
     {
+        PerfReport::Phase phase("iteration " + lexical_cast<string>(iteration + 1));
         dynamic_bitset<> zapped(g.count());
-        std::mutex mtx;
+        uint64_t zapCount = 0;
+        uint64_t tipCount = 0;
 
-        boost::atomic<uint64_t> zapCount(0);
-        boost::atomic<uint64_t> tipCount(0);
+        if (iteration == 0)
+        {
+            log(info, "locating tips (iteration 1)");
 
-        log(info, "locating tips (iteration " + lexical_cast<string>(iteration + 1) + ")");
+            std::mutex mtx;
+            boost::atomic<uint64_t> zapCountA(0);
+            boost::atomic<uint64_t> tipCountA(0);
 
-        uint64_t N = g.count();
-        uint64_t J = mThreads;
-        uint64_t S = N / J;
+            uint64_t N = g.count();
+            uint64_t J = mThreads;
+            uint64_t S = N / J;
 
-        vector<BlockPtr> blks;
-        {
-            ProgressMonitorNew mon(log, N);
-            MultithreadedBatchTask task(mon);
+            vector<BlockPtr> blks;
+            {
+                ProgressMonitorNew mon(log, N);
+                MultithreadedBatchTask task(mon);
 
-            for (uint64_t i = 0; i < J; ++i)
+                for (uint64_t i = 0; i < J; ++i)
+                {
+                    uint64_t b = i * S;
+                    uint64_t e = (i == J - 1 ? N : (i + 1) * S);
+                    if (b != e)
+                    {
+                        BlockPtr blk(new Block(task, g, finder, zapped, mtx,
+                            tipCountA, zapCountA, b, e));
+                        task.addThread(blk);
+                        blks.push_back(blk);
+                    }
+                }
+                task();
+            }
+            zapCount = zapCountA;
+            tipCount = tipCountA;
+        }
+        else
+        {
+            log(info, "checking " + lexical_cast<string>(starts.size())
+                        + " possible tips (iteration " + lexical_cast<string>(iteration + 1) + ")");
+
+            vector<vector<uint64_t> > zaps(mThreads);
+            vector<uint64_t> tips(mThreads, 0);
+            parallelFor(starts.size(), mThreads, [&] (uint64_t pBegin, uint64_t pEnd, uint64_t pThread) {
+                vector<EdgeAndRank> edges;
+                for (uint64_t i = pBegin; i < pEnd; ++i)
+                {
+                    if (finder.check(starts[i], edges, zaps[pThread]))
+                    {
+                        ++tips[pThread];
+                    }
+                }
+            });
+            for (uint64_t i = 0; i < zaps.size(); ++i)
             {
-                uint64_t b = i * S;
-                uint64_t e = (i == J - 1 ? N : (i + 1) * S);
-                if (b != e)
+                for (uint64_t j = 0; j < zaps[i].size(); ++j)
                 {
-                    BlockPtr blk(new Block(task, g, zapped, mtx,
-                        tipCount, zapCount, b, e,
-                        mCutoff, mRelCutoff));
-                    task.addThread(blk);
-                    blks.push_back(blk);
+                    zapped[zaps[i][j]] = true;
                 }
+                zapCount += zaps[i].size();
+                tipCount += tips[i];
             }
-            task();
         }
 
-        g.remove(zapped);
         log(info, "number of tips removed: " + lexical_cast<string>(tipCount));
         log(info, "number of edges removed: " + lexical_cast<string>(zapCount));
         tc += tipCount;
         zc += zapCount;
+
+        if (zapCount == 0)
+        {
+            break;
+        }
+
+        // The nodes at either end of the removed edges.
+        vector<Graph::Node> affected;
+        for (uint64_t r = zapped.find_first(); r != dynamic_bitset<>::npos; r = zapped.find_next(r))
+        {
+            Graph::Edge e = g.select(r);
+            affected.push_back(g.from(e));
+            affected.push_back(g.to(e));
+        }
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+
+        g.remove(zapped);
+
+        vector<vector<Graph::Edge> > nexts(mThreads);
+        parallelFor(affected.size(), mThreads, [&] (uint64_t pBegin, uint64_t pEnd, uint64_t pThread) {
+            for (uint64_t i = pBegin; i < pEnd; ++i)
+            {
+                finder.frontier(affected[i], nexts[pThread]);
+            }
+        });
+        starts.clear();
+        for (uint64_t i = 0; i < nexts.size(); ++i)
+        {
+            starts.insert(starts.end(), nexts[i].begin(), nexts[i].end());
+        }
+        std::sort(starts.begin(), starts.end());
+        starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
     }
 
     log(info, "writing out graph.");
@@ -359,6 +475,9 @@ GossCmdFactoryPruneTips::create(App& pApp, const variables_map& pOpts)
     uint64_t I = 1;
     chk.getOptional("iterate", I);
 
+    bool stable = false;
+    chk.getOptional("until-stable", stable);
+
     optional<uint64_t> c;
     chk.getOptional("cutoff", c);
 
@@ -369,7 +488,7 @@ GossCmdFactoryPruneTips::create(App& pApp, const variables_map& pOpts)
     chk.getOptional("num-threads", t);
     chk.throwIfNecessary(pApp);
 
-    return GossCmdPtr(new GossCmdPruneTips(in, out, c, relC, t, I));
+    return GossCmdPtr(new GossCmdPruneTips(in, out, c, relC, t, I, stable));
 }
 
 GossCmdFactoryPruneTips::GossCmdFactoryPruneTips()
@@ -380,5 +499,8 @@ GossCmdFactoryPruneTips::GossCmdFactoryPruneTips()
     mCommonOptions.insert("cutoff");
     mCommonOptions.insert("relative-cutoff");
     mCommonOptions.insert("iterate");
+
+    mSpecificOptions.addOpt<bool>("until-stable", "",
+            "keep pruning until no more tips are removed (ignores --iterate)");
 }
 
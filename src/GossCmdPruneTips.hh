@@ -21,9 +21,10 @@ public:
     GossCmdPruneTips(const std::string& pIn, const std::string& pOut,
                      boost::optional<uint64_t> pCutoff,
                      boost::optional<double> pRelCutoff,
-                     const uint64_t& pThreads, const uint64_t& pIterations)
+                     const uint64_t& pThreads, const uint64_t& pIterations,
+                     bool pUntilStable = false)
         : mIn(pIn), mOut(pOut), mCutoff(pCutoff), mRelCutoff(pRelCutoff),
-          mThreads(pThreads), mIterations(pIterations)
+          mThreads(pThreads), mIterations(pIterations), mUntilStable(pUntilStable)
     {
     }
 
@@ -34,6 +35,7 @@ private:
     const boost::optional<double> mRelCutoff;
     const uint64_t mThreads;
     const uint64_t mIterations;
+    const bool mUntilStable;
 };
 class GossCmdFactoryPruneTips : public GossCmdFactory
 {
@@ -111,7 +111,7 @@ namespace   // anonymous
     {
         PrefixVis vis(pG, pBases);
         const SuperPath& p(pSG[pId]);
-        const SuperPath::Segments& segs(p.segments());
+        const SuperPath::SegmentsRef segs(p.segments());
         for (uint64_t i = 0; i < segs.size() && vis.stepsLeft(); ++i)
         {
             const SuperPath::Segment seg(segs[i]);
@@ -793,7 +793,7 @@ GossCmdThreadPairs::operator()(const GossCmdContext& pCxt)
 
     map<int64_t,uint64_t> dist;
     BiLinkMap biLinks;
-    ExternalBufferSort sorter(1024ULL * 1024ULL * 1024ULL, fac);
+    ExternalBufferSort sorter(1024ULL * 1024ULL * 1024ULL, fac, mNumThreads);
 
     if (loadLinkMap.on() || extLinkMap.on())
     {
@@ -804,7 +804,7 @@ GossCmdThreadPairs::operator()(const GossCmdContext& pCxt)
     }
     if (!loadLinkMap.on())
     {
-        log(info, "constructing edge index");
+        log(info, "opening edge index");
         GraphPtr gPtr = Graph::open(mIn, fac);
         Graph& g(*gPtr);
         if (g.asymmetric())
@@ -814,7 +814,7 @@ GossCmdThreadPairs::operator()(const GossCmdContext& pCxt)
                 << Gossamer::open_graph_name_info(mIn));
         }
 
-        auto idxPtr = EdgeIndex::create(g, entries, sg, mCacheRate, mNumThreads, log);
+        auto idxPtr = EdgeIndex::open(mIn, fac, g, entries, sg, mCacheRate, mNumThreads, log);
         EdgeIndex& idx(*idxPtr);
         const PairAligner alnr(g, entries, idx);
 
@@ -847,7 +847,7 @@ GossCmdThreadPairs::operator()(const GossCmdContext& pCxt)
         }
 
         UnboundedProgressMonitor umon(log, 100000, " read pairs");
-        LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+        LineSourceFactory lineSrcFac(BlockLineSource::create);
         ReadPairSequenceFileSequence reads(items, fac, lineSrcFac, &umon, &log);
 
         log(info, "mapping pairs.");
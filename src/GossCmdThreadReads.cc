@@ -701,7 +701,7 @@ GossCmdThreadReads::operator()(const GossCmdContext& pCxt)
     }
     else
     {
-        log(info, "constructing edge index");
+        log(info, "opening edge index");
         GraphPtr gPtr = Graph::open(mIn, fac);
         Graph& g(*gPtr);
         if (g.asymmetric())
@@ -710,7 +710,7 @@ GossCmdThreadReads::operator()(const GossCmdContext& pCxt)
                 << Gossamer::general_error_info("Asymmetric graphs not yet handled")
                 << Gossamer::open_graph_name_info(mIn));
         }
-        auto idxPtr = EdgeIndex::create(g, entries, sg, mCacheRate, mNumThreads, log);
+        auto idxPtr = EdgeIndex::open(mIn, fac, g, entries, sg, mCacheRate, mNumThreads, log);
         EdgeIndex& idx(*idxPtr);
 
         std::deque<GossReadSequence::Item> items;
@@ -742,7 +742,7 @@ GossCmdThreadReads::operator()(const GossCmdContext& pCxt)
         }
 
         UnboundedProgressMonitor umon(log, 100000, " reads");
-        LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+        LineSourceFactory lineSrcFac(BlockLineSource::create);
         ReadSequenceFileSequence reads(items, fac, lineSrcFac, &umon, &log);
 
         {
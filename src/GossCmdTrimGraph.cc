@@ -12,6 +12,7 @@
 #include "GossOptionChecker.hh"
 #include "Graph.hh"
 #include "EstimateGraphStatistics.hh"
+#include "ParallelEdgeFilter.hh"
 #include "ProgressMonitor.hh"
 #include "Timer.hh"
 
@@ -111,14 +112,25 @@ GossCmdTrimGraph::operator()(const GossCmdContext& pCxt)
     Graph::Builder b(k, mOut, fac, n);
 
     ProgressMonitorNew mon(log, z);
-    uint64_t j = 0;
 
-    for (Graph::LazyIterator itr(mIn, fac); itr.valid(); ++itr)
+    if (mNumThreads > 1)
     {
-        mon.tick(++j);
-        if ((*itr).second > cutoff)
+        GraphPtr gPtr = Graph::open(mIn, fac);
+        auto keep = [cutoff] (const Graph::Edge& pEdge, uint32_t pCount) {
+            return pCount > cutoff;
+        };
+        ParallelEdgeFilter::filter(*gPtr, b, keep, mNumThreads, mon);
+    }
+    else
+    {
+        uint64_t j = 0;
+        for (Graph::LazyIterator itr(mIn, fac); itr.valid(); ++itr)
         {
-            b.push_back((*itr).first.value(), (*itr).second);
+            mon.tick(++j);
+            if ((*itr).second > cutoff)
+            {
+                b.push_back((*itr).first.value(), (*itr).second);
+            }
         }
     }
     b.end();
@@ -166,9 +178,12 @@ GossCmdFactoryTrimGraph::create(App& pApp, const variables_map& pOpts)
                 << Gossamer::usage_info("cannot scale an inferred cutoff"));
     }
 
+    uint64_t T = 4;
+    chk.getOptional("num-threads", T);
+
     chk.throwIfNecessary(pApp);
 
-    return GossCmdPtr(new GossCmdTrimGraph(in, out, c, inferCutoff, estimateOnly, scaleCutoffByK));
+    return GossCmdPtr(new GossCmdTrimGraph(in, out, c, inferCutoff, estimateOnly, scaleCutoffByK, T));
 }
 
 GossCmdFactoryTrimGraph::GossCmdFactoryTrimGraph()
@@ -20,10 +20,11 @@ public:
 
     GossCmdTrimGraph(const std::string& pIn, const std::string& pOut,
                      uint64_t pC, bool pInferCutoff, bool pEstimateOnly,
-                     const boost::optional<uint64_t>& pScaleCutoffByK)
+                     const boost::optional<uint64_t>& pScaleCutoffByK,
+                     uint64_t pNumThreads = 1)
         : mIn(pIn), mOut(pOut), mC(pC),
           mInferCutoff(pInferCutoff), mEstimateOnly(pEstimateOnly),
-          mScaleCutoffByK(pScaleCutoffByK)
+          mScaleCutoffByK(pScaleCutoffByK), mNumThreads(pNumThreads)
     {
     }
 
@@ -34,6 +35,7 @@ private:
     const bool mInferCutoff;
     const bool mEstimateOnly;
     const boost::optional<uint64_t> mScaleCutoffByK;
+    const uint64_t mNumThreads;
 };
 
 
@@ -31,6 +31,14 @@ public:
     
     GossReadPtr clone() const;
 
+    /**
+     * The label on the quality line, which is usually empty.
+     */
+    const std::string& qualLabel() const
+    {
+        return mQLabel;
+    }
+
     GossFastqReadBaseString(const std::string& pLabel, const std::string& pRead, 
                             const std::string& pQLabel, const std::string& pQual)
         : GossReadBaseString(pLabel, pRead, pQual), mQLabel(pQLabel)
@@ -0,0 +1,185 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef GOSSREADBATCH_HH
+#define GOSSREADBATCH_HH
+
+#ifndef GOSSFASTAREADBASESTRING_HH
+#include "GossFastaReadBaseString.hh"
+#endif
+
+#ifndef GOSSFASTQREADBASESTRING_HH
+#include "GossFastqReadBaseString.hh"
+#endif
+
+#ifndef STD_MEMORY
+#include <memory>
+#define STD_MEMORY
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+// A batch of reads, or of read pairs, copied out of a parser so they
+// can be handed to another thread.
+//
+// Each read is copied into a slot, whose strings keep their capacity
+// when the batch is cleared. A batch that is reused therefore stops
+// allocating once its slots have seen the longest reads. A slot also
+// remembers whether the read came from a FASTA or FASTQ parser, so that
+// print() writes the same record the parser read.
+//
+class GossReadBatch
+{
+public:
+    // The number of reads, or pairs, in the batch.
+    uint64_t size() const
+    {
+        return mSize;
+    }
+
+    bool empty() const
+    {
+        return mSize == 0;
+    }
+
+    bool full() const
+    {
+        return mSize == mCapacity;
+    }
+
+    bool paired() const
+    {
+        return mPaired;
+    }
+
+    // The ith read of an unpaired batch.
+    const GossRead& operator[](uint64_t pIdx) const
+    {
+        BOOST_ASSERT(!mPaired);
+        BOOST_ASSERT(pIdx < mSize);
+        return mSlots[pIdx]->view();
+    }
+
+    // The left and right reads of the ith pair of a paired batch.
+    const GossRead& lhs(uint64_t pIdx) const
+    {
+        BOOST_ASSERT(mPaired);
+        BOOST_ASSERT(pIdx < mSize);
+        return mSlots[2 * pIdx]->view();
+    }
+
+    const GossRead& rhs(uint64_t pIdx) const
+    {
+        BOOST_ASSERT(mPaired);
+        BOOST_ASSERT(pIdx < mSize);
+        return mSlots[2 * pIdx + 1]->view();
+    }
+
+    void push_back(const GossRead& pRead)
+    {
+        BOOST_ASSERT(!mPaired);
+        BOOST_ASSERT(!full());
+        copy(pRead, *mSlots[mSize]);
+        ++mSize;
+    }
+
+    void push_back(const GossRead& pLhs, const GossRead& pRhs)
+    {
+        BOOST_ASSERT(mPaired);
+        BOOST_ASSERT(!full());
+        copy(pLhs, *mSlots[2 * mSize]);
+        copy(pRhs, *mSlots[2 * mSize + 1]);
+        ++mSize;
+    }
+
+    void clear()
+    {
+        mSize = 0;
+    }
+
+    GossReadBatch(uint64_t pCapacity, bool pPaired)
+        : mCapacity(pCapacity), mPaired(pPaired), mSize(0)
+    {
+        const uint64_t n = mPaired ? 2 * mCapacity : mCapacity;
+        mSlots.reserve(n);
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            mSlots.push_back(std::unique_ptr<Slot>(new Slot));
+        }
+    }
+
+private:
+    GossReadBatch(const GossReadBatch&);
+    GossReadBatch& operator=(const GossReadBatch&);
+
+    enum Kind { Plain, Fasta, Fastq };
+
+    struct Slot
+    {
+        std::string label;
+        std::string read;
+        std::string qualLabel;
+        std::string qual;
+        Kind kind;
+        GossReadBaseString plain;
+        GossFastaReadBaseString fasta;
+        GossFastqReadBaseString fastq;
+
+        const GossRead& view() const
+        {
+            switch (kind)
+            {
+                case Fasta:
+                    return fasta;
+                case Fastq:
+                    return fastq;
+                default:
+                    return plain;
+            }
+        }
+
+        Slot()
+            : kind(Plain), plain(label, read, qual), fasta(label, read),
+              fastq(label, read, qualLabel, qual)
+        {
+        }
+    };
+
+    static void copy(const GossRead& pRead, Slot& pSlot)
+    {
+        pSlot.label.assign(pRead.label());
+        pSlot.read.assign(pRead.read());
+        pSlot.qual.assign(pRead.qual());
+        if (const GossFastqReadBaseString* fq
+                = dynamic_cast<const GossFastqReadBaseString*>(&pRead))
+        {
+            pSlot.qualLabel.assign(fq->qualLabel());
+            pSlot.kind = Fastq;
+        }
+        else if (dynamic_cast<const GossFastaReadBaseString*>(&pRead))
+        {
+            pSlot.kind = Fasta;
+        }
+        else
+        {
+            pSlot.kind = Plain;
+        }
+    }
+
+    const uint64_t mCapacity;
+    const bool mPaired;
+    uint64_t mSize;
+    std::vector<std::unique_ptr<Slot> > mSlots;
+};
+
+typedef std::shared_ptr<GossReadBatch> GossReadBatchPtr;
+
+#endif // GOSSREADBATCH_HH
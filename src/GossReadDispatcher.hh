@@ -13,13 +13,12 @@
 #include "BackgroundMultiConsumer.hh"
 #endif
 
-#ifndef GOSSREADHANDLER_HH
-#include "GossReadHandler.hh"
+#ifndef BOUNDEDQUEUE_HH
+#include "BoundedQueue.hh"
 #endif
 
-#ifndef STD_UTILITY
-#define STD_UTILITY
-#include <utility>
+#ifndef GOSSREADHANDLER_HH
+#include "GossReadHandler.hh"
 #endif
 
 #ifndef STD_VECTOR
@@ -27,37 +26,132 @@
 #include <vector>
 #endif
 
-class GossReadDispatcher : public GossReadHandler
+// Hands reads to a pool of handlers, each running on its own thread.
+//
+// Reads are copied into batches of a few thousand, and a whole batch is
+// put on the queue at once, so the cost of the queue and of the copying
+// is shared across the batch. Batches are recycled through a free list
+// once a handler is done with them, which also bounds the number of
+// reads held in memory.
+//
+class GossBatchDispatcher
 {
 public:
+    static const uint64_t defaultBatchSize = 4096;
 
-    void operator()(const GossRead& pRead)
+    void push_back(const GossRead& pRead)
     {
-        mConsumer.push_back(pRead.clone());
+        current().push_back(pRead);
+        if (mCurr->full())
+        {
+            flush();
+        }
     }
 
-    void operator()(const GossRead& pLhs, const GossRead& pRhs)
+    void push_back(const GossRead& pLhs, const GossRead& pRhs)
     {
-        throw 2;
+        current().push_back(pLhs, pRhs);
+        if (mCurr->full())
+        {
+            flush();
+        }
     }
 
     void end()
     {
+        flush();
         mConsumer.wait();
     }
 
-    GossReadDispatcher(const std::vector<GossReadHandlerPtr>& pHandlers)
-        : mHandlers(pHandlers), mConsumer(1024)
+    GossBatchDispatcher(const std::vector<GossReadHandlerPtr>& pHandlers, bool pPaired,
+                        uint64_t pBatchSize)
+        : mHandlers(pHandlers), mFree(2 * pHandlers.size() + 1),
+          mConsumer(pHandlers.size() + 1)
     {
+        for (uint64_t i = 0; i < 2 * mHandlers.size() + 1; ++i)
+        {
+            mFree.put(GossReadBatchPtr(new GossReadBatch(pBatchSize, pPaired)));
+        }
         for (uint64_t i = 0; i < mHandlers.size(); ++i)
         {
-            mConsumer.addApply(*mHandlers[i]);
+            mWorkers.push_back(std::make_shared<Worker>(*mHandlers[i], mFree));
+            mConsumer.addApply(*mWorkers.back());
         }
     }
 
 private:
+    class Worker
+    {
+    public:
+        void operator()(const GossReadBatchPtr& pBatch)
+        {
+            mHandler(*pBatch);
+            pBatch->clear();
+            mFree.put(pBatch);
+        }
+
+        Worker(GossReadHandler& pHandler, BoundedQueue<GossReadBatchPtr>& pFree)
+            : mHandler(pHandler), mFree(pFree)
+        {
+        }
+
+    private:
+        GossReadHandler& mHandler;
+        BoundedQueue<GossReadBatchPtr>& mFree;
+    };
+
+    GossReadBatch& current()
+    {
+        if (!mCurr)
+        {
+            mFree.get(mCurr);
+        }
+        return *mCurr;
+    }
+
+    void flush()
+    {
+        if (mCurr && !mCurr->empty())
+        {
+            mConsumer.push_back(mCurr);
+            mCurr = GossReadBatchPtr();
+        }
+    }
+
     const std::vector<GossReadHandlerPtr> mHandlers;
-    BackgroundMultiConsumer<GossReadPtr> mConsumer;
+    BoundedQueue<GossReadBatchPtr> mFree;
+    std::vector<std::shared_ptr<Worker> > mWorkers;
+    GossReadBatchPtr mCurr;
+    BackgroundMultiConsumer<GossReadBatchPtr> mConsumer;
+};
+
+class GossReadDispatcher : public GossReadHandler
+{
+public:
+
+    void operator()(const GossRead& pRead)
+    {
+        mDispatcher.push_back(pRead);
+    }
+
+    void operator()(const GossRead& pLhs, const GossRead& pRhs)
+    {
+        throw 2;
+    }
+
+    void end()
+    {
+        mDispatcher.end();
+    }
+
+    GossReadDispatcher(const std::vector<GossReadHandlerPtr>& pHandlers,
+                       uint64_t pBatchSize = GossBatchDispatcher::defaultBatchSize)
+        : mDispatcher(pHandlers, false, pBatchSize)
+    {
+    }
+
+private:
+    GossBatchDispatcher mDispatcher;
 };
 
 class GossPairDispatcher : public GossReadHandler
@@ -71,26 +165,22 @@ public:
 
     void operator()(const GossRead& pLhs, const GossRead& pRhs)
     {
-        mConsumer.push_back(std::make_pair(pLhs.clone(), pRhs.clone()));
+        mDispatcher.push_back(pLhs, pRhs);
     }
 
     void end()
     {
-        mConsumer.wait();
+        mDispatcher.end();
     }
 
-    GossPairDispatcher(const std::vector<GossReadHandlerPtr>& pHandlers)
-        : mHandlers(pHandlers), mConsumer(1024)
+    GossPairDispatcher(const std::vector<GossReadHandlerPtr>& pHandlers,
+                       uint64_t pBatchSize = GossBatchDispatcher::defaultBatchSize)
+        : mDispatcher(pHandlers, true, pBatchSize)
     {
-        for (uint64_t i = 0; i < mHandlers.size(); ++i)
-        {
-            mConsumer.addApply(*mHandlers[i]);
-        }
     }
 
 private:
-    const std::vector<GossReadHandlerPtr> mHandlers;
-    BackgroundMultiConsumer<std::pair<GossReadPtr, GossReadPtr> > mConsumer;
+    GossBatchDispatcher mDispatcher;
 };
 
 #endif // GOSSREADDISPATCHER_HH
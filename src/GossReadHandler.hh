@@ -13,6 +13,10 @@
 #include "GossRead.hh"
 #endif
 
+#ifndef GOSSREADBATCH_HH
+#include "GossReadBatch.hh"
+#endif
+
 class GossReadHandler
 {
 public:
@@ -31,6 +35,24 @@ public:
         (*this)(*pPair.first, *pPair.second);
     }
 
+    // Handle a batch of reads, or pairs, from a dispatcher. Handlers may
+    // override this to work through the batch without a virtual call per read.
+    virtual void operator()(const GossReadBatch& pBatch)
+    {
+        if (pBatch.paired())
+        {
+            for (uint64_t i = 0; i < pBatch.size(); ++i)
+            {
+                (*this)(pBatch.lhs(i), pBatch.rhs(i));
+            }
+            return;
+        }
+        for (uint64_t i = 0; i < pBatch.size(); ++i)
+        {
+            (*this)(pBatch[i]);
+        }
+    }
+
     virtual void startFile(const std::string& pFileName) {}
 
     virtual void endFile() {}
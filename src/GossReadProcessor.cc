@@ -48,7 +48,7 @@ GossReadProcessor::processSingle(const GossCmdContext& pCxt,
     FileFactory& fac(pCxt.fac);
     uint64_t numReads = 0;
 
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
 
     BOOST_FOREACH(const std::string& fname, pLines)
     {
@@ -105,7 +105,7 @@ GossReadProcessor::processPairs(const GossCmdContext& pCxt,
     FileFactory& fac(pCxt.fac);
     uint64_t numPairs = 0;
 
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
 
     for (uint64_t i = 0; i < pLines.size(); i += 2)
     {
@@ -202,6 +202,21 @@ public:
                 mCurr.second = (*mCounts)[mEdgesView->originalRank(mRnk)];
             }
         }
+
+        // Start at the edge with rank pBegin.
+        Iterator(const Graph& pGraph, Gossamer::rank_type pBegin)
+            : mEdgesView(&pGraph.edges()),
+              mCounts(&pGraph.counts()),
+              mRnk(pBegin),
+              mCurr(Edge(Gossamer::position_type(0)), 0)
+        {
+            if (valid())
+            {
+                mCurr.first = Edge(mEdgesView->select(mRnk));
+                mCurr.second = (*mCounts)[mEdgesView->originalRank(mRnk)];
+            }
+        }
+
     private:
 
         const SparseArrayView* mEdgesView;
@@ -413,6 +428,15 @@ public:
         return mEdgesView.accessAndRank(pEdge.value(), pRank);
     }
 
+    // Do the edges in [pBegin, pEnd) exist? Looks them up as a batch,
+    // writing their ranks to pRanks and the answers to pFound.
+    //
+    template <typename EdgeItr, typename RankItr, typename FoundItr>
+    void accessAndRank(EdgeItr pBegin, EdgeItr pEnd, RankItr pRanks, FoundItr pFound) const
+    {
+        mEdgesView.accessAndRank(pBegin, pEnd, pRanks, pFound);
+    }
+
     // What is the count associated with this edge.
     //
     uint32_t multiplicity(const Edge& pEdge) const
@@ -0,0 +1,274 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "GraphComponents.hh"
+
+#include "ThreadGroup.hh"
+
+#include <atomic>
+#include <mutex>
+
+using namespace boost;
+using namespace std;
+
+namespace // anonymous
+{
+    const uint64_t sChunkSize = 1ULL << 16;
+
+    // Call pFunc(begin, end, chunk) for chunks of [0, pN), handing the
+    // chunks out to pNumThreads threads.
+    template <typename Func>
+    void forChunks(uint64_t pN, uint64_t pNumThreads, ProgressMonitorNew* pMon, Func pFunc)
+    {
+        std::atomic<uint64_t> next(0);
+        std::atomic<uint64_t> done(0);
+        std::mutex monMut;
+
+        auto worker = [&] () {
+            while (true)
+            {
+                uint64_t c = next++;
+                uint64_t b = c * sChunkSize;
+                if (b >= pN)
+                {
+                    return;
+                }
+                uint64_t e = std::min(pN, b + sChunkSize);
+                pFunc(b, e, c);
+
+                done += e - b;
+                if (pMon)
+                {
+                    std::unique_lock<std::mutex> lk(monMut, std::try_to_lock);
+                    if (lk.owns_lock())
+                    {
+                        pMon->tick(done);
+                    }
+                }
+            }
+        };
+
+        ThreadGroup grp;
+        for (uint64_t t = 1; t < pNumThreads; ++t)
+        {
+            grp.create(worker);
+        }
+        worker();
+        grp.join();
+    }
+
+    void atomicMin(std::atomic<uint64_t>& pX, uint64_t pY)
+    {
+        uint64_t x = pX.load();
+        while (pY < x && !pX.compare_exchange_weak(x, pY))
+        {
+        }
+    }
+
+    void atomicMax(std::atomic<uint64_t>& pX, uint64_t pY)
+    {
+        uint64_t x = pX.load();
+        while (pY > x && !pX.compare_exchange_weak(x, pY))
+        {
+        }
+    }
+
+    // Running totals for one component, updated from several threads.
+    struct Totals
+    {
+        std::atomic<uint64_t> numEdges;
+        std::atomic<uint64_t> countMin;
+        std::atomic<uint64_t> countMax;
+        std::atomic<uint64_t> countSum;
+        std::atomic<uint64_t> countSum2;
+
+        void add(const GraphComponents::Component& pComp)
+        {
+            numEdges += pComp.mNumEdges;
+            atomicMin(countMin, pComp.mCountMin);
+            atomicMax(countMax, pComp.mCountMax);
+            countSum += pComp.mCountSum;
+            countSum2 += pComp.mCountSum2;
+        }
+
+        Totals()
+            : numEdges(0), countMin(std::numeric_limits<uint64_t>::max()), countMax(0),
+              countSum(0), countSum2(0)
+        {
+        }
+    };
+}
+// namespace anonymous
+
+uint64_t
+GraphComponents::component(uint64_t pRank) const
+{
+    return std::lower_bound(mRoots.begin(), mRoots.end(), mSets.parent(pRank)) - mRoots.begin();
+}
+
+uint64_t
+GraphComponents::largest() const
+{
+    uint64_t l = 0;
+    for (uint64_t i = 1; i < mComps.size(); ++i)
+    {
+        if (mComps[i].mNumEdges > mComps[l].mNumEdges)
+        {
+            l = i;
+        }
+    }
+    return l;
+}
+
+void
+GraphComponents::edges(uint64_t pComp, dynamic_bitset<>& pEdges) const
+{
+    const uint64_t root = mRoots[pComp];
+    for (uint64_t i = root; i < mSets.size(); ++i)
+    {
+        if (wanted(i) && mSets.parent(i) == root)
+        {
+            pEdges[i] = true;
+        }
+    }
+}
+
+GraphComponents::GraphComponents(const Graph& pGraph, const dynamic_bitset<>& pEdges,
+                                 uint64_t pNumThreads, ProgressMonitorNew* pMon)
+    : mGraph(pGraph), mEdges(pEdges), mSets(pGraph.count())
+{
+    find(pNumThreads, pMon);
+}
+
+GraphComponents::GraphComponents(const Graph& pGraph, uint64_t pNumThreads, ProgressMonitorNew* pMon)
+    : mGraph(pGraph), mSets(pGraph.count())
+{
+    find(pNumThreads, pMon);
+}
+
+void
+GraphComponents::find(uint64_t pNumThreads, ProgressMonitorNew* pMon)
+{
+    const Graph& g(mGraph);
+    const uint64_t z = g.count();
+
+    // The first wanted edge in the rank range [pBegin, pEnd).
+    auto first = [this] (uint64_t pBegin, uint64_t pEnd) {
+        for (uint64_t r = pBegin; r < pEnd; ++r)
+        {
+            if (wanted(r))
+            {
+                return r;
+            }
+        }
+        return pEnd;
+    };
+
+    // Every edge is united with the first of its siblings, so the edges
+    // out of a node all end up together. Every edge is also united with
+    // the first edge out of the node it leads to, if there is one, or
+    // else with the first edge into that node. Between them, these link
+    // every pair of edges that meet at a node.
+    forChunks(z, pNumThreads, pMon, [&] (uint64_t pBegin, uint64_t pEnd, uint64_t) {
+        for (uint64_t r = pBegin; r < pEnd; ++r)
+        {
+            if (!wanted(r))
+            {
+                continue;
+            }
+            Graph::Edge e = g.select(r);
+
+            pair<uint64_t,uint64_t> s = g.beginEndRank(g.from(e));
+            mSets.unite(r, first(s.first, s.second));
+
+            Graph::Node n = g.to(e);
+            pair<uint64_t,uint64_t> o = g.beginEndRank(n);
+            uint64_t f = first(o.first, o.second);
+            if (f != o.second)
+            {
+                mSets.unite(r, f);
+                continue;
+            }
+
+            // In edges are the reverse complements of the edges out of
+            // the reverse complement node.
+            pair<uint64_t,uint64_t> i = g.beginEndRank(g.reverseComplement(n));
+            for (uint64_t j = i.first; j < i.second; ++j)
+            {
+                uint64_t q = g.rank(g.reverseComplement(g.select(j)));
+                if (wanted(q))
+                {
+                    mSets.unite(r, q);
+                    break;
+                }
+            }
+        }
+    });
+
+    // The roots, in rank order.
+    const uint64_t numChunks = (z + sChunkSize - 1) / sChunkSize;
+    vector<vector<uint64_t> > roots(numChunks);
+    forChunks(z, pNumThreads, 0, [&] (uint64_t pBegin, uint64_t pEnd, uint64_t pChunk) {
+        mSets.flatten(pBegin, pEnd);
+        for (uint64_t r = pBegin; r < pEnd; ++r)
+        {
+            if (wanted(r) && mSets.parent(r) == r)
+            {
+                roots[pChunk].push_back(r);
+            }
+        }
+    });
+    for (uint64_t i = 0; i < roots.size(); ++i)
+    {
+        mRoots.insert(mRoots.end(), roots[i].begin(), roots[i].end());
+        vector<uint64_t>().swap(roots[i]);
+    }
+
+    // Gather the statistics. Components tend to occupy runs of
+    // neighbouring ranks, so accumulate a run locally before adding it
+    // to the shared totals.
+    unique_ptr<Totals[]> totals(new Totals[mRoots.size()]);
+    forChunks(z, pNumThreads, 0, [&] (uint64_t pBegin, uint64_t pEnd, uint64_t) {
+        uint64_t c = mRoots.size();
+        Component run(0);
+        for (uint64_t r = pBegin; r < pEnd; ++r)
+        {
+            if (!wanted(r))
+            {
+                continue;
+            }
+            uint64_t d = component(r);
+            if (d != c)
+            {
+                if (run.mNumEdges)
+                {
+                    totals[c].add(run);
+                }
+                c = d;
+                run = Component(0);
+            }
+            run.add(g.multiplicity(r));
+        }
+        if (run.mNumEdges)
+        {
+            totals[c].add(run);
+        }
+    });
+
+    mComps.reserve(mRoots.size());
+    for (uint64_t i = 0; i < mRoots.size(); ++i)
+    {
+        Component c(mRoots[i]);
+        c.mNumEdges = totals[i].numEdges;
+        c.mCountMin = totals[i].countMin;
+        c.mCountMax = totals[i].countMax;
+        c.mCountSum = totals[i].countSum;
+        c.mCountSum2 = totals[i].countSum2;
+        mComps.push_back(c);
+    }
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef GRAPHCOMPONENTS_HH
+#define GRAPHCOMPONENTS_HH
+
+#ifndef GRAPH_HH
+#include "Graph.hh"
+#endif
+
+#ifndef CONCURRENTUNIONFIND_HH
+#include "ConcurrentUnionFind.hh"
+#endif
+
+#ifndef PROGRESSMONITOR_HH
+#include "ProgressMonitor.hh"
+#endif
+
+#ifndef BOOST_DYNAMIC_BITSET_HPP
+#include <boost/dynamic_bitset.hpp>
+#define BOOST_DYNAMIC_BITSET_HPP
+#endif
+
+#ifndef STD_ALGORITHM
+#include <algorithm>
+#define STD_ALGORITHM
+#endif
+
+#ifndef STD_CMATH
+#include <cmath>
+#define STD_CMATH
+#endif
+
+#ifndef STD_LIMITS
+#include <limits>
+#define STD_LIMITS
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+// The connected components of a graph, or of the subgraph made of a
+// chosen set of its edges, ignoring edge direction. Two edges are
+// connected if they share a node.
+//
+// The components are found with a lock-free union-find over edge
+// ranks, on several threads, so this needs 8 bytes per edge. Each
+// component is numbered by the order of its lowest ranked edge.
+//
+class GraphComponents
+{
+public:
+    struct Component
+    {
+        double mean() const
+        {
+            return mNumEdges ? mCountSum / double(mNumEdges) : 0;
+        }
+
+        double stdDev() const
+        {
+            return   mNumEdges
+                   ? std::sqrt(double(mNumEdges) * mCountSum2 - (double(mCountSum) * mCountSum)) / mNumEdges
+                   : 0;
+        }
+
+        void add(uint64_t pCount)
+        {
+            mNumEdges += 1;
+            mCountMin = std::min(mCountMin, pCount);
+            mCountMax = std::max(mCountMax, pCount);
+            mCountSum += pCount;
+            mCountSum2 += pCount * pCount;
+        }
+
+        Component(uint64_t pStart)
+            : mStart(pStart),
+              mNumEdges(0), mCountMin(std::numeric_limits<uint64_t>::max()), mCountMax(0),
+              mCountSum(0), mCountSum2(0)
+        {
+        }
+
+        // The rank of the lowest ranked edge.
+        uint64_t mStart;
+        uint64_t mNumEdges;
+        uint64_t mCountMin;
+        uint64_t mCountMax;
+        uint64_t mCountSum;
+        uint64_t mCountSum2;
+    };
+
+    const std::vector<Component>& components() const
+    {
+        return mComps;
+    }
+
+    // The number of the component containing the edge with rank pRank,
+    // which must be one of the edges considered.
+    uint64_t component(uint64_t pRank) const;
+
+    // The number of the component with the most edges (the first of
+    // them, if there's a tie).
+    uint64_t largest() const;
+
+    // Set the bits in pEdges for the ranks of the edges of component
+    // pComp. pEdges must have a bit for each edge in the graph.
+    void edges(uint64_t pComp, boost::dynamic_bitset<>& pEdges) const;
+
+    // Find the components of the subgraph made of the edges whose
+    // ranks are set in pEdges.
+    GraphComponents(const Graph& pGraph, const boost::dynamic_bitset<>& pEdges,
+                    uint64_t pNumThreads, ProgressMonitorNew* pMon = 0);
+
+    // Find the components of the whole graph.
+    GraphComponents(const Graph& pGraph, uint64_t pNumThreads, ProgressMonitorNew* pMon = 0);
+
+private:
+    void find(uint64_t pNumThreads, ProgressMonitorNew* pMon);
+
+    bool wanted(uint64_t pRank) const
+    {
+        return mEdges.empty() || mEdges[pRank];
+    }
+
+    const Graph& mGraph;
+    const boost::dynamic_bitset<> mEdges;
+    ConcurrentUnionFind mSets;
+    std::vector<uint64_t> mRoots;
+    std::vector<Component> mComps;
+};
+
+#endif // GRAPHCOMPONENTS_HH
@@ -7,6 +7,7 @@
 // Please see the file LICENSE, included with this distribution.
 //
 #include "GraphTrimmer.hh"
+#include "ParallelEdgeFilter.hh"
 
 void
 GraphTrimmer::writeTrimmedGraph(Graph::Builder& pBuilder) const
@@ -37,3 +38,23 @@ GraphTrimmer::writeTrimmedGraph(Graph::Builder& pBuilder) const
     pBuilder.end();
 }
 
+
+
+void
+GraphTrimmer::writeTrimmedGraph(Graph::Builder& pBuilder, uint64_t pNumThreads,
+                                Logger& pLog) const
+{
+    if (pNumThreads <= 1 || !mCounts.empty())
+    {
+        writeTrimmedGraph(pBuilder);
+        return;
+    }
+
+    const boost::dynamic_bitset<>& deleted(mDeletedEdges);
+    auto keep = [&deleted] (uint64_t pRank, const Graph::Edge& pEdge, uint32_t pCount) {
+        return !deleted[pRank];
+    };
+    ProgressMonitorNew mon(pLog, mGraph.count());
+    ParallelEdgeFilter::filterByRank(mGraph, pBuilder, keep, pNumThreads, mon);
+    pBuilder.end();
+}
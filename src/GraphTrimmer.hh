@@ -13,6 +13,10 @@
 #include "Graph.hh"
 #endif
 
+#ifndef LOGGER_HH
+#include "Logger.hh"
+#endif
+
 #ifndef BOOST_DYNAMIC_BITSET_HPP
 #include <boost/dynamic_bitset.hpp>
 #define BOOST_DYNAMIC_BITSET_HPP
@@ -92,6 +96,10 @@ public:
 
     void writeTrimmedGraph(Graph::Builder& pBuilder) const;
 
+    // As above, but decode and filter the edges on several threads.
+    void writeTrimmedGraph(Graph::Builder& pBuilder, uint64_t pNumThreads,
+                           Logger& pLog) const;
+
     GraphTrimmer(const Graph& pGraph)
         : mGraph(pGraph), mDeletedEdges(pGraph.count()), mModified(false)
     {
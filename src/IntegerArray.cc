@@ -78,6 +78,11 @@ public:
         return value_type(mArray[pIdx]);
     }
 
+    void prefetch(uint64_t pIdx) const
+    {
+        mArray.prefetch(pIdx);
+    }
+
     uint64_t lower_bound(uint64_t pBegin, uint64_t pEnd, const value_type& pVal) const
     {
         using namespace Gossamer;
@@ -164,6 +169,11 @@ public:
         return mArray.size();
     }
 
+    void prefetch(uint64_t pIdx) const
+    {
+        mArray.prefetch(pIdx);
+    }
+
     uint64_t lower_bound(uint64_t pBegin, uint64_t pEnd, const value_type& pVal) const
     {
         return mArray.lower_bound(pBegin, pEnd, pVal);
@@ -79,6 +79,13 @@ public:
      */
     virtual value_type operator[](uint64_t pIdx) const = 0;
 
+    /**
+     * Hint that the element at pIdx will be retrieved soon.
+     */
+    virtual void prefetch(uint64_t pIdx) const
+    {
+    }
+
     /**
      * Find the first position in the interval [pBegin, pEnd) containing a value >= pValue.
      */
@@ -0,0 +1,287 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef JSONWRITER_HH
+#define JSONWRITER_HH
+
+#ifndef STDINT_H
+#include <stdint.h>
+#define STDINT_H
+#endif
+
+#ifndef STD_CSTRING
+#include <cstring>
+#define STD_CSTRING
+#endif
+
+#ifndef STD_OSTREAM
+#include <ostream>
+#define STD_OSTREAM
+#endif
+
+#ifndef STD_SSTREAM
+#include <sstream>
+#define STD_SSTREAM
+#endif
+
+#ifndef STD_STRING
+#include <string>
+#define STD_STRING
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+#ifndef BOOST_ASSERT_HPP
+#include <boost/assert.hpp>
+#define BOOST_ASSERT_HPP
+#endif
+
+// Writes a JSON document to a stream as it goes, one element per line,
+// indented by depth. Inside an object, each value must be preceded by
+// a key().
+//
+//    JsonWriter j(cout);
+//    j.beginObject();
+//    j.field("name", "rank").field("seconds", 1.5);
+//    j.key("sizes").beginArray().value(1).value(4).endArray();
+//    j.endObject();
+//
+class JsonWriter
+{
+public:
+    JsonWriter& beginObject()
+    {
+        open('{');
+        return *this;
+    }
+
+    JsonWriter& endObject()
+    {
+        close('}');
+        return *this;
+    }
+
+    JsonWriter& beginArray()
+    {
+        open('[');
+        return *this;
+    }
+
+    JsonWriter& endArray()
+    {
+        close(']');
+        return *this;
+    }
+
+    JsonWriter& key(const std::string& pKey)
+    {
+        BOOST_ASSERT(!mLevels.empty() && mLevels.back().object && !mKeyed);
+        separate();
+        quote(pKey);
+        mOut << ": ";
+        mKeyed = true;
+        return *this;
+    }
+
+    JsonWriter& value(const std::string& pVal)
+    {
+        element();
+        quote(pVal);
+        return *this;
+    }
+
+    JsonWriter& value(const char* pVal)
+    {
+        return value(std::string(pVal));
+    }
+
+    JsonWriter& value(bool pVal)
+    {
+        element();
+        mOut << (pVal ? "true" : "false");
+        return *this;
+    }
+
+    JsonWriter& value(uint64_t pVal)
+    {
+        element();
+        mOut << pVal;
+        return *this;
+    }
+
+    JsonWriter& value(int64_t pVal)
+    {
+        element();
+        mOut << pVal;
+        return *this;
+    }
+
+    JsonWriter& value(uint32_t pVal)
+    {
+        return value(static_cast<uint64_t>(pVal));
+    }
+
+    JsonWriter& value(int pVal)
+    {
+        return value(static_cast<int64_t>(pVal));
+    }
+
+    // Non-finite numbers have no JSON form, so are written as null.
+    JsonWriter& value(double pVal)
+    {
+        element();
+        if (finite(pVal))
+        {
+            std::ostringstream s;
+            s.precision(17);
+            s << pVal;
+            mOut << s.str();
+        }
+        else
+        {
+            mOut << "null";
+        }
+        return *this;
+    }
+
+    template <typename T>
+    JsonWriter& field(const std::string& pKey, const T& pVal)
+    {
+        key(pKey);
+        return value(pVal);
+    }
+
+    explicit JsonWriter(std::ostream& pOut)
+        : mOut(pOut), mKeyed(false)
+    {
+    }
+
+    ~JsonWriter()
+    {
+        BOOST_ASSERT(mLevels.empty());
+    }
+
+private:
+    struct Level
+    {
+        bool object;
+        bool empty;
+
+        Level(bool pObject)
+            : object(pObject), empty(true)
+        {
+        }
+    };
+
+    // Get ready to write a value.
+    void element()
+    {
+        if (mKeyed)
+        {
+            mKeyed = false;
+            return;
+        }
+        BOOST_ASSERT(mLevels.empty() || !mLevels.back().object);
+        separate();
+    }
+
+    // Start a new line for the next member of the current level.
+    void separate()
+    {
+        if (mLevels.empty())
+        {
+            return;
+        }
+        if (!mLevels.back().empty)
+        {
+            mOut << ',';
+        }
+        mLevels.back().empty = false;
+        newline(mLevels.size());
+    }
+
+    void open(char pBracket)
+    {
+        element();
+        mOut << pBracket;
+        mLevels.push_back(Level(pBracket == '{'));
+    }
+
+    void close(char pBracket)
+    {
+        BOOST_ASSERT(!mLevels.empty() && mLevels.back().object == (pBracket == '}') && !mKeyed);
+        bool empty = mLevels.back().empty;
+        mLevels.pop_back();
+        if (!empty)
+        {
+            newline(mLevels.size());
+        }
+        mOut << pBracket;
+        if (mLevels.empty())
+        {
+            mOut << '\n';
+        }
+    }
+
+    // We build with -ffast-math, under which std::isfinite may be
+    // folded to true, so look at the exponent bits instead.
+    static bool finite(double pVal)
+    {
+        uint64_t x;
+        std::memcpy(&x, &pVal, sizeof(x));
+        return ((x >> 52) & 0x7ff) != 0x7ff;
+    }
+
+    void newline(uint64_t pDepth)
+    {
+        mOut << '\n';
+        for (uint64_t i = 0; i < pDepth; ++i)
+        {
+            mOut << "  ";
+        }
+    }
+
+    void quote(const std::string& pStr)
+    {
+        static const char* hex = "0123456789abcdef";
+        mOut << '"';
+        for (std::string::const_iterator i = pStr.begin(); i != pStr.end(); ++i)
+        {
+            unsigned char c = *i;
+            switch (c)
+            {
+                case '"':  mOut << "\\\""; break;
+                case '\\': mOut << "\\\\"; break;
+                case '\n': mOut << "\\n";  break;
+                case '\r': mOut << "\\r";  break;
+                case '\t': mOut << "\\t";  break;
+                default:
+                {
+                    if (c < 0x20)
+                    {
+                        mOut << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+                    }
+                    else
+                    {
+                        mOut << c;
+                    }
+                }
+            }
+        }
+        mOut << '"';
+    }
+
+    std::ostream& mOut;
+    std::vector<Level> mLevels;
+    bool mKeyed;
+};
+
+#endif // JSONWRITER_HH
@@ -0,0 +1,199 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "KmerKernels.hh"
+
+#include "Utils.hh"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define GOSS_KMER_KERNELS_SSE2
+#endif
+#if defined(GOSS_KMER_KERNELS_SSE2) && (defined(GOSS_LINUX_X64) || defined(GOSS_MACOSX_X64))
+#include <immintrin.h>
+#define GOSS_KMER_KERNELS_AVX2
+#endif
+
+using namespace std;
+
+namespace // anonymous
+{
+    // The code of a valid base c is ((c >> 1) & 3) ^ ((c >> 2) & 1):
+    //
+    //      A 0x41 -> 0     C 0x43 -> 1     G 0x47 -> 2     T 0x54 -> 3
+    //
+    // and likewise for lower case, which differs only in bit 5.
+
+    const uint8_t sCodes[256] = {
+#define X 4
+        X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X, X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+        X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X, X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+        X,0,X,1,X,X,X,2,X,X,X,X,X,X,X,X, X,X,X,X,3,X,X,X,X,X,X,X,X,X,X,X,
+        X,0,X,1,X,X,X,2,X,X,X,X,X,X,X,X, X,X,X,X,3,X,X,X,X,X,X,X,X,X,X,X,
+        X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X, X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+        X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X, X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+        X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X, X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+        X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X, X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X
+#undef X
+    };
+
+#ifdef GOSS_KMER_KERNELS_SSE2
+    uint64_t encodeSse2(const char* pBases, uint64_t pLen, uint8_t* pCodes)
+    {
+        const __m128i lower = _mm_set1_epi8(0x20);
+        const __m128i a = _mm_set1_epi8('a');
+        const __m128i c = _mm_set1_epi8('c');
+        const __m128i g = _mm_set1_epi8('g');
+        const __m128i t = _mm_set1_epi8('t');
+        const __m128i three = _mm_set1_epi8(3);
+        const __m128i one = _mm_set1_epi8(1);
+        const __m128i invalid = _mm_set1_epi8(KmerKernels::sInvalid);
+
+        uint64_t bad = 0;
+        uint64_t i = 0;
+        for (; i + 16 <= pLen; i += 16)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBases + i));
+            __m128i l = _mm_or_si128(x, lower);
+            __m128i ok = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(l, a), _mm_cmpeq_epi8(l, c)),
+                                      _mm_or_si128(_mm_cmpeq_epi8(l, g), _mm_cmpeq_epi8(l, t)));
+            __m128i code = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(x, 1), three),
+                                         _mm_and_si128(_mm_srli_epi16(x, 2), one));
+            code = _mm_or_si128(_mm_and_si128(ok, code), _mm_andnot_si128(ok, invalid));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pCodes + i), code);
+            bad += 16 - Gossamer::popcnt(_mm_movemask_epi8(ok));
+        }
+        return bad + KmerKernels::encodeScalar(pBases + i, pLen - i, pCodes + i);
+    }
+#endif
+
+#ifdef GOSS_KMER_KERNELS_AVX2
+    __attribute__((target("avx2")))
+    uint64_t encodeAvx2(const char* pBases, uint64_t pLen, uint8_t* pCodes)
+    {
+        const __m256i lower = _mm256_set1_epi8(0x20);
+        const __m256i a = _mm256_set1_epi8('a');
+        const __m256i c = _mm256_set1_epi8('c');
+        const __m256i g = _mm256_set1_epi8('g');
+        const __m256i t = _mm256_set1_epi8('t');
+        const __m256i three = _mm256_set1_epi8(3);
+        const __m256i one = _mm256_set1_epi8(1);
+        const __m256i invalid = _mm256_set1_epi8(KmerKernels::sInvalid);
+
+        uint64_t bad = 0;
+        uint64_t i = 0;
+        for (; i + 32 <= pLen; i += 32)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBases + i));
+            __m256i l = _mm256_or_si256(x, lower);
+            __m256i ok = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(l, a), _mm256_cmpeq_epi8(l, c)),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(l, g), _mm256_cmpeq_epi8(l, t)));
+            __m256i code = _mm256_xor_si256(_mm256_and_si256(_mm256_srli_epi16(x, 1), three),
+                                            _mm256_and_si256(_mm256_srli_epi16(x, 2), one));
+            code = _mm256_blendv_epi8(invalid, code, ok);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pCodes + i), code);
+            bad += 32 - Gossamer::popcnt(static_cast<uint32_t>(_mm256_movemask_epi8(ok)));
+        }
+        return bad + encodeSse2(pBases + i, pLen - i, pCodes + i);
+    }
+#endif
+
+    typedef uint64_t (*Encoder)(const char*, uint64_t, uint8_t*);
+
+    Encoder chooseEncoder()
+    {
+#ifdef GOSS_KMER_KERNELS_AVX2
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return encodeAvx2;
+        }
+#endif
+#ifdef GOSS_KMER_KERNELS_SSE2
+        return encodeSse2;
+#else
+        return KmerKernels::encodeScalar;
+#endif
+    }
+
+    const Encoder sEncoder = chooseEncoder();
+
+    struct Appender
+    {
+        void operator()(uint64_t pOffset, const Gossamer::edge_type& pKmer, const Gossamer::edge_type& pRc)
+        {
+            mKmers.push_back(pKmer);
+            if (mNormalize)
+            {
+                mKmers.back().normalizeWith(pRc);
+            }
+        }
+
+        void operator()(uint64_t pOffset, uint64_t pKmer, uint64_t pRc)
+        {
+            mKmers.push_back(Gossamer::edge_type(pKmer));
+            if (mNormalize)
+            {
+                mKmers.back().normalizeWith(Gossamer::edge_type(pRc));
+            }
+        }
+
+        Appender(bool pNormalize, vector<Gossamer::edge_type>& pKmers)
+            : mNormalize(pNormalize), mKmers(pKmers)
+        {
+        }
+
+        const bool mNormalize;
+        vector<Gossamer::edge_type>& mKmers;
+    };
+
+} // namespace anonymous
+
+
+uint64_t
+KmerKernels::encode(const char* pBases, uint64_t pLen, uint8_t* pCodes)
+{
+    return sEncoder(pBases, pLen, pCodes);
+}
+
+
+uint64_t
+KmerKernels::encodeScalar(const char* pBases, uint64_t pLen, uint8_t* pCodes)
+{
+    uint64_t bad = 0;
+    for (uint64_t i = 0; i < pLen; ++i)
+    {
+        uint8_t x = sCodes[static_cast<uint8_t>(pBases[i])];
+        pCodes[i] = x;
+        bad += (x == sInvalid);
+    }
+    return bad;
+}
+
+
+void
+KmerKernels::kmers(const string& pRead, uint64_t pK, bool pNormalize,
+                   vector<uint8_t>& pCodes, vector<Gossamer::edge_type>& pKmers)
+{
+    pCodes.resize(pRead.size());
+    if (pRead.empty())
+    {
+        return;
+    }
+    encode(pRead.data(), pRead.size(), &pCodes[0]);
+    Appender app(pNormalize, pKmers);
+    if (pK <= 32)
+    {
+        // Short kmers roll much faster in a machine word.
+        roll<uint64_t>(&pCodes[0], pCodes.size(), pK, app);
+    }
+    else
+    {
+        roll<Gossamer::edge_type>(&pCodes[0], pCodes.size(), pK, app);
+    }
+}
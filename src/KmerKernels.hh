@@ -0,0 +1,97 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef KMERKERNELS_HH
+#define KMERKERNELS_HH
+
+#ifndef GOSSAMER_HH
+#include "Gossamer.hh"
+#endif
+
+#ifndef STDINT_H
+#include <stdint.h>
+#define STDINT_H
+#endif
+
+#ifndef STD_STRING
+#include <string>
+#define STD_STRING
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+// Whole-read kmer extraction.
+//
+// A read is first translated to 2-bit base codes in one pass (using
+// SSE2 where the target has it, AVX2 where the CPU also has it, and a
+// table otherwise), then the forward and reverse complement kmers are
+// rolled along together, so that each base costs a shift and an or on
+// each strand, rather than a full rebuild or reverse complement of the
+// kmer.
+//
+class KmerKernels
+{
+public:
+    // The code for anything other than A, C, G or T (in either case).
+    static const uint8_t sInvalid = 4;
+
+    // Translate pLen ASCII bases to codes: A = 0, C = 1, G = 2, T = 3,
+    // and sInvalid for anything else. Returns the number of invalid
+    // bases.
+    static uint64_t encode(const char* pBases, uint64_t pLen, uint8_t* pCodes);
+
+    // The same, a base at a time.
+    static uint64_t encodeScalar(const char* pBases, uint64_t pLen, uint8_t* pCodes);
+
+    // Call pVis(offset, kmer, rcKmer) for each kmer of pK bases in
+    // pCodes which doesn't contain an invalid base. Kmer may be
+    // uint64_t (for pK <= 32) or Gossamer::edge_type.
+    template <typename Kmer, typename Vis>
+    static void roll(const uint8_t* pCodes, uint64_t pLen, uint64_t pK, Vis& pVis)
+    {
+        if (pLen < pK || pK == 0)
+        {
+            return;
+        }
+        const uint64_t shift = 2 * (pK - 1);
+        Kmer mask(1);
+        mask <<= shift;
+        --mask;
+        mask <<= 2;
+        mask |= Kmer(3);
+        const Kmer comp[4] = { Kmer(3) << shift, Kmer(2) << shift, Kmer(1) << shift, Kmer(0) };
+        Kmer x(0);
+        Kmer y(0);
+        uint64_t n = 0;             // The number of valid bases in x.
+        for (uint64_t i = 0; i < pLen; ++i)
+        {
+            uint64_t c = pCodes[i];
+            if (c == sInvalid)
+            {
+                n = 0;
+                continue;
+            }
+            x = ((x << 2) | Kmer(c)) & mask;
+            y = (y >> 2) | comp[c];
+            if (++n >= pK)
+            {
+                pVis(i + 1 - pK, x, y);
+            }
+        }
+    }
+
+    // Append the kmers of pRead to pKmers, normalizing them if
+    // pNormalize is set. pCodes is scratch space.
+    static void kmers(const std::string& pRead, uint64_t pK, bool pNormalize,
+                      std::vector<uint8_t>& pCodes, std::vector<Gossamer::edge_type>& pKmers);
+};
+
+#endif // KMERKERNELS_HH
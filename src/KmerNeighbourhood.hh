@@ -0,0 +1,202 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef KMERNEIGHBOURHOOD_HH
+#define KMERNEIGHBOURHOOD_HH
+
+#ifndef GOSSAMER_HH
+#include "Gossamer.hh"
+#endif
+
+#ifndef KMERSET_HH
+#include "KmerSet.hh"
+#endif
+
+#ifndef PROGRESSMONITOR_HH
+#include "ProgressMonitor.hh"
+#endif
+
+#ifndef THREADGROUP_HH
+#include "ThreadGroup.hh"
+#endif
+
+#ifndef STD_ALGORITHM
+#include <algorithm>
+#define STD_ALGORITHM
+#endif
+
+#ifndef STD_ATOMIC
+#include <atomic>
+#define STD_ATOMIC
+#endif
+
+#ifndef STD_MUTEX
+#include <mutex>
+#define STD_MUTEX
+#endif
+
+#ifndef STD_UTILITY
+#include <utility>
+#define STD_UTILITY
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+// Finds the members of a KmerSet which are a single base substitution
+// away from other members of the set.
+//
+// Rather than probing the set once per neighbour, the neighbours of a
+// batch of kmers are generated, normalized and sorted, duplicates are
+// dropped, and the survivors are looked up with the batched (prefetching)
+// accessAndRank, in kmer order.
+//
+// scanAll() carves the rank space into chunks, which are a multiple of
+// 64 ranks long, and hands them out to threads. All the visits for a
+// given kmer are made by the thread which owns its chunk, so a visitor
+// may record per-kmer results in a plain bit vector, one bit per rank,
+// without locking.
+//
+class KmerNeighbourhood
+{
+public:
+    static const uint64_t sBatchSize = 1024;
+    static const uint64_t sChunkSize = 1ULL << 16;
+
+    // For each kmer with rank in [pBegin, pEnd) for which pWanted(rank)
+    // is true, call pVis(rank, nbrRank) for every other member of the
+    // set which is one substitution away from it (in either orientation).
+    template <typename Wanted, typename Vis>
+    void scan(uint64_t pBegin, uint64_t pEnd, const Wanted& pWanted, Vis& pVis) const
+    {
+        std::vector<Probe> probes;
+        std::vector<Gossamer::position_type> xs;
+        std::vector<Gossamer::rank_type> rnks;
+        std::vector<uint8_t> found;
+
+        uint64_t i = pBegin;
+        while (i < pEnd)
+        {
+            probes.clear();
+            for (uint64_t n = 0; i < pEnd && n < sBatchSize; ++i)
+            {
+                if (!pWanted(i))
+                {
+                    continue;
+                }
+                ++n;
+                neighbours(mKmers.select(i).value(), i, probes);
+            }
+            if (probes.empty())
+            {
+                continue;
+            }
+
+            std::sort(probes.begin(), probes.end());
+
+            xs.clear();
+            for (uint64_t j = 0; j < probes.size(); ++j)
+            {
+                if (xs.empty() || xs.back() != probes[j].first)
+                {
+                    xs.push_back(probes[j].first);
+                }
+            }
+            rnks.resize(xs.size());
+            found.resize(xs.size());
+            mKmers.accessAndRank(xs.begin(), xs.end(), rnks.begin(), found.begin());
+
+            for (uint64_t j = 0, k = 0; j < probes.size(); ++j)
+            {
+                if (xs[k] != probes[j].first)
+                {
+                    ++k;
+                }
+                if (found[k] && rnks[k] != probes[j].second)
+                {
+                    pVis(probes[j].second, rnks[k]);
+                }
+            }
+        }
+    }
+
+    // As for scan(), over the whole set, on pNumThreads threads. pVis is
+    // called concurrently, but calls for ranks in the same 64 bit word
+    // are always made from the same thread. pChunkSize is rounded down
+    // to a multiple of 64.
+    template <typename Wanted, typename Vis>
+    void scanAll(uint64_t pNumThreads, const Wanted& pWanted, Vis& pVis,
+                 ProgressMonitorNew& pMon, uint64_t pChunkSize = sChunkSize) const
+    {
+        const uint64_t z = mKmers.count();
+        const uint64_t S = std::max<uint64_t>(64, pChunkSize & ~63ULL);
+        std::atomic<uint64_t> next(0);
+        std::atomic<uint64_t> done(0);
+        std::mutex monMut;
+
+        auto worker = [&] () {
+            while (true)
+            {
+                uint64_t b = S * next++;
+                if (b >= z)
+                {
+                    return;
+                }
+                uint64_t e = std::min(z, b + S);
+                scan(b, e, pWanted, pVis);
+
+                done += e - b;
+                std::unique_lock<std::mutex> lk(monMut, std::try_to_lock);
+                if (lk.owns_lock())
+                {
+                    pMon.tick(done);
+                }
+            }
+        };
+
+        ThreadGroup grp;
+        for (uint64_t t = 1; t < pNumThreads; ++t)
+        {
+            grp.create(worker);
+        }
+        worker();
+        grp.join();
+    }
+
+    KmerNeighbourhood(const KmerSet& pKmers)
+        : mKmers(pKmers), mK(pKmers.K())
+    {
+    }
+
+private:
+    typedef std::pair<Gossamer::position_type,Gossamer::rank_type> Probe;
+
+    // Append the normalized single substitution neighbours of pX.
+    void neighbours(const Gossamer::position_type& pX, Gossamer::rank_type pRank,
+                    std::vector<Probe>& pProbes) const
+    {
+        for (uint64_t j = 0; j < mK; ++j)
+        {
+            for (uint64_t b = 1; b < 4; ++b)
+            {
+                Gossamer::position_type y(b);
+                y <<= 2 * j;
+                y ^= pX;
+                y.normalize(mK);
+                pProbes.push_back(Probe(y, pRank));
+            }
+        }
+    }
+
+    const KmerSet& mKmers;
+    const uint64_t mK;
+};
+
+#endif // KMERNEIGHBOURHOOD_HH
@@ -125,6 +125,12 @@ public:
         {
         }
 
+        // Start at the kmer with the given rank.
+        Iterator(const KmerSet& pKmerSet, Gossamer::rank_type pRank)
+            : mKmersItr(pKmerSet.mKmers.iterator(pRank))
+        {
+        }
+
     private:
         SparseArray::Iterator mKmersItr;
     };
@@ -218,6 +224,13 @@ public:
         return mKmers.accessAndRank(pEdge.value(), pRank);
     }
 
+    // Look up the kmers in [pBegin, pEnd) as a batch.
+    template <typename EdgeItr, typename RankItr, typename FoundItr>
+    void accessAndRank(EdgeItr pBegin, EdgeItr pEnd, RankItr pRanks, FoundItr pFound) const
+    {
+        mKmers.accessAndRank(pBegin, pEnd, pRanks, pFound);
+    }
+
     std::pair<Gossamer::rank_type,Gossamer::rank_type> rank(const Edge& pLhs, const Edge& pRhs) const
     {
         return mKmers.rank(pLhs.value(), pRhs.value());
@@ -17,53 +17,36 @@
 #include "GossamerException.hh"
 #endif
 
+#ifndef KMERKERNELS_HH
+#include "KmerKernels.hh"
+#endif
+
 class KmerizingAdapter
 {
 public:
     bool valid()
     {
-        return mKmers.valid();
+        return mCurr < mKmers.size();
     }
 
     Gossamer::edge_type operator*() const
     {
-        BOOST_ASSERT(mKmers.valid());
-        return mKmer;
+        BOOST_ASSERT(mCurr < mKmers.size());
+        return mKmers[mCurr];
     }
 
     void operator++()
     {
-        ++mKmers;
-        while (!mKmers.valid() && mReads.valid())
-        {
-            ++mReads;
-            if (mReads.valid())
-            {
-                mKmers = GossRead::Iterator(*mReads, mK);
-            }
-        }
-        if (mKmers.valid())
+        if (++mCurr == mKmers.size())
         {
-            mKmer = mKmers.kmer();
+            nextRead();
         }
     }
 
     KmerizingAdapter(GossReadSequence& pReads, uint64_t pK)
-        : mReads(checkValid(pReads)), mK(pK), mKmers(GossRead::Iterator(*mReads, mK)),
-          mKmer(0)
+        : mReads(checkValid(pReads)), mK(pK), mCurr(0)
     {
-        while (!mKmers.valid() && mReads.valid())
-        {
-            ++mReads;
-            if (mReads.valid())
-            {
-                mKmers = GossRead::Iterator(*mReads, mK);
-            }
-        }
-        if (mKmers.valid())
-        {
-            mKmer = mKmers.kmer();
-        }
+        nextRead();
     }
 
 private:
@@ -79,10 +62,23 @@ private:
         return pReads;
     }
 
+    // Extract all the kmers of the next read which has any.
+    void nextRead()
+    {
+        mKmers.clear();
+        mCurr = 0;
+        while (mKmers.empty() && mReads.valid())
+        {
+            KmerKernels::kmers((*mReads).read(), mK, false, mCodes, mKmers);
+            ++mReads;
+        }
+    }
+
     GossReadSequence& mReads;
     const uint64_t mK;
-    GossRead::Iterator mKmers;
-    Gossamer::edge_type mKmer;
+    std::vector<uint8_t> mCodes;
+    std::vector<Gossamer::edge_type> mKmers;
+    uint64_t mCurr;
 };
 
 #endif // KMERIZINGADAPTER_HH
@@ -8,6 +8,9 @@
 //
 #include "LineSource.hh"
 
+#include <string.h>
+#include <algorithm>
+
 
 LineSource::~LineSource()
 {
@@ -76,3 +79,180 @@ BackgroundLineSource::BackgroundLineSource(const FileThunkIn& pIn)
 }
 
 
+bool
+BlockLineSource::valid() const
+{
+    return mValid;
+}
+
+
+const LineSource::value_type&
+BlockLineSource::operator*() const
+{
+    BOOST_ASSERT(valid());
+    if (!mLineCached)
+    {
+        mLine.assign(mCurr, mEol);
+        mLineCached = true;
+    }
+    return mLine;
+}
+
+
+LineSource::Range
+BlockLineSource::range() const
+{
+    BOOST_ASSERT(valid());
+    return Range(mCurr, mEol);
+}
+
+
+void
+BlockLineSource::operator++()
+{
+    BOOST_ASSERT(valid());
+    mLineCached = false;
+    mCurr = mEol + 1;
+    if (mCurr < mEnd)
+    {
+        findEol();
+        return;
+    }
+    nextBlock();
+}
+
+
+BlockLineSource::BlockLineSource(const FileThunkIn& pIn, uint64_t pBlockSize)
+    : LineSource(pIn), mFileHolder(pIn()), mBlockSize(pBlockSize),
+      mFull(sNumBlocks), mFree(sNumBlocks), mValid(false),
+      mCurr(0), mEol(0), mEnd(0), mLineCached(false)
+{
+    for (uint64_t i = 0; i < sNumBlocks; ++i)
+    {
+        mFree.put(std::make_shared<Block>());
+    }
+    mThread = std::thread([this] () { reader(); });
+    try
+    {
+        nextBlock();
+    }
+    catch (...)
+    {
+        // The destructor will not run, so stop the reader here.
+        mFree.finish();
+        mThread.join();
+        throw;
+    }
+}
+
+
+BlockLineSource::~BlockLineSource()
+{
+    // The reader only ever waits for free blocks, so finishing
+    // the free queue is enough to make it stop.
+    mFree.finish();
+    mThread.join();
+}
+
+
+void
+BlockLineSource::findEol()
+{
+    mEol = static_cast<const char*>(memchr(mCurr, '\n', mEnd - mCurr));
+    if (!mEol)
+    {
+        mEol = mEnd;
+    }
+}
+
+
+void
+BlockLineSource::nextBlock()
+{
+    if (mBlock)
+    {
+        mFree.put(mBlock);
+        mBlock = BlockPtr();
+    }
+    mValid = mFull.get(mBlock);
+    if (!mValid)
+    {
+        if (mError)
+        {
+            std::rethrow_exception(mError);
+        }
+        return;
+    }
+    mCurr = &mBlock->mData[0];
+    mEnd = mCurr + mBlock->mSize;
+    findEol();
+}
+
+
+// Fill blocks from the input so that each block holds only whole
+// lines. The partial line at the end of one block is carried over
+// to the start of the next.
+//
+void
+BlockLineSource::reader()
+{
+    try
+    {
+        std::istream& in(**mFileHolder);
+        std::vector<char> carry;
+        BlockPtr blk;
+        while ((in.good() || carry.size()) && mFree.get(blk))
+        {
+            std::vector<char>& buf(blk->mData);
+            if (buf.size() < std::max<uint64_t>(mBlockSize, 2 * carry.size()))
+            {
+                buf.resize(std::max<uint64_t>(mBlockSize, 2 * carry.size()));
+            }
+            std::copy(carry.begin(), carry.end(), buf.begin());
+            uint64_t n = carry.size();
+            carry.clear();
+
+            while (true)
+            {
+                while (n < buf.size() && in.good())
+                {
+                    in.read(&buf[n], buf.size() - n);
+                    n += in.gcount();
+                }
+                if (!in.good())
+                {
+                    break;
+                }
+                uint64_t l = n;
+                while (l > 0 && buf[l - 1] != '\n')
+                {
+                    --l;
+                }
+                if (l > 0)
+                {
+                    carry.assign(buf.begin() + l, buf.begin() + n);
+                    n = l;
+                    break;
+                }
+
+                // A single line longer than the block.
+                buf.resize(2 * buf.size());
+            }
+
+            if (n == 0)
+            {
+                break;
+            }
+            blk->mSize = n;
+            mFull.put(blk);
+            blk = BlockPtr();
+        }
+    }
+    catch (...)
+    {
+        mError = std::current_exception();
+    }
+    mFull.finish();
+}
+
+
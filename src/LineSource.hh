@@ -14,6 +14,21 @@
 #define STD_STRING
 #endif
 
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+#ifndef STD_THREAD
+#include <thread>
+#define STD_THREAD
+#endif
+
+#ifndef STD_EXCEPTION
+#include <exception>
+#define STD_EXCEPTION
+#endif
+
 #ifndef BOOST_MAKE_SHARED_HPP
 #include <boost/make_shared.hpp>
 #define BOOST_MAKE_SHARED_HPP
@@ -37,6 +52,10 @@
 #include "BackgroundBlockProducer.hh"
 #endif
 
+#ifndef BOUNDEDQUEUE_HH
+#include "BoundedQueue.hh"
+#endif
+
 
 class LineSource : private boost::noncopyable
 {
@@ -52,6 +71,43 @@ protected:
 public:
     typedef std::string value_type;
 
+    /**
+     * A view of the characters of a line held by a line source.
+     * It is only valid until the source is advanced.
+     */
+    class Range
+    {
+    public:
+        const char* begin() const
+        {
+            return mBegin;
+        }
+
+        const char* end() const
+        {
+            return mEnd;
+        }
+
+        uint64_t size() const
+        {
+            return mEnd - mBegin;
+        }
+
+        char operator[](uint64_t pIdx) const
+        {
+            return mBegin[pIdx];
+        }
+
+        Range(const char* pBegin, const char* pEnd)
+            : mBegin(pBegin), mEnd(pEnd)
+        {
+        }
+
+    private:
+        const char* mBegin;
+        const char* mEnd;
+    };
+
     /**
      * Return true if there is at least one line remaining in the source.
      */
@@ -62,6 +118,15 @@ public:
      */
     virtual const std::string& operator*() const = 0;
 
+    /**
+     * Get the current line without copying it, if the source allows.
+     */
+    virtual Range range() const
+    {
+        const std::string& l(**this);
+        return Range(l.data(), l.data() + l.size());
+    }
+
     /**
      * Advance to the next line.
      */
@@ -124,6 +189,70 @@ private:
     BackgroundBlockProducer<PlainLineSource> mBackground;
 };
 
+/**
+ * A line source which reads its input in large blocks on a background
+ * thread, and hands out lines as ranges within the current block rather
+ * than allocating a string per line.
+ */
+class BlockLineSource : public LineSource
+{
+public:
+    static const uint64_t DefaultBlockSize = 4ULL * 1024ULL * 1024ULL;
+
+    bool valid() const;
+
+    const value_type& operator*() const;
+
+    Range range() const;
+
+    void operator++();
+
+    BlockLineSource(const FileThunkIn& pIn, uint64_t pBlockSize = DefaultBlockSize);
+
+    ~BlockLineSource();
+
+    static LineSourcePtr
+    create(const FileThunkIn& pIn)
+    {
+        return boost::make_shared<BlockLineSource>(pIn);
+    }
+
+private:
+    static const uint64_t sNumBlocks = 4;
+
+    struct Block
+    {
+        std::vector<char> mData;
+        uint64_t mSize;
+
+        Block()
+            : mSize(0)
+        {
+        }
+    };
+    typedef std::shared_ptr<Block> BlockPtr;
+
+    void reader();
+
+    void nextBlock();
+
+    void findEol();
+
+    FileFactory::InHolderPtr mFileHolder;
+    const uint64_t mBlockSize;
+    BoundedQueue<BlockPtr> mFull;
+    BoundedQueue<BlockPtr> mFree;
+    std::exception_ptr mError;
+    BlockPtr mBlock;
+    bool mValid;
+    const char* mCurr;
+    const char* mEol;
+    const char* mEnd;
+    mutable bool mLineCached;
+    mutable std::string mLine;
+    std::thread mThread;
+};
+
 typedef std::function<LineSourcePtr (const FileThunkIn&)> LineSourceFactory;
 
 #endif // LINESOURCE_HH
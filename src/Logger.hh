@@ -95,6 +95,13 @@ public:
         return *this;
     }
 
+    // Append lines formatted by another Logger, such as one writing
+    // to a buffer on a worker thread.
+    void append(const std::string& pLines)
+    {
+        mOut << pLines;
+    }
+
     void sync()
     {
         mOut.flush();
@@ -0,0 +1,145 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef LOSERTREE_HH
+#define LOSERTREE_HH
+
+#ifndef STDINT_H
+#include <stdint.h>
+#define STDINT_H
+#endif
+
+#ifndef STD_FUNCTIONAL
+#include <functional>
+#define STD_FUNCTIONAL
+#endif
+
+#ifndef STD_UTILITY
+#include <utility>
+#define STD_UTILITY
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+// A tournament tree of losers, for merging k sorted sources.
+//
+// Each source must provide valid(), operator*() (returning a reference)
+// and operator++(), as the FileInWrapper and Merger classes in
+// ExternalSortUtils.hh do. The tree holds the loser of the match at
+// each internal node, so moving on from the winner costs one comparison
+// per level (log2 k), rather than the 2 log2 k of a binary heap.
+//
+// Ties are won by the source with the lower index, so the merge is
+// stable with respect to the order of the sources.
+//
+template <typename Src, typename T, typename Cmp = std::less<T> >
+class LoserTree
+{
+public:
+    bool valid() const
+    {
+        return !mSrcs.empty() && mSrcs[mWinner]->valid();
+    }
+
+    const T& operator*() const
+    {
+        return **mSrcs[mWinner];
+    }
+
+    // The index of the source whose item is current.
+    uint64_t winner() const
+    {
+        return mWinner;
+    }
+
+    void operator++()
+    {
+        ++(*mSrcs[mWinner]);
+        replay(mWinner);
+    }
+
+    LoserTree(const std::vector<Src*>& pSrcs, const Cmp& pCmp = Cmp())
+        : mSrcs(pSrcs), mCmp(pCmp), mLosers(pSrcs.size(), 0), mWinner(0)
+    {
+        const uint64_t k = mSrcs.size();
+        std::vector<uint64_t> win(2 * k);
+        for (uint64_t i = 0; i < k; ++i)
+        {
+            win[k + i] = i;
+        }
+        for (uint64_t n = k - 1; n > 0 && n < k; --n)
+        {
+            uint64_t a = win[2 * n];
+            uint64_t b = win[2 * n + 1];
+            if (beats(a, b))
+            {
+                win[n] = a;
+                mLosers[n] = b;
+            }
+            else
+            {
+                win[n] = b;
+                mLosers[n] = a;
+            }
+        }
+        if (k > 1)
+        {
+            mWinner = win[1];
+        }
+    }
+
+private:
+    // Does source pLhs beat source pRhs? Exhausted sources lose to
+    // everything.
+    bool beats(uint64_t pLhs, uint64_t pRhs) const
+    {
+        const Src& l(*mSrcs[pLhs]);
+        const Src& r(*mSrcs[pRhs]);
+        if (!l.valid())
+        {
+            return false;
+        }
+        if (!r.valid())
+        {
+            return true;
+        }
+        if (mCmp(*l, *r))
+        {
+            return true;
+        }
+        if (mCmp(*r, *l))
+        {
+            return false;
+        }
+        return pLhs < pRhs;
+    }
+
+    // Play source pSrc up the tree from its leaf.
+    void replay(uint64_t pSrc)
+    {
+        const uint64_t k = mSrcs.size();
+        for (uint64_t n = (pSrc + k) / 2; n > 0; n /= 2)
+        {
+            if (beats(mLosers[n], pSrc))
+            {
+                std::swap(mLosers[n], pSrc);
+            }
+        }
+        mWinner = pSrc;
+    }
+
+    std::vector<Src*> mSrcs;
+    Cmp mCmp;
+    std::vector<uint64_t> mLosers;
+    uint64_t mWinner;
+};
+
+#endif // LOSERTREE_HH
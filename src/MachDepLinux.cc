@@ -11,6 +11,8 @@
 #include <execinfo.h>
 #include <bitset>
 #include <time.h>
+#include <limits>
+#include <sys/resource.h>
 #include <sys/signal.h>
 
 namespace Gossamer {
@@ -22,6 +24,30 @@ namespace Gossamer {
         return tmpdir ? tmpdir : fallback;
     }
 
+    uint64_t openFileLimit(uint64_t pWanted)
+    {
+        struct rlimit lim;
+        if (getrlimit(RLIMIT_NOFILE, &lim) != 0)
+        {
+            return 0;
+        }
+        if (lim.rlim_cur != RLIM_INFINITY && lim.rlim_cur < pWanted)
+        {
+            rlim_t want = pWanted;
+            if (lim.rlim_max != RLIM_INFINITY && lim.rlim_max < want)
+            {
+                want = lim.rlim_max;
+            }
+            struct rlimit raised = lim;
+            raised.rlim_cur = want;
+            if (setrlimit(RLIMIT_NOFILE, &raised) == 0)
+            {
+                lim = raised;
+            }
+        }
+        return lim.rlim_cur == RLIM_INFINITY ? std::numeric_limits<uint64_t>::max() : lim.rlim_cur;
+    }
+
 }
 
 namespace Gossamer { namespace Linux {
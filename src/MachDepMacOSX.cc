@@ -12,6 +12,8 @@
 #include <bitset>
 #include <mach/mach.h>
 #include <mach/mach_time.h>
+#include <limits>
+#include <sys/resource.h>
 #include <sys/signal.h>
 #include <sys/sysctl.h>
 #include <sys/types.h>
@@ -107,6 +109,30 @@ namespace MacOSX {
         return tmpdir ? tmpdir : fallback;
     }
 
+    uint64_t openFileLimit(uint64_t pWanted)
+    {
+        struct rlimit lim;
+        if (getrlimit(RLIMIT_NOFILE, &lim) != 0)
+        {
+            return 0;
+        }
+        if (lim.rlim_cur != RLIM_INFINITY && lim.rlim_cur < pWanted)
+        {
+            rlim_t want = pWanted;
+            if (lim.rlim_max != RLIM_INFINITY && lim.rlim_max < want)
+            {
+                want = lim.rlim_max;
+            }
+            struct rlimit raised = lim;
+            raised.rlim_cur = want;
+            if (setrlimit(RLIMIT_NOFILE, &raised) == 0)
+            {
+                lim = raised;
+            }
+        }
+        return lim.rlim_cur == RLIM_INFINITY ? std::numeric_limits<uint64_t>::max() : lim.rlim_cur;
+    }
+
     uint32_t
     logicalProcessorCount()
     {
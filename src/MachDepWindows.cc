@@ -9,7 +9,9 @@
 //#include "Utils.hh"
 
 #include "Utils.hh"
+#include <algorithm>
 #include <bitset>
+#include <stdio.h>
 #include <signal.h>
 #include <DbgHelp.h>
 
@@ -26,6 +28,20 @@ namespace Gossamer {
         return val ? val : fallBack;
     }
 
+    uint64_t openFileLimit(uint64_t pWanted)
+    {
+        int n = _getmaxstdio();
+        if (static_cast<uint64_t>(n) < pWanted)
+        {
+            int r = _setmaxstdio(static_cast<int>(std::min<uint64_t>(pWanted, 8192)));
+            if (r != -1)
+            {
+                n = r;
+            }
+        }
+        return n;
+    }
+
 }
 
 
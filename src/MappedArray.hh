@@ -21,6 +21,10 @@
 #include "Properties.hh"
 #endif
 
+#ifndef UTILS_HH
+#include "Utils.hh"
+#endif
+
 #ifndef ERRNO_H
 #include <errno.h>
 #define ERRNO_H
@@ -116,8 +120,8 @@ public:
             return mArray->size();
         }
 
-        Iterator(const MappedArray<T>* pArray)
-            : mArray(pArray), mPos(0)
+        Iterator(const MappedArray<T>* pArray, uint64_t pPos = 0)
+            : mArray(pArray), mPos(pPos)
         {
         }
 
@@ -200,6 +204,12 @@ public:
         return Iterator(this);
     }
 
+    // Iterate from the given position.
+    Iterator iterator(uint64_t pPos) const
+    {
+        return Iterator(this, pPos);
+    }
+
     static LazyIterator lazyIterator(const std::string& pBaseName, FileFactory& pFactory)
     {
         return LazyIterator(pBaseName, pFactory);
@@ -219,6 +229,12 @@ public:
         return mItems[pIdx];
     }
 
+    // Hint that item pIdx will be read soon.
+    void prefetch(uint64_t pIdx) const
+    {
+        Gossamer::prefetch(mItems + pIdx);
+    }
+
     const T* begin() const
     {
         return mItems;
@@ -40,8 +40,8 @@ public:
         mSorter.sort(pDest);
     }
 
-    PacketSorter(uint64_t pBufferSize, FileFactory& pFactory)
-        : mSorter(pBufferSize, pFactory)
+    PacketSorter(uint64_t pBufferSize, FileFactory& pFactory, uint64_t pNumThreads = 1)
+        : mSorter(pBufferSize, pFactory, pNumThreads)
     {
     }
 
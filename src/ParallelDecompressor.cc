@@ -0,0 +1,683 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "ParallelDecompressor.hh"
+
+#include "GossamerException.hh"
+
+#include <algorithm>
+#include <string>
+#include <zlib.h>
+#include <bzlib.h>
+
+using namespace std;
+
+namespace // anonymous
+{
+    const uint64_t sReadSize = 1ULL << 20;
+    const uint64_t sOutSize = 4ULL << 20;
+    const uint64_t sMaxJoins = 2;
+
+    const uint64_t bzBlockMagic = 0x314159265359ULL;
+    const uint64_t bzEosMagic = 0x177245385090ULL;
+    const uint64_t bzMagicMask = 0xffffffffffffULL;
+
+    void decompressError(const string& pMsg)
+    {
+        BOOST_THROW_EXCEPTION(
+            Gossamer::error()
+                << Gossamer::general_error_info(pMsg));
+    }
+
+    uint32_t le16(const vector<char>& pBuf, uint64_t pOff)
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&pBuf[pOff]);
+        return uint32_t(p[0]) | (uint32_t(p[1]) << 8);
+    }
+
+    uint32_t le32(const vector<char>& pBuf, uint64_t pOff)
+    {
+        return le16(pBuf, pOff) | (le16(pBuf, pOff + 2) << 16);
+    }
+
+    // Return the total size of the BGZF member whose header begins at
+    // pOff, or zero if the header does not describe a BGZF member.
+    // The whole header, including the extra field, must be present.
+    //
+    uint64_t bgzfMemberSize(const vector<char>& pBuf, uint64_t pOff)
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&pBuf[pOff]);
+        if (p[0] != 0x1f || p[1] != 0x8b || p[2] != 8 || !(p[3] & 4))
+        {
+            return 0;
+        }
+        uint64_t xlen = le16(pBuf, pOff + 10);
+        uint64_t i = 0;
+        while (i + 4 <= xlen)
+        {
+            uint64_t slen = le16(pBuf, pOff + 12 + i + 2);
+            if (p[12 + i] == 'B' && p[12 + i + 1] == 'C' && slen == 2
+                && i + 6 <= xlen)
+            {
+                return le16(pBuf, pOff + 12 + i + 4) + 1;
+            }
+            i += 4 + slen;
+        }
+        return 0;
+    }
+
+    class BitWriter
+    {
+    public:
+        // Append the low pNumBits (at most 56) of pBits, most significant first.
+        void put(uint64_t pBits, uint64_t pNumBits)
+        {
+            mAcc = (mAcc << pNumBits) | (pBits & ((1ULL << pNumBits) - 1));
+            mCount += pNumBits;
+            while (mCount >= 8)
+            {
+                mCount -= 8;
+                mOut.push_back(static_cast<char>(mAcc >> mCount));
+            }
+        }
+
+        vector<char>& flush()
+        {
+            if (mCount)
+            {
+                put(0, 8 - mCount);
+            }
+            return mOut;
+        }
+
+        BitWriter()
+            : mAcc(0), mCount(0)
+        {
+        }
+
+    private:
+        uint64_t mAcc;
+        uint64_t mCount;
+        vector<char> mOut;
+    };
+
+    uint64_t getBit(const vector<char>& pBuf, uint64_t pBit)
+    {
+        return (static_cast<uint8_t>(pBuf[pBit / 8]) >> (7 - pBit % 8)) & 1;
+    }
+
+} // namespace anonymous
+
+
+ParallelDecompressor::ParallelDecompressor(istream& pIn, Format pFormat, uint64_t pNumThreads)
+    : mIn(pIn), mFormat(pFormat), mNumThreads(std::max<uint64_t>(1, pNumThreads)),
+      mOrdered(4 * mNumThreads), mWork(4 * mNumThreads), mStop(false)
+{
+    setg(0, 0, 0);
+    for (uint64_t i = 0; i < mNumThreads; ++i)
+    {
+        mThreads.create([this] () { worker(); });
+    }
+    mThreads.create([this] () { reader(); });
+}
+
+
+ParallelDecompressor::~ParallelDecompressor()
+{
+    // Every chunk goes on the ordered queue before the work queue, and
+    // they have the same capacity, so draining the ordered queue is
+    // enough to let the reader run to completion.
+    mStop = true;
+    ChunkPtr c;
+    while (mOrdered.get(c))
+    {
+    }
+    mThreads.join();
+}
+
+
+ParallelDecompressor::int_type
+ParallelDecompressor::underflow()
+{
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    mCurr = ChunkPtr();
+    while (true)
+    {
+        ChunkPtr c;
+        if (!mOrdered.get(c))
+        {
+            setg(0, 0, 0);
+            return traits_type::eof();
+        }
+        try
+        {
+            c->mReady.get();
+        }
+        catch (Gossamer::error&)
+        {
+            if (!c->mJoinable)
+            {
+                throw;
+            }
+            c = join(c);
+        }
+        if (c->mOut.size())
+        {
+            mCurr = c;
+            break;
+        }
+    }
+
+    char* b = &mCurr->mOut[0];
+    setg(b, b, b + mCurr->mOut.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+
+void
+ParallelDecompressor::reader()
+{
+    try
+    {
+        vector<char> buf;
+        switch (mFormat)
+        {
+            case Gzip:
+            {
+                fill(buf, 12);
+                if (buf.size() >= 12
+                    && fill(buf, 12 + le16(buf, 10))
+                    && bgzfMemberSize(buf, 0))
+                {
+                    readBgzf(buf);
+                }
+                else
+                {
+                    readGzip(buf);
+                }
+                break;
+            }
+            case Bzip2:
+            {
+                readBzip2(buf);
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        ChunkPtr c(std::make_shared<Chunk>());
+        c->mDone.set_exception(std::current_exception());
+        mOrdered.put(c);
+    }
+    mWork.finish();
+    mOrdered.finish();
+}
+
+
+// Inflate an ordinary gzip file, which may consist of several
+// concatenated members, on the reader thread.
+//
+void
+ParallelDecompressor::readGzip(vector<char>& pBuf)
+{
+    fill(pBuf, 1);
+    if (pBuf.empty())
+    {
+        return;
+    }
+
+    z_stream zs;
+    zs.zalloc = Z_NULL;
+    zs.zfree = Z_NULL;
+    zs.opaque = Z_NULL;
+    zs.next_in = Z_NULL;
+    zs.avail_in = 0;
+    if (inflateInit2(&zs, 15 + 16) != Z_OK)
+    {
+        decompressError("unable to initialise zlib");
+    }
+    std::shared_ptr<z_stream> guard(&zs, inflateEnd);
+
+    zs.next_in = reinterpret_cast<Bytef*>(&pBuf[0]);
+    zs.avail_in = pBuf.size();
+
+    ChunkPtr out(std::make_shared<Chunk>());
+    out->mOut.resize(sOutSize);
+    uint64_t outPos = 0;
+    bool ended = false;
+    while (!mStop)
+    {
+        if (zs.avail_in == 0)
+        {
+            pBuf.clear();
+            if (!fill(pBuf, 1))
+            {
+                break;
+            }
+            zs.next_in = reinterpret_cast<Bytef*>(&pBuf[0]);
+            zs.avail_in = pBuf.size();
+        }
+
+        zs.next_out = reinterpret_cast<Bytef*>(&out->mOut[outPos]);
+        zs.avail_out = out->mOut.size() - outPos;
+        int r = inflate(&zs, Z_NO_FLUSH);
+        outPos = out->mOut.size() - zs.avail_out;
+        if (outPos == out->mOut.size())
+        {
+            emit(out);
+            out = std::make_shared<Chunk>();
+            out->mOut.resize(sOutSize);
+            outPos = 0;
+        }
+
+        if (r == Z_STREAM_END)
+        {
+            ended = true;
+            if (zs.avail_in < 2)
+            {
+                vector<char> rest(zs.next_in, zs.next_in + zs.avail_in);
+                pBuf.swap(rest);
+                fill(pBuf, 2);
+                zs.next_in = reinterpret_cast<Bytef*>(pBuf.size() ? &pBuf[0] : 0);
+                zs.avail_in = pBuf.size();
+            }
+            if (zs.avail_in < 2 || zs.next_in[0] != 0x1f || zs.next_in[1] != 0x8b)
+            {
+                // Like gzip, ignore anything trailing the last member.
+                break;
+            }
+            inflateReset(&zs);
+            ended = false;
+            continue;
+        }
+        if (r != Z_OK)
+        {
+            decompressError(string("error in gzip data: ") + (zs.msg ? zs.msg : "unknown error"));
+        }
+    }
+
+    if (!ended && !mStop)
+    {
+        decompressError("unexpected end of gzip data");
+    }
+    if (outPos)
+    {
+        out->mOut.resize(outPos);
+        emit(out);
+    }
+}
+
+
+// Split a BGZF file into its members, to be inflated by the workers.
+//
+void
+ParallelDecompressor::readBgzf(vector<char>& pBuf)
+{
+    uint64_t pos = 0;
+    auto need = [&] (uint64_t pN) {
+        if (pBuf.size() - pos >= pN)
+        {
+            return true;
+        }
+        pBuf.erase(pBuf.begin(), pBuf.begin() + pos);
+        pos = 0;
+        return fill(pBuf, pN);
+    };
+
+    while (!mStop)
+    {
+        if (!need(1))
+        {
+            break;
+        }
+        if (!need(12) || !need(12 + le16(pBuf, pos + 10)))
+        {
+            decompressError("unexpected end of BGZF data");
+        }
+        uint64_t sz = bgzfMemberSize(pBuf, pos);
+        if (sz < 12 + le16(pBuf, pos + 10) + 8)
+        {
+            decompressError("gzip member is not in BGZF format");
+        }
+        if (!need(sz))
+        {
+            decompressError("unexpected end of BGZF data");
+        }
+        ChunkPtr c(std::make_shared<Chunk>());
+        c->mIn.assign(pBuf.begin() + pos, pBuf.begin() + pos + sz);
+        pos += sz;
+        dispatch(c);
+    }
+}
+
+
+// Scan a bzip2 file for block boundaries, and hand out the blocks to
+// be decoded by the workers.
+//
+void
+ParallelDecompressor::readBzip2(vector<char>& pBuf)
+{
+    fill(pBuf, 4);
+    if (pBuf.empty())
+    {
+        return;
+    }
+    if (pBuf.size() < 4 || pBuf[0] != 'B' || pBuf[1] != 'Z' || pBuf[2] != 'h')
+    {
+        decompressError("bzip2 data does not begin with a valid header");
+    }
+
+    uint64_t base = 0;      // The byte offset of pBuf[0] in the input.
+    uint64_t pos = 0;       // The next byte of pBuf to scan.
+    uint64_t bits = 0;      // The number of bits scanned.
+    uint64_t window = 0;
+    bool inSegment = false;
+    bool inEos = false;
+    uint64_t segStart = 0;
+
+    // Everything from one magic number to the next is handed out, even
+    // the stream trailers which follow end of stream magic numbers, so
+    // that a block split by a spurious magic number can be put back
+    // together again.
+    auto segment = [&] (uint64_t pEnd) {
+        ChunkPtr c(std::make_shared<Chunk>());
+        c->mIn.assign(pBuf.begin() + (segStart / 8 - base),
+                      pBuf.begin() + ((pEnd + 7) / 8 - base));
+        c->mStartBit = segStart % 8;
+        c->mNumBits = pEnd - segStart;
+        c->mJoinable = true;
+        c->mEos = inEos;
+        dispatch(c);
+    };
+
+    while (!mStop)
+    {
+        if (pos == pBuf.size())
+        {
+            // Retain the current segment, or enough to hold a magic number.
+            uint64_t keep = inSegment ? segStart / 8 : std::max<uint64_t>(base, bits / 8 - std::min<uint64_t>(bits / 8, 6));
+            pBuf.erase(pBuf.begin(), pBuf.begin() + (keep - base));
+            pos -= keep - base;
+            base = keep;
+            if (!fill(pBuf, pBuf.size() + 1))
+            {
+                break;
+            }
+        }
+
+        uint8_t x = pBuf[pos++];
+        for (int i = 7; i >= 0; --i)
+        {
+            window = (window << 1) | ((x >> i) & 1);
+            ++bits;
+            uint64_t m = window & bzMagicMask;
+            if (bits < 48 || (m != bzBlockMagic && m != bzEosMagic))
+            {
+                continue;
+            }
+
+            uint64_t start = bits - 48;
+            if (inSegment)
+            {
+                segment(start);
+            }
+            inSegment = true;
+            inEos = (m == bzEosMagic);
+            segStart = start;
+        }
+    }
+
+    if (mStop)
+    {
+        return;
+    }
+    if (inSegment && !inEos)
+    {
+        decompressError("unexpected end of bzip2 data");
+    }
+    if (inSegment)
+    {
+        segment(bits);
+    }
+}
+
+
+void
+ParallelDecompressor::worker()
+{
+    ChunkPtr c;
+    while (mWork.get(c))
+    {
+        try
+        {
+            if (!mStop)
+            {
+                if (mFormat == Gzip)
+                {
+                    inflateBgzf(*c);
+                }
+                else if (!c->mEos)
+                {
+                    decodeBzip2(*c);
+                }
+            }
+            c->mDone.set_value();
+        }
+        catch (...)
+        {
+            c->mDone.set_exception(std::current_exception());
+        }
+        c = ChunkPtr();
+    }
+}
+
+
+bool
+ParallelDecompressor::fill(vector<char>& pBuf, uint64_t pWanted)
+{
+    while (pBuf.size() < pWanted && mIn.good())
+    {
+        uint64_t n = pBuf.size();
+        uint64_t w = std::max(pWanted - n, sReadSize);
+        pBuf.resize(n + w);
+        mIn.read(&pBuf[n], w);
+        pBuf.resize(n + mIn.gcount());
+    }
+    return pBuf.size() >= pWanted;
+}
+
+
+void
+ParallelDecompressor::dispatch(const ChunkPtr& pChunk)
+{
+    mOrdered.put(pChunk);
+    mWork.put(pChunk);
+}
+
+
+void
+ParallelDecompressor::emit(const ChunkPtr& pChunk)
+{
+    pChunk->mDone.set_value();
+    mOrdered.put(pChunk);
+}
+
+
+// A bzip2 block failed to decode, most likely because a magic number
+// turned up by chance in the compressed data, and split the block in
+// two. Join it with the following chunk and try again.
+//
+ParallelDecompressor::ChunkPtr
+ParallelDecompressor::join(const ChunkPtr& pChunk)
+{
+    std::exception_ptr err = std::current_exception();
+    ChunkPtr j(pChunk);
+    for (uint64_t i = 0; i < sMaxJoins; ++i)
+    {
+        ChunkPtr n;
+        if (!mOrdered.get(n))
+        {
+            break;
+        }
+        try
+        {
+            n->mReady.get();
+        }
+        catch (...)
+        {
+            if (!n->mJoinable)
+            {
+                throw;
+            }
+        }
+
+        ChunkPtr m(std::make_shared<Chunk>());
+        uint64_t endBit = j->mStartBit + j->mNumBits;
+        m->mIn.assign(j->mIn.begin(), j->mIn.begin() + endBit / 8);
+        m->mIn.insert(m->mIn.end(), n->mIn.begin(), n->mIn.end());
+        m->mStartBit = j->mStartBit;
+        m->mNumBits = j->mNumBits + n->mNumBits;
+        m->mJoinable = true;
+        try
+        {
+            decodeBzip2(*m);
+            return m;
+        }
+        catch (Gossamer::error&)
+        {
+        }
+        j = m;
+    }
+    std::rethrow_exception(err);
+}
+
+
+void
+ParallelDecompressor::inflateBgzf(Chunk& pChunk)
+{
+    const vector<char>& in(pChunk.mIn);
+    uint64_t xlen = le16(in, 10);
+    uint64_t n = in.size();
+    uint32_t crc = le32(in, n - 8);
+    uint32_t isize = le32(in, n - 4);
+
+    vector<char>& out(pChunk.mOut);
+    out.resize(isize);
+    char dummy;
+
+    z_stream zs;
+    zs.zalloc = Z_NULL;
+    zs.zfree = Z_NULL;
+    zs.opaque = Z_NULL;
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(&in[12 + xlen]));
+    zs.avail_in = n - 12 - xlen - 8;
+    if (inflateInit2(&zs, -15) != Z_OK)
+    {
+        decompressError("unable to initialise zlib");
+    }
+    zs.next_out = reinterpret_cast<Bytef*>(isize ? &out[0] : &dummy);
+    zs.avail_out = isize;
+    int r = inflate(&zs, Z_FINISH);
+    bool ok = r == Z_STREAM_END && zs.avail_out == 0;
+    inflateEnd(&zs);
+
+    if (!ok)
+    {
+        decompressError("error in BGZF data");
+    }
+    if (crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(isize ? &out[0] : &dummy), isize) != crc)
+    {
+        decompressError("CRC error in BGZF data");
+    }
+    vector<char>().swap(pChunk.mIn);
+}
+
+
+// Decode one bzip2 block by wrapping it up as a complete stream of
+// its own: a header, the block, an end of stream marker, and a
+// stream CRC which for a single block is just the block CRC.
+//
+void
+ParallelDecompressor::decodeBzip2(Chunk& pChunk)
+{
+    const vector<char>& in(pChunk.mIn);
+    const uint64_t s = pChunk.mStartBit;
+    const uint64_t n = pChunk.mNumBits;
+    if (n < 80)
+    {
+        decompressError("error in bzip2 data");
+    }
+
+    BitWriter w;
+    w.put('B', 8);
+    w.put('Z', 8);
+    w.put('h', 8);
+    w.put('9', 8);
+
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&in[0]);
+    uint64_t i = 0;
+    for (; 8 * i + 8 <= n; ++i)
+    {
+        uint8_t b = s ? static_cast<uint8_t>((p[i] << s) | (p[i + 1] >> (8 - s))) : p[i];
+        w.put(b, 8);
+    }
+    for (uint64_t j = s + 8 * i; j < s + n; ++j)
+    {
+        w.put(getBit(in, j), 1);
+    }
+
+    uint64_t crc = 0;
+    for (uint64_t j = s + 48; j < s + 80; ++j)
+    {
+        crc = (crc << 1) | getBit(in, j);
+    }
+    w.put(bzEosMagic, 48);
+    w.put(crc, 32);
+    vector<char>& stream(w.flush());
+
+    bz_stream bs;
+    bs.bzalloc = NULL;
+    bs.bzfree = NULL;
+    bs.opaque = NULL;
+    if (BZ2_bzDecompressInit(&bs, 0, 0) != BZ_OK)
+    {
+        decompressError("unable to initialise bzip2");
+    }
+    std::shared_ptr<bz_stream> guard(&bs, BZ2_bzDecompressEnd);
+
+    vector<char>& out(pChunk.mOut);
+    out.resize(std::max<uint64_t>(sReadSize, 4 * stream.size()));
+    bs.next_in = &stream[0];
+    bs.avail_in = stream.size();
+    uint64_t outPos = 0;
+    while (true)
+    {
+        if (outPos == out.size())
+        {
+            out.resize(2 * out.size());
+        }
+        bs.next_out = &out[outPos];
+        bs.avail_out = out.size() - outPos;
+        int r = BZ2_bzDecompress(&bs);
+        outPos = out.size() - bs.avail_out;
+        if (r == BZ_STREAM_END)
+        {
+            break;
+        }
+        if (r != BZ_OK || (bs.avail_in == 0 && bs.avail_out > 0))
+        {
+            decompressError("error in bzip2 data");
+        }
+    }
+    out.resize(outPos);
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef PARALLELDECOMPRESSOR_HH
+#define PARALLELDECOMPRESSOR_HH
+
+#ifndef STD_ISTREAM
+#include <istream>
+#define STD_ISTREAM
+#endif
+
+#ifndef STD_STREAMBUF
+#include <streambuf>
+#define STD_STREAMBUF
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+#ifndef STD_FUTURE
+#include <future>
+#define STD_FUTURE
+#endif
+
+#ifndef STD_ATOMIC
+#include <atomic>
+#define STD_ATOMIC
+#endif
+
+#ifndef STD_MEMORY
+#include <memory>
+#define STD_MEMORY
+#endif
+
+#ifndef BOOST_NONCOPYABLE_HPP
+#include <boost/noncopyable.hpp>
+#define BOOST_NONCOPYABLE_HPP
+#endif
+
+#ifndef BOUNDEDQUEUE_HH
+#include "BoundedQueue.hh"
+#endif
+
+#ifndef THREADGROUP_HH
+#include "ThreadGroup.hh"
+#endif
+
+// A stream buffer which decompresses gzip or bzip2 data using
+// several threads, presenting the result as an ordinary input stream.
+//
+// gzip input written in the BGZF format (as by bgzip and samtools)
+// consists of independent members of at most 64k, each of which
+// records its own size, so members are inflated in parallel.
+// Other gzip input can only be inflated serially, so this is done
+// on a background thread ahead of the consumer.
+//
+// bzip2 blocks are independently coded, but start at arbitrary bit
+// offsets. The blocks are found by scanning for the block header
+// magic number, and each one is decoded in parallel by wrapping it
+// in a single block stream. The magic number may also turn up inside
+// compressed data; when a block fails to decode, it is joined to the
+// following one and decoded again.
+//
+class ParallelDecompressor : public std::streambuf, private boost::noncopyable
+{
+public:
+    enum Format { Gzip, Bzip2 };
+
+    ParallelDecompressor(std::istream& pIn, Format pFormat, uint64_t pNumThreads);
+
+    ~ParallelDecompressor();
+
+protected:
+    int_type underflow();
+
+private:
+    struct Chunk
+    {
+        std::vector<char> mIn;
+        uint64_t mStartBit;
+        uint64_t mNumBits;
+        bool mJoinable;
+        bool mEos;
+        std::vector<char> mOut;
+        std::promise<void> mDone;
+        std::future<void> mReady;
+
+        Chunk()
+            : mStartBit(0), mNumBits(0), mJoinable(false), mEos(false), mDone(), mReady(mDone.get_future())
+        {
+        }
+    };
+    typedef std::shared_ptr<Chunk> ChunkPtr;
+
+    void reader();
+
+    void readGzip(std::vector<char>& pBuf);
+
+    void readBgzf(std::vector<char>& pBuf);
+
+    void readBzip2(std::vector<char>& pBuf);
+
+    void worker();
+
+    bool fill(std::vector<char>& pBuf, uint64_t pWanted);
+
+    void dispatch(const ChunkPtr& pChunk);
+
+    void emit(const ChunkPtr& pChunk);
+
+    ChunkPtr join(const ChunkPtr& pChunk);
+
+    static void inflateBgzf(Chunk& pChunk);
+
+    static void decodeBzip2(Chunk& pChunk);
+
+    std::istream& mIn;
+    const Format mFormat;
+    const uint64_t mNumThreads;
+    BoundedQueue<ChunkPtr> mOrdered;
+    BoundedQueue<ChunkPtr> mWork;
+    std::atomic<bool> mStop;
+    ChunkPtr mCurr;
+    ThreadGroup mThreads;
+};
+
+#endif // PARALLELDECOMPRESSOR_HH
@@ -0,0 +1,149 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef PARALLELEDGEFILTER_HH
+#define PARALLELEDGEFILTER_HH
+
+#ifndef GRAPH_HH
+#include "Graph.hh"
+#endif
+
+#ifndef PROGRESSMONITOR_HH
+#include "ProgressMonitor.hh"
+#endif
+
+#ifndef THREADGROUP_HH
+#include "ThreadGroup.hh"
+#endif
+
+#ifndef STD_ALGORITHM
+#include <algorithm>
+#define STD_ALGORITHM
+#endif
+
+#ifndef STD_MEMORY
+#include <memory>
+#define STD_MEMORY
+#endif
+
+#ifndef STD_UTILITY
+#include <utility>
+#define STD_UTILITY
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+// Build a new graph from the edges of an existing graph which satisfy a
+// predicate, such as a coverage cutoff.
+//
+// The rank space is carved into segments, which are filtered a round
+// at a time, one segment per thread. The survivors of each round are
+// pushed into the builder, in order, while the next round is filtered.
+//
+class ParallelEdgeFilter
+{
+public:
+    static const uint64_t sSegmentSize = 1ULL << 20;
+
+    // Push the edges of pGraph for which pKeep(edge, count) is true
+    // into pOut. pKeep is called concurrently from several threads.
+    template <typename Keep>
+    static void filter(const Graph& pGraph, Graph::Builder& pOut, const Keep& pKeep,
+                       uint64_t pNumThreads, ProgressMonitorNew& pMon,
+                       uint64_t pSegmentSize = sSegmentSize)
+    {
+        auto keep = [&pKeep] (uint64_t pRank, const Graph::Edge& pEdge, uint32_t pCount) {
+            return pKeep(pEdge, pCount);
+        };
+        filterByRank(pGraph, pOut, keep, pNumThreads, pMon, pSegmentSize);
+    }
+
+    // As for filter, but pKeep(rank, edge, count) is also given the
+    // rank of the edge.
+    template <typename Keep>
+    static void filterByRank(const Graph& pGraph, Graph::Builder& pOut, const Keep& pKeep,
+                             uint64_t pNumThreads, ProgressMonitorNew& pMon,
+                             uint64_t pSegmentSize = sSegmentSize)
+    {
+        const uint64_t T = std::max<uint64_t>(1, pNumThreads);
+        const uint64_t S = std::max<uint64_t>(1, pSegmentSize);
+        const uint64_t z = pGraph.count();
+
+        std::vector<Segment> curr(T);
+        std::vector<Segment> next(T);
+        uint64_t begin = 0;
+        launch(pGraph, pKeep, begin, z, S, curr)->join();
+
+        while (begin < z)
+        {
+            uint64_t nextBegin = std::min(z, begin + T * S);
+            std::unique_ptr<ThreadGroup> grp;
+            if (nextBegin < z)
+            {
+                grp = launch(pGraph, pKeep, nextBegin, z, S, next);
+            }
+
+            for (uint64_t t = 0; t < T; ++t)
+            {
+                const Segment& seg(curr[t]);
+                for (uint64_t i = 0; i < seg.size(); ++i)
+                {
+                    pOut.push_back(seg[i].first, seg[i].second);
+                }
+                pMon.tick(std::min(z, begin + (t + 1) * S));
+            }
+
+            if (grp)
+            {
+                grp->join();
+            }
+            curr.swap(next);
+            begin = nextBegin;
+        }
+    }
+
+private:
+    typedef std::vector<std::pair<Gossamer::position_type,uint32_t> > Segment;
+
+    // Start one thread per segment, filtering the round of segments
+    // beginning at rank pBegin.
+    template <typename Keep>
+    static std::unique_ptr<ThreadGroup> launch(const Graph& pGraph, const Keep& pKeep,
+                                               uint64_t pBegin, uint64_t pEnd, uint64_t pSegmentSize,
+                                               std::vector<Segment>& pSegs)
+    {
+        std::unique_ptr<ThreadGroup> grp(new ThreadGroup);
+        for (uint64_t t = 0; t < pSegs.size(); ++t)
+        {
+            uint64_t b = std::min(pEnd, pBegin + t * pSegmentSize);
+            uint64_t e = std::min(pEnd, b + pSegmentSize);
+            Segment* seg = &pSegs[t];
+            seg->clear();
+            if (b == e)
+            {
+                continue;
+            }
+            grp->create([&pGraph, &pKeep, b, e, seg] () {
+                Graph::Iterator itr(pGraph, b);
+                for (uint64_t r = b; r < e; ++r, ++itr)
+                {
+                    if (pKeep(r, (*itr).first, (*itr).second))
+                    {
+                        seg->push_back(std::make_pair((*itr).first.value(), (*itr).second));
+                    }
+                }
+            });
+        }
+        return grp;
+    }
+};
+
+#endif // PARALLELEDGEFILTER_HH
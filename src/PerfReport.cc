@@ -0,0 +1,332 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "PerfReport.hh"
+
+#include "JsonWriter.hh"
+#include "Profile.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/algorithm/string/trim.hpp>
+#include <chrono>
+#include <mutex>
+#include <sys/resource.h>
+
+using namespace std;
+
+namespace // anonymous
+{
+    double wallNow()
+    {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count() * 1e-6;
+    }
+
+    double seconds(const struct timeval& pTv)
+    {
+        return pTv.tv_sec + pTv.tv_usec * 1e-6;
+    }
+
+    double cpuNow()
+    {
+        struct rusage u;
+        getrusage(RUSAGE_SELF, &u);
+        return seconds(u.ru_utime) + seconds(u.ru_stime);
+    }
+
+    struct PhaseRecord
+    {
+        string name;
+        double start;
+        double wall;
+        double cpu;
+    };
+
+    struct ProgressRecord
+    {
+        string unit;
+        uint64_t items;
+        uint64_t total;
+        double seconds;
+    };
+
+    struct QueueRecord
+    {
+        uint64_t capacity;
+        uint64_t puts;
+        uint64_t sumItems;
+        uint64_t maxItems;
+        uint64_t fullWaits;
+        uint64_t emptyWaits;
+    };
+
+    std::atomic<double> sStart(wallNow());
+    std::atomic<double> sUserStart(0);
+    std::atomic<double> sSystemStart(0);
+
+    std::atomic<bool> sEnabled(false);
+
+    std::atomic<uint64_t> sBytesRead(0);
+    std::atomic<uint64_t> sBytesWritten(0);
+    std::atomic<uint64_t> sBytesMapped(0);
+    std::atomic<uint64_t> sFilesRead(0);
+    std::atomic<uint64_t> sFilesWritten(0);
+    std::atomic<uint64_t> sFilesMapped(0);
+
+    std::mutex sMutex;
+    vector<PhaseRecord> sPhases;
+    vector<ProgressRecord> sProgress;
+    vector<QueueRecord> sQueues;
+
+    bool byStart(const PhaseRecord& pLhs, const PhaseRecord& pRhs)
+    {
+        return pLhs.start < pRhs.start;
+    }
+
+    bool byLabel(const Profile::NodePtr& pLhs, const Profile::NodePtr& pRhs)
+    {
+        return string(pLhs->label) < string(pRhs->label);
+    }
+
+    void writeProfile(JsonWriter& pJson, const Profile::Node& pNode)
+    {
+        pJson.beginObject();
+        pJson.field("label", pNode.label);
+        pJson.field("calls", pNode.calls);
+        pJson.field("seconds", pNode.time * 1e-9);
+        vector<Profile::NodePtr> kids;
+        for (auto& k : pNode.kids)
+        {
+            kids.push_back(k.second);
+        }
+        std::sort(kids.begin(), kids.end(), byLabel);
+        pJson.key("children").beginArray();
+        for (uint64_t i = 0; i < kids.size(); ++i)
+        {
+            writeProfile(pJson, *kids[i]);
+        }
+        pJson.endArray();
+        pJson.endObject();
+    }
+}
+// namespace anonymous
+
+PerfReport::Phase::Phase(const string& pName)
+    : mName(pName), mWallStart(wallNow()), mCpuStart(cpuNow())
+{
+}
+
+PerfReport::Phase::~Phase()
+{
+    if (!sEnabled)
+    {
+        return;
+    }
+    PhaseRecord r;
+    r.name = mName;
+    r.start = mWallStart - sStart;
+    r.wall = wallNow() - mWallStart;
+    r.cpu = cpuNow() - mCpuStart;
+
+    std::unique_lock<std::mutex> lk(sMutex);
+    sPhases.push_back(r);
+}
+
+void
+PerfReport::enable(bool pEnabled)
+{
+    sEnabled = pEnabled;
+}
+
+bool
+PerfReport::enabled()
+{
+    return sEnabled;
+}
+
+void
+PerfReport::reset()
+{
+    struct rusage u;
+    getrusage(RUSAGE_SELF, &u);
+
+    std::unique_lock<std::mutex> lk(sMutex);
+    sStart = wallNow();
+    sUserStart = seconds(u.ru_utime);
+    sSystemStart = seconds(u.ru_stime);
+    sBytesRead = 0;
+    sBytesWritten = 0;
+    sBytesMapped = 0;
+    sFilesRead = 0;
+    sFilesWritten = 0;
+    sFilesMapped = 0;
+    sPhases.clear();
+    sProgress.clear();
+    sQueues.clear();
+}
+
+void
+PerfReport::addBytesRead(uint64_t pBytes)
+{
+    if (!sEnabled)
+    {
+        return;
+    }
+    sBytesRead += pBytes;
+    ++sFilesRead;
+}
+
+void
+PerfReport::addBytesWritten(uint64_t pBytes)
+{
+    if (!sEnabled)
+    {
+        return;
+    }
+    sBytesWritten += pBytes;
+    ++sFilesWritten;
+}
+
+void
+PerfReport::addBytesMapped(uint64_t pBytes)
+{
+    if (!sEnabled)
+    {
+        return;
+    }
+    sBytesMapped += pBytes;
+    ++sFilesMapped;
+}
+
+void
+PerfReport::addProgress(const string& pUnit, uint64_t pItems, uint64_t pTotal, double pSeconds)
+{
+    if (!sEnabled)
+    {
+        return;
+    }
+    ProgressRecord r;
+    r.unit = boost::algorithm::trim_copy(pUnit);
+    r.items = pItems;
+    r.total = pTotal;
+    r.seconds = pSeconds;
+
+    std::unique_lock<std::mutex> lk(sMutex);
+    sProgress.push_back(r);
+}
+
+void
+PerfReport::addQueue(uint64_t pCapacity, uint64_t pPuts, uint64_t pSumItems,
+                     uint64_t pMaxItems, uint64_t pFullWaits, uint64_t pEmptyWaits)
+{
+    if (!sEnabled)
+    {
+        return;
+    }
+    QueueRecord r;
+    r.capacity = pCapacity;
+    r.puts = pPuts;
+    r.sumItems = pSumItems;
+    r.maxItems = pMaxItems;
+    r.fullWaits = pFullWaits;
+    r.emptyWaits = pEmptyWaits;
+
+    std::unique_lock<std::mutex> lk(sMutex);
+    sQueues.push_back(r);
+}
+
+void
+PerfReport::write(ostream& pOut, const string& pProgram, const string& pVersion,
+                  const string& pCommand, const vector<string>& pArgs, int pStatus)
+{
+    struct rusage u;
+    getrusage(RUSAGE_SELF, &u);
+
+    std::unique_lock<std::mutex> lk(sMutex);
+    JsonWriter j(pOut);
+    j.beginObject();
+    j.field("program", pProgram);
+    j.field("version", pVersion);
+    j.field("command", pCommand);
+    j.key("arguments").beginArray();
+    for (uint64_t i = 0; i < pArgs.size(); ++i)
+    {
+        j.value(pArgs[i]);
+    }
+    j.endArray();
+    j.field("status", pStatus);
+    j.field("wall_seconds", wallNow() - sStart);
+    j.field("user_seconds", seconds(u.ru_utime) - sUserStart);
+    j.field("system_seconds", seconds(u.ru_stime) - sSystemStart);
+    // Linux gives ru_maxrss in kilobytes.
+    j.field("peak_rss_bytes", static_cast<uint64_t>(u.ru_maxrss) * 1024);
+
+    j.key("io").beginObject();
+    j.field("files_read", sFilesRead.load());
+    j.field("bytes_read", sBytesRead.load());
+    j.field("files_written", sFilesWritten.load());
+    j.field("bytes_written", sBytesWritten.load());
+    j.field("files_mapped", sFilesMapped.load());
+    j.field("bytes_mapped", sBytesMapped.load());
+    j.endObject();
+
+    // Phases are recorded as they finish, so put them back in order.
+    std::sort(sPhases.begin(), sPhases.end(), byStart);
+    j.key("phases").beginArray();
+    for (uint64_t i = 0; i < sPhases.size(); ++i)
+    {
+        const PhaseRecord& r(sPhases[i]);
+        j.beginObject();
+        j.field("name", r.name);
+        j.field("start_seconds", r.start);
+        j.field("wall_seconds", r.wall);
+        j.field("cpu_seconds", r.cpu);
+        j.endObject();
+    }
+    j.endArray();
+
+    j.key("progress").beginArray();
+    for (uint64_t i = 0; i < sProgress.size(); ++i)
+    {
+        const ProgressRecord& r(sProgress[i]);
+        j.beginObject();
+        j.field("unit", r.unit);
+        j.field("items", r.items);
+        j.field("total", r.total);
+        j.field("seconds", r.seconds);
+        j.field("items_per_second", r.seconds > 0 ? r.items / r.seconds : 0.0);
+        j.endObject();
+    }
+    j.endArray();
+
+    j.key("queues").beginArray();
+    for (uint64_t i = 0; i < sQueues.size(); ++i)
+    {
+        const QueueRecord& r(sQueues[i]);
+        j.beginObject();
+        j.field("capacity", r.capacity);
+        j.field("puts", r.puts);
+        j.field("mean_occupancy", r.puts ? double(r.sumItems) / r.puts : 0.0);
+        j.field("max_occupancy", r.maxItems);
+        j.field("full_waits", r.fullWaits);
+        j.field("empty_waits", r.emptyWaits);
+        j.endObject();
+    }
+    j.endArray();
+
+    // Profile only gathers anything when built with GOSS_PROFILING_ENABLED.
+    j.key("profile");
+#ifdef GOSS_PROFILING_ENABLED
+    writeProfile(j, *Profile::merged());
+#else
+    writeProfile(j, Profile::Node("<root>"));
+#endif
+
+    j.endObject();
+}
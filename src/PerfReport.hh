@@ -0,0 +1,92 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef PERFREPORT_HH
+#define PERFREPORT_HH
+
+#ifndef STDINT_H
+#include <stdint.h>
+#define STDINT_H
+#endif
+
+#ifndef STD_OSTREAM
+#include <ostream>
+#define STD_OSTREAM
+#endif
+
+#ifndef STD_STRING
+#include <string>
+#define STD_STRING
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+// Performance figures gathered over the run of a command, which the
+// --perf-report option writes out as a JSON document. Everything is
+// static, and may be called from any thread. Nothing is gathered
+// unless the report is enabled.
+//
+class PerfReport
+{
+public:
+    // Turn gathering on or off.
+    static void enable(bool pEnabled);
+
+    static bool enabled();
+
+    // Forget everything gathered so far, and measure times from now.
+    // A process may run several commands, each with its own report.
+    static void reset();
+
+    // Record the wall and CPU time between construction and destruction
+    // as a named phase. The CPU time is that of the whole process, so
+    // includes all the threads working during the phase.
+    class Phase
+    {
+    public:
+        explicit Phase(const std::string& pName);
+
+        ~Phase();
+
+    private:
+        Phase(const Phase&);
+        Phase& operator=(const Phase&);
+
+        const std::string mName;
+        const double mWallStart;
+        const double mCpuStart;
+    };
+
+    // Bytes of files opened for reading, written, or mapped.
+    static void addBytesRead(uint64_t pBytes);
+    static void addBytesWritten(uint64_t pBytes);
+    static void addBytesMapped(uint64_t pBytes);
+
+    // A progress monitor saw pItems go by in pSeconds. pTotal is the
+    // number of items it expected, or 0 if it didn't know.
+    static void addProgress(const std::string& pUnit, uint64_t pItems, uint64_t pTotal,
+                            double pSeconds);
+
+    // A bounded queue of pCapacity items had pPuts items put on to it.
+    // pSumItems is the sum of its length after each put, and pMaxItems
+    // the longest it got.
+    static void addQueue(uint64_t pCapacity, uint64_t pPuts, uint64_t pSumItems,
+                         uint64_t pMaxItems, uint64_t pFullWaits, uint64_t pEmptyWaits);
+
+    // Write a JSON document with everything gathered since the last
+    // reset, along with the times since then, and the process's peak
+    // resident set size.
+    static void write(std::ostream& pOut, const std::string& pProgram,
+                      const std::string& pVersion, const std::string& pCommand,
+                      const std::vector<std::string>& pArgs, int pStatus);
+};
+
+#endif // PERFREPORT_HH
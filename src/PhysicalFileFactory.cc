@@ -10,6 +10,8 @@
 
 #include "GossamerException.hh"
 #include "MappedFile.hh"
+#include "ParallelDecompressor.hh"
+#include "PerfReport.hh"
 
 #include <stdint.h>
 #include <string.h>
@@ -32,6 +34,40 @@ using namespace Gossamer;
 namespace // anonymous
 {
 
+uint64_t
+fileSize(const string& pFileName)
+{
+    boost::system::error_code ec;
+    uintmax_t size = boost::filesystem::file_size(pFileName, ec);
+    return ec ? 0 : size;
+}
+
+// Adds the bytes written to a file to the performance report. It must
+// be the first member of an output holder, so that it is destroyed
+// after the streams above it have been flushed and closed.
+class WriteCounter
+{
+public:
+    WriteCounter(const string& pFileName, FileFactory::FileMode pMode)
+        : mFileName(pFileName), mStart(pMode == FileFactory::AppendMode ? fileSize(pFileName) : 0)
+    {
+    }
+
+    ~WriteCounter()
+    {
+        boost::system::error_code ec;
+        uint64_t end = boost::filesystem::file_size(mFileName, ec);
+        if (!ec)
+        {
+            PerfReport::addBytesWritten(end > mStart ? end - mStart : 0);
+        }
+    }
+
+private:
+    const string mFileName;
+    const uint64_t mStart;
+};
+
 class StdCinHolder : public FileFactory::InHolder
 {
 public:
@@ -64,6 +100,7 @@ public:
                     << errinfo_file_name(mFileName));
         }
         mFile.exceptions(std::ifstream::badbit);
+        PerfReport::addBytesRead(fileSize(mFileName));
     }
 
 private:
@@ -90,6 +127,7 @@ public:
                     << errinfo_file_name(mFileName));
         }
         mFile.exceptions(std::ifstream::badbit);
+        PerfReport::addBytesRead(fileSize(mFileName));
         mFilter.push(gzip_decompressor());
         mFilter.push(mFile);
     }
@@ -120,6 +158,7 @@ public:
                     << errinfo_file_name(mFileName));
         }
         mFile.exceptions(std::ifstream::badbit);
+        PerfReport::addBytesRead(fileSize(mFileName));
         mFilter.push(bzip2_decompressor(false, 63493103));
         mFilter.push(mFile);
     }
@@ -153,7 +192,7 @@ public:
     }
 
     PlainOutHolder(const string& pFileName, FileFactory::FileMode pMode)
-        : mFileName(pFileName), mFile(mFileName.c_str(), (pMode == FileFactory::TruncMode ? ios::trunc : ios::app) | ios::binary )
+        : mCounter(pFileName, pMode), mFileName(pFileName), mFile(mFileName.c_str(), (pMode == FileFactory::TruncMode ? ios::trunc : ios::app) | ios::binary )
     {
         if (!mFile.good())
         {
@@ -166,6 +205,7 @@ public:
     }
 
 private:
+    WriteCounter mCounter;
     string mFileName;
     std::ofstream mFile;
 };
@@ -202,7 +242,7 @@ public:
     }
 
     GzippedOutHolder(const string& pFileName, FileFactory::FileMode pMode)
-        : mFileName(pFileName), mFile(mFileName.c_str(), (pMode == FileFactory::TruncMode ? ios::trunc : ios::app) | ios::binary )
+        : mCounter(pFileName, pMode), mFileName(pFileName), mFile(mFileName.c_str(), (pMode == FileFactory::TruncMode ? ios::trunc : ios::app) | ios::binary )
     {
         if (!mFile.good())
         {
@@ -217,6 +257,7 @@ public:
     }
 
 private:
+    WriteCounter mCounter;
     string mFileName;
     std::ofstream mFile;
     filtering_stream<output> mFilter;
@@ -232,7 +273,7 @@ public:
     }
 
     BzippedOutHolder(const string& pFileName, FileFactory::FileMode pMode)
-        : mFileName(pFileName), mFile(mFileName.c_str(), (pMode == FileFactory::TruncMode ? ios::trunc : ios::app) | ios::binary )
+        : mCounter(pFileName, pMode), mFileName(pFileName), mFile(mFileName.c_str(), (pMode == FileFactory::TruncMode ? ios::trunc : ios::app) | ios::binary )
     {
         if (!mFile.good())
         {
@@ -247,12 +288,48 @@ public:
     }
 
 private:
+    WriteCounter mCounter;
     string mFileName;
     std::ofstream mFile;
     filtering_stream<output> mFilter;
 };
 
 
+class ParallelInHolder : public FileFactory::InHolder
+{
+public:
+    virtual istream& operator*()
+    {
+        return mStream;
+    }
+
+    ParallelInHolder(const string& pFileName, ParallelDecompressor::Format pFormat,
+                     uint64_t pNumThreads)
+        : mFileName(pFileName), mFile(mFileName.c_str(), ios::binary ), mStream(0)
+    {
+        if (!mFile.good())
+        {
+            BOOST_THROW_EXCEPTION(
+                Gossamer::error()
+                    << errinfo_errno(errno)
+                    << errinfo_file_name(mFileName));
+        }
+        mFile.exceptions(std::ifstream::badbit);
+        PerfReport::addBytesRead(fileSize(mFileName));
+        mBuf = std::unique_ptr<ParallelDecompressor>(
+                    new ParallelDecompressor(mFile, pFormat, pNumThreads));
+        mStream.rdbuf(mBuf.get());
+        mStream.exceptions(std::istream::badbit);
+    }
+
+private:
+    string mFileName;
+    std::ifstream mFile;
+    std::unique_ptr<ParallelDecompressor> mBuf;
+    std::istream mStream;
+};
+
+
 } // namespace anonymous
 
 
@@ -267,10 +344,20 @@ PhysicalFileFactory::in(const string& pFileName) const
     }
     if (mSpecialFileHandling && ends_with(pFileName, ".gz"))
     {
+        if (mDecompressionThreads)
+        {
+            return InHolderPtr(new ParallelInHolder(pFileName, ParallelDecompressor::Gzip,
+                                                    mDecompressionThreads));
+        }
         return InHolderPtr(new GzippedInHolder(pFileName));
     }
     if (mSpecialFileHandling && ends_with(pFileName, ".bz2"))
     {
+        if (mDecompressionThreads)
+        {
+            return InHolderPtr(new ParallelInHolder(pFileName, ParallelDecompressor::Bzip2,
+                                                    mDecompressionThreads));
+        }
         return InHolderPtr(new BzippedInHolder(pFileName));
     }
     return InHolderPtr(new PlainInHolder(pFileName));
@@ -303,7 +390,9 @@ PhysicalFileFactory::out(const string& pFileName, FileMode pMode) const
 FileFactory::MappedHolderPtr
 PhysicalFileFactory::map(const string& pFileName) const
 {
-    return MappedHolderPtr(new PlainMappedHolder(pFileName, mPopulate));
+    MappedHolderPtr m(new PlainMappedHolder(pFileName, mPopulate));
+    PerfReport::addBytesMapped(m->size());
+    return m;
 }
 
 // Remove a file
@@ -50,6 +50,13 @@ public:
         mPopulate = pPopulate;
     }
 
+    // Set the number of threads used to decompress gzipped and
+    // bzipped input. Zero means decompress serially in the caller.
+    void setDecompressionThreads(uint64_t pNumThreads)
+    {
+        mDecompressionThreads = pNumThreads;
+    }
+
     void turnOffSpecialFileHandling()
     {
         mSpecialFileHandling = false;
@@ -63,13 +70,14 @@ public:
     explicit PhysicalFileFactory(const std::string& pTmpDir = "/tmp",
                                  bool pSpecialFileHandling = true)
         : mSpecialFileHandling(pSpecialFileHandling), mPopulate(true),
-          mTmpDir(pTmpDir)
+          mDecompressionThreads(4), mTmpDir(pTmpDir)
     {
     }
 
 private:
     bool mSpecialFileHandling;
     bool mPopulate;
+    uint64_t mDecompressionThreads;
     std::string mTmpDir;
 };
 
@@ -190,7 +190,38 @@ public:
         }
     }
 
+    // The trees from all the threads, merged into one.
+    static NodePtr merged()
+    {
+        NodePtr root(new Node("<root>"));
+        std::unique_lock<std::mutex> lk(sMutex);
+        if (sThreadRoots)
+        {
+            for (uint64_t i = 0; i < sThreadRoots->size(); ++i)
+            {
+                merge(*root, *(*sThreadRoots)[i]);
+            }
+        }
+        return root;
+    }
+
 private:
+    static void merge(Node& pTo, const Node& pFrom)
+    {
+        pTo.calls += pFrom.calls;
+        pTo.time += pFrom.time;
+        for (std::unordered_map<const char*,NodePtr>::const_iterator i = pFrom.kids.begin();
+                i != pFrom.kids.end(); ++i)
+        {
+            NodePtr& kid(pTo.kids[i->first]);
+            if (!kid)
+            {
+                kid = NodePtr(new Node(i->first));
+            }
+            merge(*kid, *i->second);
+        }
+    }
+
     static std::mutex sMutex;
     static boost::thread_specific_ptr<NodePtr> sCurrentNodePtr;
     static RootsPtr sThreadRoots;
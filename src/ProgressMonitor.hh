@@ -43,6 +43,10 @@
 #define STD_CHRONO
 #endif
 
+#ifndef PERFREPORT_HH
+#include "PerfReport.hh"
+#endif
+
 #ifndef BOOST_TIMER_HPP
 #include <boost/timer.hpp>
 #define BOOST_TIMER_HPP
@@ -63,6 +67,7 @@ public:
     template <typename Actor>
     void tick(uint64_t pX, Actor& pAct)
     {
+        mX = pX;
         if (pX >= mNext)
         {
             double n = mN;
@@ -75,6 +80,7 @@ public:
     
     void tick(uint64_t pX)
     {
+        mX = pX;
         if (pX >= mNext)
         {
             double n = mN;
@@ -92,11 +98,22 @@ public:
     }
 
     ProgressMonitor(Logger& pLog, uint64_t pN, uint64_t pDivisions)
-        : mLog(pLog), mNext(0), mN(pN + 1), mTick(1 + mN / pDivisions),
-          mPrec(std::max(0.0, (double)std::ceil(std::log10((long double)pDivisions)) - 2))
+        : mLog(pLog), mX(0), mNext(0), mN(pN + 1), mTick(1 + mN / pDivisions),
+          mPrec(std::max(0.0, (double)std::ceil(std::log10((long double)pDivisions)) - 2)),
+          mStartTime(std::chrono::steady_clock::now())
     {
     }
 
+    ~ProgressMonitor()
+    {
+        using namespace std::chrono;
+        if (mX && PerfReport::enabled())
+        {
+            double secs = duration_cast<microseconds>(steady_clock::now() - mStartTime).count() * 1e-6;
+            PerfReport::addProgress("", mX, mN - 1, secs);
+        }
+    }
+
 private:
     
     void log(double p)
@@ -107,10 +124,12 @@ private:
     }
 
     Logger& mLog;
+    uint64_t mX;
     uint64_t mNext;
     const uint64_t mN;
     const uint64_t mTick;
     const uint64_t mPrec;
+    const std::chrono::steady_clock::time_point mStartTime;
 };
 
 
@@ -236,6 +255,16 @@ public:
     {
         mStartTime = monotonic_clock::now();
     }
+
+    ~ProgressMonitorNew()
+    {
+        using namespace std::chrono;
+        if (mX && PerfReport::enabled())
+        {
+            double secs = duration_cast<microseconds>(monotonic_clock::now() - mStartTime).count() * 1e-6;
+            PerfReport::addProgress("", mX, mN - 1, secs);
+        }
+    }
 };
 
 
@@ -127,15 +127,21 @@ namespace Gossamer
         {
             position_type rc(*this);
             rc.reverseComplement(pK);
+            normalizeWith(rc);
+        }
+
+        // Normalize, given the reverse complement of this k-mer.
+        void normalizeWith(param_type pRc)
+        {
             uint64_t h0 = Hash()(*this);
-            uint64_t h1 = Hash()(rc);
+            uint64_t h1 = Hash()(pRc);
             if (h0 > h1)
             {
-                *this = rc;
+                *this = pRc;
             }
-            else if (h0 == h1 && rc < *this)
+            else if (h0 == h1 && pRc < *this)
             {
-                *this = rc;
+                *this = pRc;
             }
         }
 
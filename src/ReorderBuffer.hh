@@ -0,0 +1,135 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef REORDERBUFFER_HH
+#define REORDERBUFFER_HH
+
+#ifndef STD_ALGORITHM
+#include <algorithm>
+#define STD_ALGORITHM
+#endif
+
+#ifndef STD_CONDITION_VARIABLE
+#include <condition_variable>
+#define STD_CONDITION_VARIABLE
+#endif
+
+#ifndef STD_MAP
+#include <map>
+#define STD_MAP
+#endif
+
+#ifndef STD_MUTEX
+#include <mutex>
+#define STD_MUTEX
+#endif
+
+#ifndef STDINT_H
+#include <stdint.h>
+#define STDINT_H
+#endif
+
+#ifndef BOOST_ASSERT_HPP
+#include <boost/assert.hpp>
+#define BOOST_ASSERT_HPP
+#endif
+
+/**
+ * Hands back items put by several threads in the order of their sequence
+ * numbers, which start at 0.
+ *
+ * To bound the number of items held, a producer must reserve() a sequence
+ * number before the item is made. This waits until it is less than the
+ * capacity ahead of the next item to be taken.
+ */
+template <typename T>
+class ReorderBuffer
+{
+public:
+    /**
+     * Wait until the item with the given sequence number may be made.
+     */
+    void reserve(uint64_t pSeq)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (pSeq >= mNext + mCapacity)
+        {
+            mSpaceCond.wait(lock);
+        }
+    }
+
+    /**
+     * Put the item with the given sequence number.
+     */
+    void put(uint64_t pSeq, const T& pItem)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        BOOST_ASSERT(pSeq >= mNext);
+        mItems[pSeq] = pItem;
+        if (pSeq == mNext)
+        {
+            mReadyCond.notify_one();
+        }
+    }
+
+    /**
+     * Get the next item in sequence, waiting for it if necessary.
+     * Once finish() has been called and all the items have been taken,
+     * return false.
+     */
+    bool get(T& pItem)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (!ready() && !mFinished)
+        {
+            mReadyCond.wait(lock);
+        }
+        if (!ready())
+        {
+            BOOST_ASSERT(mItems.empty());
+            return false;
+        }
+        typename std::map<uint64_t,T>::iterator i = mItems.begin();
+        std::swap(pItem, i->second);
+        mItems.erase(i);
+        ++mNext;
+        mSpaceCond.notify_all();
+        return true;
+    }
+
+    /**
+     * Indicate that all the items have been put.
+     */
+    void finish()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mFinished = true;
+        mReadyCond.notify_all();
+    }
+
+    explicit ReorderBuffer(uint64_t pCapacity)
+        : mCapacity(pCapacity), mNext(0), mFinished(false)
+    {
+    }
+
+private:
+    bool ready() const
+    {
+        return !mItems.empty() && mItems.begin()->first == mNext;
+    }
+
+    const uint64_t mCapacity;
+    uint64_t mNext;
+    bool mFinished;
+    std::map<uint64_t,T> mItems;
+    std::mutex mMutex;
+    std::condition_variable mSpaceCond;
+    std::condition_variable mReadyCond;
+};
+
+#endif // REORDERBUFFER_HH
@@ -0,0 +1,601 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "ResidentFileFactory.hh"
+
+#include "GossamerException.hh"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+#include <streambuf>
+#include <vector>
+
+using namespace std;
+
+typedef std::shared_ptr<const string> ContentPtr;
+typedef std::shared_ptr<string> OwnedContentPtr;
+
+// The bytes held count every resident file, and the files being
+// written, which reserve() their bytes as they grow.
+struct ResidentFileFactory::Files
+{
+    struct File
+    {
+        OwnedContentPtr content;
+        bool dirty;
+    };
+
+    ContentPtr get(const string& pFileName)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        std::map<string,File>::const_iterator i = files.find(pFileName);
+        return i == files.end() ? ContentPtr() : i->second.content;
+    }
+
+    // Add a file whose bytes have already been reserved.
+    void put(const string& pFileName, const OwnedContentPtr& pContent)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        std::map<string,File>::iterator i = files.find(pFileName);
+        if (i != files.end())
+        {
+            bytes -= i->second.content->size();
+        }
+        File& f(files[pFileName]);
+        f.content = pContent;
+        f.dirty = true;
+    }
+
+    // Take a file out to append to it, if no one else is reading it.
+    // Its bytes stay reserved.
+    OwnedContentPtr take(const string& pFileName)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        std::map<string,File>::iterator i = files.find(pFileName);
+        if (i == files.end() || i->second.content.use_count() != 1)
+        {
+            return OwnedContentPtr();
+        }
+        OwnedContentPtr c = i->second.content;
+        files.erase(i);
+        return c;
+    }
+
+    // Note that a file was written to the underlying factory instead.
+    void spill(const string& pFileName)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        eraseLocked(pFileName);
+        spilled.insert(pFileName);
+    }
+
+    bool erase(const string& pFileName)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        spilled.erase(pFileName);
+        return eraseLocked(pFileName);
+    }
+
+    bool reserve(uint64_t pBytes)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        if (bytes + pBytes > budget)
+        {
+            return false;
+        }
+        bytes += pBytes;
+        return true;
+    }
+
+    void unreserve(uint64_t pBytes)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        bytes -= pBytes;
+    }
+
+    explicit Files(uint64_t pBudget)
+        : budget(pBudget), bytes(0)
+    {
+    }
+
+    bool eraseLocked(const string& pFileName)
+    {
+        std::map<string,File>::iterator i = files.find(pFileName);
+        if (i == files.end())
+        {
+            return false;
+        }
+        bytes -= i->second.content->size();
+        files.erase(i);
+        return true;
+    }
+
+    std::mutex mutex;
+    std::map<string,File> files;
+    std::set<string> spilled;
+    const uint64_t budget;
+    uint64_t bytes;
+};
+
+namespace // anonymous
+{
+
+bool
+startsWith(const string& pStr, const string& pPrefix)
+{
+    return pStr.compare(0, pPrefix.size(), pPrefix) == 0;
+}
+
+// Reads directly from the contents of a resident file.
+class ContentReadBuf : public std::streambuf
+{
+public:
+    explicit ContentReadBuf(const ContentPtr& pContent)
+        : mContent(pContent)
+    {
+        char* b = const_cast<char*>(mContent->data());
+        setg(b, b, b + mContent->size());
+    }
+
+protected:
+    virtual pos_type seekoff(off_type pOff, std::ios_base::seekdir pDir, std::ios_base::openmode pMode)
+    {
+        off_type base = pDir == std::ios_base::beg ? 0
+                      : pDir == std::ios_base::cur ? gptr() - eback()
+                      : egptr() - eback();
+        off_type pos = base + pOff;
+        if (!(pMode & std::ios_base::in) || pos < 0 || pos > egptr() - eback())
+        {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), eback() + pos, egptr());
+        return pos_type(pos);
+    }
+
+    virtual pos_type seekpos(pos_type pPos, std::ios_base::openmode pMode)
+    {
+        return seekoff(off_type(pPos), std::ios_base::beg, pMode);
+    }
+
+private:
+    ContentPtr mContent;
+};
+
+// Buffers output and writes it into a string, which is extended as
+// needed. Seeking back, to fill in a header, for instance, is allowed.
+//
+// Each extension is reserved against the budget first. Once that fails,
+// the file spills: what has been written so far goes to the underlying
+// factory, and so does the rest of the output.
+class ContentWriteBuf : public std::streambuf
+{
+public:
+    // Finish the file, which is then either resident or spilled.
+    void close()
+    {
+        sync();
+        if (mSpill)
+        {
+            mSpill = FileFactory::OutHolderPtr();
+            mFiles->spill(mFileName);
+            return;
+        }
+        mFiles->put(mFileName, mContent);
+    }
+
+    // pContent holds reserved bytes to continue from. If pShared is
+    // given, the file continues from a copy of it instead.
+    ContentWriteBuf(const std::shared_ptr<ResidentFileFactory::Files>& pFiles,
+                    const FileFactoryPtr& pBase, const string& pFileName,
+                    const OwnedContentPtr& pContent, const ContentPtr& pShared)
+        : mFiles(pFiles), mBase(pBase), mFileName(pFileName), mContent(pContent),
+          mPos(pContent->size()), mBuffer(1ULL << 16)
+    {
+        setp(&mBuffer[0], &mBuffer[0] + mBuffer.size());
+        if (!pShared)
+        {
+            return;
+        }
+        mPos = pShared->size();
+        if (mFiles->reserve(pShared->size()))
+        {
+            mContent->assign(*pShared);
+            return;
+        }
+        spill(*pShared);
+    }
+
+protected:
+    virtual int overflow(int pCh)
+    {
+        sync();
+        if (pCh != traits_type::eof())
+        {
+            *pptr() = traits_type::to_char_type(pCh);
+            pbump(1);
+        }
+        return traits_type::not_eof(pCh);
+    }
+
+    virtual int sync()
+    {
+        write(pbase(), pptr() - pbase());
+        setp(&mBuffer[0], &mBuffer[0] + mBuffer.size());
+        return 0;
+    }
+
+    virtual pos_type seekoff(off_type pOff, std::ios_base::seekdir pDir, std::ios_base::openmode pMode)
+    {
+        if (!(pMode & std::ios_base::out))
+        {
+            return pos_type(off_type(-1));
+        }
+        sync();
+        if (mSpill)
+        {
+            return (**mSpill).rdbuf()->pubseekoff(pOff, pDir, pMode);
+        }
+        off_type base = pDir == std::ios_base::beg ? 0
+                      : pDir == std::ios_base::cur ? off_type(mPos)
+                      : off_type(mContent->size());
+        off_type pos = base + pOff;
+        if (pos < 0 || pos > off_type(mContent->size()))
+        {
+            return pos_type(off_type(-1));
+        }
+        mPos = pos;
+        return pos_type(pos);
+    }
+
+    virtual pos_type seekpos(pos_type pPos, std::ios_base::openmode pMode)
+    {
+        return seekoff(off_type(pPos), std::ios_base::beg, pMode);
+    }
+
+private:
+    void write(const char* pData, uint64_t pLen)
+    {
+        if (pLen == 0)
+        {
+            return;
+        }
+        if (!mSpill && mPos + pLen > mContent->size())
+        {
+            uint64_t grow = mPos + pLen - mContent->size();
+            if (mFiles->reserve(grow))
+            {
+                // Grow by a quarter at a time, rather than doubling, so
+                // the string holds little more than the reserved bytes.
+                uint64_t z = mContent->size() + grow;
+                if (z > mContent->capacity())
+                {
+                    mContent->reserve(std::max(z, mContent->capacity() + mContent->capacity() / 4));
+                }
+            }
+            else
+            {
+                spill(*mContent);
+                mFiles->unreserve(mContent->size());
+                mContent->clear();
+                mContent->shrink_to_fit();
+            }
+        }
+
+        if (mSpill)
+        {
+            if (!(**mSpill).write(pData, pLen))
+            {
+                BOOST_THROW_EXCEPTION(Gossamer::error()
+                    << Gossamer::write_error_info(mFileName));
+            }
+            mPos += pLen;
+            return;
+        }
+
+        uint64_t over = std::min<uint64_t>(pLen, mContent->size() - mPos);
+        std::copy(pData, pData + over, mContent->begin() + mPos);
+        mContent->append(pData + over, pLen - over);
+        mPos += pLen;
+    }
+
+    // Write pSoFar to the underlying factory, and carry on there from mPos.
+    void spill(const string& pSoFar)
+    {
+        mSpill = mBase->out(mFileName);
+        std::ostream& o(**mSpill);
+        o.write(pSoFar.data(), pSoFar.size());
+        if (mPos != pSoFar.size())
+        {
+            o.seekp(mPos);
+        }
+        if (!o)
+        {
+            BOOST_THROW_EXCEPTION(Gossamer::error()
+                << Gossamer::write_error_info(mFileName));
+        }
+    }
+
+    std::shared_ptr<ResidentFileFactory::Files> mFiles;
+    FileFactoryPtr mBase;
+    const string mFileName;
+    OwnedContentPtr mContent;
+    uint64_t mPos;
+    vector<char> mBuffer;
+    FileFactory::OutHolderPtr mSpill;
+};
+
+class ResidentInHolder : public FileFactory::InHolder
+{
+public:
+    virtual istream& operator*()
+    {
+        return mStream;
+    }
+
+    explicit ResidentInHolder(const ContentPtr& pContent)
+        : mBuf(pContent), mStream(&mBuf)
+    {
+    }
+
+private:
+    ContentReadBuf mBuf;
+    std::istream mStream;
+};
+
+class ResidentOutHolder : public FileFactory::OutHolder
+{
+public:
+    virtual ostream& operator*()
+    {
+        return mStream;
+    }
+
+    ResidentOutHolder(const std::shared_ptr<ResidentFileFactory::Files>& pFiles,
+                      const FileFactoryPtr& pBase, const string& pFileName,
+                      const OwnedContentPtr& pContent, const ContentPtr& pShared)
+        : mBuf(pFiles, pBase, pFileName, pContent, pShared), mStream(&mBuf)
+    {
+    }
+
+    ~ResidentOutHolder()
+    {
+        mStream.flush();
+        mBuf.close();
+    }
+
+private:
+    ContentWriteBuf mBuf;
+    std::ostream mStream;
+};
+
+class ResidentMappedHolder : public FileFactory::MappedHolder
+{
+public:
+    virtual uint64_t size() const
+    {
+        return mContent->size();
+    }
+
+    virtual const void* data() const
+    {
+        return mContent->data();
+    }
+
+    explicit ResidentMappedHolder(const ContentPtr& pContent)
+        : mContent(pContent)
+    {
+    }
+
+private:
+    ContentPtr mContent;
+};
+
+string
+readAll(const FileFactory& pFactory, const string& pFileName)
+{
+    FileFactory::InHolderPtr inp(pFactory.in(pFileName));
+    return string(std::istreambuf_iterator<char>(**inp), std::istreambuf_iterator<char>());
+}
+
+} // namespace anonymous
+
+
+FileFactory::InHolderPtr
+ResidentFileFactory::in(const string& pFileName) const
+{
+    ContentPtr c(mFiles->get(pFileName));
+    if (c)
+    {
+        return InHolderPtr(new ResidentInHolder(c));
+    }
+    return mBase->in(pFileName);
+}
+
+FileFactory::OutHolderPtr
+ResidentFileFactory::out(const string& pFileName, FileMode pMode) const
+{
+    if (!resident(pFileName))
+    {
+        return mBase->out(pFileName, pMode);
+    }
+
+    OwnedContentPtr c;
+    ContentPtr shared;
+    if (pMode == AppendMode)
+    {
+        // Carry on with the resident contents, which are only copied
+        // if someone is still reading them. A file that is only in the
+        // underlying factory is appended to there.
+        c = mFiles->take(pFileName);
+        if (!c)
+        {
+            shared = mFiles->get(pFileName);
+            if (!shared && mBase->exists(pFileName))
+            {
+                return mBase->out(pFileName, pMode);
+            }
+        }
+    }
+    if (!c)
+    {
+        c = std::make_shared<string>();
+    }
+    return OutHolderPtr(new ResidentOutHolder(mFiles, mBase, pFileName, c, shared));
+}
+
+FileFactory::MappedHolderPtr
+ResidentFileFactory::map(const string& pFileName) const
+{
+    ContentPtr c(mFiles->get(pFileName));
+    if (c)
+    {
+        return MappedHolderPtr(new ResidentMappedHolder(c));
+    }
+    return mBase->map(pFileName);
+}
+
+void
+ResidentFileFactory::remove(const string& pFileName) const
+{
+    bool wasResident = mFiles->erase(pFileName);
+    if (!wasResident || mBase->exists(pFileName))
+    {
+        mBase->remove(pFileName);
+    }
+}
+
+void
+ResidentFileFactory::copy(const string& pFrom, const string& pTo) const
+{
+    ContentPtr c(mFiles->get(pFrom));
+    if (resident(pTo))
+    {
+        uint64_t z = c ? c->size() : mBase->size(pFrom);
+        if (mFiles->reserve(z))
+        {
+            mFiles->put(pTo, std::make_shared<string>(c ? *c : readAll(*mBase, pFrom)));
+            return;
+        }
+        mFiles->spill(pTo);
+    }
+
+    if (!c)
+    {
+        mBase->copy(pFrom, pTo);
+        return;
+    }
+    FileFactory::OutHolderPtr outp(mBase->out(pTo));
+    (**outp).write(c->data(), c->size());
+}
+
+bool
+ResidentFileFactory::exists(const string& pFileName) const
+{
+    return mFiles->get(pFileName) || mBase->exists(pFileName);
+}
+
+uint64_t
+ResidentFileFactory::size(const string& pFileName) const
+{
+    ContentPtr c(mFiles->get(pFileName));
+    if (c)
+    {
+        return c->size();
+    }
+    return mBase->size(pFileName);
+}
+
+string
+ResidentFileFactory::tmpName()
+{
+    return mBase->tmpName();
+}
+
+void
+ResidentFileFactory::populate(bool pPopulate)
+{
+    mBase->populate(pPopulate);
+}
+
+void
+ResidentFileFactory::checkpoint(const string& pPrefix)
+{
+    vector<pair<string,ContentPtr> > dirty;
+    {
+        std::unique_lock<std::mutex> lk(mFiles->mutex);
+        // Spilled files are already where the checkpoint needs them.
+        std::set<string>::iterator j = mFiles->spilled.lower_bound(pPrefix);
+        while (j != mFiles->spilled.end() && startsWith(*j, pPrefix))
+        {
+            mFiles->spilled.erase(j++);
+        }
+        for (auto& f : mFiles->files)
+        {
+            if (f.second.dirty && startsWith(f.first, pPrefix))
+            {
+                dirty.push_back(make_pair(f.first, f.second.content));
+                f.second.dirty = false;
+            }
+        }
+    }
+
+    for (uint64_t i = 0; i < dirty.size(); ++i)
+    {
+        FileFactory::OutHolderPtr outp(mBase->out(dirty[i].first));
+        (**outp).write(dirty[i].second->data(), dirty[i].second->size());
+    }
+}
+
+void
+ResidentFileFactory::release(const string& pPrefix)
+{
+    vector<string> spilled;
+    {
+        std::unique_lock<std::mutex> lk(mFiles->mutex);
+        std::map<string,Files::File>::iterator i = mFiles->files.lower_bound(pPrefix);
+        while (i != mFiles->files.end() && startsWith(i->first, pPrefix))
+        {
+            mFiles->eraseLocked((i++)->first);
+        }
+        std::set<string>::iterator j = mFiles->spilled.lower_bound(pPrefix);
+        while (j != mFiles->spilled.end() && startsWith(*j, pPrefix))
+        {
+            spilled.push_back(*j);
+            mFiles->spilled.erase(j++);
+        }
+    }
+
+    // Files that spilled were only ever meant to be resident.
+    for (uint64_t i = 0; i < spilled.size(); ++i)
+    {
+        if (mBase->exists(spilled[i]))
+        {
+            mBase->remove(spilled[i]);
+        }
+    }
+}
+
+uint64_t
+ResidentFileFactory::residentBytes() const
+{
+    std::unique_lock<std::mutex> lk(mFiles->mutex);
+    return mFiles->bytes;
+}
+
+ResidentFileFactory::ResidentFileFactory(const FileFactoryPtr& pBase, const string& pPrefix,
+                                         uint64_t pBudget)
+    : mBase(pBase), mPrefix(pPrefix), mFiles(new Files(pBudget))
+{
+}
+
+ResidentFileFactory::~ResidentFileFactory()
+{
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef RESIDENTFILEFACTORY_HH
+#define RESIDENTFILEFACTORY_HH
+
+#ifndef FILEFACTORY_HH
+#include "FileFactory.hh"
+#endif
+
+#ifndef STD_LIMITS
+#include <limits>
+#define STD_LIMITS
+#endif // STD_LIMITS
+
+// A file factory that keeps the files whose names start with a given
+// prefix in memory, and passes everything else through to another
+// factory. Mapping a resident file gives its contents directly, so a
+// graph written by one command can be opened by the next without going
+// through the disk.
+//
+// Resident files only reach the underlying factory when checkpoint() is
+// called, or when keeping them would take more than the budget. A file
+// whose writing runs over the budget spills: it is written to the
+// underlying factory instead, and is removed from there again when it is
+// released. Otherwise, existing files there are only used for reading
+// names that have not been written in memory.
+//
+class ResidentFileFactory : public FileFactory
+{
+public:
+    // Open a file for reading
+    virtual InHolderPtr in(const std::string& pFileName) const;
+
+    // Open a file for writing
+    virtual OutHolderPtr out(const std::string& pFileName, FileMode pMode = TruncMode) const;
+
+    // Open a file for mapping
+    virtual MappedHolderPtr map(const std::string& pFileName) const;
+
+    // Remove a file.
+    virtual void remove(const std::string& pFileName) const;
+
+    // Copy a file.
+    virtual void copy(const std::string& pFrom, const std::string& pTo) const;
+
+    // Return true iff a file exists.
+    virtual bool exists(const std::string& pFileName) const;
+
+    // Return the size of a file, or throw an exception if it does not exist.
+    virtual uint64_t size(const std::string& pFileName) const;
+
+    // Create a unique temprorary file name.
+    virtual std::string tmpName();
+
+    virtual void populate(bool pPopulate);
+
+    // Write the resident files whose names start with pPrefix, and which
+    // have changed since they were last written, to the underlying factory.
+    void checkpoint(const std::string& pPrefix);
+
+    // Drop the resident files whose names start with pPrefix, and
+    // remove the ones that spilled.
+    void release(const std::string& pPrefix);
+
+    // The total size of the resident files, including the ones still
+    // being written.
+    uint64_t residentBytes() const;
+
+    ResidentFileFactory(const FileFactoryPtr& pBase, const std::string& pPrefix,
+                        uint64_t pBudget = std::numeric_limits<uint64_t>::max());
+
+    ~ResidentFileFactory();
+
+    // The resident files, shared with any holders still open.
+    struct Files;
+
+private:
+    bool resident(const std::string& pFileName) const
+    {
+        return pFileName.compare(0, mPrefix.size(), mPrefix) == 0;
+    }
+
+    FileFactoryPtr mBase;
+    const std::string mPrefix;
+    std::shared_ptr<Files> mFiles;
+};
+
+#endif // RESIDENTFILEFACTORY_HH
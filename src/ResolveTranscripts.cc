@@ -750,7 +750,7 @@ struct ResolveTranscripts::Impl
 
         typedef std::unordered_map<node_t,distance_type> distance_map_t;
 
-        boost::mt19937 mRng;
+        std::mt19937 mRng;
         typedef std::unordered_map<node_t,distance_map_t> cache_map_t;
         cache_map_t mCache;
 
@@ -758,7 +758,7 @@ struct ResolveTranscripts::Impl
 
         void ejectElementFromCache()
         {
-            boost::uniform_int<> dist(0, mCache.size() - 1);
+            std::uniform_int_distribution<> dist(0, mCache.size() - 1);
             cache_map_t::iterator it = mCache.begin();
             std::advance(it, dist(mRng));
             mCache.erase(it);
@@ -17,63 +17,39 @@
 #include "GossamerException.hh"
 #endif
 
+#ifndef KMERKERNELS_HH
+#include "KmerKernels.hh"
+#endif
+
 class ReverseComplementAdapter
 {
 public:
     bool valid()
     {
-        return mUseRC || mKmers.valid();
+        return mCurr < mKmers.size();
     }
 
     Gossamer::edge_type operator*() const
     {
-        BOOST_ASSERT(mKmers.valid());
-        return mKmer;
+        BOOST_ASSERT(mCurr < mKmers.size());
+        return mKmers[mCurr];
     }
 
     void operator++()
     {
-        mUseRC = !mUseRC;
-        if (mUseRC)
-        {
-            mKmer.reverseComplement(mRho);
-            return;
-        }
-        ++mKmers;
-        while (!mKmers.valid() && mReads.valid())
+        if (++mCurr == mKmers.size())
         {
-            ++mReads;
-            if (mReads.valid())
-            {
-                mKmers = GossRead::Iterator(*mReads, mRho);
-            }
-        }
-        if (mKmers.valid())
-        {
-            mKmer = mKmers.kmer();
+            nextRead();
         }
     }
 
     ReverseComplementAdapter(GossReadSequence& pReads, uint64_t pRho)
-        : mReads(checkValid(pReads)), mRho(pRho), mKmers(GossRead::Iterator(*mReads, mRho)),
-          mUseRC(false), mKmer(0)
+        : mReads(checkValid(pReads)), mRho(pRho), mCurr(0)
     {
-        while (!mKmers.valid() && mReads.valid())
-        {
-            ++mReads;
-            if (mReads.valid())
-            {
-                mKmers = GossRead::Iterator(*mReads, mRho);
-            }
-        }
-        if (mKmers.valid())
-        {
-            mKmer = mKmers.kmer();
-        }
+        nextRead();
     }
 
 private:
-
     GossReadSequence& checkValid(GossReadSequence& pReads)
     {
         if (!pReads.valid())
@@ -85,11 +61,35 @@ private:
         return pReads;
     }
 
+    // Extract all the kmers of the next read which has any, each
+    // followed by its reverse complement.
+    void nextRead()
+    {
+        mKmers.clear();
+        mCurr = 0;
+        auto both = [this] (uint64_t pOffset, const Gossamer::edge_type& pKmer,
+                            const Gossamer::edge_type& pRc) {
+            mKmers.push_back(pKmer);
+            mKmers.push_back(pRc);
+        };
+        while (mKmers.empty() && mReads.valid())
+        {
+            const std::string& r((*mReads).read());
+            mCodes.resize(r.size());
+            if (r.size())
+            {
+                KmerKernels::encode(r.data(), r.size(), &mCodes[0]);
+                KmerKernels::roll<Gossamer::edge_type>(&mCodes[0], mCodes.size(), mRho, both);
+            }
+            ++mReads;
+        }
+    }
+
     GossReadSequence& mReads;
     const uint64_t mRho;
-    GossRead::Iterator mKmers;
-    bool mUseRC;
-    Gossamer::edge_type mKmer;
+    std::vector<uint8_t> mCodes;
+    std::vector<Gossamer::edge_type> mKmers;
+    uint64_t mCurr;
 };
 
 #endif // REVERSECOMPLEMENTADAPTER_HH
@@ -0,0 +1,178 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#ifndef SORTEDKMERLOOKUP_HH
+#define SORTEDKMERLOOKUP_HH
+
+#ifndef GOSSAMER_HH
+#include "Gossamer.hh"
+#endif
+
+#ifndef KMERSET_HH
+#include "KmerSet.hh"
+#endif
+
+#ifndef BLENDEDSORT_HH
+#include "BlendedSort.hh"
+#endif
+
+#ifndef STD_UTILITY
+#include <utility>
+#define STD_UTILITY
+#endif
+
+#ifndef STD_VECTOR
+#include <vector>
+#define STD_VECTOR
+#endif
+
+// Answers a large batch of kmer lookups against a KmerSet in one
+// forward pass over the set, rather than a random probe per kmer.
+//
+// The (normalized) kmers are collected, radix sorted, and merged with
+// the sorted stream of kmers from the set's iterator. This reads the
+// set sequentially, which is much kinder to a memory mapped set that
+// doesn't fit in RAM. The merge starts at the first query, and jumps
+// over long stretches of the set between queries, so a batch costs no
+// more than the part of the set that it spans.
+//
+class SortedKmerLookup
+{
+public:
+    typedef std::pair<Gossamer::edge_type,uint64_t> Query;
+
+    // Add a kmer to the batch. Queries are numbered from zero in the
+    // order they are added.
+    void push_back(const Gossamer::edge_type& pKmer)
+    {
+        mQueries.push_back(Query(pKmer, mQueries.size()));
+    }
+
+    uint64_t size() const
+    {
+        return mQueries.size();
+    }
+
+    void clear()
+    {
+        mQueries.clear();
+    }
+
+    // Sort the batch. This must be done after the last kmer is added,
+    // and before any lookups.
+    void sort(uint64_t pNumThreads)
+    {
+        const uint64_t bits = 2 * mK;
+        if (bits <= 64)
+        {
+            BlendedSort<Query>::sort(pNumThreads, mQueries, bits, RadixCmp(0));
+        }
+        else
+        {
+            BlendedSort<Query>::sort(pNumThreads, mQueries, 64, RadixCmp(bits - 64));
+        }
+    }
+
+    // Look up the sorted batch in pKmers, calling pVis(query, rank) for
+    // each query whose kmer is present, in kmer order.
+    template <typename Vis>
+    void lookup(const KmerSet& pKmers, Vis& pVis) const
+    {
+        if (mQueries.empty())
+        {
+            return;
+        }
+        Gossamer::rank_type rnk = pKmers.rank(KmerSet::Edge(mQueries.front().first));
+        KmerSet::Iterator itr(pKmers, rnk);
+        for (uint64_t i = 0; i < mQueries.size() && itr.valid(); ++i)
+        {
+            const Gossamer::edge_type& x(mQueries[i].first);
+            for (uint64_t j = 0; itr.valid() && (*itr).first.value() < x; ++j)
+            {
+                if (j == sMaxStep)
+                {
+                    // A long way yet: seek rather than step.
+                    rnk = pKmers.rank(KmerSet::Edge(x));
+                    itr = KmerSet::Iterator(pKmers, rnk);
+                    break;
+                }
+                ++itr;
+                ++rnk;
+            }
+            if (itr.valid() && (*itr).first.value() == x)
+            {
+                pVis(mQueries[i].second, rnk);
+            }
+        }
+    }
+
+    // As lookup(), but probing the set once for each distinct kmer,
+    // rather than stepping through the set between nearby queries.
+    template <typename Vis>
+    void probe(const KmerSet& pKmers, Vis& pVis) const
+    {
+        Gossamer::rank_type rnk = 0;
+        bool found = false;
+        for (uint64_t i = 0; i < mQueries.size(); ++i)
+        {
+            const Gossamer::edge_type& x(mQueries[i].first);
+            if (i == 0 || x != mQueries[i - 1].first)
+            {
+                found = pKmers.accessAndRank(KmerSet::Edge(x), rnk);
+            }
+            if (found)
+            {
+                pVis(mQueries[i].second, rnk);
+            }
+        }
+    }
+
+    SortedKmerLookup(uint64_t pK)
+        : mK(pK)
+    {
+    }
+
+private:
+    // How far lookup() steps through the set before seeking instead.
+    static const uint64_t sMaxStep = 64;
+
+    class RadixCmp
+    {
+    public:
+        static Query zero()
+        {
+            return Query(Gossamer::edge_type(0), 0);
+        }
+
+        // The top (at most) 64 bits of the kmer.
+        uint64_t radix(const Query& pQuery) const
+        {
+            Gossamer::edge_type x(pQuery.first);
+            x >>= mShift;
+            return x.asUInt64();
+        }
+
+        bool operator()(const Query& pLhs, const Query& pRhs) const
+        {
+            return pLhs.first < pRhs.first;
+        }
+
+        RadixCmp(uint64_t pShift)
+            : mShift(pShift)
+        {
+        }
+
+    private:
+        uint64_t mShift;
+    };
+
+    const uint64_t mK;
+    std::vector<Query> mQueries;
+};
+
+#endif // SORTEDKMERLOOKUP_HH
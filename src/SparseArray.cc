@@ -43,6 +43,14 @@ SparseArray::Iterator::Iterator(const SparseArray& pArray)
     }
 }
 
+SparseArray::Iterator::Iterator(const SparseArray& pArray, rank_type pRank)
+    : mArray(&pArray),
+      mHiItr(pRank < pArray.count() ? pArray.mHighBits.iterator1(pArray.mD1.select(pRank))
+                                    : pArray.mHighBits.iterator1()),
+      mI(pRank), mValid(pRank < pArray.count())
+{
+}
+
 
 uint64_t
 SparseArray::Builder::d(const position_type& pN, rank_type pM)
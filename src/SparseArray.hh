@@ -30,6 +30,10 @@
 #include "Logger.hh"
 #endif
 
+#ifndef TAGGEDNUM_HH
+#include "TaggedNum.hh"
+#endif
+
 #ifndef PROPERTIES_HH
 #include "Properties.hh"
 #endif
@@ -179,6 +183,8 @@ public:
         bool mValid;
 
         Iterator(const SparseArray& pArray);
+
+        Iterator(const SparseArray& pArray, rank_type pRank);
     };
 
     // TODO: Consolidate with Iterator
@@ -228,6 +234,12 @@ public:
         return Iterator(*this);
     }
 
+    // Iterate from the element with the given rank.
+    Iterator iterator(rank_type pRank) const
+    {
+        return Iterator(*this, pRank);
+    }
+
     static LazyIterator lazyIterator(const std::string& pBaseName, FileFactory& pFactory)
     {
         return LazyIterator(pBaseName, pFactory);
@@ -275,6 +287,58 @@ public:
         return position_type(mLowBits[pRank]) == j;
     }
 
+    // Look up each position in the random access range [pBegin, pEnd),
+    // writing its rank to pRanks and whether it is present to pFound,
+    // as accessAndRank() does for one position. The positions may also
+    // be tagged (e.g. graph edges).
+    //
+    // The lookups proceed in lock step, a window at a time, and each
+    // level of the index is prefetched for the whole window before any
+    // of it is read, so the cache misses of many lookups overlap.
+    template <typename PosItr, typename RankItr, typename FoundItr>
+    void accessAndRank(PosItr pBegin, PosItr pEnd, RankItr pRanks, FoundItr pFound) const
+    {
+        uint64_t posD[sBatchWindow];
+        std::pair<uint64_t,uint64_t> xrange[sBatchWindow];
+
+        while (pBegin != pEnd)
+        {
+            uint64_t n = pEnd - pBegin;
+            if (n > sBatchWindow)
+            {
+                n = sBatchWindow;
+            }
+
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                posD[i] = (position(pBegin[i]) >> mHeader.D).asUInt64();
+                prefetchLowOrderGroup(posD[i], false);
+            }
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                prefetchLowOrderGroup(posD[i], true);
+            }
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                xrange[i] = findLowOrderGroup(posD[i]);
+                BOOST_ASSERT(xrange[i].second <= mLowBits.size());
+                if (xrange[i].first < xrange[i].second)
+                {
+                    mLowBits.prefetch(xrange[i].first);
+                }
+            }
+            for (uint64_t i = 0; i < n; ++i, ++pRanks, ++pFound)
+            {
+                position_type j = position(pBegin[i]) & mHeader.DMask;
+                rank_type r = searchLowBits(xrange[i].first, xrange[i].second, j);
+                *pRanks = r;
+                *pFound = r < xrange[i].second && position_type(mLowBits[r]) == j;
+            }
+
+            pBegin += n;
+        }
+    }
+
     std::pair<rank_type,rank_type> rank(const position_type& pLhs, const position_type& pRhs) const
     {
         std::pair<rank_type,rank_type> retval;
@@ -342,6 +406,36 @@ public:
     ~SparseArray();
 
 private:
+    // The number of lookups in flight in a batched accessAndRank().
+    static const uint64_t sBatchWindow = 16;
+
+    static const position_type& position(const position_type& pPos)
+    {
+        return pPos;
+    }
+
+    template <typename Tag>
+    static position_type position(const TaggedNum<Tag,position_type>& pPos)
+    {
+        return pPos.value();
+    }
+
+    // Prefetch the parts of the D0 index that findLowOrderGroup(posD)
+    // will read: the master index entries first, then (pBlocks) the
+    // blocks they point to.
+    void prefetchLowOrderGroup(uint64_t posD, bool pBlocks) const
+    {
+        if (mHeader.D >= position_type::value_type::sBits)
+        {
+            return;
+        }
+        if (posD)
+        {
+            pBlocks ? mD0.prefetchBlock(posD - 1) : mD0.prefetchIndex(posD - 1);
+        }
+        pBlocks ? mD0.prefetchBlock(posD) : mD0.prefetchIndex(posD);
+    }
+
     std::pair<uint64_t,uint64_t> findLowOrderGroup(uint64_t posD) const
     {
         if (mHeader.D >= position_type::value_type::sBits)
@@ -164,6 +164,22 @@ public:
         return a && !m;
     }
 
+    template <typename PosItr, typename RankItr, typename FoundItr>
+    void accessAndRank(PosItr pBegin, PosItr pEnd, RankItr pRanks, FoundItr pFound) const
+    {
+        if (!mMask.get())
+        {
+            mArray.accessAndRank(pBegin, pEnd, pRanks, pFound);
+            return;
+        }
+        for (; pBegin != pEnd; ++pBegin, ++pRanks, ++pFound)
+        {
+            rank_type r;
+            *pFound = accessAndRank(position(*pBegin), r);
+            *pRanks = r;
+        }
+    }
+
     std::pair<rank_type,rank_type> rank(const position_type& pLhs, const position_type& pRhs) const
     {
         if (!mMask.get())
@@ -263,6 +279,17 @@ public:
 
 private:
 
+    static const position_type& position(const position_type& pPos)
+    {
+        return pPos;
+    }
+
+    template <typename Tag>
+    static position_type position(const TaggedNum<Tag,position_type>& pPos)
+    {
+        return pPos.value();
+    }
+
     const SparseArray& mArray;
     StringFileFactory mFac;
     std::unique_ptr<Mask> mMask;
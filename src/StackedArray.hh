@@ -222,6 +222,13 @@ public:
         return retval;
     }
 
+    // Hint that item pIdx will be read soon.
+    void prefetch(uint64_t pIdx) const
+    {
+        mUpr.prefetch(pIdx);
+        mLwr.prefetch(pIdx);
+    }
+
     uint64_t lower_bound(uint64_t pBegin, uint64_t pEnd, const integer_type& pVal) const
     {
         integer_type upr(pVal);
@@ -183,9 +183,9 @@ namespace // anonymous
             string segLens;
             string segStarts;
             const EntryEdgeSet& entries(mSg.entries());
-            const vector<SuperPath::Segment>& segs(mSg[id].segments());
+            const SuperPath::SegmentsRef segs(mSg[id].segments());
             ContigVisitor vis(mG);
-            for (vector<SuperPath::Segment>::const_iterator
+            for (SuperPath::SegmentsRef::const_iterator
                  j = segs.begin(); j != segs.end(); ++j)
             {
                 // Extend contig
@@ -271,8 +271,33 @@ namespace // anonymous
 
     typedef std::shared_ptr<ContigPrinter> ContigPrinterPtr;
 
+    // FNV-1a over the bytes of an array.
+    template <typename T>
+    uint64_t hashBytes(uint64_t pHash, const vector<T>& pItems)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(pItems.data());
+        const unsigned char* e = p + pItems.size() * sizeof(T);
+        for (; p != e; ++p)
+        {
+            pHash ^= *p;
+            pHash *= 1099511628211ULL;
+        }
+        return pHash;
+    }
+
+    template <typename T>
+    void writeArray(const string& pName, FileFactory& pFactory, const vector<T>& pItems)
+    {
+        typename MappedArray<T>::Builder arr(pName, pFactory);
+        for (uint64_t i = 0; i < pItems.size(); ++i)
+        {
+            arr.push_back(pItems[i]);
+        }
+        arr.end();
+    }
+
     // TODO: Fix in light of gap segments!
-    bool entails(const SuperPath::Segments& pLhs, const SuperPath::Segments& pRhs)
+    bool entails(const SuperPath::SegmentsRef& pLhs, const SuperPath::SegmentsRef& pRhs)
     {
         BOOST_ASSERT(pLhs.size() > 0);
         BOOST_ASSERT(pRhs.size() > 0);
@@ -624,23 +649,13 @@ SuperGraph::ShortestPathIterator::next(vector<SuperPathId>& pPath)
     return ok;
 }
 
-/**
- * Returns the reverse complement of the given path.
- */
-SuperPathId
-SuperGraph::reverseComplement(const SuperPathId& pId) const
-{
-    return SuperPathId(mRCs[pId.value()]);
-}
-
 void
 SuperGraph::nodes(vector<Node>& pNodes) const
 {
-    pNodes.reserve(mSucc.size());
-    for (unordered_map<Node, SuperPathIds>::const_iterator
-         i = mSucc.begin(); i != mSucc.end(); ++i)
+    pNodes.reserve(pNodes.size() + mSucc.size() + (mCsr ? mCsr->nodes.size() : 0));
+    for (NodeIterator i(*this); i.valid(); ++i)
     {
-        pNodes.push_back(i->first);
+        pNodes.push_back(*i);
     }
 }
 
@@ -652,11 +667,8 @@ void
 SuperGraph::successors(const Node& pNode, SuperPathIds& pSucc) const
 {
     pSucc.clear();
-    unordered_map<Node, SuperPathIds>::const_iterator i(mSucc.find(pNode));
-    if (i != mSucc.end())
-    {
-        pSucc.insert(pSucc.end(), i->second.begin(), i->second.end());
-    }
+    SuccRange r(succs(pNode));
+    pSucc.insert(pSucc.end(), r.first, r.second);
 }
 
 /**
@@ -678,7 +690,7 @@ SuperGraph::unique(const SuperPath& pPath, double pExpectedCoverage) const
 
     double n = 0;
     double c = 0;
-    const vector<SuperPath::Segment>& segs(pPath.segments());
+    const SuperPath::SegmentsRef segs(pPath.segments());
     for (uint64_t i = 0; i < segs.size(); ++i)
     {
         SuperPath::Segment s(segs[i]);
@@ -704,8 +716,8 @@ SuperGraph::contigInfo(const Graph& pG, const SuperPathId& pId, string& pSeq,
                        SuperPathId& pRc, double& pCovMean) const
 {
     ContigVisitor vis(pG);
-    const vector<SuperPath::Segment>& segs(mSegs[pId.value()]);
-    for (vector<SuperPath::Segment>::const_iterator
+    const SuperPath::SegmentsRef segs(segments(pId.value()));
+    for (SuperPath::SegmentsRef::const_iterator
          j = segs.begin(); j != segs.end(); ++j)
     {
         const SuperPath::Segment s = *j;
@@ -749,7 +761,7 @@ SuperGraph::printContigs(const std::string& pBaseName, FileFactory& pFactory,
             for (PathIterator i(*this); i.valid(); ++i)
             {
                 const SuperPath path((*this)[*i]);
-                const vector<SuperPath::Segment>& segs(path.segments());
+                const SuperPath::SegmentsRef segs(path.segments());
                 for (uint64_t j = 0; j < segs.size(); ++j)
                 {
                     const uint64_t seg = segs[j];
@@ -776,7 +788,7 @@ SuperGraph::printContigs(const std::string& pBaseName, FileFactory& pFactory,
         for (PathIterator i(*this); i.valid(); ++i)
         {
             const SuperPath path((*this)[*i]);
-            const vector<SuperPath::Segment>& segs(path.segments());
+            const SuperPath::SegmentsRef segs(path.segments());
             for (uint64_t j = 0; j < segs.size(); ++j)
             {
                 const uint64_t seg = segs[j];
@@ -797,11 +809,11 @@ SuperGraph::printContigs(const std::string& pBaseName, FileFactory& pFactory,
             for (uint64_t j = 0; j < ids.size(); ++j)
             {
                 const SuperPath p_j((*this)[ids[j]]);
-                const SuperPath::Segments& u(p_j.segments());
+                const SuperPath::SegmentsRef u(p_j.segments());
                 for (uint64_t k = j + 1; k < ids.size(); ++k)
                 {
                     const SuperPath p_k((*this)[ids[k]]);
-                    const SuperPath::Segments& v(p_k.segments());
+                    const SuperPath::SegmentsRef v(p_k.segments());
                     if (entails(u, v))
                     {
                         entailed.insert(ids[k]);
@@ -858,23 +870,23 @@ void
 SuperGraph::dump(std::ostream& pOut) const
 {
     pOut << "elements\n";
-    for (uint64_t i = 0; i < mRCs.size(); ++i)
+    for (uint64_t i = 0; i < size(); ++i)
     {
+        const SuperPath::SegmentsRef segs(segments(i));
         pOut << i << " [";
-        for (uint64_t j = 0; j < mSegs[i].size(); ++j)
+        for (uint64_t j = 0; j < segs.size(); ++j)
         {
-            pOut << " " << mSegs[i][j];
+            pOut << " " << segs[j];
         }
-        pOut << "] " << mRCs[i] << '\n';
+        pOut << "] " << rc(i) << '\n';
     }
 
     pOut << "succs\n";
-    for (unordered_map<Node, SuperPathIds>::const_iterator
-         i = mSucc.begin(); i != mSucc.end(); ++i)
+    for (NodeIterator i(*this); i.valid(); ++i)
     {
-        pOut << i->first.value() << ":";
-        const SuperPathIds& ids(i->second);
-        for (SuperPathIds::const_iterator j = ids.begin(); j != ids.end(); ++j)
+        pOut << (*i).value() << ":";
+        SuccRange r(succs(*i));
+        for (const SuperPathId* j = r.first; j != r.second; ++j)
         {
             pOut << " " << (*j).value();
         }
@@ -893,12 +905,54 @@ SuperGraph::write(const string& pBaseName, FileFactory& pFactory) const
 {
     string name = pBaseName + "-supergraph";
 
+    // The files written may be the ones this graph was read from,
+    // so gather everything before any of them is opened.
+    vector<Node> ns;
+    nodes(ns);
+    sort(ns.begin(), ns.end());
+
+    vector<uint64_t> succOffsets;
+    vector<SuperPathId> pathIds;
+    succOffsets.reserve(ns.size() + 1);
+    succOffsets.push_back(0);
+    for (uint64_t i = 0; i < ns.size(); ++i)
+    {
+        SuccRange r(succs(ns[i]));
+        pathIds.insert(pathIds.end(), r.first, r.second);
+        succOffsets.push_back(pathIds.size());
+    }
+
+    const uint64_t n = size();
+    vector<uint64_t> segOffsets;
+    vector<uint64_t> segs;
+    vector<uint64_t> rcs;
+    segOffsets.reserve(n + 1);
+    rcs.reserve(n);
+    segOffsets.push_back(0);
+    for (uint64_t i = 0; i < n; ++i)
+    {
+        const SuperPath::SegmentsRef s(segments(i));
+        segs.insert(segs.end(), s.begin(), s.end());
+        segOffsets.push_back(segs.size());
+        rcs.push_back(rc(i));
+    }
+
+    uint64_t fp = 14695981039346656037ULL;
+    fp = hashBytes(fp, vector<uint64_t>{mNextId, mCount});
+    fp = hashBytes(fp, ns);
+    fp = hashBytes(fp, succOffsets);
+    fp = hashBytes(fp, pathIds);
+    fp = hashBytes(fp, segOffsets);
+    fp = hashBytes(fp, segs);
+    fp = hashBytes(fp, rcs);
+
     // mHeader
     {
         FileFactory::OutHolderPtr op(pFactory.out(name + ".header"));
         ostream& o(**op);
         Header h;
         h.version = version;
+        h.fingerprint = fp ? fp : 1;
         o.write(reinterpret_cast<const char*>(&h), sizeof(h));
     }
 
@@ -916,56 +970,12 @@ SuperGraph::write(const string& pBaseName, FileFactory& pFactory) const
         o.write(reinterpret_cast<const char*>(&mCount), sizeof(mCount));
     }
 
-    // mSucc
-    {
-        MappedArray<Node>::Builder nodeArr(name + ".succ.nodes", pFactory);
-        MappedArray<uint32_t>::Builder numPathIdsArr(name + ".succ.num-path-ids", pFactory);
-        MappedArray<SuperPathId>::Builder pathIdArr(name + ".succ.path-ids", pFactory);
-
-        for (unordered_map<Node, SuperPathIds>::const_iterator
-             i = mSucc.begin(); i != mSucc.end(); ++i)
-        {
-            nodeArr.push_back(i->first);
-            numPathIdsArr.push_back(i->second.size());
-            for (uint64_t j = 0; j < i->second.size(); ++j)
-            {
-                pathIdArr.push_back(i->second[j]);
-            }
-        }
-        nodeArr.end();
-        numPathIdsArr.end();
-        pathIdArr.end();
-    }
-
-    // mSegs
-    {
-        MappedArray<uint32_t>::Builder numSegmentsArr(name + ".segs.num-segments", pFactory);
-        MappedArray<uint64_t>::Builder segmentArr(name + ".segs.segments", pFactory);
-        for (vector<SuperPath::Segments>::const_iterator
-             i = mSegs.begin(); i != mSegs.end(); ++i)
-        {
-            const SuperPath::Segments& segs(*i);
-            numSegmentsArr.push_back(segs.size());
-            for (SuperPath::Segments::const_iterator
-                 j = segs.begin(); j != segs.end(); ++j)
-            {
-                segmentArr.push_back(*j);
-            }
-        }
-        numSegmentsArr.end();
-        segmentArr.end();
-    }
-
-    // mRCs
-    {
-        MappedArray<uint64_t>::Builder rcPathIdArr(name + ".rcs.rc-path-ids", pFactory);
-        for (vector<uint64_t>::const_iterator 
-             i = mRCs.begin(); i != mRCs.end(); ++i)
-        {
-            rcPathIdArr.push_back(*i);
-        }
-        rcPathIdArr.end();
-    }
+    writeArray(name + ".succ.nodes", pFactory, ns);
+    writeArray(name + ".succ.offsets", pFactory, succOffsets);
+    writeArray(name + ".succ.path-ids", pFactory, pathIds);
+    writeArray(name + ".segs.offsets", pFactory, segOffsets);
+    writeArray(name + ".segs.segments", pFactory, segs);
+    writeArray(name + ".rcs.rc-path-ids", pFactory, rcs);
 }
 
 unique_ptr<SuperGraph>
@@ -997,6 +1007,7 @@ SuperGraph::read(const string& pBaseName, FileFactory& pFactory)
                     << boost::errinfo_file_name(name + ".header")
                     << Gossamer::version_mismatch_info(make_pair(SuperGraph::version, h.version)));
         }
+        sg->mFingerprint = h.fingerprint;
     }
 
     // mNextId
@@ -1013,49 +1024,8 @@ SuperGraph::read(const string& pBaseName, FileFactory& pFactory)
         i.read(reinterpret_cast<char*>(&sg->mCount), sizeof(sg->mCount));
     }
 
-    // mSucc
-    {
-        MappedArray<Node>::LazyIterator nodeItr(name + ".succ.nodes", pFactory);
-        MappedArray<uint32_t>::LazyIterator numPathIdsItr(name + ".succ.num-path-ids", pFactory);
-        MappedArray<SuperPathId>::LazyIterator pathIdItr(name + ".succ.path-ids", pFactory);
-        for (; nodeItr.valid(); ++nodeItr, ++numPathIdsItr)
-        {
-            vector<SuperPathId>& pathIds(sg->mSucc[*nodeItr]);
-            pathIds.reserve(*numPathIdsItr);
-            for (uint32_t i = 0; i < *numPathIdsItr; ++i, ++pathIdItr)
-            {
-                pathIds.push_back(*pathIdItr);
-            }
-        }
-    }
-
-    // mSegs
-    {
-        MappedArray<uint32_t>::LazyIterator numSegmentsItr(name + ".segs.num-segments", pFactory);
-        MappedArray<uint64_t>::LazyIterator segmentItr(name + ".segs.segments", pFactory);
-
-        for (; numSegmentsItr.valid(); ++numSegmentsItr)
-        {
-            sg->mSegs.resize(sg->mSegs.size() + 1);
-            SuperPath::Segments& segs(sg->mSegs.back());
-            segs.reserve(*numSegmentsItr);
-            for (uint32_t i = 0; i < *numSegmentsItr; ++i, ++segmentItr)
-            {
-                segs.push_back(*segmentItr);
-            }
-        }
-    }
-
-    // mRCs
-    {
-        MappedArray<uint64_t>::LazyIterator rcPathIdItr(name + ".rcs.rc-path-ids", pFactory);
-        uint64_t i = 0;
-        for (; rcPathIdItr.valid(); ++rcPathIdItr, ++i)
-        {
-            // cerr << i << " -> " << *rcPathIdItr << '\n';
-            sg->mRCs.push_back(*rcPathIdItr);
-        }
-    }
+    sg->mCsr = unique_ptr<Csr>(new Csr(name, pFactory));
+    sg->mNumBaseIds = sg->mCsr->rcs.size();
 
     return sg;
 }
@@ -1090,65 +1060,44 @@ SuperGraph::link(const std::vector<SuperPathId>& pPaths)
 {
     BOOST_ASSERT(!pPaths.empty());
     pair<SuperPathId, SuperPathId> ids = allocRcIds();
-    uint64_t fd = ids.first.value();
-    uint64_t rc = ids.second.value();
-
-    SuperPath::Segments& fdSegs(mSegs[fd]);
-    SuperPath::Segments& rcSegs(mSegs[rc]);
-    BOOST_ASSERT(fdSegs.empty());
-    BOOST_ASSERT(rcSegs.empty());
+    mFingerprint = 0;
 
     uint64_t sz = 0;
     for (uint64_t i = 0; i < pPaths.size(); ++i)
     {
-        sz += mSegs[pPaths[i].value()].size();
+        sz += segments(pPaths[i].value()).size();
     }
 
+    SuperPath::Segments fdSegs;
+    SuperPath::Segments rcSegs;
     fdSegs.reserve(sz);
     rcSegs.reserve(sz);
     for (uint64_t i = 0; i < pPaths.size(); ++i)
     {
         uint64_t fd = pPaths[i].value();
         uint64_t rc = reverseComplement(pPaths[i]).value();
-        const SuperPath::Segments& segs(mSegs[fd]);
-        const SuperPath::Segments& segsRc(mSegs[rc]);
-        // cerr << "fd: " << fd << " (" << segs.size() << ")\n";
-        // cerr << "rc: " << rc << " (" << segsRc.size() << ")\n";
+        const SuperPath::SegmentsRef segs(segments(fd));
+        const SuperPath::SegmentsRef segsRc(segments(rc));
         BOOST_ASSERT(segs.size());
         BOOST_ASSERT(segsRc.size());
         fdSegs.insert(fdSegs.end(), segs.begin(), segs.end());
         rcSegs.insert(rcSegs.begin(), segsRc.begin(), segsRc.end());
     }
 
-/*
-    cerr << "fdSegs";
-    for (SuperPath::Segments::const_iterator i = fdSegs.begin(); i != fdSegs.end(); ++i)
-    {
-        cerr << ' ' << *i;
-    }
-    cerr << "\nrcSegs";
-    for (SuperPath::Segments::const_iterator i = rcSegs.begin(); i != rcSegs.end(); ++i)
-    {
-        cerr << ' ' << *i;
-    }
-    cerr << '\n';
-*/
-
     BOOST_ASSERT(fdSegs.size() == rcSegs.size());
 
-    mSucc[start(ids.first)].push_back(ids.first);
-    mSucc[start(ids.second)].push_back(ids.second);
+    SuperPath::Segments& fdDst(editSegments(ids.first.value()));
+    BOOST_ASSERT(fdDst.empty());
+    fdDst.swap(fdSegs);
+    SuperPath::Segments& rcDst(editSegments(ids.second.value()));
+    BOOST_ASSERT(rcDst.empty());
+    rcDst.swap(rcSegs);
 
-    mCount += 2;
+    editSuccs(start(ids.first)).push_back(ids.first);
+    editSuccs(start(ids.second)).push_back(ids.second);
 
-/*
-    cerr << "ids: " << ids.first.value() << " " << ids.second.value() << '\n';
+    mCount += 2;
 
-    if (ids.first != reverseComplement(ids.second))
-    {
-        cerr << ids.first.value() << " " << reverseComplement(ids.second).value() << '\n';
-    }
-*/
     BOOST_ASSERT(ids.first == reverseComplement(ids.second));
     BOOST_ASSERT(ids.second == reverseComplement(ids.first));
 
@@ -1162,20 +1111,14 @@ SuperPathId
 SuperGraph::gapPath(int64_t pLen)
 {
     pair<SuperPathId, SuperPathId> ids = allocRcIds();
-    uint64_t fd = ids.first.value();
-    uint64_t rc = ids.second.value();
     SuperPath::Segment s = SuperPath::gapSeg(pLen);
+    mFingerprint = 0;
 
-    SuperPath::Segments& fdSegs(mSegs[fd]);
-    SuperPath::Segments& rcSegs(mSegs[rc]);
-
-    fdSegs = SuperPath::Segments(1, s);
-    rcSegs = SuperPath::Segments(1, s);
+    editSegments(ids.first.value()) = SuperPath::Segments(1, s);
+    editSegments(ids.second.value()) = SuperPath::Segments(1, s);
     
     mCount += 2;
 
-    // cerr << "gapPath " << ids.first.value() << '\n';
-
     return ids.first;
 }
 
@@ -1185,9 +1128,8 @@ SuperGraph::gapPath(int64_t pLen)
 void 
 SuperGraph::erase(const SuperPathId& pId)
 {
-    // cerr << "erase " << pId.value() << '\n';
     // The rc id can only be found before the path is deleted!
-    uint64_t rcId = mRCs[pId.value()];
+    uint64_t rcId = rc(pId.value());
     halfErase(pId);
 
     if (rcId != pId.value())
@@ -1202,18 +1144,15 @@ SuperGraph::erase(const SuperPathId& pId)
 void 
 SuperGraph::halfErase(const SuperPathId& pId)
 {
-    // cerr << "halfErase " << pId.value() << "\n";
     uint64_t id = pId.value();
-    BOOST_ASSERT(id < mRCs.size());
+    BOOST_ASSERT(id < size());
+    mFingerprint = 0;
 
     // Remove from node->path map
     // NOTE: This must occur before the path's segments are cleared!
     if (!isGap(pId))
     {
-        Node n(start(pId));
-        unordered_map<Node, SuperPathIds>::iterator i(mSucc.find(n));
-        BOOST_ASSERT(i != mSucc.end());
-        SuperPathIds& ids(i->second);
+        SuperPathIds& ids(editSuccs(start(pId)));
         SuperPathIds::iterator j(find(ids.begin(), ids.end(), pId));
         BOOST_ASSERT(j != ids.end());
         ids.erase(j);
@@ -1221,13 +1160,52 @@ SuperGraph::halfErase(const SuperPathId& pId)
 
     // Clear segments.
     SuperPath::Segments empty;
-    mSegs[id].swap(empty);
+    editSegments(id).swap(empty);
 
     // Free the SuperPathId
     freeId(pId);
     mCount--;
 }
 
+SuperGraph::SuccRange
+SuperGraph::succs(const Node& pNode) const
+{
+    if (!mSucc.empty())
+    {
+        unordered_map<Node, SuperPathIds>::const_iterator i(mSucc.find(pNode));
+        if (i != mSucc.end())
+        {
+            const SuperPathId* ids = i->second.data();
+            return SuccRange(ids, ids + i->second.size());
+        }
+    }
+    if (mCsr)
+    {
+        const Node* n = lower_bound(mCsr->nodes.begin(), mCsr->nodes.end(), pNode);
+        if (n != mCsr->nodes.end() && *n == pNode)
+        {
+            const uint64_t j = n - mCsr->nodes.begin();
+            const SuperPathId* ids = mCsr->pathIds.begin();
+            return SuccRange(ids + mCsr->succOffsets[j], ids + mCsr->succOffsets[j + 1]);
+        }
+    }
+    return SuccRange(0, 0);
+}
+
+SuperGraph::SuperPathIds&
+SuperGraph::editSuccs(const Node& pNode)
+{
+    unordered_map<Node, SuperPathIds>::iterator i(mSucc.find(pNode));
+    if (i != mSucc.end())
+    {
+        return i->second;
+    }
+    SuccRange r(succs(pNode));
+    SuperPathIds& ids(mSucc[pNode]);
+    ids.assign(r.first, r.second);
+    return ids;
+}
+
 /**
  * The next usable SuperPathId.
  */
@@ -1235,11 +1213,11 @@ SuperPathId
 SuperGraph::allocId()
 {
     uint64_t i = mNextId;
-    mNextId = mRCs[i];
+    mNextId = rc(i);
     if (mNextId == invalidSuperPathId)
     {
         grow();
-        mNextId = mRCs.size() - 1;
+        mNextId = size() - 1;
     }
     
     return SuperPathId(i);
@@ -1252,9 +1230,9 @@ void
 SuperGraph::freeId(SuperPathId pId)
 {
     uint64_t i = pId.value();
-    BOOST_ASSERT(i < mRCs.size());
+    BOOST_ASSERT(i < size());
 
-    mRCs[i] = mNextId;
+    setRc(i, mNextId);
     mNextId = i;
 }
 
@@ -1270,14 +1248,37 @@ SuperGraph::grow()
 }
 
 
+SuperGraph::Csr::Csr(const std::string& pName, FileFactory& pFactory)
+    : nodes(pName + ".succ.nodes", pFactory),
+      succOffsets(pName + ".succ.offsets", pFactory),
+      pathIds(pName + ".succ.path-ids", pFactory),
+      segOffsets(pName + ".segs.offsets", pFactory),
+      segments(pName + ".segs.segments", pFactory),
+      rcs(pName + ".rcs.rc-path-ids", pFactory)
+{
+    if (   succOffsets.size() != nodes.size() + 1
+        || succOffsets[nodes.size()] != pathIds.size()
+        || segOffsets.size() != rcs.size() + 1
+        || segOffsets[rcs.size()] != segments.size())
+    {
+        BOOST_THROW_EXCEPTION(
+            Gossamer::error()
+                << Gossamer::general_error_info("Inconsistent supergraph files.")
+                << boost::errinfo_file_name(pName));
+    }
+}
+
 SuperGraph::SuperGraph(const std::string& pBaseName, FileFactory& pFactory)
     : mEntries(pBaseName + "-entries", pFactory),
       mNextId(mEntries.count()),
       mCount(mEntries.count()),
+      mFingerprint(0),
+      mCsr(),
+      mNumBaseIds(0),
+      mSucc(),
+      mSegEdits(),
+      mRCEdits(),
       mSegs(),
       mRCs()
 {
-      mSegs.reserve(mNextId + 1);
-      mRCs.reserve(mNextId + 1);
 }
-
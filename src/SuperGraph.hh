@@ -13,6 +13,10 @@
 #include "EntryEdgeSet.hh"
 #endif
 
+#ifndef MAPPEDARRAY_HH
+#include "MappedArray.hh"
+#endif
+
 #ifndef SUPERPATH_HH
 #include "SuperPath.hh"
 #endif
@@ -43,14 +47,17 @@ class SuperGraph
     friend class PathIterator;
 
 public:
-    static constexpr uint64_t version = 2011082301ULL;
+    static constexpr uint64_t version = 2026101702ULL;
     // Version history
     // 2011062101   - introduce version tracking
     // 2011082301   - simplified structures and API
+    // 2026101701   - sorted nodes and offset arrays, used in place
+    // 2026101702   - header records a fingerprint of the contents
 
     struct Header
     {
         uint64_t version;
+        uint64_t fingerprint;
     };
 
     typedef EntryEdgeSet::Edge Edge;
@@ -61,31 +68,57 @@ public:
 
     static const uint64_t invalidSuperPathId = -1ULL;
 
+    /**
+     * Visits the nodes of the mapped graph which have not been edited,
+     * in order, and then the edited ones.
+     */
     class NodeIterator
     {
     public:
         bool valid() const
         {
-            return mCurr != mEnd;
+            return mPos < mNumBase || mCurr != mEnd;
         }
 
         Node operator*() const
         {
-            return mCurr->first;
+            return mPos < mNumBase ? mSG.mCsr->nodes[mPos] : mCurr->first;
         }
 
         void operator++()
         {
-            ++mCurr;
+            if (mPos < mNumBase)
+            {
+                ++mPos;
+                skipEdited();
+            }
+            else
+            {
+                ++mCurr;
+            }
         }
 
-        NodeIterator(const std::unordered_map<Node,SuperPathIds>::const_iterator& pCurr,
-                     const std::unordered_map<Node,SuperPathIds>::const_iterator& pEnd)
-            : mCurr(pCurr), mEnd(pEnd)
+        NodeIterator(const SuperGraph& pSuperGraph)
+            : mSG(pSuperGraph), mPos(0),
+              mNumBase(pSuperGraph.mCsr ? pSuperGraph.mCsr->nodes.size() : 0),
+              mCurr(pSuperGraph.mSucc.begin()), mEnd(pSuperGraph.mSucc.end())
         {
+            skipEdited();
         }
 
     private:
+        void skipEdited()
+        {
+            while (   mPos < mNumBase && !mSG.mSucc.empty()
+                   && mSG.mSucc.count(mSG.mCsr->nodes[mPos]))
+            {
+                ++mPos;
+            }
+        }
+
+        const SuperGraph& mSG;
+        uint64_t mPos;
+        const uint64_t mNumBase;
         std::unordered_map<Node,SuperPathIds>::const_iterator mCurr;
         std::unordered_map<Node,SuperPathIds>::const_iterator mEnd;
     };
@@ -110,7 +143,7 @@ public:
         }
 
         PathIterator(const SuperGraph& pSuperGraph)
-            : mSG(pSuperGraph), mNodes(pSuperGraph.mSucc.begin(), pSuperGraph.mSucc.end()),
+            : mSG(pSuperGraph), mNodes(pSuperGraph),
               mIds(), mCurr(mIds.begin()), mEnd(mIds.end())
         {
             next();
@@ -224,13 +257,16 @@ public:
      */
     SuperPath operator[](const SuperPathId& pId) const
     {
-        return SuperPath(*this, pId, mSegs[pId.value()], SuperPathId(mRCs[pId.value()]));
+        return SuperPath(*this, pId, segments(pId.value()), SuperPathId(rc(pId.value())));
     }
 
     /**
      * Returns the reverse complement of the given path.
      */
-    SuperPathId reverseComplement(const SuperPathId& pId) const;
+    SuperPathId reverseComplement(const SuperPathId& pId) const
+    {
+        return SuperPathId(rc(pId.value()));
+    }
 
     /**
      * Populate pNodes with all the nodes of the supergraph.
@@ -257,12 +293,8 @@ public:
      */
     uint64_t numOut(const Node& pNode) const
     {
-        std::unordered_map<Node, SuperPathIds>::const_iterator i(mSucc.find(pNode));
-        if (i != mSucc.end())
-        {
-            return i->second.size();
-        }
-        return 0;
+        SuccRange r(succs(pNode));
+        return r.second - r.first;
     }
 
     /**
@@ -270,10 +302,9 @@ public:
      */
     SuperPathId onlyOut(const Node& pNode) const
     {
-        std::unordered_map<Node, SuperPathIds>::const_iterator i(mSucc.find(pNode));
-        BOOST_ASSERT(i != mSucc.end());
-        BOOST_ASSERT(i->second.size() == 1);
-        return i->second.front();
+        SuccRange r(succs(pNode));
+        BOOST_ASSERT(r.second - r.first == 1);
+        return *r.first;
     }
 
     /**
@@ -377,9 +408,9 @@ public:
      */
     bool isGap(const SuperPathId& pId) const
     {
-        uint64_t id = pId.value();
-        return    mSegs[id].size() == 1 
-               && SuperPath::isGap(mEntries, mSegs[id][0]);
+        const SuperPath::SegmentsRef segs(segments(pId.value()));
+        return    segs.size() == 1 
+               && SuperPath::isGap(mEntries, segs[0]);
     }
 
     /**
@@ -395,23 +426,33 @@ public:
         return mCount;
     }
 
+    /**
+     * A fingerprint of the saved SuperGraph this was read from, or 0 if
+     * it was not read or has since been edited. Structures derived from
+     * a supergraph may record it, to tell whether they are still current.
+     */
+    uint64_t fingerprint() const
+    {
+        return mFingerprint;
+    }
+
     /**
      * An upper bound on the ids of edges in the graph.
      */ 
      uint64_t size() const
      {
-        return mRCs.size();
+        return mNumBaseIds + mRCs.size();
      }
 
     bool valid(const SuperPathId& pId) const
     {
         const uint64_t n = pId.value();
-        if (n >= mSegs.size())
+        if (n >= size())
         {
             return false;
         }
 
-        return !mSegs[n].empty();
+        return !segments(n).empty();
     }
 
     /**
@@ -432,12 +473,14 @@ public:
     void dump(std::ostream& pOut) const;
 
     /**
-     * Saves the SuperGraph.
+     * Saves the SuperGraph. If it is written over the files it was read
+     * from, it must not be used afterwards.
      */
     void write(const std::string& pBaseName, FileFactory& pFactory) const;
 
     /**
-     * Reads a saved SuperGraph.
+     * Opens a saved SuperGraph. The nodes, successors and segments are
+     * used in place from the mapped files; edits are kept in memory.
      */
     static std::unique_ptr<SuperGraph> read(const std::string& pBaseName, FileFactory& pFactory);
     
@@ -448,6 +491,25 @@ public:
 
 private:
 
+    typedef std::pair<const SuperPathId*, const SuperPathId*> SuccRange;
+
+    /**
+     * A saved SuperGraph in compressed sparse row form. The successors of
+     * nodes[i] are pathIds[succOffsets[i]..succOffsets[i+1]), and the
+     * segments of path j are segments[segOffsets[j]..segOffsets[j+1]).
+     */
+    struct Csr
+    {
+        MappedArray<Node> nodes;
+        MappedArray<uint64_t> succOffsets;
+        MappedArray<SuperPathId> pathIds;
+        MappedArray<uint64_t> segOffsets;
+        MappedArray<SuperPath::Segment> segments;
+        MappedArray<uint64_t> rcs;
+
+        Csr(const std::string& pName, FileFactory& pFactory);
+    };
+
     SuperGraph(const std::string& pBaseName, FileFactory& pFactory);
 
     SuperGraph(const SuperGraph&);
@@ -458,6 +520,83 @@ private:
      */
     void halfErase(const SuperPathId& pId);
 
+    /**
+     * The successors of the given node.
+     */
+    SuccRange succs(const Node& pNode) const;
+
+    /**
+     * The successors of the given node, copied out of the mapped graph
+     * so they may be edited.
+     */
+    SuperPathIds& editSuccs(const Node& pNode);
+
+    /**
+     * The segments of the given path.
+     */
+    SuperPath::SegmentsRef segments(uint64_t pId) const
+    {
+        if (pId >= mNumBaseIds)
+        {
+            return SuperPath::SegmentsRef(mSegs[pId - mNumBaseIds]);
+        }
+        if (!mSegEdits.empty())
+        {
+            std::unordered_map<uint64_t, SuperPath::Segments>::const_iterator i(mSegEdits.find(pId));
+            if (i != mSegEdits.end())
+            {
+                return SuperPath::SegmentsRef(i->second);
+            }
+        }
+        const SuperPath::Segment* s = mCsr->segments.begin();
+        return SuperPath::SegmentsRef(s + mCsr->segOffsets[pId], s + mCsr->segOffsets[pId + 1]);
+    }
+
+    /**
+     * The segments of the given path, for editing.
+     */
+    SuperPath::Segments& editSegments(uint64_t pId)
+    {
+        if (pId >= mNumBaseIds)
+        {
+            return mSegs[pId - mNumBaseIds];
+        }
+        return mSegEdits[pId];
+    }
+
+    /**
+     * The reverse complement of the given path, or if the path is free,
+     * the next free path.
+     */
+    uint64_t rc(uint64_t pId) const
+    {
+        if (pId >= mNumBaseIds)
+        {
+            return mRCs[pId - mNumBaseIds];
+        }
+        if (!mRCEdits.empty())
+        {
+            std::unordered_map<uint64_t, uint64_t>::const_iterator i(mRCEdits.find(pId));
+            if (i != mRCEdits.end())
+            {
+                return i->second;
+            }
+        }
+        return mCsr->rcs[pId];
+    }
+
+    void setRc(uint64_t pId, uint64_t pRc)
+    {
+        if (pId >= mNumBaseIds)
+        {
+            mRCs[pId - mNumBaseIds] = pRc;
+        }
+        else
+        {
+            mRCEdits[pId] = pRc;
+        }
+    }
+
     /**
      * Given a source and sink, calculates the distance to the sink of all nodes
      * which lie within some bound of the distance between the source and sink.
@@ -484,8 +623,8 @@ private:
     {
         SuperPathId fd = allocId();
         SuperPathId rc = allocId();
-        mRCs[fd.value()] = rc.value();
-        mRCs[rc.value()] = fd.value();
+        setRc(fd.value(), rc.value());
+        setRc(rc.value(), fd.value());
         return std::make_pair(fd, rc);
     }
 
@@ -502,7 +641,21 @@ private:
     EntryEdgeSet mEntries;
     uint64_t mNextId;
     uint64_t mCount;
+    uint64_t mFingerprint;
+
+    // The graph as read, if any. Ids below mNumBaseIds are held here,
+    // unless they have been edited.
+    std::unique_ptr<Csr> mCsr;
+    uint64_t mNumBaseIds;
+
+    // Nodes whose successors are not (or are no longer) those in mCsr.
     std::unordered_map<Node, SuperPathIds> mSucc;
+
+    // Edited paths with ids below mNumBaseIds.
+    std::unordered_map<uint64_t, SuperPath::Segments> mSegEdits;
+    std::unordered_map<uint64_t, uint64_t> mRCEdits;
+
+    // Paths with ids from mNumBaseIds.
     std::vector<SuperPath::Segments> mSegs;
     std::vector<uint64_t> mRCs;
 };
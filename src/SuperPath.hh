@@ -117,6 +117,65 @@ public:
 
     typedef std::vector<Segment> Segments;
 
+    /**
+     * A read-only view of the segments of a path, which may be held in
+     * a Segments vector or directly in a mapped file.
+     */
+    class SegmentsRef
+    {
+    public:
+        typedef const Segment* const_iterator;
+
+        const_iterator begin() const
+        {
+            return mBegin;
+        }
+
+        const_iterator end() const
+        {
+            return mEnd;
+        }
+
+        uint64_t size() const
+        {
+            return mEnd - mBegin;
+        }
+
+        bool empty() const
+        {
+            return mBegin == mEnd;
+        }
+
+        const Segment& operator[](uint64_t pIdx) const
+        {
+            return mBegin[pIdx];
+        }
+
+        const Segment& front() const
+        {
+            return *mBegin;
+        }
+
+        const Segment& back() const
+        {
+            return *(mEnd - 1);
+        }
+
+        SegmentsRef(const Segment* pBegin, const Segment* pEnd)
+            : mBegin(pBegin), mEnd(pEnd)
+        {
+        }
+
+        SegmentsRef(const Segments& pSegs)
+            : mBegin(pSegs.data()), mEnd(pSegs.data() + pSegs.size())
+        {
+        }
+
+    private:
+        const Segment* mBegin;
+        const Segment* mEnd;
+    };
+
     /**
      * Return the starting node of the SuperPath.
      */
@@ -206,7 +265,7 @@ public:
     /**
      * Retrieve the set of segments that constitute this path.
      */
-    const std::vector<Segment>& segments() const
+    SegmentsRef segments() const
     {
         return mSegs;
     }
@@ -222,7 +281,7 @@ public:
     }
 
     SuperPath(const SuperGraph& pSG, const SuperPathId& pId, 
-              const Segments& pSegs, SuperPathId pRC)
+              const SegmentsRef& pSegs, SuperPathId pRC)
         : mSG(pSG), mId(pId), mSegs(pSegs), mRC(pRC)
     {
     }
@@ -231,7 +290,7 @@ private:
 
     const SuperGraph& mSG;
     const SuperPathId mId;
-    const Segments& mSegs;
+    const SegmentsRef mSegs;
     const SuperPathId mRC;
 };
 
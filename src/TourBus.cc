@@ -11,12 +11,14 @@
 #include "ProgressMonitor.hh"
 #include "SimpleHashSet.hh"
 #include "MultithreadedBatchTask.hh"
+#include "ThreadGroup.hh"
+#include <atomic>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <iostream>
+#include <iterator>
 #include <boost/lexical_cast.hpp>
-#include <boost/function_output_iterator.hpp>
 #include <boost/tuple/tuple_io.hpp>
 
 #undef VERBOSE_DEBUG
@@ -64,7 +66,6 @@ struct TourBus::Impl
     void doSingleNode(const Graph::Node& pBegin);
 
     typedef map<uint64_t,Graph::Edge> path_predecessor_t;
-    path_predecessor_t mPredecessors;
 
     struct LinearPathInfo
     {
@@ -95,14 +96,6 @@ struct TourBus::Impl
 
     void doWholeGraph();
 
-    void doNode(float pTime, uint32_t pDistance, uint64_t pNodeRnk);
-
-    void doPath(float pOriginTime, uint32_t pOriginDistance, const LinearPathInfo& pPath);
-
-    void analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin);
-
-    bool isOnPredecessorChain(const Graph::Edge& pEnd, const Graph::Edge& pBegin) const;
-
     uint64_t rank(const Graph::Node& pNode) const
     {
         vector<Graph::Node>::const_iterator i = lower_bound(mNodes.begin(), mNodes.end(), pNode);
@@ -197,6 +190,102 @@ struct TourBus::Impl
         }
     };
 
+    // A bubble found by a search whose removal has been deferred.
+    // It is dropped if an earlier bubble has already removed any edge
+    // of either of its paths, or kept any edge it would remove.
+    struct Bubble
+    {
+        vector<uint64_t> mRemove;
+        vector<uint64_t> mKeep;
+        uint64_t mPaths;
+
+        Bubble()
+            : mPaths(0)
+        {
+        }
+    };
+
+    // The state of a search from a single start node. A tour either
+    // trims the graph as it goes, or collects the bubbles it would
+    // have popped so that several tours can run at once against the
+    // same trimmer.
+    struct Tour
+    {
+        const Impl& mImpl;
+        const Graph& mGraph;
+        GraphTrimmer* mTrimmer;
+        path_predecessor_t mPredecessors;
+        dist_map_t mDistance;
+        WorkQueue mWorkQueue;
+        std::unordered_set<uint64_t> mRemoved;
+        vector<Bubble> mBubbles;
+        uint64_t mPotentialBubblesConsidered;
+        uint64_t mBubblesRemoved;
+        uint64_t mPathsRemoved;
+
+        // Records the edges of a path, and both of their strands, in
+        // a deferred bubble. The edges of a minority path are also
+        // treated as deleted for the rest of the search.
+        struct BubbleVisitor
+        {
+            Tour& mTour;
+            vector<uint64_t>& mRanks;
+            bool mRemove;
+
+            void operator()(const Graph::Edge& pEdge, const Gossamer::rank_type& pRank)
+            {
+                const Graph& g(mTour.mGraph);
+                uint64_t r = g.rank(pEdge);
+                uint64_t rc = g.rank(g.reverseComplement(pEdge));
+                mRanks.push_back(r);
+                mRanks.push_back(rc);
+                if (mRemove)
+                {
+                    mTour.mRemoved.insert(r);
+                    mTour.mRemoved.insert(rc);
+                }
+            }
+
+            BubbleVisitor(Tour& pTour, vector<uint64_t>& pRanks, bool pRemove)
+                : mTour(pTour), mRanks(pRanks), mRemove(pRemove)
+            {
+            }
+        };
+
+        bool edgeDeleted(uint64_t pRank) const
+        {
+            return mImpl.mTrimmer.edgeDeleted(pRank)
+                || (!mTrimmer && mRemoved.count(pRank));
+        }
+
+        // Search from the node with the given rank in mNodes.
+        // Returns the number of nodes examined, which exceeds
+        // pMaxPasses if the search was abandoned.
+        uint64_t run(uint64_t pNodeRnk, uint64_t pMaxPasses);
+
+        void doNode(float pTime, uint32_t pDistance, uint64_t pNodeRnk);
+
+        void doPath(float pOriginTime, uint32_t pOriginDistance, const LinearPathInfo& pPath);
+
+        void analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin);
+
+        bool isOnPredecessorChain(const Graph::Edge& pEnd, const Graph::Edge& pBegin) const;
+
+        Tour(const Impl& pImpl, GraphTrimmer* pTrimmer)
+            : mImpl(pImpl), mGraph(pImpl.mGraph), mTrimmer(pTrimmer),
+              mPotentialBubblesConsidered(0), mBubblesRemoved(0),
+              mPathsRemoved(0)
+        {
+        }
+    };
+
+    void doWholeGraphInRounds(deque<StartNodeItem>& pStartNodeQueue,
+                              uint64_t pMaxPasses);
+
+    void abandonedNode(uint64_t pNodeRnk, uint64_t pPasses);
+
+    bool applyBubble(const Bubble& pBubble, dynamic_bitset<>& pKept);
+
     const Graph& mGraph;
     Logger& mLog;
     GraphTrimmer mTrimmer;
@@ -208,9 +297,7 @@ struct TourBus::Impl
     bool mDoRelCutoffCheck;
     double mRelCutoff;
     uint64_t mNumThreads;
-    WorkQueue mWorkQueue;
     vector<Graph::Node> mNodes;
-    dist_map_t mDistance;
     uint64_t mPotentialBubblesConsidered;
     uint64_t mBubblesRemoved;
     uint64_t mPathsRemoved;
@@ -365,8 +452,6 @@ TourBus::Impl::Impl(const Graph& pGraph, Logger& pLog)
 void
 TourBus::Impl::findStartNodes(deque<StartNodeItem>& pStartNodeQueue)
 {
-    using namespace std::placeholders;
-
     uint64_t N = mGraph.count();
     uint64_t J = mNumThreads;
     uint64_t S = N / J;
@@ -426,17 +511,9 @@ TourBus::Impl::findStartNodes(deque<StartNodeItem>& pStartNodeQueue)
         b.swap(nodeRuns.front());
         nodeRuns.pop_front();
 
-        // cast to a specific overload function of push_back
-        // this is mainly due to:
-        //   deque<T>::push_back(const T&)
-        //   deque<T>::push_back(T&&) // C++11 move semantic
-        // being unresolvable.
-        void (deque<Graph::Node>:: *dequePushBaskConstRef)(const Graph::Node&) = &deque<Graph::Node>::push_back;
-
         deque<Graph::Node> c;
         merge(a.begin(), a.end(), b.begin(), b.end(),
-              make_function_output_iterator(
-                  std::bind(dequePushBaskConstRef, std::ref(c), _1)));
+              back_inserter(c));
 
         nodeRuns.push_back(deque<Graph::Node>());
         nodeRuns.back().swap(c);
@@ -471,17 +548,9 @@ TourBus::Impl::findStartNodes(deque<StartNodeItem>& pStartNodeQueue)
             b.swap(nodeRuns.front());
             nodeRuns.pop_front();
 
-            // cast to a specific overload function of push_back
-            // this is mainly due to:
-            //   vector<T>::push_back(const T&)
-            //   vector<T>::push_back(T&&) // C++11 move semantic
-            // being unresolvable.
-            void (vector<Graph::Node>:: *vectorPushBaskConstRef)(const Graph::Node&) = &vector<Graph::Node>::push_back;
-
             mNodes.reserve(a.size() + b.size());
             merge(a.begin(), a.end(), b.begin(), b.end(),
-                  make_function_output_iterator(
-                      std::bind(vectorPushBaskConstRef, std::ref(mNodes), _1)));
+                  back_inserter(mNodes));
             break;
         }
 
@@ -505,17 +574,9 @@ TourBus::Impl::findStartNodes(deque<StartNodeItem>& pStartNodeQueue)
         b.swap(startNodeRuns.front());
         startNodeRuns.pop_front();
 
-        // cast to a specific overload function of push_back
-        // this is mainly due to:
-        //   vector<T>::push_back(const T&)
-        //   vector<T>::push_back(T&&) // C++11 move semantic
-        // being unresolvable.
-        void (deque<StartNodeItem>:: *dequePushBaskConstRef)(const StartNodeItem&) = &deque<StartNodeItem>::push_back;
-
         deque<StartNodeItem> c;
         merge(a.begin(), a.end(), b.begin(), b.end(),
-              make_function_output_iterator(
-                  std::bind(dequePushBaskConstRef, std::ref(c), _1)));
+              back_inserter(c));
 
         startNodeRuns.push_back(deque<StartNodeItem>());
         startNodeRuns.back().swap(c);
@@ -568,77 +629,144 @@ TourBus::Impl::doWholeGraph()
     deque<StartNodeItem> startNodeQueue;
     findStartNodes(startNodeQueue);
 
-    uint64_t j = 0;
     const uint64_t maxPasses = 10000ull;
 
     mLog(info, "Pass 2: Popping bubbles.");
-    ProgressMonitorNew examineMon(mLog, startNodeQueue.size());
-    std::map<uint64_t,uint64_t> passCountMap;
-    while (!startNodeQueue.empty())
+    doWholeGraphInRounds(startNodeQueue, maxPasses);
+
+    mEdgesRemoved = mTrimmer.removedEdgesCount();
+
+    mLog(info, "  potential bubbles considered: " + lexical_cast<string>(mPotentialBubblesConsidered));
+    mLog(info, "  bubbles popped: " + lexical_cast<string>(mBubblesRemoved));
+    mLog(info, "  paths removed: " + lexical_cast<string>(mPathsRemoved));
+    mLog(info, "  edges removed: " + lexical_cast<string>(mEdgesRemoved));
+    mLog(info, "Done.");
+}
+
+
+void
+TourBus::Impl::abandonedNode(uint64_t pNodeRnk, uint64_t pPasses)
+{
+    SmallBaseVector v_n;
+    mGraph.seq(mNodes[pNodeRnk], v_n);
+    mLog(warning, "Potential problem with node " + lexical_cast<string>(v_n) + " (rank " + lexical_cast<string>(pNodeRnk) + ")");
+    mLog(warning, "Processing will take at least " + lexical_cast<string>(pPasses) + " passes.");
+    mLog(warning, "Abandoning this node just in case.");
+}
+
+
+void
+TourBus::Impl::doWholeGraphInRounds(deque<StartNodeItem>& pStartNodeQueue,
+                                    uint64_t pMaxPasses)
+{
+    // Start nodes are taken in rounds of a fixed size. Within a round,
+    // threads claim small runs of start nodes from a shared counter and
+    // search from them against the deletions made by earlier rounds.
+    // The bubbles found are then applied in start node order, so the
+    // result does not depend on the number of threads or on which
+    // thread searched from which node. The majority paths of the
+    // bubbles popped are kept for the rest of the pass, so that two
+    // searches can't remove both sides of the same bubble.
+    const uint64_t roundSize = 65536;
+    const uint64_t claimSize = 64;
+
+    struct Result
     {
-        examineMon.tick(j++);
-        Graph::Node n = startNodeQueue.back().second;
-        uint64_t nRank = rank(n);
-        mPredecessors.clear();
-        mDistance.clear();
-        mWorkQueue.clear();
-        mDistance[nRank] = 0;
-        startNodeQueue.pop_back();
-#ifdef VERBOSE_DEBUG
-        cerr << "Inserting initial work queue node " << nRank << "\n";
-#endif
-        mWorkQueue.insert(0, nRank, 0);
-        uint64_t passes = 0ull;
-        while (!mWorkQueue.empty())
+        vector<Bubble> mBubbles;
+        uint64_t mPasses;
+        uint64_t mPending;
+    };
+
+    uint64_t j = 0;
+    ProgressMonitorNew examineMon(mLog, pStartNodeQueue.size());
+    dynamic_bitset<> kept(mGraph.count());
+    vector<uint64_t> starts;
+    vector<Result> results;
+    while (!pStartNodeQueue.empty())
+    {
+        uint64_t n = std::min<uint64_t>(roundSize, pStartNodeQueue.size());
+        starts.clear();
+        for (uint64_t i = 0; i < n; ++i)
         {
-            WorkItem item = mWorkQueue.get();
-            uint64_t nn = item.get<0>();
-#ifdef VERBOSE_DEBUG
-            cerr << "Getting minimum work queue node " << nn << "\n";
-#endif
-            float time = item.get<1>();
-            float distance = item.get<2>();
-#ifdef VERBOSE_DEBUG
+            starts.push_back(rank(pStartNodeQueue.back().second));
+            pStartNodeQueue.pop_back();
+        }
+        results.clear();
+        results.resize(n);
+
+        std::atomic<uint64_t> next(0);
+        std::atomic<uint64_t> considered(0);
+        {
+            ThreadGroup grp;
+            for (uint64_t t = 0; t < mNumThreads; ++t)
             {
-                SmallBaseVector v_n;
-                mGraph.seq(mNodes[nn], v_n);
-                cerr << "Examining node " << v_n << " with time " << time << " and distance " << distance << "\n";
+                grp.create([&] () {
+                    Tour tour(*this, 0);
+                    for (uint64_t b = next.fetch_add(claimSize); b < n;
+                         b = next.fetch_add(claimSize))
+                    {
+                        uint64_t e = std::min(n, b + claimSize);
+                        for (uint64_t i = b; i < e; ++i)
+                        {
+                            Result& res(results[i]);
+                            res.mPasses = tour.run(starts[i], pMaxPasses);
+                            res.mPending = tour.mWorkQueue.size();
+                            res.mBubbles.swap(tour.mBubbles);
+                        }
+                    }
+                    considered += tour.mPotentialBubblesConsidered;
+                });
             }
-            cerr << "Removing minimum work queue node " << nn << "\n";
-#endif
-            mWorkQueue.removeMinimum();
-            doNode(time, distance, nn);
-            if (++passes > maxPasses)
+            grp.join();
+        }
+        mPotentialBubblesConsidered += considered;
+
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            const Result& res(results[i]);
+            if (res.mPasses > pMaxPasses)
             {
-                SmallBaseVector v_n;
-                mGraph.seq(n, v_n);
-                mLog(warning, "Potential problem with node " + lexical_cast<string>(v_n) + " (rank " + lexical_cast<string>(nRank) + ")");
-                mLog(warning, "Processing will take at least " + lexical_cast<string>(passes + mWorkQueue.size()) + " passes.");
-                mLog(warning, "Abandoning this node just in case.");
-                break;
+                abandonedNode(starts[i], res.mPasses + res.mPending);
             }
+            for (uint64_t k = 0; k < res.mBubbles.size(); ++k)
+            {
+                applyBubble(res.mBubbles[k], kept);
+            }
+            examineMon.tick(j++);
         }
-        ++passCountMap[passes];
     }
-#if 0
-    mLog(info, "Pass count histogram: ");
-    for (std::map<uint64_t,uint64_t>::const_iterator ii = passCountMap.begin();
-         ii != passCountMap.end(); ++ii)
+}
+
+
+bool
+TourBus::Impl::applyBubble(const Bubble& pBubble, dynamic_bitset<>& pKept)
+{
+    for (uint64_t i = 0; i < pBubble.mRemove.size(); ++i)
     {
-        mLog(info, "    " + lexical_cast<string>(ii->first)
-                   + "\t" + lexical_cast<string>(ii->second));
+        if (mTrimmer.edgeDeleted(pBubble.mRemove[i]) || pKept[pBubble.mRemove[i]])
+        {
+            return false;
+        }
+    }
+    for (uint64_t i = 0; i < pBubble.mKeep.size(); ++i)
+    {
+        if (mTrimmer.edgeDeleted(pBubble.mKeep[i]))
+        {
+            return false;
+        }
     }
-#endif
-    mDistance.clear();
-    mPredecessors.clear();
-
-    mEdgesRemoved = mTrimmer.removedEdgesCount();
 
-    mLog(info, "  potential bubbles considered: " + lexical_cast<string>(mPotentialBubblesConsidered));
-    mLog(info, "  bubbles popped: " + lexical_cast<string>(mBubblesRemoved));
-    mLog(info, "  paths removed: " + lexical_cast<string>(mPathsRemoved));
-    mLog(info, "  edges removed: " + lexical_cast<string>(mEdgesRemoved));
-    mLog(info, "Done.");
+    ++mBubblesRemoved;
+    mPathsRemoved += pBubble.mPaths;
+    for (uint64_t i = 0; i < pBubble.mKeep.size(); ++i)
+    {
+        pKept[pBubble.mKeep[i]] = true;
+    }
+    for (uint64_t i = 0; i < pBubble.mRemove.size(); i += 2)
+    {
+        mTrimmer.deleteEdge(pBubble.mRemove[i], pBubble.mRemove[i + 1]);
+    }
+    return true;
 }
 
 
@@ -649,12 +777,27 @@ TourBus::Impl::doSingleNode(const Graph::Node& pBegin)
     findStartNodes(startNodeQueue);
     startNodeQueue.clear();
 
-    uint64_t nn = rank(pBegin);
+    Tour tour(*this, &mTrimmer);
+    tour.run(rank(pBegin), ~0ull);
+    mPotentialBubblesConsidered += tour.mPotentialBubblesConsidered;
+    mBubblesRemoved += tour.mBubblesRemoved;
+    mPathsRemoved += tour.mPathsRemoved;
+}
+
+
+uint64_t
+TourBus::Impl::Tour::run(uint64_t pNodeRnk, uint64_t pMaxPasses)
+{
     mPredecessors.clear();
     mDistance.clear();
-    mDistance[nn] = 0;
-    mWorkQueue.insert(0, nn, 0);
-
+    mWorkQueue.clear();
+    mRemoved.clear();
+    mDistance[pNodeRnk] = 0;
+#ifdef VERBOSE_DEBUG
+    cerr << "Inserting initial work queue node " << pNodeRnk << "\n";
+#endif
+    mWorkQueue.insert(0, pNodeRnk, 0);
+    uint64_t passes = 0ull;
     while (!mWorkQueue.empty())
     {
         WorkItem item = mWorkQueue.get();
@@ -663,30 +806,33 @@ TourBus::Impl::doSingleNode(const Graph::Node& pBegin)
         uint32_t distance = item.get<2>();
 #ifdef VERBOSE_DEBUG
         {
-            Graph::Node n = mNodes[nn];
             SmallBaseVector v_n;
-            mGraph.seq(n, v_n);
+            mGraph.seq(mImpl.mNodes[nn], v_n);
             cerr << "Examining node " << v_n << " with time " << time << " and distance " << distance << "\n";
         }
 #endif // VERBOSE_DEBUG
         mWorkQueue.removeMinimum();
         doNode(time, distance, nn);
+        if (++passes > pMaxPasses)
+        {
+            break;
+        }
     }
-
-    mDistance.clear();
     mPredecessors.clear();
+    mDistance.clear();
+    return passes;
 }
 
 
 void
-TourBus::Impl::doNode(float pTime, uint32_t pDistance, uint64_t pNodeRnk)
+TourBus::Impl::Tour::doNode(float pTime, uint32_t pDistance, uint64_t pNodeRnk)
 {
-    pair<uint64_t,uint64_t> r = mGraph.beginEndRank(mNodes[pNodeRnk]);
+    pair<uint64_t,uint64_t> r = mGraph.beginEndRank(mImpl.mNodes[pNodeRnk]);
     uint64_t r0 = r.first;
     uint64_t r1 = r.second;
     for (uint64_t i = r0; i < r1; ++i)
     {
-        if (mTrimmer.edgeDeleted(i))
+        if (edgeDeleted(i))
         {
             continue;
         }
@@ -701,7 +847,7 @@ TourBus::Impl::doNode(float pTime, uint32_t pDistance, uint64_t pNodeRnk)
 
 
 void
-TourBus::Impl::doPath(float pOriginTime, uint32_t pOriginDistance,
+TourBus::Impl::Tour::doPath(float pOriginTime, uint32_t pOriginDistance,
                       const LinearPathInfo& pPath)
 {
 #ifdef VERBOSE_DEBUG
@@ -714,7 +860,7 @@ TourBus::Impl::doPath(float pOriginTime, uint32_t pOriginDistance,
     }
 #endif // VERBOSE_DEBUG
     Graph::Node endNode = mGraph.to(pPath.mEnd);
-    uint64_t endNodeRank = rank(endNode);
+    uint64_t endNodeRank = mImpl.rank(endNode);
     path_predecessor_t::iterator predecessor = mPredecessors.find(endNodeRank);
     if (predecessor != mPredecessors.end() && predecessor->second == pPath.mBegin)
     {
@@ -731,7 +877,7 @@ TourBus::Impl::doPath(float pOriginTime, uint32_t pOriginDistance,
     cerr << "Non-loop with edge time " << edgeTime << " (total time " << totalTime << ") and distance " << edgeDistance << " (total distance " << totalDistance << ")\n";
 #endif // VERBOSE_DEBUG
 
-    if (totalDistance > mMaxSequenceLength * 2)
+    if (totalDistance > mImpl.mMaxSequenceLength * 2)
     {
 #ifdef VERBOSE_DEBUG
         cerr << "Maximum sequence length bound exceeded.\n";
@@ -785,7 +931,7 @@ TourBus::Impl::doPath(float pOriginTime, uint32_t pOriginDistance,
 
 
 bool
-TourBus::Impl::isOnPredecessorChain(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
+TourBus::Impl::Tour::isOnPredecessorChain(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
     const
 {
     // TODO This is obviously incorrect, but a conservative approximation.
@@ -794,13 +940,13 @@ TourBus::Impl::isOnPredecessorChain(const Graph::Edge& pEnd, const Graph::Edge&
 
 
 void
-TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
+TourBus::Impl::Tour::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
 {
     const Graph& g = mGraph;
     Graph::Node f = g.from(pBegin);
-    uint64_t fRank = rank(f);
+    uint64_t fRank = mImpl.rank(f);
     Graph::Node t = g.to(pEnd);
-    uint64_t tRank = rank(t);
+    uint64_t tRank = mImpl.rank(t);
 
 #ifdef VERBOSE_DEBUG
     SmallBaseVector sbv;
@@ -875,7 +1021,7 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
     while (x != mPredecessors.end())
     {
         n = g.from(x->second);
-        nRank = rank(n);
+        nRank = mImpl.rank(n);
         if (minority.count(nRank))
         {
 #ifdef VERBOSE_DEBUG
@@ -898,7 +1044,7 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
 
     // Now let's scan back up the majority path looking for a common element.
     n = g.from(majEdge);
-    nRank = rank(n);
+    nRank = mImpl.rank(n);
     do
     {
 #ifdef VERBOSE_DEBUG
@@ -913,7 +1059,7 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
         x = mPredecessors.find(nRank);
         BOOST_ASSERT(x != mPredecessors.end());
         n = g.from(x->second);
-        nRank = rank(n);
+        nRank = mImpl.rank(n);
     } while (x != mPredecessors.end());
 
 #ifdef VERBOSE_DEBUG
@@ -936,8 +1082,8 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
     min.push_front(e);
     while (g.from(e) != n)
     {
-        BOOST_ASSERT(mPredecessors.find(rank(g.from(e))) != mPredecessors.end());
-        e = mPredecessors.find(rank(g.from(e)))->second;
+        BOOST_ASSERT(mPredecessors.find(mImpl.rank(g.from(e))) != mPredecessors.end());
+        e = mPredecessors.find(mImpl.rank(g.from(e)))->second;
 #ifdef VERBOSE_DEBUG
         sbv.clear();
         g.seq(e, sbv);
@@ -945,12 +1091,12 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
 #endif // VERBOSE_DEBUG
         min.push_front(e);
     }
-    composeSequence(min, minSeq);
+    mImpl.composeSequence(min, minSeq);
 #ifdef VERBOSE_DEBUG
     cerr << "Minority sequence: " << minSeq << "\n";
 #endif // VERBOSE_DEBUG
 
-    if (minSeq.size() > mMaxSequenceLength)
+    if (minSeq.size() > mImpl.mMaxSequenceLength)
     {
 #ifdef VERBOSE_DEBUG
         cerr << "Sequence too long.\n";
@@ -970,8 +1116,8 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
         max.push_front(e);
         while (g.from(e) != n)
         {
-            BOOST_ASSERT(mPredecessors.find(rank(g.from(e))) != mPredecessors.end());
-            e = mPredecessors.find(rank(g.from(e)))->second;
+            BOOST_ASSERT(mPredecessors.find(mImpl.rank(g.from(e))) != mPredecessors.end());
+            e = mPredecessors.find(mImpl.rank(g.from(e)))->second;
 #ifdef VERBOSE_DEBUG
             sbv.clear();
             g.seq(e, sbv);
@@ -980,12 +1126,12 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
             max.push_front(e);
         }
     }
-    composeSequence(max, maxSeq);
+    mImpl.composeSequence(max, maxSeq);
 #ifdef VERBOSE_DEBUG
     cerr << "Majority sequence: " << maxSeq << "\n";
 #endif // VERBOSE_DEBUG
 
-    if (maxSeq.size() > mMaxSequenceLength)
+    if (maxSeq.size() > mImpl.mMaxSequenceLength)
     {
 #ifdef VERBOSE_DEBUG
         cerr << "Sequence too long.\n";
@@ -993,7 +1139,7 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
         return;
     }
 
-    if (static_cast<size_t>(std::abs((int64_t)maxSeq.size() - (int64_t)minSeq.size())) > mMaxEditDistance)
+    if (static_cast<size_t>(std::abs((int64_t)maxSeq.size() - (int64_t)minSeq.size())) > mImpl.mMaxEditDistance)
     {
 #ifdef VERBOSE_DEBUG
         cerr << "Length difference too high.\n";
@@ -1002,7 +1148,7 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
     }
 
     size_t editDistance = maxSeq.editDistance(minSeq);
-    if (editDistance > mMaxEditDistance)
+    if (editDistance > mImpl.mMaxEditDistance)
     {
 #ifdef VERBOSE_DEBUG
         cerr << "Edit distance too high.\n";
@@ -1011,7 +1157,7 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
     }
 
     double relErrors = (double)editDistance / std::max(minSeq.size(), maxSeq.size());
-    if (relErrors > mMaxRelativeErrors)
+    if (relErrors > mImpl.mMaxRelativeErrors)
     {
 #ifdef VERBOSE_DEBUG
         cerr << "Relative error rate too high.\n";
@@ -1020,7 +1166,7 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
     }
 
     // Perform cutoff checks
-    if (mDoCutoffCheck || mDoRelCutoffCheck)
+    if (mImpl.mDoCutoffCheck || mImpl.mDoRelCutoffCheck)
     {
         CoverageVisitor covVisitor(g);
 
@@ -1031,12 +1177,12 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
         }
         double minCoverage = (double)covVisitor.mCoverage / covVisitor.mLength;
 
-        if (mDoCutoffCheck && minCoverage < mCutoff)
+        if (mImpl.mDoCutoffCheck && minCoverage < mImpl.mCutoff)
         {
             return;
         }
 
-        if (mDoRelCutoffCheck)
+        if (mImpl.mDoRelCutoffCheck)
         {
             covVisitor.reset();
 
@@ -1048,15 +1194,37 @@ TourBus::Impl::analyseEdge(const Graph::Edge& pEnd, const Graph::Edge& pBegin)
             double maxCoverage
                 = (double)covVisitor.mCoverage / covVisitor.mLength;
 
-            if (minCoverage < maxCoverage * mRelCutoff)
+            if (minCoverage < maxCoverage * mImpl.mRelCutoff)
             {
                 return;
             }
         }
     }
 
+    if (!mTrimmer)
+    {
+        mBubbles.push_back(Bubble());
+        Bubble& bubble(mBubbles.back());
+        BubbleVisitor removeVisitor(*this, bubble.mRemove, true);
+        uint64_t r = g.rank(min.front());
+        removeVisitor(min.front(), r);
+        for (uint64_t i = 0; i < min.size(); ++i)
+        {
+            Graph::Edge end = g.linearPath(min[i]);
+            g.visitPath(min[i], end, removeVisitor);
+            ++bubble.mPaths;
+        }
+        BubbleVisitor keepVisitor(*this, bubble.mKeep, false);
+        for (uint64_t i = 0; i < max.size(); ++i)
+        {
+            Graph::Edge end = g.linearPath(max[i]);
+            g.visitPath(max[i], end, keepVisitor);
+        }
+        return;
+    }
+
     ++mBubblesRemoved;
-    GraphTrimmer::EdgeTrimVisitor trimVisitor(mTrimmer);
+    GraphTrimmer::EdgeTrimVisitor trimVisitor(*mTrimmer);
     uint64_t r = g.rank(min.front());
     trimVisitor(min.front(), r);
 #ifdef VERBOSE_DEBUG
@@ -1099,12 +1267,8 @@ TourBus::Impl::composeSequence(const deque<Graph::Edge>& pSegStarts,
 void
 TourBus::Impl::pass()
 {
-    mPredecessors.clear();
-    mDistance.clear();
     mNodes.clear();
     doWholeGraph();
-    mPredecessors.clear();
-    mDistance.clear();
 }
 
 
@@ -1119,12 +1283,8 @@ TourBus::pass()
 bool
 TourBus::singleNode(const Graph::Node& pNode)
 {
-    mPImpl->mPredecessors.clear();
-    mPImpl->mDistance.clear();
     mPImpl->mNodes.clear();
     mPImpl->doSingleNode(pNode);
-    mPImpl->mPredecessors.clear();
-    mPImpl->mDistance.clear();
     return mPImpl->mTrimmer.modified();
 }
 
@@ -1176,7 +1336,7 @@ TourBus::setCoverageRelativeCutoff(double pRelCutoff)
 void
 TourBus::writeModifiedGraph(Graph::Builder& pBuilder) const
 {
-    mPImpl->mTrimmer.writeTrimmedGraph(pBuilder);
+    mPImpl->mTrimmer.writeTrimmedGraph(pBuilder, mPImpl->mNumThreads, mPImpl->mLog);
 }
 
 
@@ -18,9 +18,11 @@
 #include <string>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <boost/lexical_cast.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/pending/disjoint_sets.hpp>
@@ -40,6 +42,7 @@
 #include "ExternalBufferSort.hh"
 #include "BoundedQueue.hh"
 #include "VByteCodec.hh"
+#include "ThreadGroup.hh"
 
 #undef DEBUG
 #undef DUMP_CONTIGS
@@ -257,9 +260,15 @@ namespace // anonymous
         }
     };
 
+    // Ties are broken by rank, so that the seeds come out in the same
+    // order however the graph was split between threads.
     bool seedInfoGt(const SeedInfo& pLhs, const SeedInfo& pRhs)
     {
-        return pLhs.mCount > pRhs.mCount;
+        if (pLhs.mCount != pRhs.mCount)
+        {
+            return pLhs.mCount > pRhs.mCount;
+        }
+        return pLhs.mRank < pRhs.mRank;
     }
 
     struct EdgeInfo
@@ -623,6 +632,31 @@ SortThread::get(vector<uint8_t>& pData)
 }
 
 
+// The contigs and read pairs of one non-empty component, gathered so
+// that several components can be resolved at once.
+struct ComponentJob
+{
+    typedef pair<ResolveTranscripts::ReadInfo,
+                ResolveTranscripts::ReadInfo> read_pair_info;
+
+    uint32_t mId;
+    vector<SmallBaseVector> mContigs;
+    vector<read_pair_info> mReadPairs;
+    string mOut;
+    string mLog;
+
+    uint64_t size() const
+    {
+        return mContigs.size() + mReadPairs.size();
+    }
+
+    ComponentJob(uint32_t pId)
+        : mId(pId)
+    {
+    }
+};
+
+
 struct TransCmdAssemble : public GossCmd
 {
     TransCmdAssemble(
@@ -664,9 +698,82 @@ struct TransCmdAssemble : public GossCmd
     void operator()(const GossCmdContext& pCxt);
 
     void initialiseReads(std::deque<GossReadSequence::Item>& pItems);
+
+    void resolveComponents(Logger& pLog, ostream& pOut,
+                           uint64_t pMappableReads,
+                           deque<ComponentJob>& pJobs);
 };
 
 
+// Resolve a batch of components on mNumThreads threads. The largest
+// components are started first. Each component writes its transcripts
+// and log messages to its own buffers, which are copied out in
+// component order once the whole batch is done, so the output is the
+// same for any number of threads.
+void
+TransCmdAssemble::resolveComponents(Logger& pLog, ostream& pOut,
+                                    uint64_t pMappableReads,
+                                    deque<ComponentJob>& pJobs)
+{
+    Graph& g(*mGPtr);
+
+    vector<uint64_t> order(pJobs.size());
+    for (uint64_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&pJobs] (uint64_t pLhs, uint64_t pRhs) {
+        return pJobs[pLhs].size() > pJobs[pRhs].size();
+    });
+
+    std::atomic<uint64_t> next(0);
+    auto worker = [&] () {
+        for (uint64_t j = next++; j < order.size(); j = next++)
+        {
+            ComponentJob& job(pJobs[order[j]]);
+            std::ostringstream out;
+            std::ostringstream log;
+            {
+                Logger jobLog(log, pLog.sev());
+                ResolveTranscripts resolver(lexical_cast<string>(job.mId),
+                            g, jobLog, out, mMinLength, pMappableReads);
+                for (auto& seq: job.mContigs)
+                {
+                    resolver.addContig(seq);
+                }
+                for (auto& readPair: job.mReadPairs)
+                {
+                    resolver.addReadPair(readPair.first, readPair.second);
+                }
+                resolver.processComponent();
+            }
+            job.mOut = out.str();
+            job.mLog = log.str();
+            vector<SmallBaseVector>().swap(job.mContigs);
+            vector<ComponentJob::read_pair_info>().swap(job.mReadPairs);
+        }
+    };
+
+    {
+        ThreadGroup grp;
+        for (uint64_t t = 1; t < std::min<uint64_t>(mNumThreads, pJobs.size()); ++t)
+        {
+            grp.create(worker);
+        }
+        worker();
+        grp.join();
+    }
+
+    for (auto& job: pJobs)
+    {
+        pLog.append(job.mLog);
+        pOut << job.mOut;
+    }
+    pOut.flush();
+    pJobs.clear();
+}
+
+
 void
 TransCmdAssemble::initialiseReads(std::deque<GossReadSequence::Item>& pItems)
 {
@@ -1397,7 +1504,7 @@ TransCmdAssemble::operator()(const GossCmdContext& pCxt)
     Logger& log(pCxt.log);
     Timer t;
 
-    LineSourceFactory lineSrcFac(BackgroundLineSource::create);
+    LineSourceFactory lineSrcFac(BlockLineSource::create);
 
     log(info, "Assembling transcripts");
     mGPtr = Graph::open(mIn, fac);
@@ -1611,7 +1718,7 @@ TransCmdAssemble::operator()(const GossCmdContext& pCxt)
                 + " components");
     }
 
-    ExternalBufferSort sorter(1024ULL * 1024ULL * 1024ULL, fac);
+    ExternalBufferSort sorter(1024ULL * 1024ULL * 1024ULL, fac, mNumThreads);
     uint64_t numNonEmptyComponents = 0;
     dynamic_bitset<uint64_t> nonEmptyComponents(numComponents);
     uint64_t totalMappableReads = 0;
@@ -1685,16 +1792,18 @@ TransCmdAssemble::operator()(const GossCmdContext& pCxt)
             rhsRead.mRead.decode(i);
         }
 
+        // Components are resolved a batch at a time, so that only
+        // the reads of one batch are held in memory.
+        const uint64_t batchComponents = 64 * mNumThreads;
+        const uint64_t batchReadPairs = 1ULL << 22;
+        deque<ComponentJob> jobs;
+        uint64_t jobReadPairs = 0;
+
         uint32_t nonEmptyCompId = 0;
         uint32_t compId = 0;
         for (auto& component: linkGraph.mComponents)
         {
-            ResolveTranscripts resolver(lexical_cast<string>(nonEmptyCompId),
-                        g, log, out, mMinLength, totalMappableReads);
-
-            typedef pair<ResolveTranscripts::ReadInfo,
-                        ResolveTranscripts::ReadInfo> read_pair_info;
-            vector<read_pair_info> readPairs;
+            vector<ComponentJob::read_pair_info> readPairs;
 
             while (moreInQueue && alignedComponent < compId)
             {
@@ -1716,7 +1825,7 @@ TransCmdAssemble::operator()(const GossCmdContext& pCxt)
                 {
                     break;
                 }
-                readPairs.push_back(read_pair_info(lhsRead, rhsRead));
+                readPairs.push_back(ComponentJob::read_pair_info(lhsRead, rhsRead));
                 vector<uint8_t>::iterator i = read.begin();
                 alignedComponent = VByteCodec::decode(i);
                 lhsRead.mRead.decode(i);
@@ -1725,46 +1834,51 @@ TransCmdAssemble::operator()(const GossCmdContext& pCxt)
 
             if (nonEmptyComponents[compId])
             {
+                jobs.push_back(ComponentJob(nonEmptyCompId));
+                ComponentJob& job(jobs.back());
 #ifdef DUMP_COMPONENT_INTERMEDIATES
-                out << "# BEGIN Contents of component " << nonEmptyCompId << " (" << compId << ")\n";
-                out << "# Contigs:\n";
+                std::ostringstream dump;
+                dump << "# BEGIN Contents of component " << nonEmptyCompId << " (" << compId << ")\n";
+                dump << "# Contigs:\n";
 #endif
 
                 for (auto ctg: component)
                 {
                     const ContigInfo& info = linkGraph.mContigInfo[ctg];
-                    SmallBaseVector seq;
-                    info.decompressContig(g, seq);
+                    job.mContigs.push_back(SmallBaseVector());
+                    info.decompressContig(g, job.mContigs.back());
 #ifdef DUMP_COMPONENT_INTERMEDIATES
-                    out << ">component" << compId << "--" << "contig" << ctg << "\n";
-                    seq.print(out);
+                    dump << ">component" << compId << "--" << "contig" << ctg << "\n";
+                    job.mContigs.back().print(dump);
 #endif
-                    resolver.addContig(seq);
                 }
 #ifdef DUMP_COMPONENT_INTERMEDIATES
                 unsigned readId = 0;
-                out << "# Reads:\n";
-#endif
+                dump << "# Reads:\n";
                 for (auto& readPair: readPairs)
                 {
-#ifdef DUMP_COMPONENT_INTERMEDIATES
-                    out << ">component" << compId << "--" << "read" << readId << "/1\n";
-                    readPair.first.mRead.print(out);
-                    out << ">component" << compId << "--" << "read" << readId << "/2\n";
-                    readPair.second.mRead.print(out);
+                    dump << ">component" << compId << "--" << "read" << readId << "/1\n";
+                    readPair.first.mRead.print(dump);
+                    dump << ">component" << compId << "--" << "read" << readId << "/2\n";
+                    readPair.second.mRead.print(dump);
                     ++readId;
-#endif
-                    resolver.addReadPair(readPair.first, readPair.second);
                 }
-#ifdef DUMP_COMPONENT_INTERMEDIATES
-                out << "# END Contents of component " << nonEmptyCompId << " (" << compId << ")\n";
-                out.flush();
+                dump << "# END Contents of component " << nonEmptyCompId << " (" << compId << ")\n";
+                out << dump.str();
 #endif
-                resolver.processComponent();
+                job.mReadPairs.swap(readPairs);
+                jobReadPairs += job.mReadPairs.size();
                 ++nonEmptyCompId;
+
+                if (jobs.size() >= batchComponents || jobReadPairs >= batchReadPairs)
+                {
+                    resolveComponents(log, out, totalMappableReads, jobs);
+                    jobReadPairs = 0;
+                }
             }
             ++compId;
         }
+        resolveComponents(log, out, totalMappableReads, jobs);
 
         while (moreInQueue)
         {
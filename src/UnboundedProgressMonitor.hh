@@ -13,11 +13,21 @@
 #include "Logger.hh"
 #endif
 
+#ifndef PERFREPORT_HH
+#include "PerfReport.hh"
+#endif
+
+#ifndef STD_CHRONO
+#include <chrono>
+#define STD_CHRONO
+#endif
+
 class UnboundedProgressMonitor
 {
 public:
     void tick(uint64_t pX)
     {
+        mX = pX;
         if (pX >= mNext)
         {
             mNext += mGap;
@@ -31,15 +41,28 @@ public:
     }
 
     UnboundedProgressMonitor(Logger& pLog, uint64_t pGap, const std::string& pUnit)
-        : mLog(pLog), mUnit(pUnit), mGap(pGap), mNext(mGap)
+        : mLog(pLog), mUnit(pUnit), mGap(pGap), mX(0), mNext(mGap),
+          mStartTime(std::chrono::steady_clock::now())
     {
     }
 
+    ~UnboundedProgressMonitor()
+    {
+        using namespace std::chrono;
+        if (mX && PerfReport::enabled())
+        {
+            double secs = duration_cast<microseconds>(steady_clock::now() - mStartTime).count() * 1e-6;
+            PerfReport::addProgress(mUnit, mX, 0, secs);
+        }
+    }
+
 private:
     Logger& mLog;
     std::string mUnit;
     uint64_t mGap;
+    uint64_t mX;
     uint64_t mNext;
+    const std::chrono::steady_clock::time_point mStartTime;
 };
 
 #endif // UNBOUNDEDPROGRESSMONITOR_HH
@@ -273,6 +273,17 @@ inline uint64_t find_first_set(uint64_t pWord)
 }
 
 
+// Hint that the cache line holding pAddr will be read soon.
+inline void prefetch(const void* pAddr)
+{
+#if defined(GOSS_LINUX_X64) || defined(GOSS_MACOSX_X64)
+    __builtin_prefetch(pAddr);
+#elif defined(GOSS_WINDOWS_X64)
+    _mm_prefetch(static_cast<const char*>(pAddr), _MM_HINT_T0);
+#endif
+}
+
+
 inline uint64_t select_by_ffs(uint64_t pWord, uint64_t pR)
 {
     uint64_t bit = 0;
@@ -499,6 +510,10 @@ sortAndUnique(Container& pContainer)
 
 std::string defaultTmpDir(); // OS dependent
 
+// Raise the limit on open files to at least pWanted, if the system
+// allows it, and return the limit. OS dependent.
+uint64_t openFileLimit(uint64_t pWanted);
+
 
 // Helper class to implement the empty member optimisation.
 // See http://www.cantrip.org/emptyopt.html for details.
@@ -168,6 +168,20 @@ public:
             seek1();
         }
 
+        // Start at the first 1 at or after pBitPos, given an iterator
+        // at the word containing it.
+        GeneralIterator(const Itr& pItr, uint64_t pBitPos)
+            : mWordItr(pItr), mValid(pItr.valid()),
+              mCurrWordNum(pBitPos / wordBits), mCurrBitPos(0), mCurrWord(0)
+        {
+            if (!mValid)
+            {
+                return;
+            }
+            mCurrWord = *mWordItr & (~uint64_t(0) << (pBitPos % wordBits));
+            seek1();
+        }
+
     private:
         void next()
         {
@@ -231,6 +245,13 @@ public:
         return Iterator1(mWords.iterator());
     }
 
+    // As above, but starting from the given bit position.
+    //
+    Iterator1 iterator1(uint64_t pBitPos) const
+    {
+        return Iterator1(mWords.iterator(pBitPos / wordBits), pBitPos);
+    }
+
     static LazyIterator1 lazyIterator1(const std::string& pName, FileFactory& pFactory)
     {
         return LazyIterator1(MappedArray<uint64_t>::lazyIterator(pName, pFactory));
@@ -146,7 +146,8 @@ namespace // anonymous
 
             string b = mIn + "-both";
             GossCmdGroupReads(b, mFastas, mFastqs, mLines, mPairs, mMaxMemory, mNumThreads,
-                              mGraftName, mHostName, mPrefix, mDontWriteReads, mPreserveReadOrder)(pCxt);
+                              mGraftName, mHostName, mPrefix, mDontWriteReads, mPreserveReadOrder,
+                              mSortedLookupBatch, mSpillKmers)(pCxt);
 
             log(info, "total elapsed time: " + lexical_cast<string>(t.check()));
         }
@@ -155,11 +156,13 @@ namespace // anonymous
                      const strings& pFastas, const strings& pFastqs, const strings& pLines,
                      bool pPairs, double pMaxMemory, uint64_t pNumThreads,
                      const std::string& pGraftName, const std::string& pHostName, const std::string& pPrefix,
-                     bool pDontWriteReads, bool pPreserveReadOrder)
+                     bool pDontWriteReads, bool pPreserveReadOrder, uint64_t pSortedLookupBatch,
+                     bool pSpillKmers)
             : mIn(pIn), mFastas(pFastas), mFastqs(pFastqs), mLines(pLines), 
               mPairs(pPairs), mMaxMemory(pMaxMemory), mNumThreads(pNumThreads),
               mGraftName(pGraftName), mHostName(pHostName), mPrefix(pPrefix),
-              mDontWriteReads(pDontWriteReads), mPreserveReadOrder(pPreserveReadOrder)
+              mDontWriteReads(pDontWriteReads), mPreserveReadOrder(pPreserveReadOrder),
+              mSortedLookupBatch(pSortedLookupBatch), mSpillKmers(pSpillKmers)
         {
         }
 
@@ -169,13 +172,15 @@ namespace // anonymous
         const strings mFastqs;
         const strings mLines;
         const bool mPairs;
-        const uint64_t mMaxMemory;
+        const double mMaxMemory;
         const uint64_t mNumThreads;
         const std::string mGraftName;
         const std::string mHostName;
         const std::string mPrefix;
         const bool mDontWriteReads;
         const bool mPreserveReadOrder;
+        const uint64_t mSortedLookupBatch;
+        const bool mSpillKmers;
     };
 
     class XenoCmdFactoryGroup : public GossCmdFactory
@@ -223,10 +228,16 @@ namespace // anonymous
             bool ord = false;
             chk.getOptional("preserve-read-order", ord);
 
+            uint64_t batch = 0;
+            chk.getOptional("sorted-lookup-batch", batch);
+
+            bool spill = false;
+            chk.getOptional("spill-kmers", spill);
+
             chk.throwIfNecessary(pApp);
 
             return GossCmdPtr(new XenoCmdGroup(in, fastas, fastqs, lines, pairs, M, T, 
-                                               graftName, hostName, prefix, noOut, ord));
+                                               graftName, hostName, prefix, noOut, ord, batch, spill));
         }
 
         XenoCmdFactoryGroup()
@@ -250,6 +261,12 @@ namespace // anonymous
                     "do not produce any output read files");
             mSpecificOptions.addOpt<bool>("preserve-read-order", "",
                     "maintain the same relative ordering of reads in output files");
+            mSpecificOptions.addOpt<uint64_t>("sorted-lookup-batch", "",
+                    "classify reads in batches of this many, looking up the kmers of each batch "
+                    "in one sequential pass over the index (default: off)");
+            mSpecificOptions.addOpt<bool>("spill-kmers", "",
+                    "when the index needs more than one pass, read the input once, "
+                    "spilling its kmers to temporary files (default: off)");
         }
     };
 
@@ -279,6 +296,7 @@ XenoApp::XenoApp()
                                 "enable particular debugging output");
     globalOpts.addOpt<bool>("help", "h", "show a help message");
     globalOpts.addOpt<string>("log-file", "l", "place to write messages");
+    globalOpts.addOpt<string>("perf-report", "", "write a JSON report of the time, memory and I/O used to this file");
     globalOpts.addOpt<strings>("tmp-dir", "", "a directory to use for temporary files (default /tmp)");
     globalOpts.addOpt<uint64_t>("num-threads", "T", "maximum number of worker threads to use, where possible");
     globalOpts.addOpt<bool>("verbose", "v", "show progress messages");
@@ -0,0 +1,131 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+
+// Compare extracting the normalized kmers of simulated reads with
+// GossRead::Iterator against the whole-read kernels.
+//
+//    benchKmerKernels [k [reads]]
+//
+
+#include "KmerKernels.hh"
+#include "GossReadBaseString.hh"
+#include "Logger.hh"
+#include "Timer.hh"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+using namespace boost;
+using namespace std;
+
+int
+main(int argc, char* argv[])
+{
+    const uint64_t L = 150;
+    uint64_t K = argc > 1 ? lexical_cast<uint64_t>(argv[1]) : 25;
+    uint64_t numReads = argc > 2 ? lexical_cast<uint64_t>(argv[2]) : 200000;
+
+    std::mt19937 rng(19);
+    vector<string> reads;
+    for (uint64_t r = 0; r < numReads; ++r)
+    {
+        string s;
+        for (uint64_t i = 0; i < L; ++i)
+        {
+            s.push_back(rng() % 1000 ? "ACGT"[rng() % 4] : 'N');
+        }
+        reads.push_back(s);
+    }
+    const double bases = numReads * L;
+
+    cout << "method\tseconds\tMbases/s\tkmers" << endl;
+
+    // Checksums of the kmers, which also keep the work from being
+    // optimised away.
+    vector<uint64_t> sums;
+    const string label;
+    const string qual;
+
+    for (uint64_t norm = 0; norm < 2; ++norm)
+    {
+        const string suffix(norm ? "-normalized" : "");
+        {
+            Timer t;
+            uint64_t n = 0;
+            uint64_t sum = 0;
+            for (uint64_t r = 0; r < reads.size(); ++r)
+            {
+                GossReadBaseString read(label, reads[r], qual);
+                for (GossRead::Iterator i(read, K); i.valid(); ++i)
+                {
+                    sum += (norm ? i.kmer().normalized(K) : i.kmer()).asUInt64();
+                    ++n;
+                }
+            }
+            double s = t.check();
+            cout << "iterator" << suffix << '\t' << s << '\t' << (bases / s / 1e6) << '\t' << n << endl;
+            sums.push_back(sum);
+        }
+
+        {
+            Timer t;
+            uint64_t n = 0;
+            uint64_t sum = 0;
+            vector<uint8_t> codes;
+            vector<Gossamer::edge_type> kmers;
+            for (uint64_t r = 0; r < reads.size(); ++r)
+            {
+                kmers.clear();
+                KmerKernels::kmers(reads[r], K, norm, codes, kmers);
+                for (uint64_t i = 0; i < kmers.size(); ++i)
+                {
+                    sum += kmers[i].asUInt64();
+                }
+                n += kmers.size();
+            }
+            double s = t.check();
+            cout << "kernels" << suffix << '\t' << s << '\t' << (bases / s / 1e6) << '\t' << n << endl;
+            sums.push_back(sum);
+        }
+    }
+
+    {
+        vector<uint8_t> codes(L);
+        uint64_t bad = 0;
+        Timer t;
+        for (uint64_t r = 0; r < reads.size(); ++r)
+        {
+            bad += KmerKernels::encodeScalar(reads[r].data(), L, &codes[0]);
+        }
+        double s = t.check();
+        cout << "encode-scalar\t" << s << '\t' << (bases / s / 1e6) << '\t' << bad << endl;
+    }
+
+    {
+        vector<uint8_t> codes(L);
+        uint64_t bad = 0;
+        Timer t;
+        for (uint64_t r = 0; r < reads.size(); ++r)
+        {
+            bad += KmerKernels::encode(reads[r].data(), L, &codes[0]);
+        }
+        double s = t.check();
+        cout << "encode-simd\t" << s << '\t' << (bases / s / 1e6) << '\t' << bad << endl;
+    }
+
+    if (sums[0] != sums[1] || sums[2] != sums[3])
+    {
+        cerr << "kernel kmers differ from iterator kmers" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+
+// Compare the throughput of reading compressed files through the
+// boost::iostreams filter chains with the parallel decompressor.
+//
+//    benchPhysicalFileFactory [megabytes [threads]]
+//
+
+#include "PhysicalFileFactory.hh"
+#include "Logger.hh"
+#include "Timer.hh"
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/lexical_cast.hpp>
+#include <zlib.h>
+
+using namespace boost;
+using namespace std;
+
+namespace // anonymous
+{
+    string randomReads(uint64_t pBytes)
+    {
+        std::mt19937 rng(19);
+        std::uniform_int_distribution<int> base(0, 3);
+        string s;
+        for (uint64_t i = 0; s.size() < pBytes; ++i)
+        {
+            s += "@read" + lexical_cast<string>(i) + "\n";
+            for (uint64_t j = 0; j < 100; ++j)
+            {
+                s += "ACGT"[base(rng)];
+            }
+            s += "\n+\n" + string(100, 'I') + "\n";
+        }
+        return s;
+    }
+
+    template <typename Filter>
+    void writeCompressed(const string& pFileName, const string& pData, const Filter& pFilter)
+    {
+        ofstream f(pFileName.c_str(), ios::binary);
+        iostreams::filtering_ostream out;
+        out.push(pFilter);
+        out.push(f);
+        out.write(pData.data(), pData.size());
+    }
+
+    void putLe(string& pStr, uint64_t pVal, uint64_t pBytes)
+    {
+        for (uint64_t i = 0; i < pBytes; ++i)
+        {
+            pStr += static_cast<char>((pVal >> (8 * i)) & 0xff);
+        }
+    }
+
+    void writeBgzf(const string& pFileName, const string& pData)
+    {
+        ofstream f(pFileName.c_str(), ios::binary);
+        for (uint64_t i = 0; i < pData.size(); i += 65280)
+        {
+            string in(pData.substr(i, 65280));
+            string body(compressBound(in.size()) + 16, '\0');
+            z_stream zs;
+            zs.zalloc = Z_NULL;
+            zs.zfree = Z_NULL;
+            zs.opaque = Z_NULL;
+            deflateInit2(&zs, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+            zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+            zs.avail_in = in.size();
+            zs.next_out = reinterpret_cast<Bytef*>(&body[0]);
+            zs.avail_out = body.size();
+            deflate(&zs, Z_FINISH);
+            body.resize(zs.total_out);
+            deflateEnd(&zs);
+
+            string m("\x1f\x8b\x08\x04\0\0\0\0\0\xff\x06\0BC\x02\0", 16);
+            putLe(m, body.size() + 25, 2);
+            m += body;
+            putLe(m, crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(in.data()), in.size()), 4);
+            putLe(m, in.size(), 4);
+            f.write(m.data(), m.size());
+        }
+    }
+
+    void time(const string& pLabel, const string& pFileName, uint64_t pThreads, uint64_t pBytes)
+    {
+        PhysicalFileFactory fac;
+        fac.setDecompressionThreads(pThreads);
+        Timer t;
+        FileFactory::InHolderPtr inp(fac.in(pFileName));
+        istream& in(**inp);
+        vector<char> buf(1ULL << 20);
+        uint64_t n = 0;
+        while (in.good())
+        {
+            in.read(&buf[0], buf.size());
+            n += in.gcount();
+        }
+        double s = t.check();
+        if (n != pBytes)
+        {
+            cerr << pLabel << ": expected " << pBytes << " bytes, but read " << n << endl;
+        }
+        cout << pLabel << '\t' << pThreads << '\t' << s << '\t' << (n / s / 1048576.0) << endl;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t mb = argc > 1 ? lexical_cast<uint64_t>(argv[1]) : 256;
+    uint64_t T = argc > 2 ? lexical_cast<uint64_t>(argv[2]) : 4;
+
+    PhysicalFileFactory fac;
+    string data(randomReads(mb << 20));
+    string gz(fac.tmpName() + ".gz");
+    string bgz(fac.tmpName() + ".gz");
+    string bz2(fac.tmpName() + ".bz2");
+    writeCompressed(gz, data, iostreams::gzip_compressor());
+    writeBgzf(bgz, data);
+    writeCompressed(bz2, data, iostreams::bzip2_compressor());
+
+    cout << "format\tthreads\tseconds\tMB/s" << endl;
+    time("gzip", gz, 0, data.size());
+    time("gzip", gz, T, data.size());
+    time("bgzf", bgz, 0, data.size());
+    time("bgzf", bgz, T, data.size());
+    time("bzip2", bz2, 0, data.size());
+    time("bzip2", bz2, T, data.size());
+
+    fac.remove(gz);
+    fac.remove(bgz);
+    fac.remove(bz2);
+    return 0;
+}
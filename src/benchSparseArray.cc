@@ -0,0 +1,158 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+
+// Compare looking up the kmers of simulated reads in a SparseArray
+// one at a time with looking them up a read at a time as a batch.
+//
+//    benchSparseArray [genome megabases [reads]]
+//
+
+#include "SparseArray.hh"
+#include "PhysicalFileFactory.hh"
+#include "Logger.hh"
+#include "Timer.hh"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+using namespace boost;
+using namespace std;
+using namespace Gossamer;
+
+namespace // anonymous
+{
+    const uint64_t K = 25;
+    const uint64_t L = 100;
+
+    uint64_t kmerAt(const vector<uint8_t>& pSeq, uint64_t pPos)
+    {
+        uint64_t x = 0;
+        for (uint64_t i = 0; i < K; ++i)
+        {
+            x = (x << 2) | pSeq[pPos + i];
+        }
+        return x;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t mb = argc > 1 ? lexical_cast<uint64_t>(argv[1]) : 16;
+    uint64_t numReads = argc > 2 ? lexical_cast<uint64_t>(argv[2]) : 200000;
+
+    std::mt19937 rng(19);
+    std::uniform_int_distribution<int> base(0, 3);
+
+    vector<uint8_t> genome(mb << 20);
+    for (uint64_t i = 0; i < genome.size(); ++i)
+    {
+        genome[i] = base(rng);
+    }
+
+    vector<uint64_t> kmers;
+    for (uint64_t i = 0; i + K <= genome.size(); ++i)
+    {
+        kmers.push_back(kmerAt(genome, i));
+    }
+    sort(kmers.begin(), kmers.end());
+    kmers.erase(unique(kmers.begin(), kmers.end()), kmers.end());
+
+    PhysicalFileFactory fac;
+    string name(fac.tmpName());
+    {
+        position_type N(1);
+        N <<= 2 * K;
+        SparseArray::Builder b(name, fac, N, kmers.size());
+        for (uint64_t i = 0; i < kmers.size(); ++i)
+        {
+            b.push_back(position_type(kmers[i]));
+        }
+        b.end(N);
+    }
+    SparseArray a(name, fac);
+
+    // Reads with a 1% substitution rate, so that some kmers are absent.
+    std::uniform_int_distribution<uint64_t> start(0, genome.size() - L);
+    std::uniform_real_distribution<> err;
+    vector<vector<position_type> > reads;
+    for (uint64_t r = 0; r < numReads; ++r)
+    {
+        vector<uint8_t> read;
+        uint64_t s = start(rng);
+        for (uint64_t i = 0; i < L; ++i)
+        {
+            read.push_back(err(rng) < 0.01 ? base(rng) : genome[s + i]);
+        }
+        reads.push_back(vector<position_type>());
+        for (uint64_t i = 0; i + K <= L; ++i)
+        {
+            reads.back().push_back(position_type(kmerAt(read, i)));
+        }
+    }
+    const uint64_t lookups = numReads * (L - K + 1);
+
+    cout << "method\tseconds\tMlookups/s\tfound" << endl;
+
+    // Checksums of the ranks, which also keep the lookups from being
+    // optimised away.
+    vector<uint64_t> sums;
+
+    {
+        Timer t;
+        uint64_t found = 0;
+        uint64_t rankSum = 0;
+        for (uint64_t r = 0; r < reads.size(); ++r)
+        {
+            for (uint64_t i = 0; i < reads[r].size(); ++i)
+            {
+                rank_type rnk;
+                found += a.accessAndRank(reads[r][i], rnk);
+                rankSum += rnk;
+            }
+        }
+        double s = t.check();
+        cout << "single\t" << s << '\t' << (lookups / s / 1e6) << '\t' << found << endl;
+        sums.push_back(rankSum);
+    }
+
+    {
+        Timer t;
+        uint64_t found = 0;
+        uint64_t rankSum = 0;
+        vector<rank_type> ranks;
+        vector<bool> present;
+        for (uint64_t r = 0; r < reads.size(); ++r)
+        {
+            ranks.resize(reads[r].size());
+            present.resize(reads[r].size());
+            a.accessAndRank(reads[r].begin(), reads[r].end(), ranks.begin(), present.begin());
+            for (uint64_t i = 0; i < ranks.size(); ++i)
+            {
+                found += present[i];
+                rankSum += ranks[i];
+            }
+        }
+        double s = t.check();
+        cout << "batched\t" << s << '\t' << (lookups / s / 1e6) << '\t' << found << endl;
+        sums.push_back(rankSum);
+    }
+
+    if (sums[0] != sums[1])
+    {
+        cerr << "batched ranks differ from single ranks" << endl;
+    }
+
+    SparseArray::remove(name, fac);
+    return 0;
+}
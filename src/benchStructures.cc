@@ -0,0 +1,560 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+
+// Microbenchmarks of the structures underneath graph building and
+// lookup: SparseArray, DenseArray (DenseRank and DenseSelect),
+// VariableByteArray, BackyardHash, BlendedSort and kmer extraction.
+// Each is run on synthetic graphs built from random genomes of the
+// given sizes, and the results are written to standard output as JSON.
+//
+//    benchStructures [-T threads] [-r repetitions] [genome megabases...]
+//
+// Everything is seeded, so runs of different builds see identical
+// inputs. Each benchmark is repeated, and the fastest and median times
+// are reported; the checksum ties the work to its result, and should
+// not change between builds.
+//
+
+#include "BackyardHash.hh"
+#include "BlendedSort.hh"
+#include "DenseArray.hh"
+#include "GossReadBaseString.hh"
+#include "JsonWriter.hh"
+#include "KmerKernels.hh"
+#include "PhysicalFileFactory.hh"
+#include "SparseArray.hh"
+#include "ThreadGroup.hh"
+#include "Timer.hh"
+#include "VariableByteArray.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+using namespace boost;
+using namespace std;
+using namespace Gossamer;
+
+namespace // anonymous
+{
+    const uint64_t K = 27;
+    const uint64_t E = K + 1;
+    const uint64_t L = 150;
+    const uint64_t Q = 1ULL << 20;
+    const uint64_t sBatchSize = 1024;
+
+    // Runs and reports the benchmarks for one input size.
+    class Bench
+    {
+    public:
+        // Time pBody, which does pOps operations and returns a
+        // checksum, after calling pSetup, which is not timed.
+        template <typename Setup, typename Body>
+        void run(const string& pName, uint64_t pOps, Setup pSetup, Body pBody)
+        {
+            vector<double> secs;
+            uint64_t sum = 0;
+            for (uint64_t i = 0; i < mReps; ++i)
+            {
+                pSetup();
+                Timer t;
+                sum = pBody();
+                secs.push_back(t.check());
+            }
+            sort(secs.begin(), secs.end());
+
+            mOut.beginObject();
+            mOut.field("name", pName);
+            mOut.field("megabases", mMegabases);
+            mOut.field("ops", pOps);
+            mOut.field("reps", mReps);
+            mOut.field("seconds_min", secs.front());
+            mOut.field("seconds_median", secs[secs.size() / 2]);
+            mOut.field("mops_per_second", pOps / secs.front() / 1e6);
+            mOut.field("checksum", sum);
+            mOut.endObject();
+            cerr << pName << '\t' << secs.front() << endl;
+        }
+
+        template <typename Body>
+        void run(const string& pName, uint64_t pOps, Body pBody)
+        {
+            run(pName, pOps, [] () {}, pBody);
+        }
+
+        Bench(JsonWriter& pOut, uint64_t pMegabases, uint64_t pReps)
+            : mOut(pOut), mMegabases(pMegabases), mReps(pReps)
+        {
+        }
+
+    private:
+        JsonWriter& mOut;
+        const uint64_t mMegabases;
+        const uint64_t mReps;
+    };
+
+    // 1, 2, 4, ... up to and including pThreads.
+    vector<uint64_t> threadCounts(uint64_t pThreads)
+    {
+        vector<uint64_t> ts;
+        for (uint64_t t = 1; t < pThreads; t *= 2)
+        {
+            ts.push_back(t);
+        }
+        ts.push_back(pThreads);
+        return ts;
+    }
+
+    uint64_t kmerAt(const vector<uint8_t>& pSeq, uint64_t pPos, uint64_t pK)
+    {
+        uint64_t x = 0;
+        for (uint64_t i = 0; i < pK; ++i)
+        {
+            x = (x << 2) | pSeq[pPos + i];
+        }
+        return x;
+    }
+
+    uint64_t reverseComplement(uint64_t pX, uint64_t pK)
+    {
+        uint64_t y = 0;
+        for (uint64_t i = 0; i < pK; ++i)
+        {
+            y = (y << 2) | (3 - (pX & 3));
+            pX >>= 2;
+        }
+        return y;
+    }
+
+    class U64Cmp
+    {
+    public:
+        static const uint64_t zero()
+        {
+            return 0;
+        }
+
+        uint64_t radix(const uint64_t& pX) const
+        {
+            return pX;
+        }
+
+        bool operator()(const uint64_t& pLhs, const uint64_t& pRhs) const
+        {
+            return pLhs < pRhs;
+        }
+    };
+
+    // The inputs for one size.
+    struct Inputs
+    {
+        vector<uint8_t> genome;
+        vector<uint64_t> edges;         // sorted, both strands
+        vector<string> reads;
+        vector<uint64_t> edgeQueries;   // about half present
+        vector<uint64_t> rankQueries;
+
+        Inputs(uint64_t pMegabases, std::mt19937_64& pRng)
+        {
+            genome.resize(pMegabases << 20);
+            for (uint64_t i = 0; i < genome.size(); ++i)
+            {
+                genome[i] = pRng() & 3;
+            }
+
+            for (uint64_t i = 0; i + E <= genome.size(); ++i)
+            {
+                uint64_t x = kmerAt(genome, i, E);
+                edges.push_back(x);
+                edges.push_back(reverseComplement(x, E));
+            }
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            // One-fold coverage in reads, with a 1% substitution rate.
+            for (uint64_t i = 0; i < genome.size() / L; ++i)
+            {
+                uint64_t s = pRng() % (genome.size() - L);
+                string r;
+                for (uint64_t j = 0; j < L; ++j)
+                {
+                    r.push_back("ACGT"[pRng() % 100 ? genome[s + j] : pRng() & 3]);
+                }
+                reads.push_back(r);
+            }
+
+            const uint64_t M = (1ULL << (2 * E)) - 1;
+            for (uint64_t i = 0; i < Q; ++i)
+            {
+                edgeQueries.push_back(i & 1 ? edges[pRng() % edges.size()] : pRng() & M);
+                rankQueries.push_back(pRng() % edges.size());
+            }
+        }
+    };
+
+    void benchSparseArray(Bench& pBench, const Inputs& pIn, PhysicalFileFactory& pFac)
+    {
+        const string name(pFac.tmpName());
+        position_type N(1);
+        N <<= 2 * E;
+        {
+            SparseArray::Builder b(name, pFac, N, pIn.edges.size());
+            for (uint64_t i = 0; i < pIn.edges.size(); ++i)
+            {
+                b.push_back(position_type(pIn.edges[i]));
+            }
+            b.end(N);
+        }
+
+        {
+            SparseArray a(name, pFac);
+            vector<position_type> qs(pIn.edgeQueries.begin(), pIn.edgeQueries.end());
+
+            pBench.run("sparse-array/access-and-rank", Q, [&] () {
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < Q; ++i)
+                {
+                    rank_type r;
+                    sum += a.accessAndRank(qs[i], r) + r;
+                }
+                return sum;
+            });
+
+            pBench.run("sparse-array/access-and-rank-batched", Q, [&] () {
+                uint64_t sum = 0;
+                vector<rank_type> rs(sBatchSize);
+                vector<bool> fs(sBatchSize);
+                for (uint64_t i = 0; i < Q; i += sBatchSize)
+                {
+                    a.accessAndRank(qs.begin() + i, qs.begin() + i + sBatchSize, rs.begin(), fs.begin());
+                    for (uint64_t j = 0; j < sBatchSize; ++j)
+                    {
+                        sum += fs[j] + rs[j];
+                    }
+                }
+                return sum;
+            });
+
+            pBench.run("sparse-array/rank", Q, [&] () {
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < Q; ++i)
+                {
+                    sum += a.rank(qs[i]);
+                }
+                return sum;
+            });
+
+            pBench.run("sparse-array/select", Q, [&] () {
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < Q; ++i)
+                {
+                    sum += a.select(pIn.rankQueries[i]).asUInt64();
+                }
+                return sum;
+            });
+        }
+        SparseArray::remove(name, pFac);
+    }
+
+    void benchDenseArray(Bench& pBench, const Inputs& pIn, PhysicalFileFactory& pFac, std::mt19937_64& pRng)
+    {
+        // A bitmap with a bit for every edge, half of them set, as for
+        // the edge flags in a graph.
+        const string name(pFac.tmpName());
+        const uint64_t n = pIn.edges.size();
+        uint64_t count = 0;
+        {
+            DenseArray::Builder b(name, pFac);
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                if (pRng() & 1)
+                {
+                    b.push_back(i);
+                    ++count;
+                }
+            }
+            b.end(n);
+        }
+
+        {
+            DenseArray a(name, pFac);
+            vector<uint64_t> ps;
+            vector<uint64_t> rs;
+            for (uint64_t i = 0; i < Q; ++i)
+            {
+                ps.push_back(pRng() % n);
+                rs.push_back(pRng() % count);
+            }
+
+            pBench.run("dense-array/rank", Q, [&] () {
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < Q; ++i)
+                {
+                    sum += a.rank(ps[i]);
+                }
+                return sum;
+            });
+
+            pBench.run("dense-array/access-and-rank", Q, [&] () {
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < Q; ++i)
+                {
+                    DenseArray::rank_type r;
+                    sum += a.accessAndRank(ps[i], r) + r;
+                }
+                return sum;
+            });
+
+            pBench.run("dense-array/select", Q, [&] () {
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < Q; ++i)
+                {
+                    sum += a.select(rs[i]);
+                }
+                return sum;
+            });
+        }
+        DenseArray::remove(name, pFac);
+    }
+
+    void benchVariableByteArray(Bench& pBench, const Inputs& pIn, PhysicalFileFactory& pFac, std::mt19937_64& pRng)
+    {
+        // Edge counts: mostly small, with a long tail, as from reads.
+        const string name(pFac.tmpName());
+        const uint64_t n = pIn.edges.size();
+        {
+            VariableByteArray::Builder b(name, pFac, n, 1.0 / 1024.0);
+            std::geometric_distribution<uint32_t> cov(0.05);
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                uint32_t c = 1 + cov(pRng);
+                if (pRng() % 1000 == 0)
+                {
+                    c <<= 10;
+                }
+                b.push_back(c);
+            }
+            b.end();
+        }
+
+        {
+            VariableByteArray a(name, pFac);
+            pBench.run("variable-byte-array/lookup", Q, [&] () {
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < Q; ++i)
+                {
+                    sum += a[pIn.rankQueries[i]];
+                }
+                return sum;
+            });
+        }
+        VariableByteArray::remove(name, pFac);
+    }
+
+    void benchBackyardHash(Bench& pBench, const Inputs& pIn, uint64_t pThreads)
+    {
+        vector<uint64_t> kmers;
+        for (uint64_t i = 0; i < pIn.reads.size(); ++i)
+        {
+            const string& r(pIn.reads[i]);
+            vector<uint8_t> s;
+            for (uint64_t j = 0; j < r.size(); ++j)
+            {
+                s.push_back(strchr("ACGT", r[j]) - "ACGT");
+            }
+            for (uint64_t j = 0; j + E <= s.size(); ++j)
+            {
+                uint64_t x = kmerAt(s, j, E);
+                kmers.push_back(std::min(x, reverseComplement(x, E)));
+            }
+        }
+
+        // Size the table as build-graph would for this many kmers.
+        const uint64_t bytes = kmers.size() * 16;
+        const uint64_t S = BackyardHash::maxSlotBits(bytes);
+        const uint64_t N = bytes / (1.5 * sizeof(uint32_t) + sizeof(BackyardHash::value_type));
+        std::unique_ptr<BackyardHash> h;
+
+        for (uint64_t t : threadCounts(pThreads))
+        {
+            pBench.run("backyard-hash/insert/threads-" + lexical_cast<string>(t), kmers.size(), [&] () {
+                h = std::unique_ptr<BackyardHash>();
+                h = std::unique_ptr<BackyardHash>(new BackyardHash(S, 2 * E, N));
+            }, [&] () {
+                ThreadGroup grp;
+                for (uint64_t j = 1; j < t; ++j)
+                {
+                    grp.create([&, j] () {
+                        for (uint64_t i = kmers.size() * j / t; i < kmers.size() * (j + 1) / t; ++i)
+                        {
+                            h->insert(BackyardHash::value_type(kmers[i]));
+                        }
+                    });
+                }
+                for (uint64_t i = 0; i < kmers.size() / t; ++i)
+                {
+                    h->insert(BackyardHash::value_type(kmers[i]));
+                }
+                grp.join();
+                // Racing inserts may store an item twice, so with more
+                // than one thread this varies a little from run to run.
+                return h->size();
+            });
+        }
+
+        for (uint64_t t : threadCounts(pThreads))
+        {
+            vector<uint32_t> perm;
+            pBench.run("backyard-hash/sort/threads-" + lexical_cast<string>(t), h->size(), [&] () {
+                perm.clear();
+            }, [&] () {
+                h->sort(perm, t);
+                return h->radix64(perm[perm.size() / 2]);
+            });
+        }
+    }
+
+    void benchBlendedSort(Bench& pBench, const Inputs& pIn, uint64_t pThreads, std::mt19937_64& pRng)
+    {
+        const uint64_t M = (1ULL << (2 * E)) - 1;
+        vector<uint64_t> orig;
+        for (uint64_t i = 0; i < pIn.edges.size(); ++i)
+        {
+            orig.push_back(pRng() & M);
+        }
+        vector<uint64_t> xs;
+        auto setup = [&] () {
+            xs = orig;
+        };
+        auto checksum = [&] () {
+            return xs[xs.size() / 3] ^ xs[2 * xs.size() / 3];
+        };
+
+        pBench.run("std-sort", xs.size(), setup, [&] () {
+            std::sort(xs.begin(), xs.end());
+            return checksum();
+        });
+
+        U64Cmp cmp;
+        for (uint64_t t : threadCounts(pThreads))
+        {
+            pBench.run("blended-sort/threads-" + lexical_cast<string>(t), orig.size(), setup, [&] () {
+                BlendedSort<uint64_t>::sort(t, xs, 2 * E, cmp);
+                return checksum();
+            });
+        }
+    }
+
+    void benchKmerExtraction(Bench& pBench, const Inputs& pIn)
+    {
+        const uint64_t n = pIn.reads.size() * (L - E + 1);
+        const string label;
+        const string qual;
+
+        pBench.run("kmer-extraction/iterator", n, [&] () {
+            uint64_t sum = 0;
+            for (uint64_t r = 0; r < pIn.reads.size(); ++r)
+            {
+                GossReadBaseString read(label, pIn.reads[r], qual);
+                for (GossRead::Iterator i(read, E); i.valid(); ++i)
+                {
+                    sum += i.kmer().normalized(E).asUInt64();
+                }
+            }
+            return sum;
+        });
+
+        pBench.run("kmer-extraction/kernels", n, [&] () {
+            uint64_t sum = 0;
+            vector<uint8_t> codes;
+            vector<edge_type> kmers;
+            for (uint64_t r = 0; r < pIn.reads.size(); ++r)
+            {
+                kmers.clear();
+                KmerKernels::kmers(pIn.reads[r], E, true, codes, kmers);
+                for (uint64_t i = 0; i < kmers.size(); ++i)
+                {
+                    sum += kmers[i].asUInt64();
+                }
+            }
+            return sum;
+        });
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t threads = 4;
+    uint64_t reps = 5;
+    vector<uint64_t> sizes;
+    for (int i = 1; i < argc; ++i)
+    {
+        string a(argv[i]);
+        if (a == "-T" && i + 1 < argc)
+        {
+            threads = lexical_cast<uint64_t>(argv[++i]);
+        }
+        else if (a == "-r" && i + 1 < argc)
+        {
+            reps = lexical_cast<uint64_t>(argv[++i]);
+        }
+        else
+        {
+            sizes.push_back(lexical_cast<uint64_t>(a));
+        }
+    }
+    if (sizes.empty())
+    {
+        sizes.push_back(1);
+        sizes.push_back(4);
+        sizes.push_back(16);
+    }
+    threads = std::max<uint64_t>(1, threads);
+    reps = std::max<uint64_t>(1, reps);
+
+    PhysicalFileFactory fac;
+    JsonWriter out(cout);
+    out.beginObject();
+    out.field("benchmark", "benchStructures");
+    out.field("k", K);
+    out.field("threads", threads);
+    out.field("queries", Q);
+#ifdef __VERSION__
+    out.field("compiler", __VERSION__);
+#endif
+#ifdef NDEBUG
+    out.field("assertions", false);
+#else
+    out.field("assertions", true);
+#endif
+
+    out.key("results").beginArray();
+    for (uint64_t i = 0; i < sizes.size(); ++i)
+    {
+        std::mt19937_64 rng(19 + sizes[i]);
+        Inputs in(sizes[i], rng);
+        Bench b(out, sizes[i], reps);
+
+        benchSparseArray(b, in, fac);
+        benchDenseArray(b, in, fac, rng);
+        benchVariableByteArray(b, in, fac, rng);
+        benchBackyardHash(b, in, threads);
+        benchBlendedSort(b, in, threads, rng);
+        benchKmerExtraction(b, in);
+    }
+    out.endArray();
+
+    out.endObject();
+    return 0;
+}
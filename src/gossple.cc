@@ -10,10 +10,17 @@
 #include "GossKillSignal.hh"
 #endif
 
+#include "GossApp.hh"
+#include "PhysicalFileFactory.hh"
+#include "ResidentFileFactory.hh"
+#include "Utils.hh"
+
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <boost/algorithm/string.hpp>
 #include <boost/xpressive/xpressive.hpp>
 #include <boost/filesystem.hpp>
 
@@ -26,6 +33,8 @@ void usage(bool pPrintGossCmds)
 {
     cout << "usage: $0 [options and files]...." << endl;
     cout << "  -B <buffer-size>        amount of buffer space to use in GB (default 2)." << endl;
+    cout << "  --checkpoint            write every intermediate graph to the working directory." << endl;
+    cout << "                          (by default they are kept in memory, and only the final graph is written)" << endl;
     cout << "  -c <coverage>           coverage estimate to use during pair/read threading." << endl;
     cout << "                          (defaults to using automatic coverage estimation)" << endl;
     cout << "  -D                      don't execute the goss commands." << endl;
@@ -36,6 +45,10 @@ void usage(bool pPrintGossCmds)
     cout << "  -o <file-name>          file-name for the contigs. (default 'contigs.fa')" << endl;
     cout << "  -p <insert-size>        introduce files containing paired end reads with the given insert size." << endl;
     cout << "                          files following (until the next -m or -p) will be treated as paired ends." << endl;
+    cout << "  --resident <size>       amount of memory in GB for keeping intermediate graphs between stages." << endl;
+    cout << "                          graphs beyond it are written to the working directory. (default half of -B)" << endl;
+    cout << "  --resume <stage>        skip the stages before the given one, whose graphs must have been" << endl;
+    cout << "                          written by an earlier run with --checkpoint. (stages count from 1)" << endl;
     cout << "  -T <num-threads>        use the given number of worker threads (default 4)." << endl;
     cout << "  -t <coverage>           trim edges with coverage less than the given value." << endl;
     cout << "                          (defaults to using automatic trim value estimation)" << endl;
@@ -44,7 +57,8 @@ void usage(bool pPrintGossCmds)
     cout << "  -w <dir>                directory for graphs and other working files." << endl;
     cout << "                          (default 'goss-files')" << endl;
     cout << "  --tmp-dir <dir>         directory for temporary files. (default '/tmp')" << endl;
-    cout << "  -x <path>               path to the 'goss' executable " << endl;
+    cout << "  -x <path>               run each stage with the given 'goss' executable," << endl;
+    cout << "                          rather than within this process." << endl;
     if( pPrintGossCmds )
     {
         cout << "" << endl;
@@ -123,19 +137,24 @@ public:
 public:
     // program options
     int mBufferSizeGb;
+    bool mCheckpoint;
     int mExpectedCoverage;
     bool mDryRun;
     bool mHelp;
     int mKmerSize;
     vector<InputFileGroup> mInputFileGroups;
     string mOut;
+    int mResidentGb;
+    int mResume;
     int mThreads;
     int mTrim;
     string mTempDir;
+    string mTempDirName;
     bool mPrintGossCmds;
     string mVerbose;
     string mWorkingDir;
     string mGossExec;
+    bool mInProcess;
     string mKillSignal;
 
 protected:
@@ -149,7 +168,7 @@ protected:
 class CmdBuilder
 {
 public:
-    CmdBuilder(Options& pOps) : mOps(pOps) {}
+    CmdBuilder(Options& pOps);
 
     void build( stringstream& ss,
         const string& pModule,
@@ -158,28 +177,44 @@ public:
     int runStage(const string& pCmd, bool pExitOnError = true);
     int createDir(const string& dir);
 
+    // Write what has been produced so far for the given graph to disk.
+    void checkpoint(const string& pGraph);
+
+    // The given graph is not needed by any later stage.
+    void done(const string& pGraph);
 
 public:
     const Options& mOps;
+
+private:
+    int runInProcess(const string& pCmd);
+
+    std::shared_ptr<GossApp> mApp;
+    std::shared_ptr<ResidentFileFactory> mFactory;
 };
 
 
 
 Options::Options(int pArgc, char* pArgv[])
     : mBufferSizeGb(2)
+    , mCheckpoint(false)
     , mExpectedCoverage(-1)
     , mDryRun(false)
     , mHelp(false)
     , mKmerSize(27)
     , mInputFileGroups()
     , mOut( " -o contigs.fa" )
+    , mResidentGb(-1)
+    , mResume(0)
     , mThreads(4)
     , mTrim(-1)
     , mTempDir()
+    , mTempDirName()
     , mPrintGossCmds(true)
     , mVerbose()
     , mWorkingDir("goss-files")
-    , mGossExec("goss") // default assumes goss executable is in current dir
+    , mGossExec("goss")
+    , mInProcess(true)
     , mKillSignal()
     , mArgs(pArgv, pArgv + pArgc)
     , mIdx(1) // skip the program name
@@ -273,6 +308,16 @@ void Options::parse2()
         mBufferSizeGb = atoi(mArgs[mIdx+1]);
         mIdx += 2;
     }
+    else if( isOption("--resident") )
+    {
+        mResidentGb = atoi(mArgs[mIdx+1]);
+        mIdx += 2;
+    }
+    else if( isOption("--checkpoint") )
+    {
+        mCheckpoint = true;
+        mIdx += 1;
+    }
     else if( isOption("-c") )
     {
         mExpectedCoverage = atoi(mArgs[mIdx+1]);
@@ -312,6 +357,11 @@ void Options::parse2()
         mOut = string(" -o ") + mArgs[mIdx+1];
         mIdx += 2;
     }
+    else if( isOption("--resume") )
+    {
+        mResume = atoi(mArgs[mIdx+1]);
+        mIdx += 2;
+    }
     else if( isOption("-T") )
     {
         mThreads = atoi(mArgs[mIdx+1]);
@@ -325,6 +375,7 @@ void Options::parse2()
     else if( isOption("--tmp-dir") )
     {
         mTempDir = string("--tmp-dir ") + mArgs[mIdx+1];
+        mTempDirName = mArgs[mIdx+1];
         mIdx += 2;
     }
     else if( isOption("-v") )
@@ -346,6 +397,7 @@ void Options::parse2()
     {
         mGossExec = mArgs[mIdx+1];
         mGossExec = "\"" + mGossExec + "\"";
+        mInProcess = false;
         mIdx += 2;
     }
 #ifdef KILL_SIGNAL_SUPPORT
@@ -370,14 +422,35 @@ string Options::graphName(int pGraphCnt)
     return ss.str();
 }
 
+CmdBuilder::CmdBuilder(Options& pOps)
+    : mOps(pOps)
+{
+    if( mOps.mInProcess && !mOps.mDryRun )
+    {
+        // Intermediate graphs stay in memory between stages. Anything
+        // else, such as temporary files and contigs, goes to disk.
+        string tmp = mOps.mTempDirName.empty() ? Gossamer::defaultTmpDir() : mOps.mTempDirName;
+        std::shared_ptr<PhysicalFileFactory> fac(new PhysicalFileFactory(tmp));
+        fac->setDecompressionThreads(mOps.mThreads);
+        // Held to a budget, beyond which they go to disk after all,
+        // since the stages need their buffer space as well.
+        uint64_t budget = mOps.mResidentGb >= 0
+                        ? uint64_t(mOps.mResidentGb) << 30
+                        : uint64_t(mOps.mBufferSizeGb) << 29;
+        mFactory = std::make_shared<ResidentFileFactory>(fac, mOps.mWorkingDir + "/graph-", budget);
+        mApp = std::make_shared<GossApp>();
+    }
+}
+
 int CmdBuilder::runStage(const string& pCmd, bool pExitOnError)
 {
     ++sCurrStage;
+    bool skip = sCurrStage < mOps.mResume;
     if( mOps.mPrintGossCmds )
     {
-        cout << pCmd << endl;
+        cout << (skip ? "# skipped: " : "") << pCmd << endl;
     }
-    if( mOps.mDryRun )
+    if( mOps.mDryRun || skip )
     {
         return 0;
     }
@@ -387,9 +460,56 @@ int CmdBuilder::runStage(const string& pCmd, bool pExitOnError)
     out << sCurrStage << endl;
     out.close();
     
+    if( mOps.mInProcess )
+    {
+        int error = runInProcess(pCmd);
+        if( error && pExitOnError )
+        {
+            cerr << "error executing command: " << pCmd << endl;
+            exit(1);
+        }
+        return error;
+    }
     return runCmd(pCmd, pExitOnError);
 }
 
+int CmdBuilder::runInProcess(const string& pCmd)
+{
+    // The command line starts with the goss executable, which stands in
+    // for the program name.
+    vector<string> args;
+    boost::algorithm::split(args, pCmd, boost::algorithm::is_space(),
+                            boost::algorithm::token_compress_on);
+    args.erase(std::remove(args.begin(), args.end(), string()), args.end());
+
+    vector<char*> argv;
+    for( unsigned i = 0; i < args.size(); ++i )
+    {
+        argv.push_back(&args[i][0]);
+    }
+    argv.push_back(0);
+    return mApp->run(int(args.size()), &argv[0], mFactory);
+}
+
+void CmdBuilder::checkpoint(const string& pGraph)
+{
+    if( mFactory )
+    {
+        // A graph is its header, <graph>.header, and <graph>-* files.
+        mFactory->checkpoint(pGraph + ".");
+        mFactory->checkpoint(pGraph + "-");
+    }
+}
+
+void CmdBuilder::done(const string& pGraph)
+{
+    if( mFactory )
+    {
+        mFactory->release(pGraph + ".");
+        mFactory->release(pGraph + "-");
+    }
+}
+
 int CmdBuilder::createDir(const string& dir)
 {
     if( mOps.mDryRun )
@@ -412,7 +532,7 @@ void CmdBuilder::build(
     ss.str("");
     ss  << mOps.mGossExec
         << " " << pModule
-        << " " << mOps.mKillSignal
+        << " " << (mOps.mInProcess ? "" : mOps.mKillSignal)
         << " " << mOps.mVerbose
         << " -T " << mOps.mThreads
         << " " << mOps.mTempDir;
@@ -467,6 +587,10 @@ int run(Options& ops)
         << " -B " << ops.mBufferSizeGb
         << ops.files();
     cb.runStage( ss.str() );
+    if( ops.mCheckpoint )
+    {
+        cb.checkpoint(g);
+    }
     
     // trim-graph
     // --------------------------------------------------------
@@ -481,6 +605,11 @@ int run(Options& ops)
         ss << " -C " <<  ops.mTrim;
     }
     cb.runStage( ss.str() );
+    cb.done(g);
+    if( ops.mCheckpoint )
+    {
+        cb.checkpoint(h);
+    }
 
 
     // prune-tips
@@ -494,6 +623,11 @@ int run(Options& ops)
     
         cb.build(ss, "prune-tips", g, h);
         cb.runStage(ss.str());
+        cb.done(g);
+        if( ops.mCheckpoint )
+        {
+            cb.checkpoint(h);
+        }
     }
 
     // pop-bubbles
@@ -503,18 +637,25 @@ int run(Options& ops)
     h = ops.graphName(graphCnt);
     cb.build(ss, "pop-bubbles", g, h);
     cb.runStage(ss.str());
+    cb.done(g);
+
+    // All the remaining stages work on this graph, and add their results
+    // to it, so it is written out after each of them.
+    cb.checkpoint(h);
 
     // build-entry-edge-set
     // --------------------------------------------------------
     g = h;
     cb.build(ss, "build-entry-edge-set", g, "");
     cb.runStage(ss.str());
+    cb.checkpoint(g);
     
 
     // build-supergraph
     // --------------------------------------------------------
     cb.build(ss, "build-supergraph", g, "");
     cb.runStage(ss.str());
+    cb.checkpoint(g);
 
 
     // --------------------------------------------------------
@@ -539,6 +680,7 @@ int run(Options& ops)
         ss << group.files();
 
         cb.runStage(ss.str());
+        cb.checkpoint(g);
     }
 
     // thread-reads
@@ -547,6 +689,7 @@ int run(Options& ops)
     ss << expectedCoverage;    
     ss << ops.files();
     cb.runStage(ss.str());
+    cb.checkpoint(g);
 
     // build-scaffold
     // --------------------------------------------------------
@@ -561,6 +704,7 @@ int run(Options& ops)
         ss << " --scaffold-out " << scaf;
         ss << group.files();
         cb.runStage(ss.str());
+        cb.checkpoint(g);
     }
 
 
@@ -571,6 +715,7 @@ int run(Options& ops)
         cb.build(ss, "scaffold", g, "");
         ss << " --scaffold-in " << scaf;
         cb.runStage(ss.str());
+        cb.checkpoint(g);
     }
 
     // print-contigs
@@ -125,7 +125,7 @@ BOOST_AUTO_TEST_CASE(test6)
 {
     const uint64_t M = (1ULL << 40) - 1;
     std::mt19937 rng(17);
-    std::uniform_int_distribution<uint64_t> d(0, M);;
+    std::uniform_int_distribution<uint64_t> d(0, M);
 
     BackyardHash h(16, 40, (1ULL << 16) + (1ULL << 15));
 
@@ -161,6 +161,35 @@ BOOST_AUTO_TEST_CASE(test6)
     }
 }
 
+BOOST_AUTO_TEST_CASE(testInsertExclusive)
+{
+    const uint64_t M = (1ULL << 40) - 1;
+    std::mt19937 rng(19);
+    std::uniform_int_distribution<uint64_t> d(0, M);
+
+    BackyardHash h(16, 40, 1ULL << 16);
+    BackyardHash x(16, 40, 1ULL << 16);
+
+    vector<uint64_t> xs;
+    for (uint64_t i = 0; i < 20000; ++i)
+    {
+        xs.push_back(d(rng));
+        xs.push_back(xs[i / 2]);
+    }
+    for (uint64_t i = 0; i < xs.size(); ++i)
+    {
+        h.insert(BackyardHash::value_type(xs[i]));
+        x.insertExclusive(BackyardHash::value_type(xs[i]));
+    }
+
+    BOOST_CHECK_EQUAL(h.size(), x.size());
+    for (uint64_t i = 0; i < xs.size(); ++i)
+    {
+        BackyardHash::value_type v(xs[i]);
+        BOOST_CHECK_EQUAL(h.count(v), x.count(v));
+    }
+}
+
 #if 0
 class Inserter
 {
@@ -170,7 +199,7 @@ public:
         const uint64_t M = (1ULL << 40) - 1;
         const uint64_t N = 50;
         std::mt19937 rng(mSeed);
-        std::uniform_int_distribution<uint64_t> d(0, M);;
+        std::uniform_int_distribution<uint64_t> d(0, M);
         vector<uint64_t> xs;
         for (uint64_t i = 0; i < N; ++i)
         {
@@ -225,7 +254,7 @@ public:
         const uint64_t M = (1ULL << 40) - 1;
         const uint64_t N = 50;
         std::mt19937 rng(mSeed);
-        std::uniform_int_distribution<uint64_t> d(0, M);;
+        std::uniform_int_distribution<uint64_t> d(0, M);
         for (uint64_t i = 0; i < N; ++i)
         {
             uint64_t x = d(rng);
@@ -14,6 +14,7 @@
 
 #include "BigInteger.hh"
 #include "RankSelect.hh"
+#include <random>
 
 using namespace boost;
 using namespace std;
@@ -335,5 +336,116 @@ BOOST_AUTO_TEST_CASE(test_shift_word_size)
     BOOST_CHECK_EQUAL(lexical_cast<string>(w), "1");
 }
 
+namespace {
+
+    // Byte-at-a-time FNV-1a over every word, the hash used to
+    // normalize k-mers, so must not change.
+    uint64_t referenceHash(const BigInteger<2>& pValue)
+    {
+        uint64_t r = 14695981039346656037ULL;
+        std::pair<const uint64_t*,const uint64_t*> ws = pValue.words();
+        for (const uint64_t* w = ws.first; w != ws.second; ++w)
+        {
+            uint64_t x = *w;
+            for (uint64_t i = 0; i < 8; ++i)
+            {
+                r ^= x & 0xFFULL;
+                x >>= 8;
+                r *= 1099511628211ULL;
+            }
+        }
+        return r;
+    }
+
+    BigInteger<2> referenceReverseComplement(const BigInteger<2>& pValue, uint64_t pK)
+    {
+        BigInteger<2> x(pValue);
+        BigInteger<2> r(0);
+        for (uint64_t i = 0; i < pK; ++i)
+        {
+            r <<= 2;
+            r |= 3 - (x & 3ULL);
+            x >>= 2;
+        }
+        return r;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_hash)
+{
+    std::mt19937_64 rng(19);
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        BigInteger<2> a(rng());
+        BOOST_CHECK_EQUAL(a.hash(), referenceHash(a));
+        a <<= 64;
+        BOOST_CHECK_EQUAL(a.hash(), referenceHash(a));
+        a |= rng();
+        BOOST_CHECK_EQUAL(a.hash(), referenceHash(a));
+    }
+    BigInteger<2> z(0);
+    BOOST_CHECK_EQUAL(z.hash(), referenceHash(z));
+}
+
+BOOST_AUTO_TEST_CASE(test_reverse_complement)
+{
+    std::mt19937_64 rng(23);
+    for (uint64_t k = 1; k <= 63; ++k)
+    {
+        for (uint64_t i = 0; i < 100; ++i)
+        {
+            BigInteger<2> a(rng());
+            a <<= 64;
+            a |= rng();
+            if (k < 64)
+            {
+                BigInteger<2> m(1);
+                m <<= 2 * k;
+                --m;
+                a &= m;
+            }
+            BigInteger<2> rc(a);
+            rc.reverseComplement(k);
+            BOOST_CHECK(rc == referenceReverseComplement(a, k));
+            rc.reverseComplement(k);
+            BOOST_CHECK(rc == a);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_shift_all_distances)
+{
+    std::mt19937_64 rng(29);
+    for (uint64_t s = 0; s <= 128; ++s)
+    {
+        uint64_t hi = rng();
+        uint64_t lo = rng();
+        BigInteger<2> a(hi);
+        a <<= 64;
+        a |= lo;
+
+        // Build the expected results one bit at a time.
+        BigInteger<2> l(0);
+        BigInteger<2> r(0);
+        for (int64_t i = 127; i >= 0; --i)
+        {
+            uint64_t li = i - int64_t(s) >= 0 ? i - s : 128;
+            uint64_t ri = i + s;
+            uint64_t lb = li < 64 ? (lo >> li) & 1 : (li < 128 ? (hi >> (li - 64)) & 1 : 0);
+            uint64_t rb = ri < 64 ? (lo >> ri) & 1 : (ri < 128 ? (hi >> (ri - 64)) & 1 : 0);
+            l += l;
+            l |= lb;
+            r += r;
+            r |= rb;
+        }
+
+        BigInteger<2> x(a);
+        x <<= s;
+        BOOST_CHECK(x == l);
+        x = a;
+        x >>= s;
+        BOOST_CHECK(x == r);
+    }
+}
 
 #include "testEnd.hh"
@@ -0,0 +1,155 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "LineSource.hh"
+#include "StringFileFactory.hh"
+#include "GossamerException.hh"
+
+#include <vector>
+#include <iostream>
+#include <string>
+#include <random>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestBlockLineSource
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    class ThrowingBuf : public std::streambuf
+    {
+    protected:
+        int_type underflow()
+        {
+            BOOST_THROW_EXCEPTION(Gossamer::error()
+                << Gossamer::general_error_info("corrupt input"));
+        }
+    };
+
+    // A factory whose files all fail on the first read.
+    class ThrowingFileFactory : public StringFileFactory
+    {
+    public:
+        class ThrowingInHolder : public InHolder
+        {
+        public:
+            std::istream& operator*()
+            {
+                return mIn;
+            }
+
+            ThrowingInHolder()
+                : mIn(&mBuf)
+            {
+                mIn.exceptions(std::ios::badbit);
+            }
+
+        private:
+            ThrowingBuf mBuf;
+            std::istream mIn;
+        };
+
+        InHolderPtr in(const std::string& pFileName) const
+        {
+            return InHolderPtr(new ThrowingInHolder);
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(test1)
+{
+    StringFileFactory fac;
+
+    fac.addFile("empty", "");
+
+    BlockLineSource src(FileThunkIn(fac, "empty"));
+    BOOST_CHECK_EQUAL(src.valid(), false);
+}
+
+BOOST_AUTO_TEST_CASE(test2)
+{
+    StringFileFactory fac;
+
+    fac.addFile("oneA", "abc");
+    fac.addFile("oneB", "abc\n");
+
+    {
+        BlockLineSource src(FileThunkIn(fac, "oneA"));
+        BOOST_CHECK_EQUAL(src.valid(), true);
+        BOOST_CHECK_EQUAL(*src, "abc");
+        ++src;
+        BOOST_CHECK_EQUAL(src.valid(), false);
+    }
+    {
+        BlockLineSource src(FileThunkIn(fac, "oneB"));
+        BOOST_CHECK_EQUAL(src.valid(), true);
+        BOOST_CHECK_EQUAL(*src, "abc");
+        ++src;
+        BOOST_CHECK_EQUAL(src.valid(), false);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testAgreesWithPlain)
+{
+    // Small blocks force lines to be carried across block
+    // boundaries, and some lines to be longer than a block.
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> len(0, 40);
+    std::string text;
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        text += std::string(len(rng), 'a' + i % 26);
+        text += '\n';
+    }
+    text += "tail";
+
+    StringFileFactory fac;
+    fac.addFile("text", text);
+
+    PlainLineSource plain(FileThunkIn(fac, "text"));
+    BlockLineSource block(FileThunkIn(fac, "text"), 16);
+    while (plain.valid())
+    {
+        BOOST_REQUIRE(block.valid());
+        LineSource::Range r(block.range());
+        BOOST_CHECK_EQUAL(std::string(r.begin(), r.end()), *plain);
+        BOOST_CHECK_EQUAL(*block, *plain);
+        ++plain;
+        ++block;
+    }
+    BOOST_CHECK_EQUAL(block.valid(), false);
+}
+
+BOOST_AUTO_TEST_CASE(testEarlyExit)
+{
+    std::string text;
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        text += "ACGTACGTACGT\n";
+    }
+
+    StringFileFactory fac;
+    fac.addFile("text", text);
+
+    BlockLineSource src(FileThunkIn(fac, "text"), 64);
+    BOOST_CHECK_EQUAL(*src, "ACGTACGTACGT");
+    ++src;
+    BOOST_CHECK_EQUAL(src.valid(), true);
+}
+
+BOOST_AUTO_TEST_CASE(testErrorOnFirstBlock)
+{
+    ThrowingFileFactory fac;
+    BOOST_CHECK_THROW(BlockLineSource(FileThunkIn(fac, "corrupt")), Gossamer::error);
+}
+
+#include "testEnd.hh"
+
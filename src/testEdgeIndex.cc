@@ -0,0 +1,170 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "EdgeIndex.hh"
+#include "GossCmdBuildGraph.hh"
+#include "GossCmdBuildEntryEdgeSet.hh"
+#include "GossCmdBuildSupergraph.hh"
+#include "StringFileFactory.hh"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestEdgeIndex
+#include "testBegin.hh"
+
+namespace {
+
+    // Two copies of a repeat, so that some segments occur in more
+    // than one superpath.
+    static const char* rs[] = {
+        "GCATCTCTTCTATCGGTGAA",
+        "TATCGGTGAACAAGCTTTAG",
+        "CAAGCTTTAGGGAGGAGCGC",
+        "GGAGGAGCGCTCATGATGAT",
+        "TCATGATGATTCCTTAAAAC",
+        "TCCTTAAAACCGAACATAGG",
+        "CGAACATAGGCAAGCTTTAGGG",
+        "CAAGCTTTAGGGTGTCGTGC"
+    };
+
+    void buildSupergraph(StringFileFactory& pFac, Logger& pLog)
+    {
+        string reads;
+        for (uint64_t i = 0; i < sizeof(rs) / sizeof(char*); ++i)
+        {
+            reads += string(rs[i]) + "\n";
+        }
+        pFac.addFile("reads.ln", reads);
+
+        vector<string> fastas;
+        vector<string> fastqs;
+        vector<string> lines(1, "reads.ln");
+        boost::program_options::variables_map opts;
+        {
+            GossCmdBuildGraph cmd(9, 16, (1ULL << 16), 2, "graph", fastas, fastqs, lines);
+            GossCmdContext cxt(pFac, pLog, "build-graph", opts);
+            cmd(cxt);
+        }
+        {
+            GossCmdBuildEntryEdgeSet cmd("graph", 1);
+            GossCmdContext cxt(pFac, pLog, "build-entry-edge-set", opts);
+            cmd(cxt);
+        }
+        {
+            GossCmdBuildSupergraph cmd("graph", true);
+            GossCmdContext cxt(pFac, pLog, "build-supergraph", opts);
+            cmd(cxt);
+        }
+    }
+
+    // The answer to every query of the index.
+    string describe(const Graph& pGraph, const EdgeIndex& pIx)
+    {
+        ostringstream out;
+        for (uint64_t r = 0; r < pGraph.count(); ++r)
+        {
+            EdgeIndex::SegmentRank seg = 0;
+            EdgeIndex::EdgeOffset ofs = 0;
+            if (!pIx.segment(r, seg, ofs))
+            {
+                continue;
+            }
+            out << r << ' ' << seg << ' ' << ofs;
+            EdgeIndex::SuperPathIdAndOffset info;
+            if (pIx.superpath(seg, info))
+            {
+                out << ' ' << info.first.value() << ' ' << info.second;
+            }
+            out << '\n';
+        }
+        return out.str();
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(testReadMatchesCreate)
+{
+    StringFileFactory fac;
+    Logger log("log.txt", fac);
+    buildSupergraph(fac, log);
+
+    GraphPtr gPtr = Graph::open("graph", fac);
+    const Graph& g(*gPtr);
+    auto sgPtr = SuperGraph::read("graph", fac);
+    const SuperGraph& sg(*sgPtr);
+    BOOST_CHECK(sg.fingerprint() != 0);
+
+    auto created = EdgeIndex::create(g, sg.entries(), sg, 2, 2, log);
+    const string expected = describe(g, *created);
+    BOOST_CHECK(expected.find('\n') != string::npos);
+    created->write("graph", fac);
+
+    auto read = EdgeIndex::read("graph", fac, g);
+    BOOST_CHECK_EQUAL(describe(g, *read), expected);
+
+    auto opened = EdgeIndex::open("graph", fac, g, sg.entries(), sg, 2, 2, log);
+    BOOST_CHECK_EQUAL(describe(g, *opened), expected);
+
+    // Writing an index that is mapped from the same files.
+    read->write("graph", fac);
+    auto reread = EdgeIndex::read("graph", fac, g);
+    BOOST_CHECK_EQUAL(describe(g, *reread), expected);
+}
+
+BOOST_AUTO_TEST_CASE(testOpenRebuildsWhenStale)
+{
+    StringFileFactory fac;
+    Logger log("log.txt", fac);
+    buildSupergraph(fac, log);
+
+    GraphPtr gPtr = Graph::open("graph", fac);
+    const Graph& g(*gPtr);
+    uint64_t fp = 0;
+    {
+        auto sgPtr = SuperGraph::read("graph", fac);
+        const SuperGraph& sg(*sgPtr);
+        fp = sg.fingerprint();
+        EdgeIndex::create(g, sg.entries(), sg, 2, 2, log)->write("graph", fac);
+    }
+
+    // Link the first superpath to a copy of itself, so that its
+    // segments are no longer unique.
+    {
+        auto sgPtr = SuperGraph::read("graph", fac);
+        SuperGraph& sg(*sgPtr);
+        SuperPathId a = *SuperGraph::PathIterator(sg);
+        sg.link(vector<SuperPathId>(1, a));
+        BOOST_CHECK_EQUAL(sg.fingerprint(), 0);
+        sg.write("graph", fac);
+    }
+
+    auto sgPtr = SuperGraph::read("graph", fac);
+    const SuperGraph& sg(*sgPtr);
+    BOOST_CHECK(sg.fingerprint() != 0);
+    BOOST_CHECK(sg.fingerprint() != fp);
+
+    auto created = EdgeIndex::create(g, sg.entries(), sg, 2, 2, log);
+    auto stale = EdgeIndex::read("graph", fac, g);
+    BOOST_CHECK(describe(g, *stale) != describe(g, *created));
+
+    auto opened = EdgeIndex::open("graph", fac, g, sg.entries(), sg, 2, 2, log);
+    BOOST_CHECK_EQUAL(describe(g, *opened), describe(g, *created));
+
+    // A different cache rate also needs a new index.
+    auto coarser = EdgeIndex::create(g, sg.entries(), sg, 3, 2, log);
+    coarser->write("graph", fac);
+    opened = EdgeIndex::open("graph", fac, g, sg.entries(), sg, 2, 2, log);
+    BOOST_CHECK_EQUAL(describe(g, *opened), describe(g, *created));
+}
+
+#include "testEnd.hh"
@@ -0,0 +1,215 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "ElectApp.hh"
+#include "StringFileFactory.hh"
+
+#include <string>
+#include <vector>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestElectApp
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    // Made on first use, after the options it registers with.
+    ElectApp& app()
+    {
+        static ElectApp a;
+        return a;
+    }
+
+    const char* refFasta =
+        ">ref\n"
+        "GGATCACAGTCTACACTGCTCACTCCAACCCCGGCCCCTGAGTCCGAGGAGAGGGTGCTTCAGAGTATGTATACCACTGG\n";
+
+    const char* fastaMatch =
+        ">r1 first read\n"
+        "CACAGTCTACACTGCTCACTCCAACC\n"
+        ">r3\n"
+        "CCTGAGTCCGAGGAGAGGGTGCTTCAG\n";
+
+    const char* fastaNonmatch =
+        ">r2 second read\n"
+        "GTAGGATACGGCGGAGGGCACGTCAATACG\n";
+
+    const char* fastqMatch =
+        "@q1 first read\n"
+        "CACAGTCTACACTGCTCACTCCAACC\n"
+        "+\n"
+        "IIIIIIIIIIIIIIIIIIIIIIIIII\n"
+        "@q3\n"
+        "CCTGAGTCCGAGGAGAGGGTGCTTCAG\n"
+        "+q3\n"
+        "IIIIIIIIIIIIIIIIIIIIIIIII#I\n";
+
+    const char* fastqNonmatch =
+        "@q2 second read\n"
+        "GTAGGATACGGCGGAGGGCACGTCAATACG\n"
+        "+\n"
+        "IIIII#IIIIIIIIIIIIIIIIIIIIIIII\n";
+
+    // The reads of each kind, with the matching reads interleaved with
+    // the non-matching ones.
+    string interleave(const string& pMatch, const string& pNonmatch, uint64_t pLines)
+    {
+        vector<string> m;
+        string::size_type i = 0;
+        uint64_t l = 0;
+        for (string::size_type j = 0; j < pMatch.size(); ++j)
+        {
+            if (pMatch[j] == '\n' && ++l % pLines == 0)
+            {
+                m.push_back(pMatch.substr(i, j + 1 - i));
+                i = j + 1;
+            }
+        }
+        return m[0] + pNonmatch + m[1];
+    }
+
+    const char* otherFasta =
+        ">other\n"
+        "GTAGGATACGGCGGAGGGCACGTCAATACG\n"
+        ">another\n"
+        "TTGACCGTAGCATCAGGTTCAGCAAGTCCAT\n";
+
+    void runApp(StringFileFactory& pFac, const vector<string>& pArgs)
+    {
+        vector<string> args(1, "electus");
+        args.insert(args.end(), pArgs.begin(), pArgs.end());
+        vector<char*> argv;
+        for (uint64_t i = 0; i < args.size(); ++i)
+        {
+            argv.push_back(const_cast<char*>(args[i].c_str()));
+        }
+        FileFactoryPtr fac(&pFac, [](FileFactory*) {});
+        BOOST_CHECK_EQUAL(app().run(argv.size(), &argv[0], fac), 0);
+    }
+
+    void run(StringFileFactory& pFac, const vector<string>& pArgs)
+    {
+        vector<string> args = {"classify", "-K", "15",
+                               "--match-prefix", "m", "--non-match-prefix", "n"};
+        args.insert(args.end(), pArgs.begin(), pArgs.end());
+        runApp(pFac, args);
+    }
+
+    void index(StringFileFactory& pFac, const vector<string>& pArgs)
+    {
+        vector<string> args = {"index", "-K", "15", "-M", "0.3", "-T", "1"};
+        args.insert(args.end(), pArgs.begin(), pArgs.end());
+        runApp(pFac, args);
+    }
+
+    void classify(StringFileFactory& pFac, const vector<string>& pExtra)
+    {
+        vector<string> args = {"--ref-fasta", "ref.fa", "-I", "reads.fa", "-i", "reads.fq"};
+        args.insert(args.end(), pExtra.begin(), pExtra.end());
+        run(pFac, args);
+    }
+
+    void check(const vector<string>& pExtra)
+    {
+        StringFileFactory fac;
+        fac.addFile("ref.fa", refFasta);
+        fac.addFile("reads.fa", interleave(fastaMatch, fastaNonmatch, 2));
+        fac.addFile("reads.fq", interleave(fastqMatch, fastqNonmatch, 4));
+        classify(fac, pExtra);
+
+        BOOST_CHECK_EQUAL(fac.readFile("m.fasta"), fastaMatch);
+        BOOST_CHECK_EQUAL(fac.readFile("n.fasta"), fastaNonmatch);
+        BOOST_CHECK_EQUAL(fac.readFile("m.fastq"), fastqMatch);
+        BOOST_CHECK_EQUAL(fac.readFile("n.fastq"), fastqNonmatch);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testClassifiedRecords)
+{
+    check({"-T", "1"});
+}
+
+BOOST_AUTO_TEST_CASE(testClassifiedRecordsThreaded)
+{
+    check({"-T", "2"});
+}
+
+BOOST_AUTO_TEST_CASE(testClassifiedRecordsSortedLookup)
+{
+    check({"-T", "2", "--sorted-lookup-batch", "2"});
+}
+
+// By default a read must match every reference file, however many
+// sequences each holds.
+BOOST_AUTO_TEST_CASE(testDefaultRefThreshold)
+{
+    for (uint64_t t = 0; t < 2; ++t)
+    {
+        StringFileFactory fac;
+        fac.addFile("ref.fa", refFasta);
+        fac.addFile("other.fa", otherFasta);
+        fac.addFile("reads.fa", interleave(fastaMatch, fastaNonmatch, 2));
+        vector<string> args = {"--ref-fasta", "ref.fa", "--ref-fasta", "other.fa",
+                               "-I", "reads.fa", "-T", "1"};
+        if (t)
+        {
+            args.push_back("--ref-threshold");
+            args.push_back("1");
+        }
+        run(fac, args);
+
+        const string all = interleave(fastaMatch, fastaNonmatch, 2);
+        BOOST_CHECK_EQUAL(fac.readFile("m.fasta"), t ? all : string());
+        BOOST_CHECK_EQUAL(fac.readFile("n.fasta"), t ? string() : all);
+    }
+}
+
+// A union index holds several references, and classifying against it
+// gives the same reads as against an index for each reference.
+BOOST_AUTO_TEST_CASE(testUnionIndex)
+{
+    StringFileFactory fac;
+    fac.addFile("ref.fa", refFasta);
+    fac.addFile("other.fa", otherFasta);
+    const string reads = interleave(fastaMatch, fastaNonmatch, 2);
+    fac.addFile("reads.fa", reads);
+
+    index(fac, {"--ref-fasta", "ref.fa", "-P", "ref"});
+    index(fac, {"--ref-fasta", "other.fa", "-P", "other"});
+    index(fac, {"--ref-fasta", "ref.fa", "--ref-fasta", "other.fa", "--union-index", "-P", "both"});
+
+    for (uint64_t t = 0; t < 2; ++t)
+    {
+        vector<string> extra = {"-I", "reads.fa", "-T", "1"};
+        if (t)
+        {
+            extra.push_back("--ref-threshold");
+            extra.push_back("1");
+        }
+
+        vector<string> args = {"--ref-index", "ref", "--ref-index", "other"};
+        args.insert(args.end(), extra.begin(), extra.end());
+        run(fac, args);
+        const string m = fac.readFile("m.fasta");
+        const string n = fac.readFile("n.fasta");
+
+        args = {"--ref-index", "both"};
+        args.insert(args.end(), extra.begin(), extra.end());
+        run(fac, args);
+        BOOST_CHECK_EQUAL(fac.readFile("m.fasta"), m);
+        BOOST_CHECK_EQUAL(fac.readFile("n.fasta"), n);
+
+        // By default a read must match both references.
+        BOOST_CHECK_EQUAL(m, t ? reads : string());
+        BOOST_CHECK_EQUAL(n, t ? string() : reads);
+    }
+}
+
+#include "testEnd.hh"
@@ -108,4 +108,23 @@ BOOST_AUTO_TEST_CASE(test1)
     c.done();
 }
 
+BOOST_AUTO_TEST_CASE(testItemSize)
+{
+    typedef ExternalBufferSort::Codec Codec;
+    typedef ExternalBufferSort::Item Item;
+
+    BOOST_CHECK_EQUAL(Codec::size(Item()), sizeof(Item));
+    uint64_t prev = 0;
+    for (uint64_t z = 1; z < 200; ++z)
+    {
+        // Each packet costs at least its bytes and a heap block header,
+        // and no less than a shorter one.
+        uint64_t s = Codec::size(Item(z));
+        BOOST_CHECK(s >= sizeof(Item) + z + sizeof(void*));
+        BOOST_CHECK(s >= prev);
+        prev = s;
+    }
+    BOOST_CHECK(Codec::size(Item(1)) >= sizeof(Item) + 4 * sizeof(void*));
+}
+
 #include "testEnd.hh"
@@ -0,0 +1,182 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "ExternalMergeSort.hh"
+
+#include <vector>
+#include <iostream>
+#include <string>
+#include <random>
+
+#include "StringFileFactory.hh"
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestExternalMergeSort
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    typedef ExternalMergeSort<uint64_t> Sorter;
+
+    class Collector
+    {
+    public:
+        vector<uint64_t> items;
+
+        void push_back(uint64_t x)
+        {
+            items.push_back(x);
+        }
+    };
+
+    class Src
+    {
+    public:
+        bool valid() const
+        {
+            return mCurr != mEnd;
+        }
+
+        const uint64_t& operator*() const
+        {
+            return *mCurr;
+        }
+
+        void operator++()
+        {
+            ++mCurr;
+        }
+
+        Src(vector<uint64_t>::const_iterator pBegin, vector<uint64_t>::const_iterator pEnd)
+            : mCurr(pBegin), mEnd(pEnd)
+        {
+        }
+
+    private:
+        vector<uint64_t>::const_iterator mCurr;
+        vector<uint64_t>::const_iterator mEnd;
+    };
+
+    vector<uint64_t> randomItems(uint64_t pN)
+    {
+        std::mt19937_64 rng(19);
+        vector<uint64_t> xs;
+        for (uint64_t i = 0; i < pN; ++i)
+        {
+            xs.push_back(rng() % (pN / 2 + 1));
+        }
+        return xs;
+    }
+
+    void check(const Sorter::Params& pParams, uint64_t pN)
+    {
+        StringFileFactory fac;
+        Sorter sorter(fac, pParams);
+        vector<uint64_t> xs = randomItems(pN);
+        for (uint64_t i = 0; i < xs.size(); ++i)
+        {
+            sorter.push_back(xs[i]);
+        }
+        BOOST_CHECK_EQUAL(sorter.count(), xs.size());
+
+        Collector c;
+        sorter.sort(c);
+        sort(xs.begin(), xs.end());
+        BOOST_CHECK(c.items == xs);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testLoserTree)
+{
+    vector<vector<uint64_t> > ins(7);
+    vector<uint64_t> all;
+    std::mt19937 rng(17);
+    for (uint64_t i = 0; i < ins.size(); ++i)
+    {
+        // Leave one of the sources empty.
+        uint64_t n = (i == 3 ? 0 : rng() % 100);
+        for (uint64_t j = 0; j < n; ++j)
+        {
+            ins[i].push_back(rng() % 50);
+        }
+        sort(ins[i].begin(), ins[i].end());
+        all.insert(all.end(), ins[i].begin(), ins[i].end());
+    }
+    sort(all.begin(), all.end());
+
+    vector<Src> srcs;
+    for (uint64_t i = 0; i < ins.size(); ++i)
+    {
+        srcs.push_back(Src(ins[i].begin(), ins[i].end()));
+    }
+    vector<Src*> ptrs;
+    for (uint64_t i = 0; i < srcs.size(); ++i)
+    {
+        ptrs.push_back(&srcs[i]);
+    }
+    LoserTree<Src,uint64_t> tree(ptrs);
+    vector<uint64_t> out;
+    while (tree.valid())
+    {
+        out.push_back(*tree);
+        ++tree;
+    }
+    BOOST_CHECK(out == all);
+}
+
+BOOST_AUTO_TEST_CASE(testInMemory)
+{
+    check(Sorter::Params(1ULL << 30), 10000);
+}
+
+BOOST_AUTO_TEST_CASE(testRuns)
+{
+    check(Sorter::Params(8 * 1000), 100000);
+}
+
+BOOST_AUTO_TEST_CASE(testMultiPassMerge)
+{
+    Sorter::Params p(8 * 200);
+    p.fanIn = 3;
+    check(p, 20000);
+}
+
+BOOST_AUTO_TEST_CASE(testThreaded)
+{
+    check(Sorter::Params(8 * 200000, 4), 300000);
+    check(Sorter::Params(8 * 50000, 4), 300000);
+}
+
+BOOST_AUTO_TEST_CASE(testTmpSpace)
+{
+    Sorter::Params p(8 * 1000);
+    p.tmpSpace = 8 * 10000;
+
+    StringFileFactory fac;
+    Sorter sorter(fac, p);
+    vector<uint64_t> xs = randomItems(100000);
+    bool thrown = false;
+    try
+    {
+        for (uint64_t i = 0; i < xs.size(); ++i)
+        {
+            sorter.push_back(xs[i]);
+        }
+        Collector c;
+        sorter.sort(c);
+    }
+    catch (Gossamer::error& e)
+    {
+        thrown = true;
+    }
+    BOOST_CHECK(thrown);
+}
+
+#include "testEnd.hh"
@@ -178,4 +178,86 @@ BOOST_AUTO_TEST_CASE(test124ReadWithNs)
     BOOST_CHECK_EQUAL(g.count(), 42);
 }
 
+// The shared, partitioned and bucketed modes must build the same graph.
+void checkBuildModesAgree(uint64_t pK)
+{
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<uint64_t> start(0, 19900);
+
+    string G;
+    for (uint64_t i = 0; i < 20000; ++i)
+    {
+        G += "ACGT"[base(rng)];
+    }
+    string R;
+    for (uint64_t i = 0; i < 2000; ++i)
+    {
+        R += ">\n" + G.substr(start(rng), 100) + "\n";
+    }
+
+    StringFileFactory fac;
+    {
+        Logger log("log.txt", fac);
+
+        fac.addFile("reads.fa", R);
+
+        std::vector<string> fastas;
+        std::vector<string> fastqs;
+        std::vector<string> lines;
+
+        fastas.push_back("reads.fa");
+
+        boost::program_options::variables_map opts;
+        GossCmdContext cxt(fac, log, "build-graph", opts);
+
+        GossCmdBuildGraph cmd1(pK, 16, (1ULL << 16), 2, "graph1", fastas, fastqs, lines);
+        cmd1(cxt);
+
+        // Small tables, so that the partitions are dumped and merged.
+        GossCmdBuildGraph cmd2(pK, 12, (1ULL << 13), 3, "graph2", fastas, fastqs, lines, true);
+        cmd2(cxt);
+
+        GossCmdBuildGraph cmd3(pK, 16, (1ULL << 16), 3, "graph3", fastas, fastqs, lines, true);
+        cmd3(cxt);
+
+        GossCmdBuildGraph cmd4(pK, 16, (1ULL << 16), 3, "graph4", fastas, fastqs, lines, false, 5);
+        cmd4(cxt);
+    }
+
+    Graph::LazyIterator i1(Graph::lazyIterator("graph1", fac));
+    Graph::LazyIterator i2(Graph::lazyIterator("graph2", fac));
+    Graph::LazyIterator i3(Graph::lazyIterator("graph3", fac));
+    Graph::LazyIterator i4(Graph::lazyIterator("graph4", fac));
+    BOOST_CHECK(i1.count() > 30000);
+    BOOST_CHECK_EQUAL(i1.count(), i2.count());
+    BOOST_CHECK_EQUAL(i1.count(), i3.count());
+    BOOST_CHECK_EQUAL(i1.count(), i4.count());
+    while (i1.valid() && i2.valid() && i3.valid() && i4.valid())
+    {
+        BOOST_CHECK((*i1).first == (*i2).first);
+        BOOST_CHECK_EQUAL((*i1).second, (*i2).second);
+        BOOST_CHECK((*i1).first == (*i3).first);
+        BOOST_CHECK_EQUAL((*i1).second, (*i3).second);
+        BOOST_CHECK((*i1).first == (*i4).first);
+        BOOST_CHECK_EQUAL((*i1).second, (*i4).second);
+        ++i1;
+        ++i2;
+        ++i3;
+        ++i4;
+    }
+    BOOST_CHECK(!i1.valid() && !i2.valid() && !i3.valid() && !i4.valid());
+}
+
+BOOST_AUTO_TEST_CASE(testBuildModesAgree)
+{
+    checkBuildModesAgree(25);
+}
+
+// Rho-mers of more than one word.
+BOOST_AUTO_TEST_CASE(testBuildModesAgreeLargeK)
+{
+    checkBuildModesAgree(45);
+}
+
 #include "testEnd.hh"
@@ -111,4 +111,55 @@ BOOST_AUTO_TEST_CASE(test123MinLength)
     BOOST_CHECK_EQUAL(fac.readFile("out.fa"), longReadOnly);
 }
 
+BOOST_AUTO_TEST_CASE(test124Threaded)
+{
+    // Random reads with errors give lots of short segments, which must
+    // come out the same, in the same order, on any number of threads.
+    std::mt19937 rng(19);
+    string genome;
+    for (uint64_t i = 0; i < 5000; ++i)
+    {
+        genome.push_back("ACGT"[rng() % 4]);
+    }
+    string fa;
+    for (uint64_t i = 0; i < 400; ++i)
+    {
+        string read = genome.substr(rng() % (genome.size() - 100), 100);
+        read[rng() % read.size()] = "ACGT"[rng() % 4];
+        fa += ">" + lexical_cast<string>(i) + "\n" + read + "\n";
+    }
+
+    StringFileFactory fac;
+    {
+        Logger log("log.txt", fac);
+        {
+            fac.addFile("reads.fa", fa);
+
+            std::vector<string> fastas;
+            std::vector<string> fastqs;
+            std::vector<string> lines;
+
+            fastas.push_back("reads.fa");
+
+            GossCmdBuildGraph cmd(27, 16, (1ULL << 16), 2, "graph", fastas, fastqs, lines);
+
+            boost::program_options::variables_map opts;
+            GossCmdContext cxt(fac, log, "build-graph", opts);
+            cmd(cxt);
+        }
+        for (uint64_t t = 1; t <= 4; t *= 2)
+        {
+            string out = "out-" + lexical_cast<string>(t) + ".fa";
+            GossCmdPrintContigs cmd("graph", 0, 0, false, false, true, false, false, false, t, out);
+
+            boost::program_options::variables_map opts;
+            GossCmdContext cxt(fac, log, "build-graph", opts);
+            cmd(cxt);
+        }
+    }
+    BOOST_CHECK(fac.readFile("out-1.fa").size() > genome.size());
+    BOOST_CHECK_EQUAL(fac.readFile("out-1.fa"), fac.readFile("out-2.fa"));
+    BOOST_CHECK_EQUAL(fac.readFile("out-1.fa"), fac.readFile("out-4.fa"));
+}
+
 #include "testEnd.hh"
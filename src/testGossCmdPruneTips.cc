@@ -0,0 +1,164 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "GossCmdPruneTips.hh"
+#include "GossCmdBuildGraph.hh"
+
+#include "Graph.hh"
+#include "StringFileFactory.hh"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestGossCmdPruneTips
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    const uint64_t K = 9;
+
+    const char* bases = "ACGT";
+
+    // pN random bases, the first of which is not pAvoid.
+    string randomBases(std::mt19937& pRng, uint64_t pN, char pAvoid)
+    {
+        string s;
+        while (s.size() < pN)
+        {
+            char b = bases[pRng() % 4];
+            if (s.empty() && b == pAvoid)
+            {
+                continue;
+            }
+            s += b;
+        }
+        return s;
+    }
+
+    // Add a nest of pDepth tips branching off the genome at pPos. Each
+    // level branches off a few bases into the one before, and has half
+    // the coverage, so that it is not removed until the levels nested
+    // in it are gone.
+    void addNest(const string& pGenome, uint64_t pPos, uint64_t pDepth,
+                 std::mt19937& pRng, vector<string>& pReads)
+    {
+        string stem = pGenome.substr(pPos - 20, 20);
+        char next = pGenome[pPos];
+        for (uint64_t d = 0; d < pDepth; ++d)
+        {
+            string branch = randomBases(pRng, 10, next);
+            for (uint64_t c = 0; c < (1ULL << (pDepth - 1 - d)); ++c)
+            {
+                pReads.push_back(stem + branch);
+            }
+            stem += branch.substr(0, 4);
+            next = branch[4];
+        }
+    }
+
+    void buildGraph(StringFileFactory& pFac, Logger& pLog)
+    {
+        std::mt19937 rng(19);
+        const string genome = randomBases(rng, 300, 'N');
+
+        vector<string> reads;
+        for (uint64_t i = 0; i + 40 <= genome.size(); i += 2)
+        {
+            reads.push_back(genome.substr(i, 40));
+        }
+        addNest(genome, 60, 1, rng, reads);
+        addNest(genome, 140, 2, rng, reads);
+        addNest(genome, 220, 3, rng, reads);
+
+        string lines;
+        for (uint64_t i = 0; i < reads.size(); ++i)
+        {
+            lines += reads[i] + "\n";
+        }
+        pFac.addFile("reads.ln", lines);
+
+        vector<string> fastas;
+        vector<string> fastqs;
+        vector<string> lineFiles(1, "reads.ln");
+        boost::program_options::variables_map opts;
+        GossCmdBuildGraph cmd(K, 16, (1ULL << 16), 2, "graph", fastas, fastqs, lineFiles);
+        GossCmdContext cxt(pFac, pLog, "build-graph", opts);
+        cmd(cxt);
+    }
+
+    void prune(StringFileFactory& pFac, Logger& pLog, const string& pIn, const string& pOut,
+               uint64_t pThreads, uint64_t pIterations, bool pUntilStable)
+    {
+        boost::program_options::variables_map opts;
+        GossCmdPruneTips cmd(pIn, pOut, boost::optional<uint64_t>(), boost::optional<double>(),
+                             pThreads, pIterations, pUntilStable);
+        GossCmdContext cxt(pFac, pLog, "prune-tips", opts);
+        cmd(cxt);
+    }
+
+    // The edges of a graph, with their multiplicities.
+    string describe(StringFileFactory& pFac, const string& pName)
+    {
+        GraphPtr g(Graph::open(pName, pFac));
+        ostringstream out;
+        for (Graph::Iterator itr(*g); itr.valid(); ++itr)
+        {
+            out << (*itr).first.value() << ' ' << (*itr).second << '\n';
+        }
+        return out.str();
+    }
+
+    uint64_t count(StringFileFactory& pFac, const string& pName)
+    {
+        return Graph::open(pName, pFac)->count();
+    }
+}
+
+// Pruning from a worklist after the first pass must give the same graph
+// as a full pass over the graph each time.
+BOOST_AUTO_TEST_CASE(testWorklistMatchesFullRescan)
+{
+    StringFileFactory fac;
+    Logger log("log.txt", fac);
+    buildGraph(fac, log);
+
+    // Full rescans: a fresh single pass each time, until nothing changes.
+    string in = "graph";
+    uint64_t passes = 0;
+    for (uint64_t i = 0; ; ++i)
+    {
+        string out = "full-" + lexical_cast<string>(i);
+        prune(fac, log, in, out, 1, 1, false);
+        if (count(fac, out) == count(fac, in))
+        {
+            break;
+        }
+        ++passes;
+        in = out;
+    }
+    // Nested tips take more than one pass.
+    BOOST_CHECK(passes >= 2);
+    const string expected = describe(fac, in);
+    BOOST_CHECK(count(fac, in) < count(fac, "graph"));
+
+    prune(fac, log, "graph", "stable-1", 1, 1, true);
+    BOOST_CHECK_EQUAL(describe(fac, "stable-1"), expected);
+
+    prune(fac, log, "graph", "stable-3", 3, 1, true);
+    BOOST_CHECK_EQUAL(describe(fac, "stable-3"), expected);
+
+    prune(fac, log, "graph", "iterated", 2, passes, false);
+    BOOST_CHECK_EQUAL(describe(fac, "iterated"), expected);
+}
+
+#include "testEnd.hh"
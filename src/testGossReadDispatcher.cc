@@ -0,0 +1,147 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "GossReadDispatcher.hh"
+
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
+#include <mutex>
+#include <set>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestGossReadDispatcher
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    class Collector : public GossReadHandler
+    {
+    public:
+        void operator()(const GossRead& pRead)
+        {
+            std::unique_lock<std::mutex> lk(mMutex);
+            mLabels.insert(pRead.label());
+            mBases += pRead.length();
+        }
+
+        void operator()(const GossRead& pLhs, const GossRead& pRhs)
+        {
+            std::unique_lock<std::mutex> lk(mMutex);
+            mLabels.insert(pLhs.label() + "/" + pRhs.label());
+            mBases += pLhs.length() + pRhs.length();
+        }
+
+        Collector(std::mutex& pMutex, set<string>& pLabels, uint64_t& pBases)
+            : mMutex(pMutex), mLabels(pLabels), mBases(pBases)
+        {
+        }
+
+    private:
+        std::mutex& mMutex;
+        set<string>& mLabels;
+        uint64_t& mBases;
+    };
+
+    class BatchCounter : public Collector
+    {
+    public:
+        void operator()(const GossReadBatch& pBatch)
+        {
+            mBatches++;
+            mMaxSize = std::max(mMaxSize, pBatch.size());
+            GossReadHandler::operator()(pBatch);
+        }
+
+        BatchCounter(std::mutex& pMutex, set<string>& pLabels, uint64_t& pBases)
+            : Collector(pMutex, pLabels, pBases), mBatches(0), mMaxSize(0)
+        {
+        }
+
+        uint64_t mBatches;
+        uint64_t mMaxSize;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(testSingle)
+{
+    std::mutex mut;
+    set<string> labels;
+    uint64_t bases = 0;
+    vector<std::shared_ptr<BatchCounter> > counters;
+    vector<GossReadHandlerPtr> handlers;
+    for (uint64_t i = 0; i < 3; ++i)
+    {
+        counters.push_back(std::make_shared<BatchCounter>(mut, labels, bases));
+        handlers.push_back(counters.back());
+    }
+
+    const uint64_t N = 10001;
+    uint64_t expected = 0;
+    {
+        GossReadDispatcher disp(handlers, 100);
+        string l;
+        string r;
+        string q;
+        for (uint64_t i = 0; i < N; ++i)
+        {
+            // The parser reuses its strings, so the dispatcher must copy.
+            l = lexical_cast<string>(i);
+            r = string(i % 150, 'A');
+            q = string(i % 150, 'B');
+            GossReadBaseString read(l, r, q);
+            disp(read);
+            expected += r.size();
+        }
+        disp.end();
+    }
+
+    BOOST_CHECK_EQUAL(labels.size(), N);
+    BOOST_CHECK_EQUAL(bases, expected);
+    uint64_t batches = 0;
+    for (uint64_t i = 0; i < counters.size(); ++i)
+    {
+        batches += counters[i]->mBatches;
+        BOOST_CHECK(counters[i]->mMaxSize <= 100);
+    }
+    BOOST_CHECK_EQUAL(batches, (N + 99) / 100);
+}
+
+BOOST_AUTO_TEST_CASE(testPairs)
+{
+    std::mutex mut;
+    set<string> labels;
+    uint64_t bases = 0;
+    vector<GossReadHandlerPtr> handlers;
+    for (uint64_t i = 0; i < 2; ++i)
+    {
+        handlers.push_back(std::make_shared<Collector>(mut, labels, bases));
+    }
+
+    const uint64_t N = 5000;
+    {
+        GossPairDispatcher disp(handlers, 64);
+        string q;
+        for (uint64_t i = 0; i < N; ++i)
+        {
+            string l1 = lexical_cast<string>(i);
+            string l2 = lexical_cast<string>(N + i);
+            string r1("ACGT");
+            string r2("ACGTACGT");
+            disp(GossReadBaseString(l1, r1, q), GossReadBaseString(l2, r2, q));
+        }
+        disp.end();
+    }
+
+    BOOST_CHECK_EQUAL(labels.size(), N);
+    BOOST_CHECK_EQUAL(bases, 12 * N);
+    BOOST_CHECK(labels.count("17/5017"));
+}
+
+#include "testEnd.hh"
@@ -0,0 +1,201 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "GraphComponents.hh"
+#include "StringFileFactory.hh"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestGraphComponents
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    const uint64_t K = 15;
+
+    // Build a graph from some random sequences, some of which overlap,
+    // so that there are components of various shapes and sizes.
+    GraphPtr buildGraph(StringFileFactory& pFac)
+    {
+        std::mt19937 rng(23);
+        vector<SmallBaseVector> seqs;
+        for (uint64_t i = 0; i < 200; ++i)
+        {
+            SmallBaseVector v;
+            if (i > 0 && rng() % 3 == 0)
+            {
+                // Branch off an earlier sequence.
+                const SmallBaseVector& w(seqs[rng() % seqs.size()]);
+                uint64_t l = std::min<uint64_t>(w.size(), K + 1 + rng() % 10);
+                for (uint64_t j = 0; j < l; ++j)
+                {
+                    v.push_back(w[j]);
+                }
+            }
+            uint64_t n = K + 1 + rng() % 40;
+            while (v.size() < n)
+            {
+                v.push_back(rng() % 4);
+            }
+            seqs.push_back(v);
+        }
+
+        map<Gossamer::position_type,uint64_t> k1mers;
+        for (uint64_t i = 0; i < seqs.size(); ++i)
+        {
+            for (uint64_t j = 0; j + K + 1 <= seqs[i].size(); ++j)
+            {
+                Gossamer::position_type x = seqs[i].kmer(K + 1, j);
+                Gossamer::position_type y = x;
+                y.reverseComplement(K + 1);
+                k1mers[x] += 1 + rng() % 20;
+                k1mers[y] = k1mers[x];
+            }
+        }
+
+        {
+            Graph::Builder b(K, "x", pFac, k1mers.size());
+            for (map<Gossamer::position_type,uint64_t>::const_iterator i = k1mers.begin();
+                    i != k1mers.end(); ++i)
+            {
+                b.push_back(i->first, i->second);
+            }
+            b.end();
+        }
+        return Graph::open("x", pFac);
+    }
+
+    // Find the components the slow way, by searching from each edge.
+    vector<GraphComponents::Component> expected(const Graph& pGraph, const dynamic_bitset<>& pEdges)
+    {
+        dynamic_bitset<> seen(pEdges);
+        vector<GraphComponents::Component> comps;
+        for (uint64_t i = 0; i < pGraph.count(); ++i)
+        {
+            if (!seen[i])
+            {
+                continue;
+            }
+            GraphComponents::Component c(i);
+            vector<uint64_t> stack;
+            stack.push_back(i);
+            seen[i] = false;
+            while (!stack.empty())
+            {
+                uint64_t r = stack.back();
+                stack.pop_back();
+                c.add(pGraph.multiplicity(r));
+
+                Graph::Edge e = pGraph.select(r);
+                Graph::Node ns[] = { pGraph.from(e), pGraph.to(e) };
+                for (uint64_t j = 0; j < 2; ++j)
+                {
+                    // Out edges, then in edges.
+                    pair<uint64_t,uint64_t> o = pGraph.beginEndRank(ns[j]);
+                    pair<uint64_t,uint64_t> n = pGraph.beginEndRank(pGraph.reverseComplement(ns[j]));
+                    vector<uint64_t> rs;
+                    for (uint64_t q = o.first; q < o.second; ++q)
+                    {
+                        rs.push_back(q);
+                    }
+                    for (uint64_t q = n.first; q < n.second; ++q)
+                    {
+                        rs.push_back(pGraph.rank(pGraph.reverseComplement(pGraph.select(q))));
+                    }
+                    for (uint64_t q = 0; q < rs.size(); ++q)
+                    {
+                        if (seen[rs[q]])
+                        {
+                            seen[rs[q]] = false;
+                            stack.push_back(rs[q]);
+                        }
+                    }
+                }
+            }
+            comps.push_back(c);
+        }
+        return comps;
+    }
+
+    void check(const GraphComponents& pActual, const vector<GraphComponents::Component>& pExpected)
+    {
+        const vector<GraphComponents::Component>& a(pActual.components());
+        BOOST_CHECK_EQUAL(a.size(), pExpected.size());
+        for (uint64_t i = 0; i < std::min(a.size(), pExpected.size()); ++i)
+        {
+            BOOST_CHECK_EQUAL(a[i].mStart, pExpected[i].mStart);
+            BOOST_CHECK_EQUAL(a[i].mNumEdges, pExpected[i].mNumEdges);
+            BOOST_CHECK_EQUAL(a[i].mCountMin, pExpected[i].mCountMin);
+            BOOST_CHECK_EQUAL(a[i].mCountMax, pExpected[i].mCountMax);
+            BOOST_CHECK_EQUAL(a[i].mCountSum, pExpected[i].mCountSum);
+            BOOST_CHECK_EQUAL(a[i].mCountSum2, pExpected[i].mCountSum2);
+            BOOST_CHECK_EQUAL(pActual.component(a[i].mStart), i);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testWholeGraph)
+{
+    StringFileFactory fac;
+    GraphPtr gPtr = buildGraph(fac);
+    const Graph& g(*gPtr);
+
+    dynamic_bitset<> all(g.count());
+    all.set();
+    vector<GraphComponents::Component> exp = expected(g, all);
+    BOOST_CHECK(exp.size() > 10);
+
+    for (uint64_t t = 1; t <= 4; t *= 2)
+    {
+        GraphComponents gc(g, t);
+        check(gc, exp);
+
+        // Every edge belongs to the component it was counted in.
+        uint64_t l = gc.largest();
+        dynamic_bitset<> es(g.count());
+        gc.edges(l, es);
+        BOOST_CHECK_EQUAL(es.count(), exp[l].mNumEdges);
+        for (uint64_t i = 0; i < exp.size(); ++i)
+        {
+            BOOST_CHECK(exp[i].mNumEdges <= exp[l].mNumEdges);
+        }
+        for (uint64_t r = es.find_first(); r != dynamic_bitset<>::npos; r = es.find_next(r))
+        {
+            BOOST_CHECK_EQUAL(gc.component(r), l);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSubgraph)
+{
+    StringFileFactory fac;
+    GraphPtr gPtr = buildGraph(fac);
+    const Graph& g(*gPtr);
+
+    std::mt19937 rng(29);
+    dynamic_bitset<> some(g.count());
+    for (uint64_t i = 0; i < g.count(); ++i)
+    {
+        some[i] = rng() % 4 != 0;
+    }
+    vector<GraphComponents::Component> exp = expected(g, some);
+
+    for (uint64_t t = 1; t <= 4; t *= 2)
+    {
+        GraphComponents gc(g, some, t);
+        check(gc, exp);
+    }
+}
+
+#include "testEnd.hh"
@@ -0,0 +1,72 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "JsonWriter.hh"
+
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+#define GOSS_TEST_MODULE TestJsonWriter
+#include "testBegin.hh"
+
+BOOST_AUTO_TEST_CASE(testEmpty)
+{
+    ostringstream out;
+    {
+        JsonWriter j(out);
+        j.beginObject().endObject();
+    }
+    BOOST_CHECK_EQUAL(out.str(), "{}\n");
+}
+
+BOOST_AUTO_TEST_CASE(testNested)
+{
+    ostringstream out;
+    {
+        JsonWriter j(out);
+        j.beginObject();
+        j.field("name", "x").field("n", uint64_t(3)).field("ok", true);
+        j.key("xs").beginArray().value(1).value(2.5).beginObject().endObject().endArray();
+        j.key("none").beginArray().endArray();
+        j.endObject();
+    }
+    BOOST_CHECK_EQUAL(out.str(),
+        "{\n"
+        "  \"name\": \"x\",\n"
+        "  \"n\": 3,\n"
+        "  \"ok\": true,\n"
+        "  \"xs\": [\n"
+        "    1,\n"
+        "    2.5,\n"
+        "    {}\n"
+        "  ],\n"
+        "  \"none\": []\n"
+        "}\n");
+}
+
+BOOST_AUTO_TEST_CASE(testEscapes)
+{
+    ostringstream out;
+    {
+        JsonWriter j(out);
+        j.beginArray();
+        j.value("a\"b\\c\nd\te\x01");
+        j.value(numeric_limits<double>::infinity());
+        j.endArray();
+    }
+    BOOST_CHECK_EQUAL(out.str(),
+        "[\n"
+        "  \"a\\\"b\\\\c\\nd\\te\\u0001\",\n"
+        "  null\n"
+        "]\n");
+}
+
+#include "testEnd.hh"
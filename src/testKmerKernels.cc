@@ -0,0 +1,131 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "KmerKernels.hh"
+#include "GossReadBaseString.hh"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestKmerKernels
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    // A random read, mostly bases of either case, with the odd N or
+    // other junk.
+    string randomRead(std::mt19937& pRng, uint64_t pLen)
+    {
+        static const char* bases = "ACGTacgt";
+        static const char* junk = "NnX.-\x80\xff";
+        string r;
+        for (uint64_t i = 0; i < pLen; ++i)
+        {
+            if (pRng() % 50 == 0)
+            {
+                r.push_back(junk[pRng() % 7]);
+            }
+            else
+            {
+                r.push_back(bases[pRng() % 8]);
+            }
+        }
+        return r;
+    }
+
+    void checkKmers(uint64_t pK)
+    {
+        std::mt19937 rng(pK);
+        vector<uint8_t> codes;
+        for (uint64_t i = 0; i < 200; ++i)
+        {
+            string r(randomRead(rng, rng() % 300));
+            string label;
+            string qual;
+            GossReadBaseString read(label, r, qual);
+
+            vector<Gossamer::edge_type> xs;
+            vector<Gossamer::edge_type> ns;
+            for (GossRead::Iterator j(read, pK); j.valid(); ++j)
+            {
+                xs.push_back(j.kmer());
+                ns.push_back(j.kmer().normalized(pK));
+            }
+
+            vector<Gossamer::edge_type> ys;
+            KmerKernels::kmers(r, pK, false, codes, ys);
+            BOOST_CHECK(xs == ys);
+
+            vector<Gossamer::edge_type> ms;
+            KmerKernels::kmers(r, pK, true, codes, ms);
+            BOOST_CHECK(ns == ms);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testEncode)
+{
+    std::mt19937 rng(17);
+    for (uint64_t i = 0; i < 500; ++i)
+    {
+        uint64_t n = rng() % 200;
+        string r(randomRead(rng, n));
+        vector<uint8_t> xs(n + 1, 99);
+        vector<uint8_t> ys(n + 1, 99);
+        uint64_t bx = KmerKernels::encode(r.data(), n, &xs[0]);
+        uint64_t by = KmerKernels::encodeScalar(r.data(), n, &ys[0]);
+        BOOST_CHECK_EQUAL(bx, by);
+        BOOST_CHECK(xs == ys);
+    }
+
+    const string s("ACGTacgtN");
+    uint8_t cs[9];
+    BOOST_CHECK_EQUAL(KmerKernels::encode(s.data(), s.size(), cs), 1);
+    BOOST_CHECK_EQUAL(cs[0], 0);
+    BOOST_CHECK_EQUAL(cs[1], 1);
+    BOOST_CHECK_EQUAL(cs[2], 2);
+    BOOST_CHECK_EQUAL(cs[3], 3);
+    BOOST_CHECK_EQUAL(cs[7], 3);
+    BOOST_CHECK(cs[8] == KmerKernels::sInvalid);
+}
+
+BOOST_AUTO_TEST_CASE(testRoll64)
+{
+    const uint64_t K = 32;
+    std::mt19937 rng(19);
+    string r(randomRead(rng, 1000));
+    vector<uint8_t> codes(r.size());
+    KmerKernels::encode(r.data(), r.size(), &codes[0]);
+    uint64_t n = 0;
+    auto vis = [&] (uint64_t pOffset, uint64_t pKmer, uint64_t pRc) {
+        BOOST_CHECK_EQUAL(pRc, Gossamer::reverseComplement(K, pKmer));
+        uint64_t x = 0;
+        for (uint64_t i = 0; i < K; ++i)
+        {
+            x = (x << 2) | codes[pOffset + i];
+        }
+        BOOST_CHECK_EQUAL(pKmer, x);
+        ++n;
+    };
+    KmerKernels::roll<uint64_t>(&codes[0], codes.size(), K, vis);
+    BOOST_CHECK(n > 0);
+}
+
+BOOST_AUTO_TEST_CASE(testKmers)
+{
+    checkKmers(1);
+    checkKmers(25);
+    checkKmers(32);
+    checkKmers(55);
+}
+
+#include "testEnd.hh"
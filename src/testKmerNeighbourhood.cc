@@ -0,0 +1,150 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+
+#include "KmerNeighbourhood.hh"
+#include "StringFileFactory.hh"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+
+using namespace boost;
+using namespace std;
+using namespace Gossamer;
+
+#define GOSS_TEST_MODULE TestKmerNeighbourhood
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    // The number of bases at which pX and pY differ.
+    uint64_t distance(uint64_t pK, edge_type pX, edge_type pY)
+    {
+        uint64_t d = 0;
+        for (uint64_t i = 0; i < pK; ++i)
+        {
+            if ((pX & edge_type(3)) != (pY & edge_type(3)))
+            {
+                ++d;
+            }
+            pX >>= 2;
+            pY >>= 2;
+        }
+        return d;
+    }
+
+    // Build a set in which many kmers have near neighbours, and check
+    // the neighbourhood scan against comparing every pair of kmers.
+    void check(uint64_t pK, uint64_t pNumThreads)
+    {
+        std::mt19937 rng(19);
+        auto kmer = [&] () {
+            edge_type x(0);
+            for (uint64_t i = 0; i < 2 * pK; i += 32)
+            {
+                x <<= 32;
+                x |= edge_type(rng());
+            }
+            x &= (edge_type(1) << (2 * pK)) - 1;
+            return x;
+        };
+
+        vector<edge_type> xs;
+        for (uint64_t i = 0; i < 300; ++i)
+        {
+            edge_type x = kmer();
+            xs.push_back(x);
+            for (uint64_t j = 0; j < 3; ++j)
+            {
+                edge_type y(rng() % 3 + 1);
+                y <<= 2 * (rng() % pK);
+                y ^= x;
+                xs.push_back(y);
+            }
+        }
+        for (uint64_t i = 0; i < xs.size(); ++i)
+        {
+            xs[i].normalize(pK);
+        }
+        sort(xs.begin(), xs.end());
+        xs.erase(unique(xs.begin(), xs.end()), xs.end());
+
+        StringFileFactory fac;
+        {
+            KmerSet::Builder bld(pK, "x", fac, xs.size());
+            for (uint64_t i = 0; i < xs.size(); ++i)
+            {
+                bld.push_back(xs[i]);
+            }
+            bld.end();
+        }
+        KmerSet s("x", fac);
+
+        set<pair<uint64_t,uint64_t> > expected;
+        for (uint64_t i = 0; i < xs.size(); ++i)
+        {
+            if (i % 3 == 0)
+            {
+                continue;
+            }
+            edge_type rc(xs[i]);
+            rc.reverseComplement(pK);
+            for (uint64_t j = 0; j < xs.size(); ++j)
+            {
+                if (j != i && (distance(pK, xs[i], xs[j]) == 1 || distance(pK, rc, xs[j]) == 1))
+                {
+                    expected.insert(make_pair(i, j));
+                }
+            }
+        }
+        BOOST_CHECK(expected.size() > xs.size() / 2);
+
+        vector<vector<uint64_t> > seen(xs.size());
+        auto wanted = [] (uint64_t pRank) {
+            return pRank % 3 != 0;
+        };
+        auto vis = [&] (uint64_t pRank, uint64_t pNbr) {
+            seen[pRank].push_back(pNbr);
+        };
+        std::ostringstream out;
+        Logger log(out);
+        ProgressMonitorNew mon(log, s.count());
+        KmerNeighbourhood(s).scanAll(pNumThreads, wanted, vis, mon, 64);
+
+        set<pair<uint64_t,uint64_t> > actual;
+        for (uint64_t i = 0; i < seen.size(); ++i)
+        {
+            for (uint64_t j = 0; j < seen[i].size(); ++j)
+            {
+                actual.insert(make_pair(i, seen[i][j]));
+            }
+        }
+        BOOST_CHECK(actual == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSmallK)
+{
+    check(25, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testLargeK)
+{
+    check(41, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testThreaded)
+{
+    check(25, 4);
+}
+
+#include "testEnd.hh"
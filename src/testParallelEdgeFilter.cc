@@ -0,0 +1,96 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "ParallelEdgeFilter.hh"
+#include "StringFileFactory.hh"
+
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestParallelEdgeFilter
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    const uint64_t K = 27;
+
+    // Build a graph of random edges with random counts.
+    void build(FileFactory& pFac, uint64_t pN)
+    {
+        std::mt19937 rng(23);
+        map<uint64_t,uint32_t> edges;
+        while (edges.size() < pN)
+        {
+            uint64_t x = (uint64_t(rng()) << 32 | rng()) & ((1ULL << (2 * K + 2)) - 1);
+            edges[x] = 1 + rng() % 10;
+        }
+        Graph::Builder b(K, "x", pFac, edges.size());
+        for (map<uint64_t,uint32_t>::const_iterator i = edges.begin(); i != edges.end(); ++i)
+        {
+            b.push_back(Gossamer::position_type(i->first), i->second);
+        }
+        b.end();
+    }
+
+    // Check that filtering with pNumThreads threads and segments of
+    // pSegmentSize edges gives the same graph as a sequential pass.
+    void check(uint64_t pNumThreads, uint64_t pSegmentSize)
+    {
+        StringFileFactory fac;
+        build(fac, 5000);
+        GraphPtr gPtr = Graph::open("x", fac);
+        const Graph& g(*gPtr);
+
+        stringstream ss;
+        Logger log(ss);
+        ProgressMonitorNew mon(log, g.count());
+        {
+            Graph::Builder b(K, "y", fac, g.count());
+            auto keep = [] (const Graph::Edge& pEdge, uint32_t pCount) {
+                return pCount > 3;
+            };
+            ParallelEdgeFilter::filter(g, b, keep, pNumThreads, mon, pSegmentSize);
+            b.end();
+        }
+        GraphPtr hPtr = Graph::open("y", fac);
+        const Graph& h(*hPtr);
+
+        Graph::Iterator j(h);
+        for (Graph::Iterator i(g); i.valid(); ++i)
+        {
+            if ((*i).second <= 3)
+            {
+                continue;
+            }
+            BOOST_REQUIRE(j.valid());
+            BOOST_CHECK((*i).first == (*j).first);
+            BOOST_CHECK_EQUAL((*i).second, (*j).second);
+            ++j;
+        }
+        BOOST_CHECK(!j.valid());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testOneThread)
+{
+    check(1, 100);
+}
+
+BOOST_AUTO_TEST_CASE(testManyThreads)
+{
+    check(3, 97);
+    check(4, 1);
+    check(2, ParallelEdgeFilter::sSegmentSize);
+}
+
+#include "testEnd.hh"
@@ -0,0 +1,129 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "PerfReport.hh"
+
+#include "BoundedQueue.hh"
+#include "PhysicalFileFactory.hh"
+#include "ProgressMonitor.hh"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define GOSS_TEST_MODULE TestPerfReport
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    bool contains(const string& pStr, const string& pSub)
+    {
+        return pStr.find(pSub) != string::npos;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testReport)
+{
+    {
+        PerfReport::Phase p("unreported phase");
+    }
+
+    PerfReport::enable(true);
+    {
+        PerfReport::Phase p("first phase");
+    }
+
+    {
+        BoundedQueue<uint64_t> q(10);
+        for (uint64_t i = 0; i < 3; ++i)
+        {
+            q.put(i);
+        }
+        uint64_t x;
+        q.get(x);
+        q.put(3);
+    }
+
+    {
+        ostringstream log;
+        Logger l(log);
+        ProgressMonitorNew mon(l, 100);
+        for (uint64_t i = 1; i <= 100; ++i)
+        {
+            mon.tick(i);
+        }
+        mon.end();
+    }
+
+    PhysicalFileFactory fac;
+    string nm = fac.tmpName();
+    {
+        FileFactory::OutHolderPtr outp(fac.out(nm));
+        **outp << "0123456789";
+    }
+    {
+        FileFactory::InHolderPtr inp(fac.in(nm));
+        string s;
+        **inp >> s;
+        BOOST_CHECK_EQUAL(s, "0123456789");
+    }
+    fac.remove(nm);
+
+    vector<string> args;
+    args.push_back("--a\"b");
+    ostringstream out;
+    PerfReport::write(out, "goss", "1.0", "test", args, 0);
+    string s = out.str();
+
+    BOOST_CHECK(contains(s, "\"command\": \"test\""));
+    BOOST_CHECK(contains(s, "\"--a\\\"b\""));
+    BOOST_CHECK(contains(s, "\"peak_rss_bytes\": "));
+    BOOST_CHECK(contains(s, "\"bytes_read\": 10,"));
+    BOOST_CHECK(contains(s, "\"bytes_written\": 10,"));
+    BOOST_CHECK(contains(s, "\"name\": \"first phase\""));
+    BOOST_CHECK(!contains(s, "unreported phase"));
+    BOOST_CHECK(contains(s, "\"items\": 100,"));
+    BOOST_CHECK(contains(s, "\"total\": 100,"));
+    BOOST_CHECK(contains(s, "\"puts\": 4,"));
+    BOOST_CHECK(contains(s, "\"mean_occupancy\": 2.25,"));
+    BOOST_CHECK(contains(s, "\"max_occupancy\": 3,"));
+    BOOST_CHECK(contains(s, "\"label\": \"<root>\""));
+    BOOST_CHECK_EQUAL(s[s.size() - 2], '}');
+}
+
+BOOST_AUTO_TEST_CASE(testReset)
+{
+    PerfReport::enable(true);
+    {
+        PerfReport::Phase p("earlier run");
+    }
+    {
+        BoundedQueue<uint64_t> q(10);
+        q.put(0);
+    }
+    PerfReport::addBytesRead(10);
+
+    PerfReport::reset();
+    {
+        PerfReport::Phase p("later run");
+    }
+
+    ostringstream out;
+    PerfReport::write(out, "goss", "1.0", "test", vector<string>(), 0);
+    string s = out.str();
+
+    BOOST_CHECK(!contains(s, "earlier run"));
+    BOOST_CHECK(contains(s, "\"name\": \"later run\""));
+    BOOST_CHECK(contains(s, "\"files_read\": 0,"));
+    BOOST_CHECK(contains(s, "\"bytes_read\": 0,"));
+    BOOST_CHECK(contains(s, "\"queues\": []"));
+}
+
+#include "testEnd.hh"
@@ -15,6 +15,15 @@
 #include <sstream>
 #include <string>
 #include <iostream>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/lexical_cast.hpp>
+#include <zlib.h>
 
 
 using namespace boost;
@@ -50,7 +59,7 @@ BOOST_AUTO_TEST_CASE(testMoreInputDetail)
 
         int const* li = get_error_info<throw_line>(exc);
         BOOST_CHECK(li != NULL);
-        BOOST_CHECK_EQUAL(*li, 64);
+        BOOST_CHECK_EQUAL(*li, 97);
 
         const char* const* fi = get_error_info<throw_file>(exc);
         BOOST_CHECK(fi != NULL);
@@ -80,7 +89,7 @@ BOOST_AUTO_TEST_CASE(testMoreOutputDetail)
 
         int const* li = get_error_info<throw_line>(exc);
         BOOST_CHECK(li != NULL);
-        BOOST_CHECK_EQUAL(*li, 163);
+        BOOST_CHECK_EQUAL(*li, 199);
 
         const char* const* fi = get_error_info<throw_file>(exc);
         BOOST_CHECK(fi != NULL);
@@ -91,4 +100,148 @@ BOOST_AUTO_TEST_CASE(testMoreOutputDetail)
     }
 }
 
+namespace // anonymous
+{
+    string randomReads(uint64_t pNumReads)
+    {
+        std::mt19937 rng(19);
+        std::uniform_int_distribution<int> base(0, 3);
+        string s;
+        for (uint64_t i = 0; i < pNumReads; ++i)
+        {
+            s += "@read" + lexical_cast<string>(i) + "\n";
+            for (uint64_t j = 0; j < 100; ++j)
+            {
+                s += "ACGT"[base(rng)];
+            }
+            s += "\n+\n" + string(100, 'I') + "\n";
+        }
+        return s;
+    }
+
+    void writeBytes(const string& pFileName, const string& pBytes)
+    {
+        ofstream f(pFileName.c_str(), ios::binary);
+        f.write(pBytes.data(), pBytes.size());
+    }
+
+    string readAll(const FileFactory& pFac, const string& pFileName)
+    {
+        FileFactory::InHolderPtr inp(pFac.in(pFileName));
+        istream& in(**inp);
+        return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+
+    template <typename Filter>
+    string compress(const string& pData, const Filter& pFilter)
+    {
+        string res;
+        {
+            iostreams::filtering_ostream out;
+            out.push(pFilter);
+            out.push(iostreams::back_inserter(res));
+            out.write(pData.data(), pData.size());
+        }
+        return res;
+    }
+
+    void putLe(string& pStr, uint64_t pVal, uint64_t pBytes)
+    {
+        for (uint64_t i = 0; i < pBytes; ++i)
+        {
+            pStr += static_cast<char>((pVal >> (8 * i)) & 0xff);
+        }
+    }
+
+    // Compress data as BGZF, in members of up to 60000 bytes of input,
+    // followed by the usual empty end of file member.
+    string bgzf(const string& pData)
+    {
+        string res;
+        uint64_t i = 0;
+        do
+        {
+            string in(pData.substr(i, 60000));
+            i += in.size();
+
+            string body(compressBound(in.size()) + 16, '\0');
+            z_stream zs;
+            zs.zalloc = Z_NULL;
+            zs.zfree = Z_NULL;
+            zs.opaque = Z_NULL;
+            deflateInit2(&zs, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+            zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+            zs.avail_in = in.size();
+            zs.next_out = reinterpret_cast<Bytef*>(&body[0]);
+            zs.avail_out = body.size();
+            deflate(&zs, Z_FINISH);
+            body.resize(zs.total_out);
+            deflateEnd(&zs);
+
+            res += string("\x1f\x8b\x08\x04\0\0\0\0\0\xff\x06\0BC\x02\0", 16);
+            putLe(res, body.size() + 25, 2);
+            res += body;
+            putLe(res, crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(in.data()), in.size()), 4);
+            putLe(res, in.size(), 4);
+        } while (i < pData.size());
+        return res;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testParallelGzip)
+{
+    PhysicalFileFactory fac;
+    fac.setDecompressionThreads(3);
+    string data(randomReads(20000));
+    string nm(fac.tmpName() + ".gz");
+
+    writeBytes(nm, compress(data, iostreams::gzip_compressor()));
+    BOOST_CHECK(readAll(fac, nm) == data);
+
+    // Concatenated members.
+    writeBytes(nm, compress(data.substr(0, 1000), iostreams::gzip_compressor())
+                   + compress(data.substr(1000), iostreams::gzip_compressor()));
+    BOOST_CHECK(readAll(fac, nm) == data);
+
+    writeBytes(nm, bgzf(data));
+    BOOST_CHECK(readAll(fac, nm) == data);
+
+    writeBytes(nm, bgzf(""));
+    BOOST_CHECK(readAll(fac, nm) == "");
+
+    string bad(bgzf(data));
+    bad[bad.size() / 2] ^= 0x55;
+    writeBytes(nm, bad);
+    BOOST_CHECK_THROW(readAll(fac, nm), Gossamer::error);
+
+    fac.remove(nm);
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBzip2)
+{
+    PhysicalFileFactory fac;
+    fac.setDecompressionThreads(3);
+    string data(randomReads(20000));
+    string nm(fac.tmpName() + ".bz2");
+
+    // With 100k blocks, this makes many blocks.
+    writeBytes(nm, compress(data, iostreams::bzip2_compressor(1)));
+    BOOST_CHECK(readAll(fac, nm) == data);
+
+    // Concatenated streams.
+    writeBytes(nm, compress(data.substr(0, 1000), iostreams::bzip2_compressor(1))
+                   + compress(data.substr(1000), iostreams::bzip2_compressor(9)));
+    BOOST_CHECK(readAll(fac, nm) == data);
+
+    writeBytes(nm, compress("", iostreams::bzip2_compressor()));
+    BOOST_CHECK(readAll(fac, nm) == "");
+
+    string bad(compress(data, iostreams::bzip2_compressor(1)));
+    bad[bad.size() / 2] ^= 0x55;
+    writeBytes(nm, bad);
+    BOOST_CHECK_THROW(readAll(fac, nm), Gossamer::error);
+
+    fac.remove(nm);
+}
+
 #include "testEnd.hh"
@@ -0,0 +1,99 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "ReorderBuffer.hh"
+
+#include "BackgroundMultiConsumer.hh"
+
+#include <vector>
+
+using namespace std;
+
+#define GOSS_TEST_MODULE TestReorderBuffer
+#include "testBegin.hh"
+
+BOOST_AUTO_TEST_CASE(testOutOfOrderPuts)
+{
+    ReorderBuffer<uint64_t> buf(4);
+    buf.put(2, 20);
+    buf.put(0, 0);
+    buf.put(1, 10);
+    buf.finish();
+
+    uint64_t x = 0;
+    BOOST_CHECK(buf.get(x));
+    BOOST_CHECK_EQUAL(x, 0);
+    BOOST_CHECK(buf.get(x));
+    BOOST_CHECK_EQUAL(x, 10);
+    BOOST_CHECK(buf.get(x));
+    BOOST_CHECK_EQUAL(x, 20);
+    BOOST_CHECK(!buf.get(x));
+}
+
+namespace // anonymous
+{
+    class Squarer
+    {
+    public:
+        void operator()(uint64_t pSeq)
+        {
+            mBuf.put(pSeq, pSeq * pSeq);
+        }
+
+        Squarer(ReorderBuffer<uint64_t>& pBuf)
+            : mBuf(pBuf)
+        {
+        }
+
+    private:
+        ReorderBuffer<uint64_t>& mBuf;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(testThreaded)
+{
+    const uint64_t N = 100000;
+    ReorderBuffer<uint64_t> buf(16);
+    vector<uint64_t> got;
+    ThreadGroup writer;
+    writer.create([&] () {
+        uint64_t x;
+        while (buf.get(x))
+        {
+            got.push_back(x);
+        }
+    });
+
+    {
+        BackgroundMultiConsumer<uint64_t> grp(8);
+        Squarer s1(buf);
+        Squarer s2(buf);
+        Squarer s3(buf);
+        grp.addApply(s1);
+        grp.addApply(s2);
+        grp.addApply(s3);
+        for (uint64_t i = 0; i < N; ++i)
+        {
+            buf.reserve(i);
+            grp.push_back(i);
+        }
+        grp.wait();
+    }
+    buf.finish();
+    writer.join();
+
+    BOOST_CHECK_EQUAL(got.size(), N);
+    bool inOrder = true;
+    for (uint64_t i = 0; i < got.size(); ++i)
+    {
+        inOrder = inOrder && got[i] == i * i;
+    }
+    BOOST_CHECK(inOrder);
+}
+
+#include "testEnd.hh"
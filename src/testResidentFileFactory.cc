@@ -0,0 +1,182 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "ResidentFileFactory.hh"
+
+#include "Graph.hh"
+#include "StringFileFactory.hh"
+
+#include <string>
+
+using namespace std;
+
+#define GOSS_TEST_MODULE TestResidentFileFactory
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    string contents(const FileFactory& pFac, const string& pName)
+    {
+        FileFactory::InHolderPtr inp(pFac.in(pName));
+        return string(std::istreambuf_iterator<char>(**inp), std::istreambuf_iterator<char>());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testResidence)
+{
+    std::shared_ptr<StringFileFactory> base(new StringFileFactory);
+    base->addFile("disk", "on disk");
+    ResidentFileFactory fac(base, "work/graph-");
+
+    {
+        FileFactory::OutHolderPtr outp(fac.out("work/graph-1-edges"));
+        **outp << "edges";
+    }
+    {
+        FileFactory::OutHolderPtr outp(fac.out("work/contigs"));
+        **outp << "contigs";
+    }
+
+    // Only names with the prefix stay in memory.
+    BOOST_CHECK(!base->fileExists("work/graph-1-edges"));
+    BOOST_CHECK(base->fileExists("work/contigs"));
+    BOOST_CHECK(fac.exists("work/graph-1-edges"));
+    BOOST_CHECK_EQUAL(fac.size("work/graph-1-edges"), 5);
+    BOOST_CHECK_EQUAL(contents(fac, "work/graph-1-edges"), "edges");
+    BOOST_CHECK_EQUAL(contents(fac, "disk"), "on disk");
+    BOOST_CHECK_EQUAL(fac.residentBytes(), 5);
+
+    // Mapping hands over the resident contents directly.
+    FileFactory::MappedHolderPtr m1(fac.map("work/graph-1-edges"));
+    FileFactory::MappedHolderPtr m2(fac.map("work/graph-1-edges"));
+    BOOST_CHECK_EQUAL(m1->data(), m2->data());
+    BOOST_CHECK_EQUAL(string(static_cast<const char*>(m1->data()), m1->size()), "edges");
+
+    {
+        FileFactory::OutHolderPtr outp(fac.out("work/graph-1-edges", FileFactory::AppendMode));
+        **outp << "!";
+    }
+    BOOST_CHECK_EQUAL(contents(fac, "work/graph-1-edges"), "edges!");
+    // Existing mappings keep what they had.
+    BOOST_CHECK_EQUAL(string(static_cast<const char*>(m1->data()), m1->size()), "edges");
+
+    fac.checkpoint("work/graph-1-");
+    BOOST_CHECK_EQUAL(base->readFile("work/graph-1-edges"), "edges!");
+
+    fac.release("work/graph-1-");
+    BOOST_CHECK_EQUAL(fac.residentBytes(), 0);
+    // The checkpointed copy is still there.
+    BOOST_CHECK_EQUAL(contents(fac, "work/graph-1-edges"), "edges!");
+
+    fac.remove("work/graph-1-edges");
+    BOOST_CHECK(!fac.exists("work/graph-1-edges"));
+}
+
+BOOST_AUTO_TEST_CASE(testSpill)
+{
+    std::shared_ptr<StringFileFactory> base(new StringFileFactory);
+    ResidentFileFactory fac(base, "g-", 10);
+
+    {
+        FileFactory::OutHolderPtr outp(fac.out("g-small"));
+        **outp << "small";
+    }
+    BOOST_CHECK_EQUAL(fac.residentBytes(), 5);
+
+    // Writing past the budget moves the file to the underlying factory,
+    // including what was written before, and a header filled in later.
+    {
+        FileFactory::OutHolderPtr outp(fac.out("g-big"));
+        **outp << "0123";
+        (**outp).flush();
+        BOOST_CHECK_EQUAL(fac.residentBytes(), 9);
+        **outp << "456789";
+        (**outp).seekp(0);
+        **outp << "x";
+    }
+    BOOST_CHECK_EQUAL(fac.residentBytes(), 5);
+    BOOST_CHECK_EQUAL(base->readFile("g-big"), "x123456789");
+    BOOST_CHECK_EQUAL(contents(fac, "g-big"), "x123456789");
+    BOOST_CHECK(!base->fileExists("g-small"));
+
+    // Appending carries on where the file is.
+    {
+        FileFactory::OutHolderPtr outp(fac.out("g-big", FileFactory::AppendMode));
+        **outp << "!";
+    }
+    BOOST_CHECK_EQUAL(base->readFile("g-big"), "x123456789!");
+    {
+        FileFactory::OutHolderPtr outp(fac.out("g-small", FileFactory::AppendMode));
+        **outp << "er";
+    }
+    BOOST_CHECK_EQUAL(contents(fac, "g-small"), "smaller");
+    BOOST_CHECK_EQUAL(fac.residentBytes(), 7);
+
+    // Copies are also held to the budget.
+    fac.copy("g-small", "g-copy");
+    BOOST_CHECK(base->fileExists("g-copy"));
+    BOOST_CHECK_EQUAL(contents(fac, "g-copy"), "smaller");
+    BOOST_CHECK_EQUAL(fac.residentBytes(), 7);
+
+    // Releasing removes the spilled files too.
+    fac.release("g-");
+    BOOST_CHECK_EQUAL(fac.residentBytes(), 0);
+    BOOST_CHECK(!fac.exists("g-big"));
+    BOOST_CHECK(!fac.exists("g-copy"));
+    BOOST_CHECK(!fac.exists("g-small"));
+}
+
+BOOST_AUTO_TEST_CASE(testSpillCheckpoint)
+{
+    std::shared_ptr<StringFileFactory> base(new StringFileFactory);
+    ResidentFileFactory fac(base, "g-", 4);
+
+    {
+        FileFactory::OutHolderPtr outp(fac.out("g-1-big"));
+        **outp << "too big";
+    }
+    BOOST_CHECK_EQUAL(fac.residentBytes(), 0);
+
+    // A checkpointed file stays, even if it got there by spilling.
+    fac.checkpoint("g-1-");
+    fac.release("g-1-");
+    BOOST_CHECK_EQUAL(base->readFile("g-1-big"), "too big");
+}
+
+BOOST_AUTO_TEST_CASE(testGraphHandover)
+{
+    std::shared_ptr<StringFileFactory> base(new StringFileFactory);
+    ResidentFileFactory fac(base, "g");
+
+    const uint64_t K = 11;
+    vector<Gossamer::position_type> xs;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        xs.push_back(Gossamer::position_type(i * 7919));
+    }
+    {
+        Graph::Builder b(K, "g", fac, xs.size());
+        for (uint64_t i = 0; i < xs.size(); ++i)
+        {
+            b.push_back(xs[i], i + 1);
+        }
+        b.end();
+    }
+    BOOST_CHECK(fac.residentBytes() > 0);
+
+    GraphPtr g(Graph::open("g", fac));
+    BOOST_CHECK_EQUAL(g->count(), xs.size());
+    for (uint64_t i = 0; i < xs.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(g->multiplicity(i), i + 1);
+    }
+    // Nothing was written underneath.
+    BOOST_CHECK(!base->fileExists("g-header"));
+}
+
+#include "testEnd.hh"
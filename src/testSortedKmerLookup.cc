@@ -0,0 +1,122 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+
+#include "SortedKmerLookup.hh"
+#include "StringFileFactory.hh"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+using namespace boost;
+using namespace std;
+using namespace Gossamer;
+
+#define GOSS_TEST_MODULE TestSortedKmerLookup
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    // Check a batch of sorted lookups, and of sorted probes, against one
+    // accessAndRank per kmer.
+    void check(uint64_t pK, uint64_t pNumQueries = 5000)
+    {
+        std::mt19937 rng(17);
+        auto kmer = [&] () {
+            edge_type x(0);
+            for (uint64_t i = 0; i < 2 * pK; i += 32)
+            {
+                x <<= 32;
+                x |= edge_type(rng());
+            }
+            x &= (edge_type(1) << (2 * pK)) - 1;
+            return x;
+        };
+
+        vector<edge_type> xs;
+        for (uint64_t i = 0; i < 20000; ++i)
+        {
+            xs.push_back(kmer());
+        }
+        sort(xs.begin(), xs.end());
+        xs.erase(unique(xs.begin(), xs.end()), xs.end());
+
+        StringFileFactory fac;
+        {
+            KmerSet::Builder bld(pK, "x", fac, xs.size());
+            for (uint64_t i = 0; i < xs.size(); ++i)
+            {
+                bld.push_back(xs[i]);
+            }
+            bld.end();
+        }
+        KmerSet s("x", fac);
+
+        // Half present, half (almost certainly) absent, with duplicates.
+        SortedKmerLookup lookup(pK);
+        vector<edge_type> qs;
+        for (uint64_t i = 0; i < pNumQueries; ++i)
+        {
+            qs.push_back(xs[rng() % xs.size()]);
+            qs.push_back(kmer());
+        }
+        for (uint64_t i = 0; i < qs.size(); ++i)
+        {
+            lookup.push_back(qs[i]);
+        }
+        BOOST_CHECK_EQUAL(lookup.size(), qs.size());
+        lookup.sort(2);
+
+        vector<rank_type> ranks(qs.size(), ~rank_type(0));
+        auto vis = [&] (uint64_t pQuery, rank_type pRank) {
+            ranks[pQuery] = pRank;
+        };
+        lookup.lookup(s, vis);
+
+        vector<rank_type> probed(qs.size(), ~rank_type(0));
+        auto probeVis = [&] (uint64_t pQuery, rank_type pRank) {
+            probed[pQuery] = pRank;
+        };
+        lookup.probe(s, probeVis);
+        BOOST_CHECK(probed == ranks);
+
+        for (uint64_t i = 0; i < qs.size(); ++i)
+        {
+            rank_type r;
+            if (s.accessAndRank(KmerSet::Edge(qs[i]), r))
+            {
+                BOOST_CHECK_EQUAL(ranks[i], r);
+            }
+            else
+            {
+                BOOST_CHECK_EQUAL(ranks[i], ~rank_type(0));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSmallK)
+{
+    check(25);
+}
+
+BOOST_AUTO_TEST_CASE(testLargeK)
+{
+    check(55);
+}
+
+// Far apart queries, which lookup() seeks between.
+BOOST_AUTO_TEST_CASE(testSparseBatch)
+{
+    check(25, 20);
+    check(55, 20);
+}
+
+#include "testEnd.hh"
@@ -306,4 +306,96 @@ BOOST_AUTO_TEST_CASE(test5)
 }
 #endif
 
+BOOST_AUTO_TEST_CASE(testBatchAccessAndRank)
+{
+    const uint64_t N = 1000000;
+    StringFileFactory fac;
+    {
+        SparseArray::Builder b("x", fac, position_type(N), N / 20);
+
+        mt19937 rng(17);
+        uniform_real_distribution<> dist;
+
+        for (uint64_t i = 0; i < N; ++i)
+        {
+            if (dist(rng) < 0.05)
+            {
+                b.push_back(position_type(i));
+            }
+        }
+        b.end(position_type(N));
+    }
+
+    SparseArray a("x", fac);
+
+    // Query a mix of present and absent positions, in no particular
+    // order, and in a batch which isn't a whole number of windows.
+    std::vector<position_type> qs;
+    mt19937 rng(19);
+    uniform_int_distribution<uint64_t> pos(0, N - 1);
+    for (uint64_t i = 0; i < 10001; ++i)
+    {
+        qs.push_back(position_type(pos(rng)));
+    }
+    SparseArray::Iterator itr(a.iterator());
+    for (uint64_t i = 0; i < 1000 && itr.valid(); ++i, ++itr)
+    {
+        qs.push_back(*itr);
+    }
+
+    std::vector<rank_type> ranks(qs.size());
+    std::vector<bool> found(qs.size());
+    a.accessAndRank(qs.begin(), qs.end(), ranks.begin(), found.begin());
+
+    for (uint64_t i = 0; i < qs.size(); ++i)
+    {
+        rank_type r;
+        BOOST_CHECK_EQUAL(a.accessAndRank(qs[i], r), found[i]);
+        BOOST_CHECK_EQUAL(r, ranks[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testIteratorFromRank)
+{
+    const uint64_t N = 100000;
+    StringFileFactory fac;
+    {
+        SparseArray::Builder b("x", fac, position_type(N), N / 20);
+
+        mt19937 rng(17);
+        uniform_real_distribution<> dist;
+
+        for (uint64_t i = 0; i < N; ++i)
+        {
+            if (dist(rng) < 0.05)
+            {
+                b.push_back(position_type(i));
+            }
+        }
+        b.end(position_type(N));
+    }
+
+    SparseArray a("x", fac);
+    std::vector<position_type> xs;
+    for (SparseArray::Iterator itr(a.iterator()); itr.valid(); ++itr)
+    {
+        xs.push_back(*itr);
+    }
+    BOOST_CHECK_EQUAL(xs.size(), a.count());
+
+    for (uint64_t r = 0; r < xs.size(); r += 97)
+    {
+        SparseArray::Iterator itr(a.iterator(r));
+        for (uint64_t i = r; i < r + 200 && i < xs.size(); ++i, ++itr)
+        {
+            BOOST_CHECK(itr.valid());
+            BOOST_CHECK_EQUAL(*itr, xs[i]);
+        }
+    }
+    SparseArray::Iterator last(a.iterator(xs.size() - 1));
+    ++last;
+    BOOST_CHECK(!last.valid());
+    BOOST_CHECK(!a.iterator(xs.size()).valid());
+}
+
 #include "testEnd.hh"
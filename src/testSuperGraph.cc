@@ -0,0 +1,167 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "GossCmdBuildGraph.hh"
+#include "GossCmdBuildEntryEdgeSet.hh"
+#include "GossCmdBuildSupergraph.hh"
+#include "StringFileFactory.hh"
+#include "SuperGraph.hh"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestSuperGraph
+#include "testBegin.hh"
+
+namespace {
+
+    // Two copies of a repeat, so that the supergraph has branches.
+    static const char* rs[] = {
+        "GCATCTCTTCTATCGGTGAA",
+        "TATCGGTGAACAAGCTTTAG",
+        "CAAGCTTTAGGGAGGAGCGC",
+        "GGAGGAGCGCTCATGATGAT",
+        "TCATGATGATTCCTTAAAAC",
+        "TCCTTAAAACCGAACATAGG",
+        "CGAACATAGGCAAGCTTTAGGG",
+        "CAAGCTTTAGGGTGTCGTGC"
+    };
+
+    void buildSupergraph(StringFileFactory& pFac, Logger& pLog)
+    {
+        string reads;
+        for (uint64_t i = 0; i < sizeof(rs) / sizeof(char*); ++i)
+        {
+            reads += string(rs[i]) + "\n";
+        }
+        pFac.addFile("reads.ln", reads);
+
+        vector<string> fastas;
+        vector<string> fastqs;
+        vector<string> lines(1, "reads.ln");
+        boost::program_options::variables_map opts;
+        {
+            GossCmdBuildGraph cmd(9, 16, (1ULL << 16), 2, "graph", fastas, fastqs, lines);
+            GossCmdContext cxt(pFac, pLog, "build-graph", opts);
+            cmd(cxt);
+        }
+        {
+            GossCmdBuildEntryEdgeSet cmd("graph", 1);
+            GossCmdContext cxt(pFac, pLog, "build-entry-edge-set", opts);
+            cmd(cxt);
+        }
+        {
+            GossCmdBuildSupergraph cmd("graph", true);
+            GossCmdContext cxt(pFac, pLog, "build-supergraph", opts);
+            cmd(cxt);
+        }
+    }
+
+    // Everything observable about a supergraph, independent of the
+    // order in which nodes are visited.
+    string describe(const SuperGraph& pSG)
+    {
+        ostringstream out;
+        out << pSG.count() << ' ' << pSG.size() << '\n';
+        for (uint64_t i = 0; i < pSG.size(); ++i)
+        {
+            SuperPathId id(i);
+            out << i << ' ' << pSG.reverseComplement(id).value();
+            if (pSG.valid(id))
+            {
+                out << ' ' << lexical_cast<string>(pSG[id]);
+            }
+            out << '\n';
+        }
+
+        vector<SuperGraph::Node> ns;
+        pSG.nodes(ns);
+        sort(ns.begin(), ns.end());
+        SuperGraph::SuperPathIds ids;
+        for (uint64_t i = 0; i < ns.size(); ++i)
+        {
+            pSG.successors(ns[i], ids);
+            BOOST_CHECK_EQUAL(pSG.numOut(ns[i]), ids.size());
+            out << ns[i].value() << ':';
+            for (uint64_t j = 0; j < ids.size(); ++j)
+            {
+                out << ' ' << ids[j].value();
+            }
+            out << '\n';
+        }
+        return out.str();
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(testReadMatchesCreate)
+{
+    StringFileFactory fac;
+    Logger log("log.txt", fac);
+    buildSupergraph(fac, log);
+
+    auto created = SuperGraph::create("graph", fac);
+    auto read = SuperGraph::read("graph", fac);
+    BOOST_CHECK(created->count() > 2);
+    BOOST_CHECK_EQUAL(describe(*created), describe(*read));
+
+    uint64_t n = 0;
+    for (SuperGraph::PathIterator i(*read); i.valid(); ++i)
+    {
+        BOOST_CHECK(read->valid(*i));
+        ++n;
+    }
+    BOOST_CHECK_EQUAL(n, read->count());
+}
+
+BOOST_AUTO_TEST_CASE(testEditAndWriteBack)
+{
+    StringFileFactory fac;
+    Logger log("log.txt", fac);
+    buildSupergraph(fac, log);
+
+    string edited;
+    {
+        auto sgPtr = SuperGraph::read("graph", fac);
+        SuperGraph& sg(*sgPtr);
+        const uint64_t n = sg.count();
+
+        SuperPathId a = *SuperGraph::PathIterator(sg);
+        SuperGraph::Node s = sg.start(a);
+        const uint64_t outs = sg.numOut(s);
+
+        // A copy of a, then a itself erased, which frees two ids
+        // of the mapped graph for reuse.
+        pair<SuperPathId, SuperPathId> b = sg.link(vector<SuperPathId>(1, a));
+        BOOST_CHECK_EQUAL(sg.numOut(s), outs + 1);
+        sg.erase(a);
+        BOOST_CHECK(!sg.valid(a));
+        BOOST_CHECK_EQUAL(sg.numOut(s), outs);
+        BOOST_CHECK(sg.reverseComplement(b.second) == b.first);
+
+        SuperPathId g = sg.gapPath(10);
+        BOOST_CHECK(sg.isGap(g));
+        BOOST_CHECK(g.value() < n);
+        pair<SuperPathId, SuperPathId> c = sg.link(vector<SuperPathId>(2, b.first));
+        BOOST_CHECK_EQUAL(sg.size(c.first), 2 * sg.size(b.first));
+        BOOST_CHECK_EQUAL(sg.count(), n + 4);
+
+        edited = describe(sg);
+        sg.write("graph", fac);
+    }
+
+    auto sgPtr = SuperGraph::read("graph", fac);
+    BOOST_CHECK_EQUAL(describe(*sgPtr), edited);
+}
+
+#include "testEnd.hh"
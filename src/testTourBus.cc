@@ -145,7 +145,8 @@ void writeKmer(ostream& pOut, uint64_t pK, uint64_t pKmer)
 }
 
 void
-doTest(uint64_t pK, const char* pGenome, const char* pReads[])
+doTest(uint64_t pK, const char* pGenome, const char* pReads[],
+       uint64_t pNumThreads = 1)
 {
     const uint64_t K1 = pK + 1;
 
@@ -186,6 +187,7 @@ doTest(uint64_t pK, const char* pGenome, const char* pReads[])
     }
 #endif // DUMP_GRAPHS
     TourBus tourBus(g, log);
+    tourBus.setNumThreads(pNumThreads);
     tourBus.pass();
 
     {
@@ -237,6 +239,92 @@ BOOST_AUTO_TEST_CASE(test_reads6)
     doTest(11, genome6, reads6);
 }
 
+BOOST_AUTO_TEST_CASE(test_threaded)
+{
+    for (uint64_t t = 2; t <= 4; t += 2)
+    {
+        doTest(7, genome2, reads2, t);
+        doTest(7, genome3, reads3, t);
+        doTest(7, genome4, reads4, t);
+        doTest(7, genome5, reads5, t);
+        doTest(11, genome6, reads6, t);
+    }
+}
+
+// Popping bubbles on several threads should give the same graph
+// however many threads there are.
+BOOST_AUTO_TEST_CASE(test_threaded_deterministic)
+{
+    static const uint64_t K = 11;
+    static const uint64_t K1 = K + 1;
+    static const uint64_t L = 2000;
+    static const uint64_t R = 100;
+
+    std::mt19937 rng(17);
+    std::string genome;
+    for (uint64_t i = 0; i < L; ++i)
+    {
+        genome.push_back("ACGT"[rng() % 4]);
+    }
+
+    StringFileFactory fac;
+    Logger log("log.txt", fac);
+    map<Gossamer::position_type,uint64_t> k1mers;
+    SmallBaseVector vec;
+    for (uint64_t i = 0; i + R <= L; i += 5)
+    {
+        std::string rd(genome.substr(i, R));
+        if ((i / 5) % 7 == 3)
+        {
+            rd[R / 2] = (rd[R / 2] == 'A' ? 'C' : 'A');
+        }
+        seqToVec(rd.c_str(), vec);
+        for (uint64_t j = 0; j < vec.size() - K1; ++j)
+        {
+            Gossamer::position_type x = vec.kmer(K1, j);
+            ++k1mers[x];
+            x.reverseComplement(K1);
+            ++k1mers[x];
+        }
+    }
+    {
+        Graph::Builder b(K, "x", fac, k1mers.size());
+        for (map<Gossamer::position_type,uint64_t>::const_iterator i = k1mers.begin();
+                i != k1mers.end(); ++i)
+        {
+            b.push_back(i->first, i->second);
+        }
+        b.end();
+    }
+
+    vector<vector<Gossamer::position_type> > edges;
+    vector<uint64_t> removed;
+    for (uint64_t t = 1; t <= 8; t *= 2)
+    {
+        GraphPtr gPtr = Graph::open("x", fac);
+        TourBus tourBus(*gPtr, log);
+        tourBus.setNumThreads(t);
+        tourBus.pass();
+        removed.push_back(tourBus.removedEdgesCount());
+        {
+            Graph::Builder b(K, "y", fac, k1mers.size() - tourBus.removedEdgesCount());
+            tourBus.writeModifiedGraph(b);
+        }
+        GraphPtr goutPtr = Graph::open("y", fac);
+        edges.push_back(vector<Gossamer::position_type>());
+        for (uint64_t i = 0; i < goutPtr->count(); ++i)
+        {
+            edges.back().push_back(goutPtr->select(i).value());
+        }
+    }
+    BOOST_CHECK(removed[0] > 0);
+    for (uint64_t i = 1; i < edges.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(removed[0], removed[i]);
+        BOOST_CHECK(edges[0] == edges[i]);
+    }
+}
+
 #include "testEnd.hh"
 
 
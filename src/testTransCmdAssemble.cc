@@ -0,0 +1,134 @@
+// Copyright (c) 2008-2016, NICTA (National ICT Australia).
+// Copyright (c) 2016, Commonwealth Scientific and Industrial Research
+// Organisation (CSIRO) ABN 41 687 119 230.
+//
+// Licensed under the CSIRO Open Source Software License Agreement;
+// you may not use this file except in compliance with the License.
+// Please see the file LICENSE, included with this distribution.
+//
+#include "TranslucentApp.hh"
+#include "StringFileFactory.hh"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace boost;
+using namespace std;
+
+#define GOSS_TEST_MODULE TestTransCmdAssemble
+#include "testBegin.hh"
+
+namespace // anonymous
+{
+    // Made on first use, after the options it registers with.
+    TranslucentApp& app()
+    {
+        static TranslucentApp a;
+        return a;
+    }
+
+    string randomBases(std::mt19937& pRng, uint64_t pN)
+    {
+        static const char* bases = "ACGT";
+        string s;
+        for (uint64_t i = 0; i < pN; ++i)
+        {
+            s += bases[pRng() % 4];
+        }
+        return s;
+    }
+
+    string reverseComplement(const string& pSeq)
+    {
+        string s(pSeq.rbegin(), pSeq.rend());
+        for (uint64_t i = 0; i < s.size(); ++i)
+        {
+            switch (s[i])
+            {
+                case 'A': s[i] = 'T'; break;
+                case 'C': s[i] = 'G'; break;
+                case 'G': s[i] = 'C'; break;
+                case 'T': s[i] = 'A'; break;
+            }
+        }
+        return s;
+    }
+
+    void run(StringFileFactory& pFac, const vector<string>& pArgs)
+    {
+        vector<string> args(1, "translucent");
+        args.insert(args.end(), pArgs.begin(), pArgs.end());
+        vector<char*> argv;
+        for (uint64_t i = 0; i < args.size(); ++i)
+        {
+            argv.push_back(const_cast<char*>(args[i].c_str()));
+        }
+        FileFactoryPtr fac(&pFac, [](FileFactory*) {});
+        BOOST_CHECK_EQUAL(app().run(argv.size(), &argv[0], fac), 0);
+    }
+
+    // Paired reads from several genes, some with two isoforms which
+    // share exons, so that there are components of different sizes.
+    void addReads(StringFileFactory& pFac)
+    {
+        std::mt19937 rng(23);
+        vector<string> transcripts;
+        for (uint64_t g = 0; g < 8; ++g)
+        {
+            vector<string> exons;
+            for (uint64_t e = 0; e < 4; ++e)
+            {
+                exons.push_back(randomBases(rng, 150 + rng() % 100));
+            }
+            transcripts.push_back(exons[0] + exons[1] + exons[2] + exons[3]);
+            if (g % 2)
+            {
+                transcripts.push_back(exons[0] + exons[2] + exons[3]);
+            }
+        }
+
+        const uint64_t L = 60;
+        const uint64_t I = 200;
+        string lhs;
+        string rhs;
+        for (uint64_t t = 0; t < transcripts.size(); ++t)
+        {
+            const string& s(transcripts[t]);
+            const uint64_t n = (20 + 10 * t) * s.size() / L;
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                uint64_t p = rng() % (s.size() - I + 1);
+                lhs += s.substr(p, L) + "\n";
+                rhs += reverseComplement(s.substr(p + I - L, L)) + "\n";
+            }
+        }
+        pFac.addFile("reads1.ln", lhs);
+        pFac.addFile("reads2.ln", rhs);
+    }
+}
+
+// Components are resolved on several threads, but the contigs must come
+// out the same, and in the same order, whatever the number of threads.
+BOOST_AUTO_TEST_CASE(testThreadsGiveSameOutput)
+{
+    StringFileFactory fac;
+    addReads(fac);
+    run(fac, {"build-graph", "-k", "25", "-B", "1", "-T", "2",
+              "--line-in", "reads1.ln", "--line-in", "reads2.ln", "-O", "graph"});
+
+    vector<string> outs;
+    for (const char* t : {"1", "2", "4"})
+    {
+        string out = string("contigs-") + t + ".fa";
+        run(fac, {"assemble", "-G", "graph", "-T", t,
+                  "--line-in", "reads1.ln", "--line-in", "reads2.ln", "-o", out});
+        outs.push_back(fac.readFile(out));
+    }
+
+    BOOST_CHECK(outs[0].find('>') != string::npos);
+    BOOST_CHECK_EQUAL(outs[1], outs[0]);
+    BOOST_CHECK_EQUAL(outs[2], outs[0]);
+}
+
+#include "testEnd.hh"